@@ -5,6 +5,7 @@
 #include "spectral/hpcp.h"
 #include "tonal/pitchcontoursmonomelody.h"
 #include "io/fileoutputproxy.h"
+#include "io/cachedmonoloader.h"
 #include "sfx/maxtototal.h"
 #include "tonal/harmonicpeaks.h"
 #include "spectral/maxmagfreq.h"
@@ -14,8 +15,12 @@
 #include "spectral/spectralwhitening.h"
 #include "spectral/spectrumtocent.h"
 #include "rhythm/superfluxnovelty.h"
+#ifdef __APPLE__
 #include "standard/iffta.h"
 #include "standard/ifftca.h"
+#endif
+#include "standard/ifftn.h"
+#include "standard/ifftcn.h"
 #include "standard/stereodemuxer.h"
 #include "tonal/inharmonicity.h"
 #include "stats/instantpower.h"
@@ -127,6 +132,7 @@
 #include "filters/bandpass.h"
 #include "synthesis/sprmodelsynth.h"
 #include "standard/framecutter.h"
+#include "standard/framedspectrum.h"
 #include "spectral/frequencybands.h"
 #include "tonal/pitchcontoursegmentation.h"
 #include "spectral/energyband.h"
@@ -145,8 +151,13 @@
 #include "synthesis/harmonicmodelanal.h"
 #include "stats/decrease.h"
 #include "standard/peakdetection.h"
+#ifdef __APPLE__
 #include "standard/ffta.h"
 #include "standard/fftca.h"
+#endif
+#include "standard/fftn.h"
+#include "standard/fftcn.h"
+#include "standard/fftbatch.h"
 #include "rhythm/onsetrate.h"
 #include "stats/poolaggregator.h"
 #include "standard/bpf.h"
@@ -226,8 +237,13 @@ ESSENTIA_API void registerAlgorithm() {
     AlgorithmFactory::Registrar<SpectralWhitening> regSpectralWhitening;
     AlgorithmFactory::Registrar<SpectrumToCent> regSpectrumToCent;
     AlgorithmFactory::Registrar<SuperFluxNovelty> regSuperFluxNovelty;
+#ifdef __APPLE__
     AlgorithmFactory::Registrar<IFFTA> regIFFTA;
     AlgorithmFactory::Registrar<IFFTCA> regIFFTCA;
+#else
+    AlgorithmFactory::Registrar<IFFTN> regIFFTN;
+    AlgorithmFactory::Registrar<IFFTCN> regIFFTCN;
+#endif
     AlgorithmFactory::Registrar<StereoDemuxer> regStereoDemuxer;
     AlgorithmFactory::Registrar<Inharmonicity> regInharmonicity;
     AlgorithmFactory::Registrar<InstantPower> regInstantPower;
@@ -355,8 +371,14 @@ ESSENTIA_API void registerAlgorithm() {
     AlgorithmFactory::Registrar<HarmonicModelAnal> regHarmonicModelAnal;
     AlgorithmFactory::Registrar<Decrease> regDecrease;
     AlgorithmFactory::Registrar<PeakDetection> regPeakDetection;
+#ifdef __APPLE__
     AlgorithmFactory::Registrar<FFTA> regFFTA;
     AlgorithmFactory::Registrar<FFTCA> regFFTCA;
+#else
+    AlgorithmFactory::Registrar<FFTN> regFFTN;
+    AlgorithmFactory::Registrar<FFTCN> regFFTCN;
+#endif
+    AlgorithmFactory::Registrar<FFTBatch> regFFTBatch;
     AlgorithmFactory::Registrar<OnsetRate> regOnsetRate;
     AlgorithmFactory::Registrar<PoolAggregator> regPoolAggregator;
     AlgorithmFactory::Registrar<BPF> regBPF;
@@ -438,8 +460,13 @@ ESSENTIA_API void registerAlgorithm() {
     AlgorithmFactory::Registrar<SpectralWhitening, essentia::standard::SpectralWhitening> regSpectralWhitening;
     AlgorithmFactory::Registrar<SpectrumToCent, essentia::standard::SpectrumToCent> regSpectrumToCent;
     AlgorithmFactory::Registrar<SuperFluxNovelty, essentia::standard::SuperFluxNovelty> regSuperFluxNovelty;
+#ifdef __APPLE__
     AlgorithmFactory::Registrar<IFFTA, essentia::standard::IFFTA> regIFFTA;
     AlgorithmFactory::Registrar<IFFTCA, essentia::standard::IFFTCA> regIFFTCA;
+#else
+    AlgorithmFactory::Registrar<IFFTN, essentia::standard::IFFTN> regIFFTN;
+    AlgorithmFactory::Registrar<IFFTCN, essentia::standard::IFFTCN> regIFFTCN;
+#endif
     AlgorithmFactory::Registrar<StereoDemuxer, essentia::standard::StereoDemuxer> regStereoDemuxer;
     AlgorithmFactory::Registrar<Inharmonicity, essentia::standard::Inharmonicity> regInharmonicity;
     AlgorithmFactory::Registrar<InstantPower, essentia::standard::InstantPower> regInstantPower;
@@ -564,8 +591,14 @@ ESSENTIA_API void registerAlgorithm() {
     AlgorithmFactory::Registrar<HarmonicModelAnal, essentia::standard::HarmonicModelAnal> regHarmonicModelAnal;
     AlgorithmFactory::Registrar<Decrease, essentia::standard::Decrease> regDecrease;
     AlgorithmFactory::Registrar<PeakDetection, essentia::standard::PeakDetection> regPeakDetection;
+#ifdef __APPLE__
     AlgorithmFactory::Registrar<FFTA, essentia::standard::FFTA> regFFTA;
     AlgorithmFactory::Registrar<FFTCA, essentia::standard::FFTCA> regFFTCA;
+#else
+    AlgorithmFactory::Registrar<FFTN, essentia::standard::FFTN> regFFTN;
+    AlgorithmFactory::Registrar<FFTCN, essentia::standard::FFTCN> regFFTCN;
+#endif
+    AlgorithmFactory::Registrar<FFTBatch, essentia::standard::FFTBatch> regFFTBatch;
     AlgorithmFactory::Registrar<OnsetRate, essentia::standard::OnsetRate> regOnsetRate;
 //    AlgorithmFactory::Registrar<PoolAggregator, essentia::standard::PoolAggregator> regPoolAggregator;
     AlgorithmFactory::Registrar<BPF, essentia::standard::BPF> regBPF;
@@ -615,6 +648,8 @@ ESSENTIA_API void registerAlgorithm() {
     AlgorithmFactory::Registrar<MFCC, essentia::standard::MFCC> regMFCC;
     AlgorithmFactory::Registrar<NoveltyCurve, essentia::standard::NoveltyCurve> regNoveltyCurve;
     AlgorithmFactory::Registrar<Spectrum, essentia::standard::Spectrum> regSpectrum;
+    AlgorithmFactory::Registrar<FramedSpectrum> regFramedSpectrum;
+    AlgorithmFactory::Registrar<CachedMonoLoader> regCachedMonoLoader;
     AlgorithmFactory::Registrar<TempoTapMaxAgreement, essentia::standard::TempoTapMaxAgreement> regTempoTapMaxAgreement;
     AlgorithmFactory::Registrar<FrameToReal, essentia::standard::FrameToReal> regFrameToReal;
     AlgorithmFactory::Registrar<PowerSpectrum, essentia::standard::PowerSpectrum> regPowerSpectrum;
@@ -623,4 +658,37 @@ ESSENTIA_API void registerAlgorithm() {
     AlgorithmFactory::Registrar<BarkExtractor> regBarkExtractor;
     AlgorithmFactory::Registrar<ConstantQ, essentia::standard::ConstantQ> regConstantQ;
     AlgorithmFactory::Registrar<Chromagram, essentia::standard::Chromagram> regChromagram;
-}}}
+}
+
+} // namespace streaming
+
+
+ESSENTIA_API void setFFTBackend(const std::string& backend) {
+  if (backend == "builtin") {
+    standard::AlgorithmFactory::replace<standard::FFTN>();
+    standard::AlgorithmFactory::replace<standard::IFFTN>();
+    standard::AlgorithmFactory::replace<standard::FFTCN>();
+    standard::AlgorithmFactory::replace<standard::IFFTCN>();
+    streaming::AlgorithmFactory::replace<streaming::FFTN, standard::FFTN>();
+    streaming::AlgorithmFactory::replace<streaming::IFFTN, standard::IFFTN>();
+    streaming::AlgorithmFactory::replace<streaming::FFTCN, standard::FFTCN>();
+    streaming::AlgorithmFactory::replace<streaming::IFFTCN, standard::IFFTCN>();
+  }
+#ifdef __APPLE__
+  else if (backend == "accelerate") {
+    standard::AlgorithmFactory::replace<standard::FFTA>();
+    standard::AlgorithmFactory::replace<standard::IFFTA>();
+    standard::AlgorithmFactory::replace<standard::FFTCA>();
+    standard::AlgorithmFactory::replace<standard::IFFTCA>();
+    streaming::AlgorithmFactory::replace<streaming::FFTA, standard::FFTA>();
+    streaming::AlgorithmFactory::replace<streaming::IFFTA, standard::IFFTA>();
+    streaming::AlgorithmFactory::replace<streaming::FFTCA, standard::FFTCA>();
+    streaming::AlgorithmFactory::replace<streaming::IFFTCA, standard::IFFTCA>();
+  }
+#endif
+  else {
+    throw EssentiaException("setFFTBackend: unknown or unavailable FFT backend: ", backend);
+  }
+}
+
+} // namespace essentia
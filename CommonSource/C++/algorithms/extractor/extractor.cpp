@@ -314,7 +314,7 @@ void Extractor::levelAverage(Pool& pool) {
 }
 
 void Extractor::tuningSystemFeatures(Pool& pool) {
-  vector<Real> hpcp_highres = meanFrames(pool.value<vector<vector<Real> > >(_tonalspace + "hpcp_highres"));
+  vector<Real> hpcp_highres = meanFrames(pool.frames(_tonalspace + "hpcp_highres"));
   normalize(hpcp_highres);
 
   // 1- diatonic strength
@@ -347,7 +347,7 @@ void Extractor::tuningSystemFeatures(Pool& pool) {
   pool.set(_tonalspace + "tuning_nontempered_energy_ratio", ntEnergy);
 
   // 3- THPCP
-  vector<Real> hpcp = meanFrames(pool.value<vector<vector<Real> > >(_tonalspace + "hpcp"));
+  vector<Real> hpcp = meanFrames(pool.frames(_tonalspace + "hpcp"));
   normalize(hpcp);
   int idxMax = argmax(hpcp);
   vector<Real> hpcp_bak = hpcp;
@@ -18,6 +18,7 @@
  */
 
 #include "freesoundextractor.h"
+#include "vectoroutput.h"
 
 using namespace std;
 
@@ -174,7 +175,6 @@ void FreesoundExtractor::compute() {
   Pool results;
   Pool stats;
 
-  streaming::AlgorithmFactory& factory = streaming::AlgorithmFactory::instance();
 
   results.set("metadata.version.essentia", essentia::version);
   results.set("metadata.version.essentia_git_sha", essentia::version_git_sha);
@@ -191,8 +191,12 @@ void FreesoundExtractor::compute() {
   E_INFO("FreesoundExtractor: Read metadata");
   readMetadata(audioFilename, results);
  
+  // the decoded signal is kept in the AudioCache until the end of the
+  // analysis, so that the file is only decoded once
+  AudioCacheReference audio;
+
   E_INFO("FreesoundExtractor: Compute md5 audio hash, codec, length, and EBU 128 loudness");
-  computeAudioMetadata(audioFilename, results);
+  computeAudioMetadata(audioFilename, results, audio);
   
   //TODO: add algorithm option to compute with replay gain? 
   //E_INFO("FreesoundExtractor: Replay gain");
@@ -200,25 +204,20 @@ void FreesoundExtractor::compute() {
 
   E_INFO("FreesoundExtractor: Compute audio features");
 
-  streaming::Algorithm* loader = factory.create("EasyLoader",
-                                    "filename",   audioFilename,
-                                    "sampleRate", analysisSampleRate,
-                                    "startTime",  startTime,
-                                    "endTime",    endTime,
-                                    //"replayGain", replayGain,
-                                    "downmix",    downmix);
+  streaming::Algorithm* trimmer;
+  streaming::Algorithm* loader = createLoader(audioFilename, trimmer);
 
   FreesoundLowlevelDescriptors *lowlevel = new FreesoundLowlevelDescriptors(options);
   FreesoundRhythmDescriptors *rhythm = new FreesoundRhythmDescriptors(options);
   FreesoundTonalDescriptors *tonal = new FreesoundTonalDescriptors(options);
   FreesoundSfxDescriptors *sfx = new FreesoundSfxDescriptors(options);
  
-  SourceBase& source = loader->output("audio");
-  lowlevel->createNetwork(loader->output("audio"),results);
+  SourceBase& source = trimmer->output("signal");
+  lowlevel->createNetwork(source, results);
   rhythm->createNetwork(source, results);
   tonal->createNetwork(source, results);
-  sfx->createNetwork(loader->output("audio"),results);
-  sfx->createHarmonicityNetwork(loader->output("audio"), results);            
+  sfx->createNetwork(source, results);
+  sfx->createHarmonicityNetwork(source, results);
 
   scheduler::Network network(loader);
   network.run();
@@ -228,16 +227,11 @@ void FreesoundExtractor::compute() {
   // requires 'loudness'
   lowlevel->computeAverageLoudness(results);
 
-  streaming::Algorithm* loader_2 = factory.create("EasyLoader",
-                                       "filename",   audioFilename,
-                                       "sampleRate", analysisSampleRate,
-                                       "startTime",  startTime,
-                                       "endTime",    endTime,
-                                       //"replayGain", replayGain,
-                                       "downmix",    downmix);
+  streaming::Algorithm* trimmer_2;
+  streaming::Algorithm* loader_2 = createLoader(audioFilename, trimmer_2);
 
   // requires 'beat_positions'
-  rhythm->createNetworkBeatsLoudness(loader_2->output("audio"), results);  
+  rhythm->createNetworkBeatsLoudness(trimmer_2->output("signal"), results);
 
   scheduler::Network network_2(loader_2);
   network_2.run();
@@ -420,7 +414,30 @@ void FreesoundExtractor::readMetadata(const string& audioFilename, Pool& results
 }
 
 
-void FreesoundExtractor::computeAudioMetadata(const string& audioFilename, Pool& results) {
+/**
+ * Creates the chain CachedMonoLoader → Trimmer, which outputs the same signal
+ * as an EasyLoader without replay gain but reads it from the AudioCache, and
+ * returns the loader. The analyzed signal is the output of @c trimmer.
+ */
+streaming::Algorithm* FreesoundExtractor::createLoader(const string& audioFilename, streaming::Algorithm*& trimmer) {
+  streaming::AlgorithmFactory& factory = streaming::AlgorithmFactory::instance();
+
+  streaming::Algorithm* loader = factory.create("CachedMonoLoader",
+                                                "filename",   audioFilename,
+                                                "sampleRate", analysisSampleRate,
+                                                "downmix",    downmix);
+  trimmer = factory.create("Trimmer",
+                           "sampleRate", analysisSampleRate,
+                           "startTime",  startTime,
+                           "endTime",    endTime);
+
+  loader->output("audio") >> trimmer->input("signal");
+
+  return loader;
+}
+
+
+void FreesoundExtractor::computeAudioMetadata(const string& audioFilename, Pool& results, AudioCacheReference& audio) {
   streaming::AlgorithmFactory& factory = streaming::AlgorithmFactory::instance();
   streaming::Algorithm* loader = factory.create("AudioLoader",
                                                 "filename",   audioFilename,
@@ -438,12 +455,17 @@ void FreesoundExtractor::computeAudioMetadata(const string& audioFilename, Pool&
   streaming::Algorithm* resampleL = factory.create("Resample");
   streaming::Algorithm* trimmer = factory.create("StereoTrimmer");
   streaming::Algorithm* loudness = factory.create("LoudnessEBUR128");
+  streaming::Algorithm* mixer = factory.create("MonoMixer", "type", downmix);
+  streaming::Algorithm* resample = factory.create("Resample");
 
   Real inputSampleRate = lastTokenProduced<Real>(loader->output("sampleRate"));
   resampleR->configure("inputSampleRate", inputSampleRate,
                        "outputSampleRate", analysisSampleRate);
   resampleL->configure("inputSampleRate", inputSampleRate,
                        "outputSampleRate", analysisSampleRate);
+  // same configuration as in MonoLoader
+  resample->configure("inputSampleRate", (int)inputSampleRate,
+                      "outputSampleRate", analysisSampleRate);
   trimmer->configure("sampleRate", analysisSampleRate,
                      "startTime", startTime,
                      "endTime", endTime);
@@ -461,6 +483,15 @@ void FreesoundExtractor::computeAudioMetadata(const string& audioFilename, Pool&
   loudness->output("shortTermLoudness") >> PC(results, "lowlevel.loudness_ebu128.short_term");
   loudness->output("loudnessRange") >> PC(results, "lowlevel.loudness_ebu128.loudness_range");
 
+  // the signal is also downmixed and resampled the same way as MonoLoader does,
+  // and put in the AudioCache, where the networks computing the audio features
+  // read it from
+  vector<AudioSample> monoSignal;
+  loader->output("audio")             >> mixer->input("audio");
+  loader->output("numberChannels")    >> mixer->input("numberChannels");
+  mixer->output("audio")              >> resample->input("signal");
+  resample->output("signal")          >> monoSignal;
+
   scheduler::Network network(loader);
   network.run();
   
@@ -468,6 +499,8 @@ void FreesoundExtractor::computeAudioMetadata(const string& audioFilename, Pool&
   Real length = loader->output("audio").totalProduced() / inputSampleRate;
   Real analysis_length = trimmer->output("signal").totalProduced() / analysisSampleRate;
 
+  audio.insert(audioFilename, analysisSampleRate, downmix, 0, monoSignal);
+
   if (!analysis_length) {
     ostringstream msg;
     msg << "FreesoundExtractor: empty input signal (analysis startTime: " << startTime
@@ -28,6 +28,7 @@
 #include "../../essentia/utils/extractor_freesound/FreesoundSfxDescriptors.h"
 #include "../../essentia/utils/extractor_freesound/FreesoundTonalDescriptors.h"
 #include "../../essentia/utils/extractor_freesound/extractor_version.h"
+#include "../io/audiocache.h"
 
 namespace essentia {
 namespace standard {
@@ -81,7 +82,8 @@ class FreesoundExtractor : public Algorithm {
   void setExtractorDefaultOptions();
   void mergeValues(Pool &pool);
   void readMetadata(const std::string& audioFilename, Pool& results);
-  void computeAudioMetadata(const std::string& audioFilename, Pool& results);
+  void computeAudioMetadata(const std::string& audioFilename, Pool& results, AudioCacheReference& audio);
+  streaming::Algorithm* createLoader(const std::string& audioFilename, streaming::Algorithm*& trimmer);
   void computeReplayGain(const std::string& audioFilename, Pool& results);
 
   Pool computeAggregation(Pool& pool);
@@ -19,6 +19,7 @@
 
 #include "musicextractor.h"
 #include "../../essentia/utils/extractor_music/tagwhitelist.h"
+#include "vectoroutput.h"
 
 using namespace std;
 
@@ -30,7 +31,9 @@ const char* MusicExtractor::category = "Extractors";
 const char* MusicExtractor::description = DOC("This algorithm is a wrapper for Music Extractor");
 
 
-MusicExtractor::MusicExtractor() {
+MusicExtractor::MusicExtractor() : _loader(0), _loader2(0), _scale(0), _scale2(0),
+                                   _network(0), _network2(0),
+                                   _lowlevel(0), _rhythm(0), _tonal(0), _aggregator(0) {
   declareInput(_audiofile, "filename", "the input audiofile");
   declareOutput(_resultsStats, "results", "Analysis results pool with across-frames statistics");
   declareOutput(_resultsFrames, "resultsFrames", "Analysis results pool with computed frame values");
@@ -38,6 +41,8 @@ MusicExtractor::MusicExtractor() {
 
 
 MusicExtractor::~MusicExtractor() {
+  clearNetworks();
+
   if (options.value<Real>("highlevel.compute")) {
 #if HAVE_GAIA2
     if (_svms) delete _svms;
@@ -49,6 +54,72 @@ MusicExtractor::~MusicExtractor() {
 void MusicExtractor::reset() {}
 
 
+void MusicExtractor::clearNetworks() {
+  // the networks own their algorithms, loaders included
+  delete _network;
+  delete _network2;
+  delete _lowlevel;
+  delete _rhythm;
+  delete _tonal;
+  delete _aggregator;
+
+  _loader = _loader2 = 0;
+  _scale = _scale2 = 0;
+  _network = _network2 = 0;
+  _lowlevel = 0;
+  _rhythm = 0;
+  _tonal = 0;
+  _aggregator = 0;
+}
+
+
+void MusicExtractor::runNetwork(scheduler::Network* network) {
+  try {
+    network->run();
+  }
+  catch (...) {
+    // the state of the networks is unknown now, rebuild them for the next file
+    clearNetworks();
+    throw;
+  }
+  // put the algorithms back in their initial state, ready for the next file
+  network->reset();
+}
+
+
+/**
+ * Creates the chain CachedMonoLoader → Trimmer → Scale, which outputs the same
+ * signal as an EasyLoader but reads it from the AudioCache, and returns the
+ * loader. The analyzed signal is the output of @c scale.
+ */
+streaming::Algorithm* MusicExtractor::createLoader(streaming::Algorithm*& scale) {
+  streaming::AlgorithmFactory& factory = streaming::AlgorithmFactory::instance();
+
+  streaming::Algorithm* loader = factory.create("CachedMonoLoader");
+  streaming::Algorithm* trimmer = factory.create("Trimmer",
+                                                 "sampleRate", analysisSampleRate,
+                                                 "startTime",  startTime,
+                                                 "endTime",    endTime);
+  scale = factory.create("Scale");
+
+  loader->output("audio")     >> trimmer->input("signal");
+  trimmer->output("signal")   >> scale->input("signal");
+
+  return loader;
+}
+
+
+void MusicExtractor::configureLoader(streaming::Algorithm* loader, streaming::Algorithm* scale,
+                                     const string& audioFilename) {
+  loader->configure("filename",   audioFilename,
+                    "sampleRate", analysisSampleRate,
+                    "downmix",    downmix);
+
+  // apply a 6dB preamp, as done by all audio players (see EasyLoader)
+  scale->configure("factor", db2amp(replayGain + 6.0));
+}
+
+
 void MusicExtractor::configure() {
 
   downmix = "mix";
@@ -63,6 +134,7 @@ void MusicExtractor::configure() {
   lowlevelZeroPadding = parameter("lowlevelZeroPadding").toInt();
   lowlevelSilentFrames = parameter("lowlevelSilentFrames").toLower();
   lowlevelWindowType = parameter("lowlevelWindowType").toLower();
+  lowlevelOutputFrames = parameter("lowlevelOutputFrames").toBool();
 
   tonalFrameSize = parameter("tonalFrameSize").toInt();
   tonalHopSize = parameter("tonalHopSize").toInt();
@@ -91,6 +163,8 @@ void MusicExtractor::configure() {
   }
 #endif
 
+  clearNetworks();
+
   options.clear();
   setExtractorDefaultOptions();
 
@@ -127,6 +201,7 @@ void MusicExtractor::setExtractorDefaultOptions() {
   options.set("lowlevel.zeroPadding", lowlevelZeroPadding);
   options.set("lowlevel.windowType", lowlevelWindowType);
   options.set("lowlevel.silentFrames", lowlevelSilentFrames);
+  options.set("lowlevel.outputFrames", lowlevelOutputFrames);
 
   // tonal
   options.set("tonal.frameSize", tonalFrameSize);
@@ -171,10 +246,11 @@ void MusicExtractor::compute() {
   Pool& resultsStats = _resultsStats.get();
   Pool& resultsFrames = _resultsFrames.get();
 
-  Pool results;
+  Pool& results = _results;
   Pool stats;
 
-  streaming::AlgorithmFactory& factory = streaming::AlgorithmFactory::instance();
+  results.clear();
+  _aggregatedStats.clear();
 
   results.set("metadata.version.essentia", essentia::version);
   results.set("metadata.version.essentia_git_sha", essentia::version_git_sha);
@@ -199,63 +275,76 @@ void MusicExtractor::compute() {
       throw EssentiaException("MusicExtractor: Error processing ", audioFilename, " file: cannot find musicbrainz recording id");
   }
   
+  // the decoded signal is kept in the AudioCache until the end of the
+  // analysis, so that the file is only decoded once
+  AudioCacheReference audio;
+
   E_INFO("MusicExtractor: Compute md5 audio hash, codec, length, and EBU 128 loudness");
-  computeAudioMetadata(audioFilename, results);
+  computeAudioMetadata(audioFilename, results, audio);
   
   E_INFO("MusicExtractor: Replay gain");
-  computeReplayGain(audioFilename, results);
+  computeReplayGain(audioFilename, results, audio);
   
   E_INFO("MusicExtractor: Compute audio features");
 
   // normalize the audio with replay gain and compute as many lowlevel, rhythm,
   // and tonal descriptors as possible
   
-  streaming::Algorithm* loader = factory.create("EasyLoader",
-                                    "filename",   audioFilename,
-                                    "sampleRate", analysisSampleRate,
-                                    "startTime",  startTime,
-                                    "endTime",    endTime,
-                                    "replayGain", replayGain,
-                                    "downmix",    downmix);
-  MusicLowlevelDescriptors *lowlevel = new MusicLowlevelDescriptors(options);
-  MusicRhythmDescriptors *rhythm = new MusicRhythmDescriptors(options);
-  MusicTonalDescriptors *tonal = new MusicTonalDescriptors(options);
-  
-  SourceBase& source = loader->output("audio");
-  lowlevel->createNetworkNeqLoud(source, results);
-  lowlevel->createNetworkEqLoud(source, results);
-  lowlevel->createNetworkLoudness(source, results);
-  rhythm->createNetwork(source, results);
-  tonal->createNetworkTuningFrequency(source, results);
+  if (!_network) {
+    _loader = createLoader(_scale);
+    configureLoader(_loader, _scale, audioFilename);
+    _lowlevel = new MusicLowlevelDescriptors(options);
+    _lowlevel->setStatsPool(&_aggregatedStats);
+    _rhythm = new MusicRhythmDescriptors(options);
+    _tonal = new MusicTonalDescriptors(options);
+
+    SourceBase& source = _scale->output("signal");
+    _lowlevel->createNetworkNeqLoud(source, results);
+    _lowlevel->createNetworkEqLoud(source, results);
+    _lowlevel->createNetworkLoudness(source, results);
+    _rhythm->createNetwork(source, results);
+    _tonal->createNetworkTuningFrequency(source, results);
+
+    // duplicates are not merged (see Network::setMergeDuplicates()): the
+    // spectra computed from the same signal have different frame sizes, and
+    // they are FramedSpectrum composites which add noise to silent frames by
+    // default, so that there would be nothing to merge
+    _network = new scheduler::Network(_loader);
+  }
+  else {
+    configureLoader(_loader, _scale, audioFilename);
+  }
+
+  runNetwork(_network);
 
-  scheduler::Network network(loader);
-  network.run();
-  
   // Descriptors that require values from other descriptors in the previous chain
-  lowlevel->computeAverageLoudness(results);  // requires 'loudness'
+  _lowlevel->computeAverageLoudness(results);  // requires 'loudness'
+
+  if (!_network2) {
+    _loader2 = createLoader(_scale2);
+    configureLoader(_loader2, _scale2, audioFilename);
 
-  streaming::Algorithm* loader_2 = factory.create("EasyLoader",
-                                       "filename",   audioFilename,
-                                       "sampleRate", analysisSampleRate,
-                                       "startTime",  startTime,
-                                       "endTime",    endTime,
-                                       "replayGain", replayGain,
-                                       "downmix",    downmix);
+    SourceBase& source_2 = _scale2->output("signal");
+    _rhythm->createNetworkBeatsLoudness(source_2, results);  // requires 'beat_positions'
+    _tonal->createNetwork(source_2, results);                // requires 'tuning frequency'
 
-  SourceBase& source_2 = loader_2->output("audio");
-  rhythm->createNetworkBeatsLoudness(source_2, results);  // requires 'beat_positions'
-  tonal->createNetwork(source_2, results);                // requires 'tuning frequency'
+    _network2 = new scheduler::Network(_loader2);
+  }
+  else {
+    configureLoader(_loader2, _scale2, audioFilename);
+    _rhythm->updateNetworkBeatsLoudness(results);
+    _tonal->updateNetwork(results);
+  }
 
-  scheduler::Network network_2(loader_2);
-  network_2.run();
+  runNetwork(_network2);
 
   // Descriptors that require values from other descriptors in the previous chain
-  tonal->computeTuningSystemFeatures(results); // requires 'hpcp_highres'
+  _tonal->computeTuningSystemFeatures(results); // requires 'hpcp_highres'
 
   // TODO is this necessary? tuning_frequency should always have one value:
-  Real tuningFreq = results.value<vector<Real> >(tonal->nameSpace + "tuning_frequency").back();
-  results.remove(tonal->nameSpace + "tuning_frequency");
-  results.set(tonal->nameSpace + "tuning_frequency", tuningFreq);
+  Real tuningFreq = results.value<vector<Real> >(MusicTonalDescriptors::nameSpace + "tuning_frequency").back();
+  results.remove(MusicTonalDescriptors::nameSpace + "tuning_frequency");
+  results.set(MusicTonalDescriptors::nameSpace + "tuning_frequency", tuningFreq);
   
 
   E_INFO("MusicExtractor: Compute aggregation");
@@ -288,36 +377,21 @@ Pool MusicExtractor::computeAggregation(Pool& pool){
   map<string, vector<string> > exceptions;
   const vector<string>& descNames = pool.descriptorNames();
   for (int i=0; i<(int)descNames.size(); i++) {
-    if (descNames[i].find("lowlevel.mfcc") != string::npos) {
-      exceptions[descNames[i]] = options.value<vector<string> >("lowlevel.mfccStats");
-      continue;
-    }
-    if (descNames[i].find("lowlevel.gfcc") != string::npos) {
-      exceptions[descNames[i]] = options.value<vector<string> >("lowlevel.gfccStats");
-      continue;
-    }
-    if (descNames[i].find("lowlevel.") != string::npos) {
-      exceptions[descNames[i]] = options.value<vector<string> >("lowlevel.stats");
-      continue;
-    }
-    if (descNames[i].find("rhythm.") != string::npos) {
-      exceptions[descNames[i]] = options.value<vector<string> >("rhythm.stats");
-      continue;
-    }
-    if (descNames[i].find("tonal.") != string::npos) {
-      exceptions[descNames[i]] = options.value<vector<string> >("tonal.stats");
-      continue;
-    }
+    vector<string> descStats = MusicDescriptorSet::descriptorStats(options, descNames[i]);
+    if (!descStats.empty()) exceptions[descNames[i]] = descStats;
   }
 
-  standard::Algorithm* aggregator = standard::AlgorithmFactory::create("PoolAggregator",
-                                                                       "defaultStats", arrayToVector<string>(defaultStats),
-                                                                       "exceptions", exceptions);
+  if (!_aggregator) _aggregator = standard::AlgorithmFactory::create("PoolAggregator");
+  _aggregator->configure("defaultStats", arrayToVector<string>(defaultStats),
+                         "exceptions", exceptions);
   Pool poolStats;
-  aggregator->input("input").set(pool);
-  aggregator->output("output").set(poolStats);
+  _aggregator->input("input").set(pool);
+  _aggregator->output("output").set(poolStats);
+
+  _aggregator->compute();
 
-  aggregator->compute();
+  // the descriptors whose frames were not stored have already been aggregated
+  poolStats.merge(_aggregatedStats);
 
 
   // add descriptors that may be missing due to content
@@ -356,8 +430,6 @@ Pool MusicExtractor::computeAggregation(Pool& pool){
   poolStats.set(string("rhythm.beats_count"), pool.value<vector<Real> >("rhythm.beats_position").size());
   //poolStats.set(string("tonal.chords_count"), pool.value<vector<string> >("tonal.chords_progression").size());
 
-  delete aggregator;
-
   return poolStats;
 }
 
@@ -438,7 +510,7 @@ void MusicExtractor::readMetadata(const string& audioFilename, Pool& results) {
 }
 
 
-void MusicExtractor::computeAudioMetadata(const string& audioFilename, Pool& results) {
+void MusicExtractor::computeAudioMetadata(const string& audioFilename, Pool& results, AudioCacheReference& audio) {
   streaming::AlgorithmFactory& factory = streaming::AlgorithmFactory::instance();
   streaming::Algorithm* loader = factory.create("AudioLoader",
                                                 "filename",   audioFilename,
@@ -456,12 +528,17 @@ void MusicExtractor::computeAudioMetadata(const string& audioFilename, Pool& res
   streaming::Algorithm* resampleL = factory.create("Resample");
   streaming::Algorithm* trimmer = factory.create("StereoTrimmer");
   streaming::Algorithm* loudness = factory.create("LoudnessEBUR128");
+  streaming::Algorithm* mixer = factory.create("MonoMixer", "type", downmix);
+  streaming::Algorithm* resample = factory.create("Resample");
 
   Real inputSampleRate = lastTokenProduced<Real>(loader->output("sampleRate"));
   resampleR->configure("inputSampleRate", inputSampleRate,
                        "outputSampleRate", analysisSampleRate);
   resampleL->configure("inputSampleRate", inputSampleRate,
                        "outputSampleRate", analysisSampleRate);
+  // same configuration as in MonoLoader
+  resample->configure("inputSampleRate", (int)inputSampleRate,
+                      "outputSampleRate", analysisSampleRate);
   trimmer->configure("sampleRate", analysisSampleRate,
                      "startTime", startTime,
                      "endTime", endTime);
@@ -479,6 +556,15 @@ void MusicExtractor::computeAudioMetadata(const string& audioFilename, Pool& res
   loudness->output("shortTermLoudness") >> PC(results, "lowlevel.loudness_ebu128.short_term");
   loudness->output("loudnessRange") >> PC(results, "lowlevel.loudness_ebu128.loudness_range");
 
+  // the signal is also downmixed and resampled the same way as MonoLoader does,
+  // and put in the AudioCache, where the networks computing the audio features
+  // read it from
+  vector<AudioSample> monoSignal;
+  loader->output("audio")             >> mixer->input("audio");
+  loader->output("numberChannels")    >> mixer->input("numberChannels");
+  mixer->output("audio")              >> resample->input("signal");
+  resample->output("signal")          >> monoSignal;
+
   scheduler::Network network(loader);
   network.run();
   
@@ -486,6 +572,8 @@ void MusicExtractor::computeAudioMetadata(const string& audioFilename, Pool& res
   Real length = loader->output("audio").totalProduced() / inputSampleRate;
   Real analysis_length = trimmer->output("signal").totalProduced() / analysisSampleRate;
 
+  audio.insert(audioFilename, analysisSampleRate, downmix, 0, monoSignal);
+
   if (!analysis_length) {
     ostringstream msg;
     msg << "MusicExtractor: empty input signal (analysis startTime: " << startTime
@@ -510,7 +598,7 @@ void MusicExtractor::computeAudioMetadata(const string& audioFilename, Pool& res
 }
 
 
-void MusicExtractor::computeReplayGain(const string& audioFilename, Pool& results) {
+void MusicExtractor::computeReplayGain(const string& audioFilename, Pool& results, AudioCacheReference& audio) {
 
   streaming::AlgorithmFactory& factory = streaming::AlgorithmFactory::instance();
 
@@ -518,19 +606,29 @@ void MusicExtractor::computeReplayGain(const string& audioFilename, Pool& result
 //  int length = 0;
 
   while (true) {
-    streaming::Algorithm* audio = factory.create("EqloudLoader",
-                                      "filename",   audioFilename,
-                                      "sampleRate", analysisSampleRate,
-                                      "startTime",  startTime,
-                                      "endTime",    endTime,
-                                      "downmix",    downmix);
+    // keep the signal with the current downmix in the cache, the one with the
+    // previous downmix (if any) is not needed anymore
+    audio.acquire(audioFilename, analysisSampleRate, downmix);
+
+    // same signal as an EqloudLoader, read from the AudioCache
+    streaming::Algorithm* loader = factory.create("CachedMonoLoader",
+                                                  "filename",   audioFilename,
+                                                  "sampleRate", analysisSampleRate,
+                                                  "downmix",    downmix);
+    streaming::Algorithm* trimmer = factory.create("Trimmer",
+                                                   "sampleRate", analysisSampleRate,
+                                                   "startTime",  startTime,
+                                                   "endTime",    endTime);
+    streaming::Algorithm* eqloud = factory.create("EqualLoudness", "sampleRate", analysisSampleRate);
     streaming::Algorithm* rgain = factory.create("ReplayGain", "applyEqloud", false);
 
-    audio->output("audio")      >> rgain->input("signal");
+    loader->output("audio")     >> trimmer->input("signal");
+    trimmer->output("signal")   >> eqloud->input("signal");
+    eqloud->output("signal")    >> rgain->input("signal");
     rgain->output("replayGain") >> PC(results, "metadata.audio_properties.replay_gain");
 
     try {
-      scheduler::Network network(audio);
+      scheduler::Network network(loader);
       network.run();
 //      length = audio->output("audio").totalProduced();
       replayGain = results.value<Real>("metadata.audio_properties.replay_gain");
@@ -27,6 +27,7 @@
 #include "../../essentia/utils/extractor_music/MusicRhythmDescriptors.h"
 #include "../../essentia/utils/extractor_music/MusicTonalDescriptors.h"
 #include "../../essentia/utils/extractor_music/extractor_version.h"
+#include "../io/audiocache.h"
 
 namespace essentia {
 namespace standard {
@@ -47,6 +48,7 @@ class MusicExtractor : public Algorithm {
   int lowlevelZeroPadding;
   std::string lowlevelSilentFrames;
   std::string lowlevelWindowType;
+  bool lowlevelOutputFrames;
 
   int tonalFrameSize;
   int tonalHopSize;
@@ -77,12 +79,35 @@ class MusicExtractor : public Algorithm {
   std::string downmix;
   standard::Algorithm* _svms;
 
+  // the networks computing the audio features only depend on the file through
+  // their loader and a few descriptors computed beforehand, so they are built
+  // once and reconfigured for each file (see compute())
+  Pool _results;
+  // statistics of the descriptors aggregated as their frames are computed
+  Pool _aggregatedStats;
+  streaming::Algorithm* _loader;
+  streaming::Algorithm* _loader2;
+  streaming::Algorithm* _scale;
+  streaming::Algorithm* _scale2;
+  scheduler::Network* _network;
+  scheduler::Network* _network2;
+  MusicLowlevelDescriptors* _lowlevel;
+  MusicRhythmDescriptors* _rhythm;
+  MusicTonalDescriptors* _tonal;
+  standard::Algorithm* _aggregator;
+
+  void clearNetworks();
+  void runNetwork(scheduler::Network* network);
+  streaming::Algorithm* createLoader(streaming::Algorithm*& scale);
+  void configureLoader(streaming::Algorithm* loader, streaming::Algorithm* scale,
+                       const std::string& audioFilename);
+
   void setExtractorOptions(const std::string& filename);
   void setExtractorDefaultOptions();
   void mergeValues(Pool &pool);
   void readMetadata(const std::string& audioFilename, Pool& results);
-  void computeAudioMetadata(const std::string& audioFilename, Pool& results);
-  void computeReplayGain(const std::string& audioFilename, Pool& results);
+  void computeAudioMetadata(const std::string& audioFilename, Pool& results, AudioCacheReference& audio);
+  void computeReplayGain(const std::string& audioFilename, Pool& results, AudioCacheReference& audio);
 
   Pool computeAggregation(Pool& pool);
 
@@ -106,6 +131,7 @@ class MusicExtractor : public Algorithm {
     declareParameter("lowlevelZeroPadding", "zero padding factor for computing low-level features", "[0,inf)", 0);
     declareParameter("lowlevelSilentFrames", "whether to [keep/drop/add noise to] silent frames for computing low-level features", "{drop,keep,noise}", "noise");
     declareParameter("lowlevelWindowType", "the window type for computing low-level features", "{hamming,hann,triangular,square,blackmanharris62,blackmanharris70,blackmanharris74,blackmanharris92}", "blackmanharris62");
+    declareParameter("lowlevelOutputFrames", "whether to store the frame values of the low-level spectral features in the frames pool. If false, only their statistics are computed, as the frames arrive, so that the memory used does not grow with the length of the audio", "{true,false}", true);
 
     declareParameter("tonalFrameSize", "the frame size for computing tonal features", "(0,inf)", 4096);
     declareParameter("tonalHopSize", "the hop size for computing tonal features", "(0,inf)", 2048);
@@ -0,0 +1,167 @@
+/*
+ * Copyright (C) 2006-2016  Music Technology Group - Universitat Pompeu Fabra
+ *
+ * This file is part of Essentia
+ *
+ * Essentia is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ */
+
+#include <sstream>
+#include "audiocache.h"
+#include "algorithmfactory.h"
+
+using namespace std;
+
+namespace essentia {
+
+AudioCache& AudioCache::instance() {
+  static AudioCache cache;
+  return cache;
+}
+
+
+string AudioCache::key(const string& filename, Real sampleRate,
+                       const string& downmix, int audioStream) {
+  ostringstream key;
+  key << filename << '|' << sampleRate << '|' << downmix << '|' << audioStream;
+  return key.str();
+}
+
+
+const vector<AudioSample>& AudioCache::acquire(const string& filename, Real sampleRate,
+                                               const string& downmix, int audioStream) {
+  {
+    ForcedMutexLocker lock(_mutex);
+    map<string, Entry>::iterator it = _entries.find(key(filename, sampleRate, downmix, audioStream));
+    if (it != _entries.end()) {
+      it->second.references++;
+      return it->second.audio;
+    }
+  }
+
+  // decode the file without holding the lock, so that other files can be
+  // read from the cache in the meantime
+  E_DEBUG(EAlgorithm, "AudioCache: decoding " << filename << " at " << sampleRate << "Hz");
+  vector<AudioSample> audio;
+  standard::Algorithm* loader = standard::AlgorithmFactory::create("MonoLoader",
+                                                                   "filename", filename,
+                                                                   "sampleRate", sampleRate,
+                                                                   "downmix", downmix,
+                                                                   "audioStream", audioStream);
+  loader->output("audio").set(audio);
+  try {
+    loader->compute();
+  }
+  catch (...) {
+    delete loader;
+    throw;
+  }
+  delete loader;
+
+  return insert(filename, sampleRate, downmix, audioStream, audio);
+}
+
+
+const vector<AudioSample>& AudioCache::insert(const string& filename, Real sampleRate,
+                                              const string& downmix, int audioStream,
+                                              vector<AudioSample>& audio) {
+  ForcedMutexLocker lock(_mutex);
+
+  map<string, Entry>::iterator it = _entries.find(key(filename, sampleRate, downmix, audioStream));
+  if (it == _entries.end()) {
+    it = _entries.insert(make_pair(key(filename, sampleRate, downmix, audioStream), Entry())).first;
+    it->second.audio.swap(audio);
+    it->second.references = 0;
+  }
+
+  it->second.references++;
+  return it->second.audio;
+}
+
+
+void AudioCache::release(const string& filename, Real sampleRate,
+                         const string& downmix, int audioStream) {
+  ForcedMutexLocker lock(_mutex);
+
+  map<string, Entry>::iterator it = _entries.find(key(filename, sampleRate, downmix, audioStream));
+  if (it == _entries.end()) {
+    E_WARNING("AudioCache: releasing " << filename << " which is not in the cache");
+    return;
+  }
+
+  if (--it->second.references == 0) _entries.erase(it);
+}
+
+
+bool AudioCache::contains(const string& filename, Real sampleRate,
+                          const string& downmix, int audioStream) const {
+  ForcedMutexLocker lock(_mutex);
+  return _entries.find(key(filename, sampleRate, downmix, audioStream)) != _entries.end();
+}
+
+
+int AudioCache::size() const {
+  ForcedMutexLocker lock(_mutex);
+  return (int)_entries.size();
+}
+
+
+long long AudioCache::memory() const {
+  ForcedMutexLocker lock(_mutex);
+  long long total = 0;
+  for (map<string, Entry>::const_iterator it = _entries.begin(); it != _entries.end(); ++it) {
+    total += (long long)it->second.audio.capacity() * sizeof(AudioSample);
+  }
+  return total;
+}
+
+
+const vector<AudioSample>& AudioCacheReference::acquire(const string& filename, Real sampleRate,
+                                                        const string& downmix, int audioStream) {
+  // acquire the new signal first, so that it is not decoded again if it is
+  // the one we already hold
+  const vector<AudioSample>& audio = AudioCache::instance().acquire(filename, sampleRate, downmix, audioStream);
+  release();
+
+  _audio = &audio;
+  _filename = filename;
+  _sampleRate = sampleRate;
+  _downmix = downmix;
+  _audioStream = audioStream;
+
+  return audio;
+}
+
+const vector<AudioSample>& AudioCacheReference::insert(const string& filename, Real sampleRate,
+                                                       const string& downmix, int audioStream,
+                                                       vector<AudioSample>& audio) {
+  const vector<AudioSample>& cached = AudioCache::instance().insert(filename, sampleRate, downmix, audioStream, audio);
+  release();
+
+  _audio = &cached;
+  _filename = filename;
+  _sampleRate = sampleRate;
+  _downmix = downmix;
+  _audioStream = audioStream;
+
+  return cached;
+}
+
+void AudioCacheReference::release() {
+  if (!_audio) return;
+  _audio = 0;
+  AudioCache::instance().release(_filename, _sampleRate, _downmix, _audioStream);
+}
+
+} // namespace essentia
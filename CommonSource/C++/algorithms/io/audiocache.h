@@ -0,0 +1,140 @@
+/*
+ * Copyright (C) 2006-2016  Music Technology Group - Universitat Pompeu Fabra
+ *
+ * This file is part of Essentia
+ *
+ * Essentia is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ */
+
+#ifndef ESSENTIA_AUDIOCACHE_H
+#define ESSENTIA_AUDIOCACHE_H
+
+#include <map>
+#include <string>
+#include <vector>
+#include "types.h"
+#include "threading.h"
+
+namespace essentia {
+
+/**
+ * A cache of decoded mono audio signals, so that a file which is read by
+ * several networks (see the CachedMonoLoader algorithm) is only decoded once.
+ *
+ * A signal is identified by the name of its file, the sample rate it has been
+ * resampled to, its downmix type and its audio stream, ie: the parameters of
+ * the MonoLoader which would decode it. Signals are reference-counted: a
+ * signal stays in the cache as long as someone holds a reference on it, which
+ * is acquired with acquire() or insert(), and is freed as soon as its last
+ * reference is released.
+ *
+ * All the methods are thread-safe.
+ */
+class AudioCache {
+ public:
+  static AudioCache& instance();
+
+  /**
+   * Returns the signal of the given file and acquires a reference on it. If
+   * the signal is not in the cache yet, it is decoded with a MonoLoader.
+   */
+  const std::vector<AudioSample>& acquire(const std::string& filename, Real sampleRate,
+                                          const std::string& downmix, int audioStream=0);
+
+  /**
+   * Puts a signal which has already been decoded in the cache, and acquires a
+   * reference on it. The content of @c audio is moved into the cache, unless
+   * the signal is already cached in which case the cached one is returned.
+   */
+  const std::vector<AudioSample>& insert(const std::string& filename, Real sampleRate,
+                                         const std::string& downmix, int audioStream,
+                                         std::vector<AudioSample>& audio);
+
+  /**
+   * Releases a reference acquired with acquire() or insert().
+   */
+  void release(const std::string& filename, Real sampleRate,
+               const std::string& downmix, int audioStream=0);
+
+  bool contains(const std::string& filename, Real sampleRate,
+                const std::string& downmix, int audioStream=0) const;
+
+  /**
+   * Returns the number of signals in the cache.
+   */
+  int size() const;
+
+  /**
+   * Returns the memory taken by the signals in the cache, in bytes.
+   */
+  long long memory() const;
+
+ protected:
+  struct Entry {
+    std::vector<AudioSample> audio;
+    int references;
+  };
+
+  std::map<std::string, Entry> _entries;
+  mutable ForcedMutex _mutex; // guards _entries
+
+  static std::string key(const std::string& filename, Real sampleRate,
+                         const std::string& downmix, int audioStream);
+};
+
+
+/**
+ * Holds a reference on a signal of the AudioCache, which is released when
+ * another signal is acquired or when the AudioCacheReference is destroyed.
+ */
+class AudioCacheReference {
+ public:
+  AudioCacheReference() : _audio(0), _sampleRate(0), _audioStream(0) {}
+  ~AudioCacheReference() { release(); }
+
+  /**
+   * See AudioCache::acquire().
+   */
+  const std::vector<AudioSample>& acquire(const std::string& filename, Real sampleRate,
+                                          const std::string& downmix, int audioStream=0);
+
+  /**
+   * See AudioCache::insert().
+   */
+  const std::vector<AudioSample>& insert(const std::string& filename, Real sampleRate,
+                                         const std::string& downmix, int audioStream,
+                                         std::vector<AudioSample>& audio);
+
+  void release();
+
+  /**
+   * Returns the signal we hold a reference on, 0 if none.
+   */
+  const std::vector<AudioSample>* audio() const { return _audio; }
+
+ protected:
+  const std::vector<AudioSample>* _audio;
+  std::string _filename;
+  Real _sampleRate;
+  std::string _downmix;
+  int _audioStream;
+
+ private:
+  AudioCacheReference(const AudioCacheReference&);
+  AudioCacheReference& operator=(const AudioCacheReference&);
+};
+
+} // namespace essentia
+
+#endif // ESSENTIA_AUDIOCACHE_H
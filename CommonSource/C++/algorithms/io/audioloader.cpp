@@ -31,6 +31,10 @@ const char* AudioLoader::category = "Input/output";
 const char* AudioLoader::description = DOC("This algorithm loads the single audio stream contained in a given audio or video file. Supported formats are all those supported by the ffmpeg library including wav, aiff, flac, ogg and mp3.\n"
 "\n"
 "This algorithm will throw an exception if it was not properly configured which is normally due to not specifying a valid filename. Invalid names comprise those with extensions different than the supported  formats and non existent files. If using this algorithm on Windows, you must ensure that the filename is encoded as UTF-8\n\n"
+"Uncompressed PCM WAV and AIFF files are read directly, by memory-mapping them, without going through ffmpeg, unless the readPCMDirectly parameter is false. The output is the same in both cases.\n"
+"\n"
+"When using more than one thread, long seekable files are split into segments of at least one minute which are decoded in parallel, each one on its own thread, and output in order. Each segment is decoded from the keyframe preceding it, so the output is the same as when decoding the file sequentially for lossless formats, and differs only slightly around the segment boundaries for lossy ones. The MD5 checksum is still computed over all the packets of the file.\n"
+"\n"
 "Note: ogg files are decoded in reverse phase, due to be using ffmpeg library.\n"
 "\n"
 "References:\n"
@@ -56,6 +60,9 @@ void AudioLoader::configure() {
     //av_log_set_level(AV_LOG_VERBOSE);
     _computeMD5 = parameter("computeMD5").toBool();
     _selectedStream = parameter("audioStream").toInt();
+    _readPCMDirectly = parameter("readPCMDirectly").toBool();
+    _threads = parameter("threads").toInt();
+    if (_threads == 0) _threads = max(1, (int)std::thread::hardware_concurrency());
     reset();
 }
 
@@ -63,6 +70,14 @@ void AudioLoader::configure() {
 void AudioLoader::openAudioFile(const string& filename) {
     E_DEBUG(EAlgorithm, "AudioLoader: opening file: " << filename);
 
+    // PCM files only contain one audio stream, if another one is requested
+    // let ffmpeg report the error
+    if (_readPCMDirectly && _selectedStream == 0 && _pcm.open(filename)) {
+        E_DEBUG(EAlgorithm, "AudioLoader: reading PCM file directly, codec: " << _pcm.codec());
+        av_md5_init(_md5Encoded);
+        return;
+    }
+
     // Open file
     int errnum;
     if ((errnum = avformat_open_input(&_demuxCtx, filename.c_str(), NULL, NULL)) != 0) {
@@ -155,6 +170,9 @@ void AudioLoader::openAudioFile(const string& filename) {
 
 
 void AudioLoader::closeAudioFile() {
+    stopSegments();
+    _pcm.close();
+
     if (!_demuxCtx) {
         return;
     }
@@ -208,11 +226,34 @@ string uint8_t_to_hex(uint8_t* input, int size) {
 }
 
 
+void AudioLoader::pushMD5() {
+    if (_computeMD5) {
+        av_md5_final(_md5Encoded, _checksum);
+        _md5.push(uint8_t_to_hex(_checksum, 16));
+    }
+    else {
+        string md5 = "";
+        _md5.push(md5);
+    }
+}
+
+
 AlgorithmStatus AudioLoader::process() {
     if (!parameter("filename").isConfigured()) {
         throw EssentiaException("AudioLoader: Trying to call process() on an AudioLoader algo which hasn't been correctly configured.");
     }
 
+    if (_pcm.isOpen()) return processPCM();
+
+    // the segments are started here rather than in reset(), so that the
+    // decoding threads are not started when the loader is only configured to
+    // read the information about the file (eg: its sample rate)
+    if (_threads > 1 && !_segmentsStarted) {
+        _segmentsStarted = true;
+        startSegments(parameter("filename").toString());
+    }
+    if (!_segments.empty()) return processSegments();
+
     // read frames until we get a good one
     do {
         int result = av_read_frame(_demuxCtx, &_packet);
@@ -231,14 +272,7 @@ AlgorithmStatus AudioLoader::process() {
             shouldStop(true);
             flushPacket();
             closeAudioFile();
-            if (_computeMD5) {
-                av_md5_final(_md5Encoded, _checksum);
-                _md5.push(uint8_t_to_hex(_checksum, 16));
-            }
-            else {
-                string md5 = "";
-                _md5.push(md5);
-            }
+            pushMD5();
             return FINISHED;
         }
     } while (_packet.stream_index != _streamIdx);
@@ -476,6 +510,150 @@ void AudioLoader::copyFFmpegOutput() {
     _audio.release(nsamples);
 }
 
+/**
+ * Converts the next chunk of a PCM file directly into the output buffer. The
+ * MD5 checksum is computed over the raw sample data, which is what ffmpeg
+ * would hash as the packets of the file.
+ */
+AlgorithmStatus AudioLoader::processPCM() {
+    int64_t remaining = _pcm.frames() - _pcm.position();
+    int nframes = (int)min((int64_t)CHUNK_SIZE, remaining);
+
+    if (nframes <= 0) {
+        shouldStop(true);
+        closeAudioFile();
+        pushMD5();
+        return FINISHED;
+    }
+
+    if (!_audio.acquire(nframes)) {
+        throw EssentiaException("AudioLoader: could not acquire output for audio");
+    }
+
+    if (_computeMD5) {
+        av_md5_update(_md5Encoded, _pcm.data(), nframes * _pcm.frameSize());
+    }
+
+    _pcm.read((StereoSample*)_audio.getFirstToken(), nframes);
+
+    _audio.release(nframes);
+
+    return OK;
+}
+
+
+/**
+ * Splits the file into as many segments as there are threads, provided that
+ * it can be seeked and that the segments are long enough, and starts decoding
+ * all of them.
+ */
+void AudioLoader::startSegments(const string& filename) {
+    if (!_demuxCtx->pb || !_demuxCtx->pb->seekable) return;
+
+    AVStream* stream = _demuxCtx->streams[_streamIdx];
+    AVRational samplesTimeBase = { 1, _audioCtx->sample_rate };
+    int64_t totalSamples;
+
+    if (stream->duration != AV_NOPTS_VALUE) {
+        totalSamples = av_rescale_q(stream->duration, stream->time_base, samplesTimeBase);
+    }
+    else if (_demuxCtx->duration != AV_NOPTS_VALUE) {
+        totalSamples = av_rescale_q(_demuxCtx->duration, AV_TIME_BASE_Q, samplesTimeBase);
+    }
+    else return;
+
+    int64_t minSegmentSamples = (int64_t)MIN_SEGMENT_DURATION * _audioCtx->sample_rate;
+    int nSegments = (int)min((int64_t)_threads, totalSamples / minSegmentSamples);
+    if (nSegments < 2) return;
+
+    E_DEBUG(EAlgorithm, "AudioLoader: decoding " << filename << " in " << nSegments << " parallel segments");
+
+    // the duration is only an estimate, so the last segment goes on until the
+    // end of the stream
+    for (int i=0; i<nSegments; i++) {
+        int64_t start = totalSamples * i / nSegments;
+        int64_t end = (i == nSegments-1) ? -1 : totalSamples * (i+1) / nSegments;
+        _segments.push_back(new AudioSegmentDecoder(filename, _streamIdx, start, end));
+    }
+    for (int i=0; i<nSegments; i++) {
+        _segments[i]->start();
+    }
+
+    _currentSegment = 0;
+    _segmentPosition = 0;
+}
+
+
+void AudioLoader::stopSegments() {
+    for (int i=0; i<(int)_segments.size(); i++) {
+        delete _segments[i];
+    }
+    _segments.clear();
+    _currentSegment = 0;
+    _segmentPosition = 0;
+}
+
+
+/**
+ * Outputs the next chunk of the current segment, waiting for it to be decoded
+ * if needed. The segments are freed as soon as they have been output.
+ */
+AlgorithmStatus AudioLoader::processSegments() {
+    while (_currentSegment < (int)_segments.size()) {
+        vector<float>& samples = _segments[_currentSegment]->wait();
+        int nsamples = (int)samples.size() / _nChannels;
+
+        if (_segmentPosition < nsamples) {
+            int nframes = min(CHUNK_SIZE, nsamples - _segmentPosition);
+
+            if (!_audio.acquire(nframes)) {
+                throw EssentiaException("AudioLoader: could not acquire output for audio");
+            }
+
+            StereoSample* audio = (StereoSample*)_audio.getFirstToken();
+            const float* input = &samples[_segmentPosition * _nChannels];
+
+            if (_nChannels == 1) {
+                for (int i=0; i<nframes; i++) {
+                    audio[i].left() = input[i];
+                }
+            }
+            else { // _nChannels == 2
+                for (int i=0; i<nframes; i++) {
+                    audio[i].left() = input[2*i];
+                    audio[i].right() = input[2*i+1];
+                }
+            }
+
+            _audio.release(nframes);
+            _segmentPosition += nframes;
+            return OK;
+        }
+
+        delete _segments[_currentSegment];
+        _segments[_currentSegment] = 0;
+        _currentSegment++;
+        _segmentPosition = 0;
+    }
+
+    // the packets have not been read by the main demuxer yet, which only needs
+    // to go through them for the MD5
+    if (_computeMD5) {
+        while (av_read_frame(_demuxCtx, &_packet) == 0) {
+            if (_packet.stream_index == _streamIdx) {
+                av_md5_update(_md5Encoded, _packet.data, _packet.size);
+            }
+            av_free_packet(&_packet);
+        }
+    }
+
+    shouldStop(true);
+    closeAudioFile();
+    pushMD5();
+    return FINISHED;
+}
+
+
 void AudioLoader::reset() {
     Algorithm::reset();
 
@@ -486,8 +664,16 @@ void AudioLoader::reset() {
     closeAudioFile();
     openAudioFile(filename);
 
+    if (_pcm.isOpen()) {
+        pushChannelsSampleRateInfo(_pcm.channels(), _pcm.sampleRate());
+        pushCodecInfo(_pcm.codec(), _pcm.bitRate());
+        return;
+    }
+
     pushChannelsSampleRateInfo(_audioCtx->channels, _audioCtx->sample_rate);
     pushCodecInfo(_audioCodec->name, _audioCtx->bit_rate);
+
+    _segmentsStarted = false;
 }
 
 } // namespace streaming
@@ -518,7 +704,9 @@ void AudioLoader::createInnerNetwork() {
 void AudioLoader::configure() {
     _loader->configure(INHERIT("filename"),
                        INHERIT("computeMD5"),
-                       INHERIT("audioStream"));
+                       INHERIT("audioStream"),
+                       INHERIT("threads"),
+                       INHERIT("readPCMDirectly"));
 }
 
 void AudioLoader::compute() {
@@ -25,6 +25,8 @@
 #include "network.h"
 #include "ffmpegapi.h"
 #include "poolstorage.h"
+#include "pcmreader.h"
+#include "audiosegmentdecoder.h"
 
 
 #define MAX_AUDIO_FRAME_SIZE 192000
@@ -68,23 +70,45 @@ class AudioLoader : public Algorithm {
   int _selectedStream;
   bool _configured;
 
+  // uncompressed WAV and AIFF files are read with this instead of ffmpeg
+  PCMReader _pcm;
+  bool _readPCMDirectly;
+
+  // long files are decoded in parallel segments when using several threads
+  int _threads;
+  bool _segmentsStarted; // they are only started by the first call to process()
+  std::vector<AudioSegmentDecoder*> _segments;
+  int _currentSegment;
+  int _segmentPosition; // in frames, in the current segment
+  const static int MIN_SEGMENT_DURATION = 60; // in seconds
+
+  // number of frames output at each call to process(), when the audio is not
+  // decoded packet by packet
+  const static int CHUNK_SIZE = 65536;
+
 
   void openAudioFile(const std::string& filename);
   void closeAudioFile();
 
   void pushChannelsSampleRateInfo(int nChannels, Real sampleRate);
   void pushCodecInfo(std::string codec, int bit_rate);
+  void pushMD5();
   int decode_audio_frame(AVCodecContext* audioCtx, float* output,
                          int* outputSize, AVPacket* packet);
   int decodePacket();
   void flushPacket();
   void copyFFmpegOutput();
+  AlgorithmStatus processPCM();
+  void startSegments(const std::string& filename);
+  void stopSegments();
+  AlgorithmStatus processSegments();
 
 
  public:
   AudioLoader() : Algorithm(), _buffer(0),  _demuxCtx(0),
 	          _audioCtx(0), _audioCodec(0), _decodedFrame(0),
-            _convertCtxAv(0), _configured(false) {
+            _convertCtxAv(0), _configured(false), _readPCMDirectly(true), _threads(1), _segmentsStarted(false), _currentSegment(0),
+            _segmentPosition(0) {
 
     declareOutput(_audio, 1, "audio", "the input audio signal");
     declareOutput(_sampleRate, 0, "sampleRate", "the sampling rate of the audio signal [Hz]");
@@ -116,6 +140,8 @@ class AudioLoader : public Algorithm {
     declareParameter("filename", "the name of the file from which to read", "", Parameter::STRING);
     declareParameter("computeMD5", "compute the MD5 checksum", "{true,false}", false);
     declareParameter("audioStream", "audio stream index to be loaded. Other streams are not taken into account (e.g. if stream 0 is video and 1 is audio use index 0 to access it.)", "[0,inf)", 0);
+    declareParameter("threads", "the number of threads used to decode long seekable files in parallel segments (0 to use one thread per core, 1 to decode sequentially)", "[0,inf)", 1);
+    declareParameter("readPCMDirectly", "read uncompressed WAV and AIFF files directly instead of decoding them with ffmpeg", "{true,false}", true);
   }
 
   void configure();
@@ -177,6 +203,8 @@ class AudioLoader : public Algorithm {
     declareParameter("filename", "the name of the file from which to read", "", Parameter::STRING);
     declareParameter("computeMD5", "compute the MD5 checksum", "{true,false}", false);
     declareParameter("audioStream", "audio stream index to be loaded. Other streams are no taken into account (e.g. if stream 0 is video and 1 is audio use index 0 to access it.)", "[0,inf)", 0);
+    declareParameter("threads", "the number of threads used to decode long seekable files in parallel segments (0 to use one thread per core, 1 to decode sequentially)", "[0,inf)", 1);
+    declareParameter("readPCMDirectly", "read uncompressed WAV and AIFF files directly instead of decoding them with ffmpeg", "{true,false}", true);
   }
 
   void configure();
@@ -0,0 +1,310 @@
+/*
+ * Copyright (C) 2006-2016  Music Technology Group - Universitat Pompeu Fabra
+ *
+ * This file is part of Essentia
+ *
+ * Essentia is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ */
+
+#include <algorithm>
+#include <cstring>
+#include "audiosegmentdecoder.h"
+#include "types.h"
+#include "debugging.h"
+
+using namespace std;
+
+namespace essentia {
+
+// opening and closing codecs is not thread-safe in ffmpeg
+static std::mutex ffmpegMutex;
+
+
+AudioSegmentDecoder::AudioSegmentDecoder(const string& filename, int streamIdx,
+                                         int64_t start, int64_t end) :
+  _filename(filename), _streamIdx(streamIdx), _start(start), _end(end),
+  _finished(false), _abort(false),
+  _demuxCtx(0), _audioCtx(0), _convertCtx(0), _frame(0) {}
+
+
+AudioSegmentDecoder::~AudioSegmentDecoder() {
+  _abort = true;
+  if (_thread.joinable()) _thread.join();
+  close();
+}
+
+
+void AudioSegmentDecoder::start() {
+  _thread = std::thread(&AudioSegmentDecoder::run, this);
+}
+
+
+vector<float>& AudioSegmentDecoder::wait() {
+  std::unique_lock<std::mutex> lock(_mutex);
+  while (!_finished) _finishedCondition.wait(lock);
+
+  if (_error) std::rethrow_exception(_error);
+  return _samples;
+}
+
+
+void AudioSegmentDecoder::run() {
+  try {
+    open();
+
+    // start with half a second of pre-roll, and go further back each time
+    // the seek lands after the start of the segment
+    int64_t preroll = _audioCtx->sample_rate / 2;
+    bool done = false;
+    for (int attempt=0; attempt<3 && !done; attempt++, preroll *= 8) {
+      done = decode(preroll, attempt == 0);
+    }
+
+    if (!done) {
+      E_WARNING("AudioSegmentDecoder: could not seek before sample " << _start
+                << " in " << _filename << ", decoding it from the beginning");
+      done = decode(_start, false);
+    }
+
+    if (!done) {
+      throw EssentiaException("AudioSegmentDecoder: could not find the timestamps of the frames in ", _filename);
+    }
+
+    E_DEBUG(EAlgorithm, "AudioSegmentDecoder: decoded samples " << _start << " to "
+            << _start + (int64_t)_samples.size() / _audioCtx->channels << " of " << _filename);
+  }
+  catch (...) {
+    _error = std::current_exception();
+  }
+
+  close();
+
+  std::lock_guard<std::mutex> lock(_mutex);
+  _finished = true;
+  _finishedCondition.notify_all();
+}
+
+
+void AudioSegmentDecoder::open() {
+  std::lock_guard<std::mutex> lock(ffmpegMutex);
+
+  if (avformat_open_input(&_demuxCtx, _filename.c_str(), NULL, NULL) != 0) {
+    throw EssentiaException("AudioSegmentDecoder: could not open file \"", _filename, "\"");
+  }
+
+  if (avformat_find_stream_info(_demuxCtx, NULL) < 0) {
+    throw EssentiaException("AudioSegmentDecoder: could not find stream information in \"", _filename, "\"");
+  }
+
+  if (_streamIdx >= (int)_demuxCtx->nb_streams) {
+    throw EssentiaException("AudioSegmentDecoder: could not find stream ", _streamIdx, " in ", _filename);
+  }
+
+  AVCodecContext* audioCtx = _demuxCtx->streams[_streamIdx]->codec;
+  AVCodec* audioCodec = avcodec_find_decoder(audioCtx->codec_id);
+
+  if (!audioCodec || avcodec_open2(audioCtx, audioCodec, NULL) < 0) {
+    throw EssentiaException("AudioSegmentDecoder: unable to instantiate codec for \"", _filename, "\"");
+  }
+  _audioCtx = audioCtx;
+
+  // same conversion to interleaved float as in the AudioLoader
+  int64_t layout = av_get_default_channel_layout(_audioCtx->channels);
+
+  _convertCtx = avresample_alloc_context();
+  av_opt_set_int(_convertCtx, "in_channel_layout", layout, 0);
+  av_opt_set_int(_convertCtx, "out_channel_layout", layout, 0);
+  av_opt_set_int(_convertCtx, "in_sample_rate", _audioCtx->sample_rate, 0);
+  av_opt_set_int(_convertCtx, "out_sample_rate", _audioCtx->sample_rate, 0);
+  av_opt_set_int(_convertCtx, "in_sample_fmt", _audioCtx->sample_fmt, 0);
+  av_opt_set_int(_convertCtx, "out_sample_fmt", AV_SAMPLE_FMT_FLT, 0);
+
+  if (avresample_open(_convertCtx) < 0) {
+    throw EssentiaException("AudioSegmentDecoder: could not initialize avresample context");
+  }
+
+  _frame = av_frame_alloc();
+  if (!_frame) {
+    throw EssentiaException("AudioSegmentDecoder: could not allocate audio frame");
+  }
+}
+
+
+void AudioSegmentDecoder::close() {
+  std::lock_guard<std::mutex> lock(ffmpegMutex);
+
+  if (_convertCtx) {
+    avresample_close(_convertCtx);
+    avresample_free(&_convertCtx);
+  }
+  if (_frame) av_frame_free(&_frame);
+  if (_audioCtx) avcodec_close(_audioCtx);
+  if (_demuxCtx) avformat_close_input(&_demuxCtx);
+
+  _convertCtx = 0;
+  _frame = 0;
+  _audioCtx = 0;
+  _demuxCtx = 0;
+}
+
+
+/**
+ * Decodes the segment, starting @c preroll samples before it. Returns false
+ * if the first frame that has been decoded starts after the segment, in which
+ * case it should be decoded again with a longer pre-roll.
+ */
+bool AudioSegmentDecoder::decode(int64_t preroll, bool first) {
+  AVStream* stream = _demuxCtx->streams[_streamIdx];
+  AVRational samplesTimeBase = { 1, _audioCtx->sample_rate };
+  int64_t startTime = stream->start_time == AV_NOPTS_VALUE ? 0 : stream->start_time;
+  int64_t target = _start - preroll;
+
+  // index of the next decoded sample, -1 until it is known from the
+  // timestamp of a frame
+  int64_t position = -1;
+
+  if (target <= 0) {
+    // from the beginning of the stream the sample indices are known, and are
+    // exactly those of a sequential decoding
+    if (!first) {
+      if (av_seek_frame(_demuxCtx, _streamIdx, startTime, AVSEEK_FLAG_BACKWARD) < 0) {
+        throw EssentiaException("AudioSegmentDecoder: could not seek to the beginning of \"", _filename, "\"");
+      }
+      avcodec_flush_buffers(_audioCtx);
+    }
+    position = 0;
+  }
+  else {
+    int64_t timestamp = startTime + av_rescale_q(target, samplesTimeBase, stream->time_base);
+    if (av_seek_frame(_demuxCtx, _streamIdx, timestamp, AVSEEK_FLAG_BACKWARD) < 0) {
+      throw EssentiaException("AudioSegmentDecoder: could not seek in \"", _filename, "\"");
+    }
+    avcodec_flush_buffers(_audioCtx);
+  }
+
+  _samples.clear();
+
+  AVPacket packet;
+  av_init_packet(&packet);
+  packet.data = NULL;
+  packet.size = 0;
+
+  bool endOfStream = false;
+
+  while (!_abort && (_end < 0 || position < _end)) {
+    if (av_read_frame(_demuxCtx, &packet) != 0) {
+      endOfStream = true;
+      break;
+    }
+
+    if (packet.stream_index == _streamIdx) {
+      AVPacket remaining = packet;
+      while (remaining.size > 0) {
+        int gotFrame = 0;
+        int len = avcodec_decode_audio4(_audioCtx, _frame, &gotFrame, &remaining);
+        // invalid frames are skipped, as in the AudioLoader
+        if (len < 0) break;
+
+        remaining.data += len;
+        remaining.size -= len;
+
+        if (gotFrame && !appendFrame(position)) {
+          av_free_packet(&packet);
+          return false;
+        }
+      }
+    }
+
+    av_free_packet(&packet);
+  }
+
+  if (endOfStream) {
+    // get the frames still buffered in the decoder
+    AVPacket empty;
+    av_init_packet(&empty);
+    empty.data = NULL;
+    empty.size = 0;
+
+    int gotFrame;
+    do {
+      gotFrame = 0;
+      if (avcodec_decode_audio4(_audioCtx, _frame, &gotFrame, &empty) < 0) break;
+      if (gotFrame && !appendFrame(position)) return false;
+    } while (gotFrame);
+
+    // no frame could be placed in the stream
+    if (position < 0) return false;
+  }
+
+  return true;
+}
+
+
+/**
+ * Appends the part of the decoded frame which is inside of the segment to the
+ * samples, and updates @c position to the index of the sample following it.
+ * Returns false if this is the first frame and it starts after the segment.
+ */
+bool AudioSegmentDecoder::appendFrame(int64_t& position) {
+  int nChannels = _audioCtx->channels;
+  int nsamples = _frame->nb_samples;
+
+  if (position < 0) {
+    int64_t timestamp = av_frame_get_best_effort_timestamp(_frame);
+    // this frame cannot be placed, but as it comes before the first one which
+    // can, it is part of the pre-roll anyway
+    if (timestamp == AV_NOPTS_VALUE) return true;
+
+    AVStream* stream = _demuxCtx->streams[_streamIdx];
+    AVRational samplesTimeBase = { 1, _audioCtx->sample_rate };
+    int64_t startTime = stream->start_time == AV_NOPTS_VALUE ? 0 : stream->start_time;
+
+    position = av_rescale_q(timestamp - startTime, stream->time_base, samplesTimeBase);
+    if (position > _start) return false;
+  }
+
+  if (nsamples == 0) return true;
+
+  int64_t first = max(_start - position, (int64_t)0);
+  int64_t last = _end < 0 ? nsamples : min(_end - position, (int64_t)nsamples);
+
+  if (last > first) {
+    _buffer.resize(nsamples * nChannels);
+
+    if (_audioCtx->sample_fmt == AV_SAMPLE_FMT_FLT) {
+      memcpy(&_buffer[0], _frame->data[0], nsamples * nChannels * sizeof(float));
+    }
+    else {
+      float* output = &_buffer[0];
+      int inputPlaneSize = av_samples_get_buffer_size(NULL, nChannels, nsamples, _audioCtx->sample_fmt, 1);
+      int outputPlaneSize = av_samples_get_buffer_size(NULL, nChannels, nsamples, AV_SAMPLE_FMT_FLT, 1);
+
+      int written = avresample_convert(_convertCtx,
+                                       (uint8_t**) &output, outputPlaneSize, nsamples,
+                                       (uint8_t**) _frame->data, inputPlaneSize, nsamples);
+      if (written < nsamples) {
+        throw EssentiaException("AudioSegmentDecoder: incomplete format conversion (some samples missing)");
+      }
+    }
+
+    _samples.insert(_samples.end(),
+                    _buffer.begin() + first*nChannels,
+                    _buffer.begin() + last*nChannels);
+  }
+
+  position += nsamples;
+  return true;
+}
+
+} // namespace essentia
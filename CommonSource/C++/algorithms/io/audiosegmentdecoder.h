@@ -0,0 +1,104 @@
+/*
+ * Copyright (C) 2006-2016  Music Technology Group - Universitat Pompeu Fabra
+ *
+ * This file is part of Essentia
+ *
+ * Essentia is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ */
+
+#ifndef ESSENTIA_AUDIOSEGMENTDECODER_H
+#define ESSENTIA_AUDIOSEGMENTDECODER_H
+
+#include <string>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <stdint.h>
+#include "ffmpegapi.h"
+
+namespace essentia {
+
+/**
+ * Decodes a segment of an audio stream on its own thread, so that the
+ * segments of a long file can be decoded in parallel (see the "threads"
+ * parameter of the AudioLoader).
+ *
+ * The segment contains the samples [start, end) of the stream, the sample
+ * indices being those the AudioLoader would output when decoding the whole
+ * stream sequentially. The decoder seeks to the keyframe preceding its start
+ * minus some pre-roll, so that lossy decoders have time to settle, places the
+ * decoded frames using their timestamps and drops the samples outside of the
+ * segment. If the seek lands after the start of the segment, it seeks further
+ * back, and eventually decodes from the beginning of the file.
+ *
+ * Each decoder opens its own demuxer and codec contexts.
+ */
+class AudioSegmentDecoder {
+ public:
+  /**
+   * @param end the index of the sample following the segment, or -1 to
+   *        decode until the end of the stream
+   */
+  AudioSegmentDecoder(const std::string& filename, int streamIdx, int64_t start, int64_t end);
+
+  /**
+   * Aborts the decoding if it is still running.
+   */
+  ~AudioSegmentDecoder();
+
+  /**
+   * Starts decoding the segment on a new thread.
+   */
+  void start();
+
+  /**
+   * Waits until the segment is decoded, and returns its samples, interleaved.
+   * Rethrows the exception thrown while decoding, if any.
+   */
+  std::vector<float>& wait();
+
+ protected:
+  std::string _filename;
+  int _streamIdx;
+  int64_t _start;
+  int64_t _end;
+
+  std::vector<float> _samples;
+
+  std::thread _thread;
+  std::mutex _mutex;
+  std::condition_variable _finishedCondition;
+  bool _finished;
+  std::exception_ptr _error;
+  std::atomic<bool> _abort;
+
+  AVFormatContext* _demuxCtx;
+  AVCodecContext* _audioCtx;
+  struct AVAudioResampleContext* _convertCtx;
+  AVFrame* _frame;
+  std::vector<float> _buffer;
+
+  void run();
+  void open();
+  void close();
+  bool decode(int64_t preroll, bool first);
+  bool appendFrame(int64_t& position);
+};
+
+} // namespace essentia
+
+#endif // ESSENTIA_AUDIOSEGMENTDECODER_H
@@ -0,0 +1,103 @@
+/*
+ * Copyright (C) 2006-2016  Music Technology Group - Universitat Pompeu Fabra
+ *
+ * This file is part of Essentia
+ *
+ * Essentia is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ */
+
+#include "cachedmonoloader.h"
+
+using namespace std;
+
+namespace essentia {
+namespace streaming {
+
+const char* CachedMonoLoader::name = "CachedMonoLoader";
+const char* CachedMonoLoader::category = "Input/output";
+const char* CachedMonoLoader::description = DOC("This algorithm outputs the same mono audio signal as MonoLoader, but reads it from the shared cache of decoded signals. If the signal is not in the cache yet, it is decoded with a MonoLoader and kept in the cache for as long as some algorithm or extractor uses it, so that a file which is read by several networks is only decoded once.\n"
+"\n"
+"The signal is kept in the cache from the moment this algorithm is configured until it has output all of it.\n"
+"\n"
+"This algorithm uses MonoLoader and thus inherits all of its input requirements and exceptions.");
+
+
+void CachedMonoLoader::acquireSignal() {
+  _signal.acquire(parameter("filename").toString(),
+                  parameter("sampleRate").toReal(),
+                  parameter("downmix").toString(),
+                  parameter("audioStream").toInt());
+}
+
+
+void CachedMonoLoader::configure() {
+  _signal.release();
+
+  // if no file has been specified, do not do anything
+  if (!parameter("filename").isConfigured()) return;
+
+  acquireSignal();
+  reset();
+}
+
+void CachedMonoLoader::reset() {
+  Algorithm::reset();
+  _idx = 0;
+  _audio.setAcquireSize(chunkSize);
+  _audio.setReleaseSize(chunkSize);
+}
+
+
+AlgorithmStatus CachedMonoLoader::process() {
+  if (!parameter("filename").isConfigured()) {
+    throw EssentiaException("CachedMonoLoader: Trying to call process() on a CachedMonoLoader algo which hasn't been correctly configured.");
+  }
+
+  // the signal has been released at the end of the previous run
+  if (!_signal.audio()) acquireSignal();
+
+  const vector<AudioSample>& signal = *_signal.audio();
+  int size = (int)signal.size();
+  if (_idx >= size) {
+    shouldStop(true);
+    _signal.release();
+    return FINISHED;
+  }
+
+  if (_idx + _audio.acquireSize() > size) {
+    int howmuch = size - _idx;
+    _audio.setAcquireSize(howmuch);
+    _audio.setReleaseSize(howmuch);
+  }
+
+  AlgorithmStatus status = acquireData();
+  if (status != OK) return status;
+
+  AudioSample* dest = (AudioSample*)_audio.getFirstToken();
+  int howmuch = _audio.acquireSize();
+  fastcopy(dest, &signal[_idx], howmuch);
+  _idx += howmuch;
+
+  releaseData();
+
+  if (_idx >= size) {
+    shouldStop(true);
+    _signal.release();
+  }
+
+  return OK;
+}
+
+} // namespace streaming
+} // namespace essentia
@@ -0,0 +1,66 @@
+/*
+ * Copyright (C) 2006-2016  Music Technology Group - Universitat Pompeu Fabra
+ *
+ * This file is part of Essentia
+ *
+ * Essentia is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ */
+
+#ifndef ESSENTIA_STREAMING_CACHEDMONOLOADER_H
+#define ESSENTIA_STREAMING_CACHEDMONOLOADER_H
+
+#include "streamingalgorithm.h"
+#include "audiocache.h"
+
+namespace essentia {
+namespace streaming {
+
+class CachedMonoLoader : public Algorithm {
+ protected:
+  Source<AudioSample> _audio;
+
+  AudioCacheReference _signal;
+  int _idx;
+
+  // number of samples output at each call to process()
+  static const int chunkSize = 4096;
+
+  void acquireSignal();
+
+ public:
+  CachedMonoLoader() : _idx(0) {
+    declareOutput(_audio, chunkSize, "audio", "the mono audio signal");
+  }
+
+  void declareParameters() {
+    declareParameter("filename", "the name of the file from which to read", "", Parameter::STRING);
+    declareParameter("sampleRate", "the desired output sampling rate [Hz]", "(0,inf)", 44100.);
+    declareParameter("downmix", "the mixing type for stereo files", "{left,right,mix}", "mix");
+    declareParameter("audioStream", "audio stream index to be loaded. Other streams are no taken into account (e.g. if stream 0 is video and 1 is audio use index 0 to access it.)", "[0,inf)", 0);
+  }
+
+  void configure();
+  void reset();
+  AlgorithmStatus process();
+
+  static const char* name;
+  static const char* category;
+  static const char* description;
+
+};
+
+} // namespace streaming
+} // namespace essentia
+
+#endif // ESSENTIA_STREAMING_CACHEDMONOLOADER_H
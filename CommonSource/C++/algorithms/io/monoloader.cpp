@@ -62,7 +62,8 @@ void MonoLoader::configure() {
 
   _audioLoader->configure("filename", filename,
                           "computeMD5", false,
-                          INHERIT("audioStream"));
+                          INHERIT("audioStream"),
+                          INHERIT("threads"));
 
   int inputSampleRate = (int)lastTokenProduced<Real>(_audioLoader->output("sampleRate"));
 
@@ -107,7 +108,8 @@ void MonoLoader::configure() {
   _loader->configure(INHERIT("filename"),
                      INHERIT("sampleRate"),
                      INHERIT("downmix"),
-                     INHERIT("audioStream"));
+                     INHERIT("audioStream"),
+                     INHERIT("threads"));
 }
 
 void MonoLoader::compute() {
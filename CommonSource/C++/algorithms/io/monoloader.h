@@ -50,6 +50,7 @@ class MonoLoader : public AlgorithmComposite {
     declareParameter("sampleRate", "the desired output sampling rate [Hz]", "(0,inf)", 44100.);
     declareParameter("downmix", "the mixing type for stereo files", "{left,right,mix}", "mix");
     declareParameter("audioStream", "audio stream index to be loaded. Other streams are no taken into account (e.g. if stream 0 is video and 1 is audio use index 0 to access it.)", "[0,inf)", 0);
+    declareParameter("threads", "the number of threads used to decode long seekable files in parallel segments (0 to use one thread per core, 1 to decode sequentially)", "[0,inf)", 1);
 
   }
 
@@ -103,6 +104,7 @@ class MonoLoader : public Algorithm {
     declareParameter("sampleRate", "the desired output sampling rate [Hz]", "(0,inf)", 44100.);
     declareParameter("downmix", "the mixing type for stereo files", "{left,right,mix}", "mix");
     declareParameter("audioStream", "audio stream index to be loaded. Other streams are no taken into account (e.g. if stream 0 is video and 1 is audio use index 0 to access it.)", "[0,inf)", 0);
+    declareParameter("threads", "the number of threads used to decode long seekable files in parallel segments (0 to use one thread per core, 1 to decode sequentially)", "[0,inf)", 1);
 
   }
 
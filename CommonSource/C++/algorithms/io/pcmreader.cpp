@@ -0,0 +1,414 @@
+/*
+ * Copyright (C) 2006-2016  Music Technology Group - Universitat Pompeu Fabra
+ *
+ * This file is part of Essentia
+ *
+ * Essentia is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ */
+
+#include <cmath>
+#include <cstring>
+#include "pcmreader.h"
+#include "debugging.h"
+
+#ifndef OS_WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+using namespace std;
+
+namespace essentia {
+
+// Sample decoders. They read bytes one by one, so that they do not depend on
+// the endianness of the host nor on the alignment of the data, and scale the
+// samples the same way as ffmpeg does when converting them to float.
+
+struct PCM_U8 {
+  static const int size = 1;
+  static Real decode(const uint8_t* p) { return (int(p[0]) - 128) * (Real(1) / 128); }
+};
+
+struct PCM_S8 {
+  static const int size = 1;
+  static Real decode(const uint8_t* p) { return int8_t(p[0]) * (Real(1) / 128); }
+};
+
+struct PCM_S16LE {
+  static const int size = 2;
+  static Real decode(const uint8_t* p) { return int16_t(p[0] | (p[1] << 8)) * (Real(1) / 32768); }
+};
+
+struct PCM_S16BE {
+  static const int size = 2;
+  static Real decode(const uint8_t* p) { return int16_t((p[0] << 8) | p[1]) * (Real(1) / 32768); }
+};
+
+struct PCM_S24LE {
+  static const int size = 3;
+  static Real decode(const uint8_t* p) {
+    return int32_t(uint32_t(p[0] << 8) | uint32_t(p[1] << 16) | uint32_t(p[2]) << 24) * (Real(1) / 2147483648.);
+  }
+};
+
+struct PCM_S24BE {
+  static const int size = 3;
+  static Real decode(const uint8_t* p) {
+    return int32_t(uint32_t(p[2] << 8) | uint32_t(p[1] << 16) | uint32_t(p[0]) << 24) * (Real(1) / 2147483648.);
+  }
+};
+
+struct PCM_S32LE {
+  static const int size = 4;
+  static Real decode(const uint8_t* p) {
+    return int32_t(uint32_t(p[0]) | uint32_t(p[1]) << 8 | uint32_t(p[2]) << 16 | uint32_t(p[3]) << 24) * (Real(1) / 2147483648.);
+  }
+};
+
+struct PCM_S32BE {
+  static const int size = 4;
+  static Real decode(const uint8_t* p) {
+    return int32_t(uint32_t(p[3]) | uint32_t(p[2]) << 8 | uint32_t(p[1]) << 16 | uint32_t(p[0]) << 24) * (Real(1) / 2147483648.);
+  }
+};
+
+struct PCM_F32LE {
+  static const int size = 4;
+  static Real decode(const uint8_t* p) {
+    uint32_t bits = uint32_t(p[0]) | uint32_t(p[1]) << 8 | uint32_t(p[2]) << 16 | uint32_t(p[3]) << 24;
+    float value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+  }
+};
+
+struct PCM_F32BE {
+  static const int size = 4;
+  static Real decode(const uint8_t* p) {
+    uint32_t bits = uint32_t(p[3]) | uint32_t(p[2]) << 8 | uint32_t(p[1]) << 16 | uint32_t(p[0]) << 24;
+    float value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+  }
+};
+
+struct PCM_F64LE {
+  static const int size = 8;
+  static Real decode(const uint8_t* p) {
+    uint64_t bits = 0;
+    for (int i=7; i>=0; i--) bits = (bits << 8) | p[i];
+    double value;
+    memcpy(&value, &bits, sizeof(value));
+    return (Real)value;
+  }
+};
+
+struct PCM_F64BE {
+  static const int size = 8;
+  static Real decode(const uint8_t* p) {
+    uint64_t bits = 0;
+    for (int i=0; i<8; i++) bits = (bits << 8) | p[i];
+    double value;
+    memcpy(&value, &bits, sizeof(value));
+    return (Real)value;
+  }
+};
+
+template <typename Format>
+void convertPCM(const uint8_t* input, int channels, StereoSample* output, int nframes) {
+  if (channels == 1) {
+    for (int i=0; i<nframes; i++) {
+      output[i].left() = Format::decode(input + i*Format::size);
+    }
+  }
+  else {
+    // a StereoSample is a pair of Reals, so interleaved stereo samples can be
+    // written as a flat array, which lets the compiler vectorize this loop
+    Real* dest = &output[0].left();
+    for (int i=0; i<2*nframes; i++) {
+      dest[i] = Format::decode(input + i*Format::size);
+    }
+  }
+}
+
+
+static uint16_t readU16LE(const uint8_t* p) { return uint16_t(p[0] | (p[1] << 8)); }
+static uint32_t readU32LE(const uint8_t* p) { return uint32_t(p[0]) | uint32_t(p[1]) << 8 | uint32_t(p[2]) << 16 | uint32_t(p[3]) << 24; }
+static uint16_t readU16BE(const uint8_t* p) { return uint16_t((p[0] << 8) | p[1]); }
+static uint32_t readU32BE(const uint8_t* p) { return uint32_t(p[3]) | uint32_t(p[2]) << 8 | uint32_t(p[1]) << 16 | uint32_t(p[0]) << 24; }
+
+// reads an 80-bit IEEE 754 extended precision number, as used in AIFF headers
+static double readExtended(const uint8_t* p) {
+  int exponent = ((p[0] & 0x7F) << 8) | p[1];
+  uint64_t mantissa = 0;
+  for (int i=2; i<10; i++) mantissa = (mantissa << 8) | p[i];
+  if (exponent == 0 && mantissa == 0) return 0;
+  double value = ldexp((double)mantissa, exponent - 16383 - 63);
+  return (p[0] & 0x80) ? -value : value;
+}
+
+
+PCMReader::PCMReader() : _map(0), _mapSize(0), _data(0), _frames(0), _position(0),
+                         _channels(0), _sampleRate(0), _bitsPerSample(0), _frameSize(0),
+                         _convert(0) {}
+
+PCMReader::~PCMReader() {
+  close();
+}
+
+
+bool PCMReader::open(const string& filename) {
+  close();
+
+#ifdef OS_WIN32
+  return false;
+#else
+  int fd = ::open(filename.c_str(), O_RDONLY);
+  if (fd < 0) return false;
+
+  struct stat st;
+  if (fstat(fd, &st) != 0 || st.st_size < 12) {
+    ::close(fd);
+    return false;
+  }
+
+  void* map = mmap(0, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd); // the mapping stays valid after the file is closed
+  if (map == MAP_FAILED) return false;
+
+  madvise(map, st.st_size, MADV_SEQUENTIAL);
+
+  _map = (const uint8_t*)map;
+  _mapSize = st.st_size;
+
+  bool ok = false;
+  if (!memcmp(_map, "RIFF", 4) && !memcmp(_map + 8, "WAVE", 4)) {
+    ok = parseWav();
+  }
+  else if (!memcmp(_map, "FORM", 4) && (!memcmp(_map + 8, "AIFF", 4) || !memcmp(_map + 8, "AIFC", 4))) {
+    ok = parseAiff();
+  }
+
+  if (!ok) {
+    close();
+    return false;
+  }
+
+  E_DEBUG(EAlgorithm, "PCMReader: opened " << filename << ": " << _codec << ", "
+          << _channels << " channels, " << _sampleRate << "Hz, " << _frames << " frames");
+  return true;
+#endif
+}
+
+
+void PCMReader::close() {
+#ifndef OS_WIN32
+  if (_map) munmap((void*)_map, _mapSize);
+#endif
+  _map = 0;
+  _mapSize = 0;
+  _data = 0;
+  _frames = 0;
+  _position = 0;
+  _channels = 0;
+  _sampleRate = 0;
+  _bitsPerSample = 0;
+  _frameSize = 0;
+  _codec.clear();
+  _convert = 0;
+}
+
+
+int PCMReader::bitRate() const {
+  return int(_sampleRate * _channels * _bitsPerSample);
+}
+
+
+int PCMReader::read(StereoSample* output, int nframes) {
+  if (!_map) throw EssentiaException("PCMReader: trying to read from a file which is not open");
+
+  int64_t remaining = _frames - _position;
+  if (nframes > remaining) nframes = (int)remaining;
+  if (nframes <= 0) return 0;
+
+  _convert(data(), _channels, output, nframes);
+  _position += nframes;
+
+  return nframes;
+}
+
+
+bool PCMReader::setEncoding(const string& codec, int bitsPerSample) {
+  if      (codec == "pcm_u8")    _convert = convertPCM<PCM_U8>;
+  else if (codec == "pcm_s8")    _convert = convertPCM<PCM_S8>;
+  else if (codec == "pcm_s16le") _convert = convertPCM<PCM_S16LE>;
+  else if (codec == "pcm_s16be") _convert = convertPCM<PCM_S16BE>;
+  else if (codec == "pcm_s24le") _convert = convertPCM<PCM_S24LE>;
+  else if (codec == "pcm_s24be") _convert = convertPCM<PCM_S24BE>;
+  else if (codec == "pcm_s32le") _convert = convertPCM<PCM_S32LE>;
+  else if (codec == "pcm_s32be") _convert = convertPCM<PCM_S32BE>;
+  else if (codec == "pcm_f32le") _convert = convertPCM<PCM_F32LE>;
+  else if (codec == "pcm_f32be") _convert = convertPCM<PCM_F32BE>;
+  else if (codec == "pcm_f64le") _convert = convertPCM<PCM_F64LE>;
+  else if (codec == "pcm_f64be") _convert = convertPCM<PCM_F64BE>;
+  else return false;
+
+  _codec = codec;
+  _bitsPerSample = bitsPerSample;
+  _frameSize = _channels * bitsPerSample / 8;
+  return true;
+}
+
+
+bool PCMReader::setData(const uint8_t* data, int64_t size) {
+  // the size written in the header might be wrong (e.g.: when the file has
+  // been written by a program which could not seek back to update it)
+  int64_t available = (int64_t)(_map + _mapSize - data);
+  if (size < 0 || size > available) size = available;
+
+  // files with more than 2 channels are left to ffmpeg, which reports the error
+  if (_channels <= 0 || _channels > 2 || _sampleRate <= 0 || _frameSize <= 0) return false;
+
+  _data = data;
+  _frames = size / _frameSize;
+  _position = 0;
+  return true;
+}
+
+
+bool PCMReader::parseWav() {
+  const uint8_t* end = _map + _mapSize;
+  const uint8_t* chunk = _map + 12;
+  bool gotFormat = false;
+
+  while (chunk + 8 <= end) {
+    uint32_t size = readU32LE(chunk + 4);
+    const uint8_t* content = chunk + 8;
+
+    if (!memcmp(chunk, "fmt ", 4)) {
+      if (size < 16 || content + 16 > end) return false;
+
+      int formatTag = readU16LE(content);
+      _channels = readU16LE(content + 2);
+      _sampleRate = (Real)readU32LE(content + 4);
+      int blockAlign = readU16LE(content + 12);
+      int bits = readU16LE(content + 14);
+
+      // WAVE_FORMAT_EXTENSIBLE: the actual format is in the sub-format GUID
+      if (formatTag == 0xFFFE) {
+        if (size < 40 || content + 40 > end) return false;
+        formatTag = readU16LE(content + 24);
+      }
+
+      string codec;
+      if (formatTag == 1) { // WAVE_FORMAT_PCM
+        switch (bits) {
+          case 8:  codec = "pcm_u8";    break;
+          case 16: codec = "pcm_s16le"; break;
+          case 24: codec = "pcm_s24le"; break;
+          case 32: codec = "pcm_s32le"; break;
+          default: return false;
+        }
+      }
+      else if (formatTag == 3) { // WAVE_FORMAT_IEEE_FLOAT
+        switch (bits) {
+          case 32: codec = "pcm_f32le"; break;
+          case 64: codec = "pcm_f64le"; break;
+          default: return false;
+        }
+      }
+      else return false;
+
+      if (!setEncoding(codec, bits) || blockAlign != _frameSize) return false;
+      gotFormat = true;
+    }
+    else if (!memcmp(chunk, "data", 4)) {
+      if (!gotFormat) return false;
+      return setData(content, size);
+    }
+
+    // chunks are padded to an even size
+    if ((int64_t)size + (size & 1) > end - content) break;
+    chunk = content + size + (size & 1);
+  }
+
+  return false;
+}
+
+
+bool PCMReader::parseAiff() {
+  const uint8_t* end = _map + _mapSize;
+  const uint8_t* chunk = _map + 12;
+  bool aifc = !memcmp(_map + 8, "AIFC", 4);
+  bool gotFormat = false;
+  int64_t frames = 0;
+  const uint8_t* data = 0;
+  int64_t dataSize = 0;
+
+  while (chunk + 8 <= end) {
+    uint32_t size = readU32BE(chunk + 4);
+    const uint8_t* content = chunk + 8;
+
+    if (!memcmp(chunk, "COMM", 4)) {
+      if (size < 18 || content + 18 > end) return false;
+
+      _channels = readU16BE(content);
+      frames = readU32BE(content + 2);
+      int bits = readU16BE(content + 6);
+      _sampleRate = (Real)readExtended(content + 8);
+
+      string codec;
+      if (!aifc || (size >= 22 && content + 22 <= end && (!memcmp(content + 18, "NONE", 4) ||
+                                                          !memcmp(content + 18, "twos", 4)))) {
+        switch (bits) {
+          case 8:  codec = "pcm_s8";    break;
+          case 16: codec = "pcm_s16be"; break;
+          case 24: codec = "pcm_s24be"; break;
+          case 32: codec = "pcm_s32be"; break;
+          default: return false;
+        }
+      }
+      else if (size >= 22 && content + 22 <= end) {
+        const uint8_t* compression = content + 18;
+        if      (!memcmp(compression, "sowt", 4) && bits == 16) codec = "pcm_s16le";
+        else if (!memcmp(compression, "fl32", 4) || !memcmp(compression, "FL32", 4)) { codec = "pcm_f32be"; bits = 32; }
+        else if (!memcmp(compression, "fl64", 4) || !memcmp(compression, "FL64", 4)) { codec = "pcm_f64be"; bits = 64; }
+        else return false;
+      }
+      else return false;
+
+      if (!setEncoding(codec, bits)) return false;
+      gotFormat = true;
+    }
+    else if (!memcmp(chunk, "SSND", 4)) {
+      // unlike in WAV files, the sound data may come before the format
+      if (size < 8 || content + 8 > end) return false;
+      uint32_t offset = readU32BE(content);
+      if (offset > (uint32_t)(end - content - 8)) return false;
+      data = content + 8 + offset;
+      dataSize = (int64_t)size - 8 - offset;
+    }
+
+    if ((int64_t)size + (size & 1) > end - content) break;
+    chunk = content + size + (size & 1);
+  }
+
+  if (!gotFormat || !data || !setData(data, dataSize)) return false;
+  if (frames < _frames) _frames = frames;
+  return true;
+}
+
+} // namespace essentia
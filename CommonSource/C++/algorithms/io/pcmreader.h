@@ -0,0 +1,115 @@
+/*
+ * Copyright (C) 2006-2016  Music Technology Group - Universitat Pompeu Fabra
+ *
+ * This file is part of Essentia
+ *
+ * Essentia is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ */
+
+#ifndef ESSENTIA_PCMREADER_H
+#define ESSENTIA_PCMREADER_H
+
+#include <string>
+#include <stdint.h>
+#include "types.h"
+
+namespace essentia {
+
+/**
+ * Reads uncompressed PCM audio from WAV and AIFF files, without going through
+ * ffmpeg. The file is memory-mapped and its samples are converted directly
+ * into the StereoSample buffer given to read().
+ *
+ * Supported encodings are 8, 16, 24 and 32-bit integer and 32 and 64-bit
+ * float samples, in WAV (including WAVE_FORMAT_EXTENSIBLE), AIFF and
+ * uncompressed AIFF-C files. For any other file, open() returns false and the
+ * file should be decoded with ffmpeg instead.
+ */
+class PCMReader {
+ public:
+  PCMReader();
+  ~PCMReader();
+
+  /**
+   * Maps the given file and parses its header. Returns false if the file
+   * could not be opened or is not a PCM file that this reader supports.
+   */
+  bool open(const std::string& filename);
+  void close();
+
+  bool isOpen() const { return _map != 0; }
+
+  int channels() const { return _channels; }
+  Real sampleRate() const { return _sampleRate; }
+
+  /**
+   * Returns the name of the codec as ffmpeg would report it, e.g.: "pcm_s16le".
+   */
+  const std::string& codec() const { return _codec; }
+
+  /**
+   * Returns the bit rate in bits per second, as ffmpeg would report it.
+   */
+  int bitRate() const;
+
+  /**
+   * Returns the total number of frames (samples per channel) in the file.
+   */
+  int64_t frames() const { return _frames; }
+
+  /**
+   * Returns the index of the next frame to be read.
+   */
+  int64_t position() const { return _position; }
+
+  /**
+   * Returns the raw undecoded bytes of the next frame to be read, and the size
+   * of a frame in bytes.
+   */
+  const uint8_t* data() const { return _data + _position*_frameSize; }
+  int frameSize() const { return _frameSize; }
+
+  /**
+   * Converts at most @c nframes frames to StereoSample and writes them to
+   * @c output. Only the left channel is written for mono files. Returns the
+   * number of frames that have been read, 0 at the end of the file.
+   */
+  int read(StereoSample* output, int nframes);
+
+ protected:
+  typedef void (*ConvertFunction)(const uint8_t* input, int channels, StereoSample* output, int nframes);
+
+  const uint8_t* _map;
+  size_t _mapSize;
+
+  const uint8_t* _data;
+  int64_t _frames;
+  int64_t _position;
+
+  int _channels;
+  Real _sampleRate;
+  int _bitsPerSample;
+  int _frameSize;
+  std::string _codec;
+  ConvertFunction _convert;
+
+  bool parseWav();
+  bool parseAiff();
+  bool setEncoding(const std::string& codec, int bitsPerSample);
+  bool setData(const uint8_t* data, int64_t size);
+};
+
+} // namespace essentia
+
+#endif // ESSENTIA_PCMREADER_H
@@ -219,9 +219,19 @@ void OnsetDetectionGlobal::computeBeatEmphasis() {
   vector<Real>& onsetDetections = _onsetDetections.get();
   onsetDetections.clear();
 
+  // the frames are transformed by batches of _fftBatchSize frames
+  vector<Real> frames;
+  vector<complex<Real> > ffts;
+  if (_fftBatchSize > 1) {
+    _fft->input("frames").set(frames);
+    _fft->output("ffts").set(ffts);
+  }
+  else {
+    _fft->input("frame").set(frames);
+    _fft->output("fft").set(ffts);
+  }
+
   vector<complex<Real> > frameFFT;
-  _fft->input("frame").set(_frameWindowed);
-  _fft->output("fft").set(frameFFT);
 
   vector<Real> spectrum;
   vector<Real> phase;
@@ -246,39 +256,57 @@ void OnsetDetectionGlobal::computeBeatEmphasis() {
   _erbbands->output("bands").set(tempERB);
 
   size_t numberFrames=0;
+  bool lastBatch = false;
 
-  while (true) {
-    // get a frame
-    _frameCutter->compute();
+  while (!lastBatch) {
+    // get a batch of windowed frames
+    frames.clear();
+    int batchFrames = 0;
 
-    if (!_frame.size()) {
+    while (batchFrames < _fftBatchSize) {
+      _frameCutter->compute();
+
+      if (!_frame.size()) {
+        lastBatch = true;
+        break;
+      }
+
+      _windowing->compute();
+      frames.insert(frames.end(), _frameWindowed.begin(), _frameWindowed.end());
+      batchFrames++;
+    }
+
+    if (!batchFrames) {
       break;
     }
 
-    _windowing->compute();
     _fft->compute();
-    _cartesian2polar->compute();
-
-    // Compute complex spectral difference. Optimized, see details in the
-    // OnsetDetection algo
-    for (int i=0; i<_numberFFTBins; ++i) {
-      Real targetPhase = 2*_phase_1[i] + _phase_2[i];
-      targetPhase = fmod(targetPhase + M_PI, -2 * M_PI) + M_PI;
-      tempFFT[i] = norm(_spectrum_1[i] - polar(spectrum[i], phase[i]-targetPhase));
-    }
 
-    // Group detection functions for spectral bins into larger ERB sub-bands using
-    // a Gammatone filterbank to improve the likelihood of finding meaningful
-    // periodicity in spectral bands.
-    _erbbands->compute();
-    for (int b=0; b<_numberERBBands; ++b) {
-      onsetERB[b].push_back(tempERB[b]);
-    }
+    for (int f=0; f<batchFrames; ++f) {
+      frameFFT.assign(ffts.begin() + f*_numberFFTBins, ffts.begin() + (f+1)*_numberFFTBins);
+      _cartesian2polar->compute();
 
-    _phase_2 = _phase_1;
-    _phase_1 = phase;
-    _spectrum_1 = spectrum;
-    numberFrames += 1;
+      // Compute complex spectral difference. Optimized, see details in the
+      // OnsetDetection algo
+      for (int i=0; i<_numberFFTBins; ++i) {
+        Real targetPhase = 2*_phase_1[i] + _phase_2[i];
+        targetPhase = fmod(targetPhase + M_PI, -2 * M_PI) + M_PI;
+        tempFFT[i] = norm(_spectrum_1[i] - polar(spectrum[i], phase[i]-targetPhase));
+      }
+
+      // Group detection functions for spectral bins into larger ERB sub-bands using
+      // a Gammatone filterbank to improve the likelihood of finding meaningful
+      // periodicity in spectral bands.
+      _erbbands->compute();
+      for (int b=0; b<_numberERBBands; ++b) {
+        onsetERB[b].push_back(tempERB[b]);
+      }
+
+      _phase_2 = _phase_1;
+      _phase_1 = phase;
+      _spectrum_1 = spectrum;
+      numberFrames += 1;
+    }
   }
 
   // Post-processing found in M.Davies' matlab code, but not mentioned in the
@@ -56,6 +56,13 @@ class OnsetDetectionGlobal : public Algorithm {
   // beat emphasis function
   int _numberERBBands;
   static const int _smoothingWindowHalfSize=8;
+#ifdef __APPLE__
+  // the platform FFT (see setFFTBackend()) transforms the frames one at a time
+  static const int _fftBatchSize=1;
+#else
+  // FFTBatch transforms the frames by batches of _fftBatchSize frames
+  static const int _fftBatchSize=32;
+#endif
   int _maxPeriodODF;
 
   std::vector<Real> _phase_1;
@@ -71,7 +78,7 @@ class OnsetDetectionGlobal : public Algorithm {
     _frameCutter = AlgorithmFactory::create("FrameCutter");
     _windowing = AlgorithmFactory::create("Windowing");
     _spectrum = AlgorithmFactory::create("Spectrum");
-    _fft = AlgorithmFactory::create("FFT");
+    _fft = AlgorithmFactory::create(_fftBatchSize > 1 ? "FFTBatch" : "FFT");
     _cartesian2polar = AlgorithmFactory::create("CartesianToPolar");
     _movingAverage = AlgorithmFactory::create("MovingAverage");
     _erbbands = AlgorithmFactory::create("ERBBands");
@@ -42,6 +42,7 @@ void ERBBands::configure() {
   createFilters(parameter("inputSize").toInt());
 
   _type = parameter("type").toLower();
+  _filterBank.setType(_type);
 }
 
 void ERBBands::calculateFilterFrequencies() {
@@ -66,7 +67,8 @@ void ERBBands::createFilters(int spectrumSize) {
   complex<Real> oneJ(0,1);
   Real order = 1;
   Real pi = Real(M_PI);
-  _filterCoefficients = vector<vector<Real> >(filterSize, vector<Real>(spectrumSize, 0.0));
+  _filterBank.clear(spectrumSize);
+  vector<Real> filter(spectrumSize);
   Real fftSize = (spectrumSize-1)*2;
   for (int i=0; i<spectrumSize; i++) {
  	  ucirc[i] = exp((oneJ*Real(2.0)*pi*Real(i))/fftSize);
@@ -116,11 +118,12 @@ void ERBBands::createFilters(int spectrumSize) {
                 Real(2)* cxExp + Real(2)*(Real(1) + cxExp)/exp(B*T)),Real(4)));
 
     for (int j=0; j<spectrumSize; j++) {
-      _filterCoefficients[i][j] = (pow(T,4)/filterGain) *
+      filter[j] = (pow(T,4)/filterGain) *
             abs(ucirc[j]-zeros[0]) * abs(ucirc[j]-zeros[1]) *
             abs(ucirc[j]-zeros[2]) * abs(ucirc[j]-zeros[3]) *
             pow(abs((pole-ucirc[j])*(pole-ucirc[j])),(-GTord));
     }
+    _filterBank.addFilter(filter);
   }
 }
 
@@ -129,37 +132,17 @@ void ERBBands::compute() {
   const std::vector<Real>& spectrum = _spectrumInput.get();
   std::vector<Real>& bands = _bandsOutput.get();
 
-  int filterSize = _numberBands;
   int spectrumSize = (int)spectrum.size();
 
-  if (_filterCoefficients.empty() ||
-      int(_filterCoefficients[0].size()) != spectrumSize) {
-    E_INFO("ERBBands: input spectrum size (" << spectrumSize << ") does not correspond to the \"inputSize\" parameter (" << _filterCoefficients[0].size() << "). Recomputing the filter bank.");
+  if (_filterBank.inputSize() != spectrumSize) {
+    E_INFO("ERBBands: input spectrum size (" << spectrumSize << ") does not correspond to the \"inputSize\" parameter (" << _filterBank.inputSize() << "). Recomputing the filter bank.");
     createFilters(spectrumSize);
   }
 
-  bands.resize(filterSize);
-
-
   // NB: Band magnitudes are returned, while BarkBands and MelBands algorithms
   // return energy. Gerard Roma have found magnitudes work better when
   // working with sound effects.  Band magnitudes option is required for
   // OnsetDetectionGlobal algorithm.
 
-  if (_type=="magnitude") {
-    for (int i=0; i<filterSize; ++i) {
-      bands[i] = 0;
-      for (int j=0; j<spectrumSize; ++j) {
-        bands[i] += (spectrum[j]) * _filterCoefficients[i][j];
-      }
-    }
-  }
-  else if (_type=="power") {
-    for (int i=0; i<filterSize; ++i) {
-      bands[i] = 0;
-      for (int j=0; j<spectrumSize; ++j) {
-        bands[i] += (spectrum[j] * spectrum[j]) * _filterCoefficients[i][j];
-      }
-    }
-  }
+  _filterBank.apply(spectrum, bands);
 }
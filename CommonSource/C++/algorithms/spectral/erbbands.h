@@ -22,6 +22,7 @@
 
 #include "essentiamath.h"
 #include "algorithm.h"
+#include "filterbank.h"
 #include <complex>
 
 namespace essentia {
@@ -61,7 +62,7 @@ class ERBBands : public Algorithm {
   void createFilters(int spectrumSize);
   void calculateFilterFrequencies();
 
-  std::vector<std::vector<Real> > _filterCoefficients;
+  FilterBank _filterBank;
   std::vector<Real> _filterFrequencies;
   int _numberBands;
 
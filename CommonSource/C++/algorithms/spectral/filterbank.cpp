@@ -0,0 +1,80 @@
+/*
+ * Copyright (C) 2006-2016  Music Technology Group - Universitat Pompeu Fabra
+ *
+ * This file is part of Essentia
+ *
+ * Essentia is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ */
+
+#include "filterbank.h"
+#include "essentiamath.h"
+
+using namespace std;
+
+namespace essentia {
+
+void FilterBank::clear(int inputSize) {
+  _inputSize = inputSize;
+  _begin.clear();
+  _length.clear();
+  _offset.clear();
+  _coefficients.clear();
+}
+
+void FilterBank::addFilter(const vector<Real>& coefficients) {
+  if ((int)coefficients.size() != _inputSize) {
+    throw EssentiaException("FilterBank: the filter has ", coefficients.size(), " coefficients instead of ", _inputSize);
+  }
+
+  int begin = 0;
+  int end = _inputSize;
+  while (begin < end && coefficients[begin] == 0) begin++;
+  while (end > begin && coefficients[end-1] == 0) end--;
+
+  _begin.push_back(begin);
+  _length.push_back(end - begin);
+  _offset.push_back((int)_coefficients.size());
+  _coefficients.insert(_coefficients.end(), coefficients.begin() + begin, coefficients.begin() + end);
+}
+
+void FilterBank::setType(const string& type) {
+  if (type == "magnitude") setType(Magnitude);
+  else if (type == "power") setType(Power);
+  else throw EssentiaException("FilterBank: invalid type: ", type);
+}
+
+void FilterBank::apply(const vector<Real>& spectrum, vector<Real>& bands) {
+  if ((int)spectrum.size() != _inputSize) {
+    throw EssentiaException("FilterBank: the spectrum has ", spectrum.size(), " values instead of ", _inputSize);
+  }
+
+  const Real* input = spectrum.empty() ? 0 : &spectrum[0];
+
+  // the bands overlap, so the spectrum is squared once for all of them
+  if (_type == Power) {
+    _power.resize(_inputSize);
+    for (int j=0; j<_inputSize; j++) _power[j] = spectrum[j] * spectrum[j];
+    input = _power.empty() ? 0 : &_power[0];
+  }
+
+  const Real* coefficients = _coefficients.empty() ? 0 : &_coefficients[0];
+
+  int nBands = size();
+  bands.resize(nBands);
+  for (int i=0; i<nBands; i++) {
+    bands[i] = dotProduct(coefficients + _offset[i], input + _begin[i], _length[i]);
+  }
+}
+
+} // namespace essentia
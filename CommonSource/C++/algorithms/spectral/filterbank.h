@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2006-2016  Music Technology Group - Universitat Pompeu Fabra
+ *
+ * This file is part of Essentia
+ *
+ * Essentia is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ */
+
+#ifndef ESSENTIA_FILTERBANK_H
+#define ESSENTIA_FILTERBANK_H
+
+#include <string>
+#include <vector>
+#include "types.h"
+
+namespace essentia {
+
+/**
+ * Bank of band filters applied to a spectrum, shared by the band energy
+ * algorithms (TriangularBands, and so MelBands and MFCC, TriangularBarkBands
+ * and BFCC, ERBBands and GFCC).
+ *
+ * Each filter only stores its coefficients between its first and last non
+ * zero ones, all the filters being stored one after the other in the same
+ * array. A band is then the dot product of this range of coefficients with
+ * the same range of the spectrum, or of its square.
+ */
+class FilterBank {
+ public:
+  enum Type { Magnitude, Power };
+
+  FilterBank() : _inputSize(0), _type(Power) {}
+
+  /**
+   * Removes all the filters, and sets the size of the spectra they apply to.
+   */
+  void clear(int inputSize);
+
+  /**
+   * Adds a filter, given by its coefficients for all the bins of the
+   * spectrum (inputSize() values). Only the range between its first and last
+   * non zero coefficients is kept.
+   */
+  void addFilter(const std::vector<Real>& coefficients);
+
+  /**
+   * Sets whether the filters are applied to the spectrum or to its square.
+   */
+  void setType(Type type) { _type = type; }
+
+  /**
+   * Sets the type from the "type" parameter of the band algorithms, either
+   * "magnitude" or "power".
+   */
+  void setType(const std::string& type);
+
+  int size() const { return (int)_begin.size(); }
+  int inputSize() const { return _inputSize; }
+  bool empty() const { return _begin.empty(); }
+
+  /**
+   * Computes the size() bands of @c spectrum, which must have inputSize()
+   * values.
+   */
+  void apply(const std::vector<Real>& spectrum, std::vector<Real>& bands);
+
+ protected:
+  int _inputSize;
+  Type _type;
+
+  // filter i has the coefficients _coefficients[_offset[i] + k] for the bins
+  // _begin[i] + k, k in [0, _length[i])
+  std::vector<int> _begin;
+  std::vector<int> _length;
+  std::vector<int> _offset;
+  std::vector<Real> _coefficients;
+
+  // the squared spectrum, for the power type
+  std::vector<Real> _power;
+};
+
+} // namespace essentia
+
+#endif // ESSENTIA_FILTERBANK_H
@@ -74,7 +74,6 @@ class MelBands : public Algorithm {
   void calculateFilterFrequencies();
   void setWarpingFunctions(std::string warping, std::string weighting);
 
-  std::vector<std::vector<Real> > _filterCoefficients;
   std::vector<Real> _filterFrequencies;
   int _numBands;
   Real _sampleRate;
@@ -50,6 +50,7 @@ void TriangularBands::configure() {
     }
   }
   _isLog = parameter("log").toBool();
+  _filterBank.setType(_type);
   setWeightingFunctions(parameter("weighting").toString());
   createFilters(_inputSize);
 }
@@ -63,38 +64,20 @@ void TriangularBands::compute() {
     throw EssentiaException("TriangularBands: the size of the input spectrum is not greater than one");
   }
 
-  int filterSize = _nBands;
   int spectrumSize = (int)spectrum.size();
 
-  if (_filterCoefficients.empty() || int(_filterCoefficients[0].size()) != spectrumSize) {
-      E_INFO("TriangularBands: input spectrum size (" << spectrumSize << ") does not correspond to the \"inputSize\" parameter (" << _filterCoefficients[0].size() << "). Recomputing the filter bank.");
+  if (_filterBank.inputSize() != spectrumSize) {
+      E_INFO("TriangularBands: input spectrum size (" << spectrumSize << ") does not correspond to the \"inputSize\" parameter (" << _filterBank.inputSize() << "). Recomputing the filter bank.");
     createFilters(spectrumSize);
   }
 
-  Real frequencyScale = (_sampleRate / 2.0) / (spectrum.size() - 1);
-
-  bands.resize(_nBands);
-  fill(bands.begin(), bands.end(), (Real) 0.0);
-
-  for (int i=0; i<filterSize; ++i) {
-
-    int jbegin = int(_bandFrequencies[i] / frequencyScale + 0.5);
-    int jend = int(_bandFrequencies[i+2] / frequencyScale + 0.5);
-
-    for (int j=jbegin; j<jend; ++j) {
-
-      if (_type == "power"){
-        bands[i] += (spectrum[j] * spectrum[j]) * _filterCoefficients[i][j];
-      }
-
-      if (_type == "magnitude"){
-        bands[i] += (spectrum[j]) * _filterCoefficients[i][j];
-      }
+  _filterBank.apply(spectrum, bands);
 
+  if (_isLog) {
+    for (int i=0; i<_nBands; ++i) {
+      bands[i] = log2(1 + bands[i]);
     }
-    if (_isLog) bands[i] = log2(1 + bands[i]);
   }
-  
 }
 
 void TriangularBands::createFilters(int spectrumSize) {
@@ -122,7 +105,8 @@ void TriangularBands::createFilters(int spectrumSize) {
 
   int filterSize = _nBands;
 
-  _filterCoefficients = vector<vector<Real> >(filterSize, vector<Real>(spectrumSize, 0.0));
+  _filterBank.clear(spectrumSize);
+  vector<Real> filter(spectrumSize);
 
   Real frequencyScale = ( _sampleRate / 2.0) / (spectrumSize - 1);
 
@@ -137,34 +121,39 @@ void TriangularBands::createFilters(int spectrumSize) {
       throw EssentiaException("TriangularBands: the number of spectrum bins is insufficient for the specified number of triangular bands. Use zero padding to increase the number of FFT bins.");
     }
 
+    // the bands above the Nyquist frequency are cut
+    jend = min(jend, spectrumSize);
+
+    fill(filter.begin(), filter.end(), (Real) 0.0);
+
     for (int j=jbegin; j<jend; ++j) {
       Real binfreq = j*frequencyScale;
       // in the ascending part of the triangle...
       if ((binfreq >= _bandFrequencies[i]) && (binfreq < _bandFrequencies[i+1])) {
-        _filterCoefficients[i][j] = ((*_weighter)(binfreq) - (*_weighter)(_bandFrequencies[i])) / fstep1;
+        filter[j] = ((*_weighter)(binfreq) - (*_weighter)(_bandFrequencies[i])) / fstep1;
       }
       // in the descending part of the triangle...
       else if ((binfreq >= _bandFrequencies[i+1]) && (binfreq < _bandFrequencies[i+2])) {
-        _filterCoefficients[i][j] = ((*_weighter)(_bandFrequencies[i+2]) - (*_weighter)(binfreq)) / fstep2;
+        filter[j] = ((*_weighter)(_bandFrequencies[i+2]) - (*_weighter)(binfreq)) / fstep2;
       }
     }
-  }
 
-  // normalize the filter weights
-  if ( _normalization.compare("unit_sum") == 0 ){
-    for (int i=0; i<filterSize; ++i) {
+    // normalize the filter weights
+    if ( _normalization.compare("unit_sum") == 0 ){
       Real weight = 0.0;
 
       for (int j=0; j<spectrumSize; ++j) {
-        weight += _filterCoefficients[i][j];
+        weight += filter[j];
       }
 
-      if (weight == 0) continue;
-
-      for (int j=0; j<spectrumSize; ++j) {
-        _filterCoefficients[i][j] = _filterCoefficients[i][j] / weight;
+      if (weight != 0) {
+        for (int j=0; j<spectrumSize; ++j) {
+          filter[j] = filter[j] / weight;
+        }
       }
     }
+
+    _filterBank.addFilter(filter);
   }
 }
 
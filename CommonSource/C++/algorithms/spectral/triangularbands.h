@@ -22,6 +22,7 @@
 
 #include "algorithm.h"
 #include "essentiautil.h"
+#include "filterbank.h"
 
 using namespace std;
 
@@ -39,7 +40,7 @@ class TriangularBands : public Algorithm {
   int _nBands;
   Real _sampleRate;
   bool _isLog;
-  std::vector<std::vector<Real> > _filterCoefficients;
+  FilterBank _filterBank;
   Real _inputSize;
   std::string _normalization;
   std::string _type;
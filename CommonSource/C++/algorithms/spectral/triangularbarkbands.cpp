@@ -44,11 +44,12 @@ void TriangularBarkBands::configure() {
   _type = parameter("type").toString();
     
     _isLog = parameter("log").toBool();
-    calculateFilterCoefficients();
+    _filterBank.setType(_type);
+    calculateFilterCoefficients(parameter("inputSize").toInt());
 }
 
-void TriangularBarkBands::calculateFilterCoefficients() {
-    int nfft = (parameter("inputSize").toInt()-1)*2;
+void TriangularBarkBands::calculateFilterCoefficients(int spectrumSize) {
+    int nfft = (spectrumSize-1)*2;
     int nfilts = _numBands;
     int sr = _sampleRate;
     float width = 1.0;
@@ -62,8 +63,6 @@ void TriangularBarkBands::calculateFilterCoefficients() {
     if(nfilts == 0)
         nfilts = ceil(nyqbark)+1;
     
-    _filterCoefficients.resize(nfilts);
-    
     float step_barks = nyqbark/(nfilts-1);
     
     std::vector<Real> binbarks;
@@ -73,8 +72,10 @@ void TriangularBarkBands::calculateFilterCoefficients() {
     for(int i=0; i<nfft/2+1; i++)
         binbarks.push_back(_hz2bark((float)i*srOverNFFT));
     
-    for(int i=0; i<nfilts; i++)
-        _filterCoefficients[i].resize(binbarks.size());
+    // the coefficients far from the center of a filter underflow to 0, and
+    // are not stored by the filter bank
+    _filterBank.clear(binbarks.size());
+    std::vector<Real> filter(binbarks.size());
     
     for(int i = 0; i < nfilts; i++)
     {
@@ -87,26 +88,26 @@ void TriangularBarkBands::calculateFilterCoefficients() {
             
             double coeff = std::min((float)0, min((float)hif, (float)-2.5*lof)/width);
             
-            _filterCoefficients[i][j] = pow(10, coeff);
+            filter[j] = pow(10, coeff);
         }
-    }
-    
-    // normalize the filter weights
-    if ( _normalization.compare("unit_sum") == 0 ){
-        for (int i=0; i<nfilts; ++i) {
+        
+        // normalize the filter weights
+        if ( _normalization.compare("unit_sum") == 0 ){
             Real weight = 0.0;
             
             for (int j=0; j<binbarks.size(); ++j) {
-                weight += _filterCoefficients[i][j];
+                weight += filter[j];
             }
             
-            if (weight == 0) continue;
-            
-            for (int j=0; j<binbarks.size(); ++j) {
-                _filterCoefficients[i][j] = _filterCoefficients[i][j] / weight;
+            if (weight != 0) {
+                for (int j=0; j<binbarks.size(); ++j) {
+                    filter[j] = filter[j] / weight;
+                }
             }
         }
-    }    
+        
+        _filterBank.addFilter(filter);
+    }
 }
 
 
@@ -118,29 +119,18 @@ void TriangularBarkBands::compute() {
         throw EssentiaException("TriangularBands: the size of the input spectrum is not greater than one");
     }
     
-    int filterSize = _numBands;
     int spectrumSize = (int)spectrum.size();
     
-    if (_filterCoefficients.empty() || int(_filterCoefficients[0].size()) != spectrumSize) {
-        E_INFO("TriangularBarkBands: input spectrum size (" << spectrumSize << ") does not correspond to the \"inputSize\" parameter (" << _filterCoefficients[0].size() << "). Recomputing the filter bank.");
-        calculateFilterCoefficients();
+    if (_filterBank.inputSize() != spectrumSize) {
+        E_INFO("TriangularBarkBands: input spectrum size (" << spectrumSize << ") does not correspond to the \"inputSize\" parameter (" << _filterBank.inputSize() << "). Recomputing the filter bank.");
+        calculateFilterCoefficients(spectrumSize);
     }
 
-    bands.resize(_numBands);
-    fill(bands.begin(), bands.end(), (Real) 0.0);
+    _filterBank.apply(spectrum, bands);
     
-    for (int i=0; i<filterSize; ++i) {
-        for (int j=0; j<spectrum.size(); ++j) {
-            if (_type == "power"){
-                bands[i] += (spectrum[j] * spectrum[j]) * _filterCoefficients[i][j];
-            }
-            
-            if (_type == "magnitude"){
-                bands[i] += (spectrum[j]) * _filterCoefficients[i][j];
-            }
-            
-            if (_isLog)
-                bands[i] = log2(1 + bands[i]);
+    if (_isLog) {
+        for (int i=0; i<(int)bands.size(); ++i) {
+            bands[i] = log2(1 + bands[i]);
         }
     }
 }
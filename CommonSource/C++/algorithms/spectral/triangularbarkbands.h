@@ -23,6 +23,7 @@
 #include "essentiamath.h"
 #include "algorithm.h"
 #include "algorithmfactory.h"
+#include "filterbank.h"
 #include <cmath>
 
 
@@ -74,10 +75,10 @@ class TriangularBarkBands : public Algorithm {
 
  protected:
   
-  void calculateFilterCoefficients();
+  void calculateFilterCoefficients(int spectrumSize);
   void setWarpingFunctions(std::string warping, std::string weighting);
 
-  std::vector<std::vector<Real> > _filterCoefficients;
+  FilterBank _filterBank;
   int _numBands;
   Real _sampleRate;
 
@@ -19,6 +19,7 @@
 
 #include "autocorrelation.h"
 #include "essentiamath.h"
+#include "fftnplan.h"
 
 using namespace std;
 using namespace essentia;
@@ -70,7 +71,14 @@ void AutoCorrelation::compute() {
   _ifft->output("frame").set(_corr);
 
   int size = int(signal.size());
-  int sizeFFT = int(nextPowerTwo(2*size));
+
+  // any size of at least 2*size-1 avoids the circular aliasing, so the
+  // smallest one the FFT computes efficiently is used (the IFFT needs an even
+  // size). The generalized autocorrelation compresses the magnitude of each
+  // bin, so its result depends on the number of bins: it keeps using the next
+  // power of 2.
+  int sizeFFT = _generalized ? int(nextPowerTwo(2*size))
+                             : max(FFTNPlan::nextFastSize(2*size-1), 2);
 
   // formula to get the auto-correlation (in matlab) is:
   //  [M,N] = size(x)
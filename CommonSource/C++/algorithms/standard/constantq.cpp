@@ -20,7 +20,9 @@
 #include "constantq.h"
 #include "essentia.h"
 #include "essentiamath.h"
+#include "fftnplan.h"
 #include <iostream>
+#include <cstring>
 
 using namespace std;
 using namespace essentia;
@@ -30,6 +32,10 @@ const char* ConstantQ::name = "ConstantQ";
 const char* ConstantQ::category = "Standard";
 const char* ConstantQ::description = DOC("This algorithm implements Constant Q Transform using the FFT for fast calculation.\n"
 "\n"
+"The input is the FFT of a frame whose length is the FFT length, which is the next power of 2 of the length of the longest kernel (Q*sampleRate/minFrequency samples). With minimalFFTLength, it is instead the smallest multiple of 8 not smaller than that length which only has 2, 3, 5 and 7 as prime factors, which is up to twice as small. An exception is thrown if the input size is not a multiple of this length.\n"
+"\n"
+"Several frames can be given at once, one after the other, in which case the output contains the transform of each of them, one after the other. This is faster than transforming the frames one by one, as the kernel is then applied to several frames in a single pass.\n"
+"\n"
 "References:\n"
 "  [1] Constant Q transform - Wikipedia, the free encyclopedia, https://en.wikipedia.org/wiki/Constant_Q_transform");
 
@@ -46,37 +52,135 @@ static double squaredModule(const complex<double> xx) {
 }
 
 
+// The frames transformed together are processed as blocks of 4 Reals, which
+// GCC and clang compile to SSE, AVX or NEON vector instructions.
+#if defined(__GNUC__)
+typedef Real FrameBlock __attribute__((vector_size(4*sizeof(Real))));
+static const int BLOCK_FRAMES = 4;
+#else
+typedef Real FrameBlock;
+static const int BLOCK_FRAMES = 1;
+#endif
+
+// number of frames the kernel is applied to in one pass
+static const int BATCH_BLOCKS = 2;
+static const int BATCH_FRAMES = BATCH_BLOCKS*BLOCK_FRAMES;
+
+/**
+ * Applies the sparse kernel to BATCH_FRAMES frames at once, and writes the
+ * @c nrows constant Q bins of each frame to @c output, one frame after the
+ * other. The frames are interleaved in @c x: the real parts of the value i of
+ * the frames are at x[2*BATCH_FRAMES*i], followed by their imaginary parts,
+ * so that each coefficient of the kernel, which is usually larger than the
+ * caches, is loaded once and multiplied with all the frames by vector
+ * instructions.
+ */
+static void applySparseKernel(const int* rows, const int* is, const Real* kr, const Real* ki, int nrows,
+                              const Real* x, complex<Real>* output) {
+  for (int k=0; k<nrows; k++) {
+    FrameBlock accRe[BATCH_BLOCKS] = {}, accIm[BATCH_BLOCKS] = {};
+
+    for (int i=rows[k]; i<rows[k+1]; i++) {
+      const FrameBlock r1 = kr[i] + FrameBlock(), i1 = ki[i] + FrameBlock();
+      const Real* xi = x + 2*BATCH_FRAMES*is[i];
+      for (int b=0; b<BATCH_BLOCKS; b++) {
+        FrameBlock r2, i2;
+        memcpy(&r2, xi + b*BLOCK_FRAMES, sizeof(FrameBlock));
+        memcpy(&i2, xi + BATCH_FRAMES + b*BLOCK_FRAMES, sizeof(FrameBlock));
+        accRe[b] += r1*r2 - i1*i2;
+        accIm[b] += r1*i2 + i1*r2;
+      }
+    }
+
+    Real re[BATCH_FRAMES], im[BATCH_FRAMES];
+    memcpy(re, accRe, sizeof(re));
+    memcpy(im, accIm, sizeof(im));
+    for (int f=0; f<BATCH_FRAMES; f++) {
+      output[f*nrows + k] = complex<Real>(re[f], im[f]);
+    }
+  }
+}
+
+/**
+ * Single frame version of applySparseKernel(), where the coefficients of a
+ * bin are multiplied 4 at a time instead, with the input values they apply to
+ * gathered into a block.
+ */
+static void applySparseKernel(const int* rows, const int* is, const Real* kr, const Real* ki, int nrows,
+                              const complex<Real>* frame, complex<Real>* output) {
+  const Real* x = reinterpret_cast<const Real*>(frame);
+
+  for (int k=0; k<nrows; k++) {
+    int i = rows[k];
+    const int end = rows[k+1];
+    Real accRe = 0, accIm = 0;
+
+#if defined(__GNUC__)
+    FrameBlock blockRe = {}, blockIm = {};
+    for (; i+4<=end; i+=4) {
+      FrameBlock r1, i1;
+      memcpy(&r1, kr+i, sizeof(FrameBlock));
+      memcpy(&i1, ki+i, sizeof(FrameBlock));
+      const int* j = is+i;
+      const FrameBlock r2 = { x[2*j[0]], x[2*j[1]], x[2*j[2]], x[2*j[3]] };
+      const FrameBlock i2 = { x[2*j[0]+1], x[2*j[1]+1], x[2*j[2]+1], x[2*j[3]+1] };
+      blockRe += r1*r2 - i1*i2;
+      blockIm += r1*i2 + i1*r2;
+    }
+    accRe = (blockRe[0] + blockRe[1]) + (blockRe[2] + blockRe[3]);
+    accIm = (blockIm[0] + blockIm[1]) + (blockIm[2] + blockIm[3]);
+#endif
+
+    for (; i<end; i++) {
+      const Real r1 = kr[i], i1 = ki[i];
+      const Real r2 = x[2*is[i]], i2 = x[2*is[i] + 1];
+      accRe += r1*r2 - i1*i2;
+      accIm += r1*i2 + i1*r2;
+    }
+
+    output[k] = complex<Real>(accRe, accIm);
+  }
+}
+
+
 void ConstantQ::compute() {
 
   const vector<complex<Real> >& signal = _signal.get();
   vector<complex<Real> >& constantQ = _constantQ.get();
 
-  if (!m_sparseKernel) {
+  const SparseKernel& sk = _sparseKernel;
+  if (sk._sparseKernelRows.empty()) {
     throw EssentiaException("ERROR: ConstantQ::compute: Sparse kernel has not been initialised");
   }
 
-  if (signal.size() != _FFTLength) {
-    throw EssentiaException("ERROR: ConstantQ::compute: The ConstantQ input size must be equal to the FFTLength : ", _FFTLength);
+  if (signal.empty() || signal.size() % _FFTLength != 0) {
+    throw EssentiaException("ERROR: ConstantQ::compute: The ConstantQ input size must be equal to the FFTLength, or to a multiple of it for several frames : ", _FFTLength);
   }
 
-  SparseKernel *sk = m_sparseKernel;
-  constantQ.assign(_uK, complex<Real>(0, 0)); // initialize output
-
-  const unsigned *fftbin = &(sk->_sparseKernelIs[0]);
-  const unsigned *cqbin  = &(sk->_sparseKernelJs[0]);
-  const double   *real   = &(sk->_sparseKernelReal[0]);
-  const double   *imag   = &(sk->_sparseKernelImag[0]);
-  const unsigned int sparseCells = (int)sk->_sparseKernelReal.size();
-
-  for (unsigned i = 0; i<sparseCells; i++) {
-    const unsigned row = cqbin[i];
-    const unsigned col = fftbin[i];
-    const double & r1  = real[i];
-    const double & i1  = imag[i];
-    const double & r2  = (double) signal.at( _FFTLength - col - 1 ).real();
-    const double & i2  = (double) signal.at( _FFTLength - col - 1 ).imag();
-    // add the multiplication
-    constantQ.at(row) += complex <Real>((r1*r2 - i1*i2), (r1*i2 + i1*r2));
+  const int nframes = (int)(signal.size() / _FFTLength);
+  constantQ.resize(nframes * _uK);
+
+  const int* rows = &sk._sparseKernelRows[0];
+  const int* is = sk._sparseKernelIs.empty() ? 0 : &sk._sparseKernelIs[0];
+  const Real* real = sk._sparseKernelReal.empty() ? 0 : &sk._sparseKernelReal[0];
+  const Real* imag = sk._sparseKernelImag.empty() ? 0 : &sk._sparseKernelImag[0];
+
+  int f = 0;
+  if (nframes >= BATCH_FRAMES) {
+    _batchFrames.resize(2*BATCH_FRAMES*_FFTLength);
+  }
+  for (; f+BATCH_FRAMES<=nframes; f+=BATCH_FRAMES) {
+    for (int i=0; i<(int)_FFTLength; i++) {
+      Real* x = &_batchFrames[2*BATCH_FRAMES*i];
+      for (int l=0; l<BATCH_FRAMES; l++) {
+        x[l] = signal[(f+l)*_FFTLength + i].real();
+        x[BATCH_FRAMES + l] = signal[(f+l)*_FFTLength + i].imag();
+      }
+    }
+    applySparseKernel(rows, is, real, imag, _uK, &_batchFrames[0], &constantQ[f*_uK]);
+  }
+  for (; f<nframes; f++) {
+    applySparseKernel(rows, is, real, imag, _uK, &signal[f*_FFTLength], &constantQ[f*_uK]);
   }
 }
 
@@ -87,32 +191,44 @@ void ConstantQ::configure() {
   _maxFrequency = parameter("maxFrequency").toDouble();
   _binsPerOctave = parameter("binsPerOctave").toInt();
   _threshold = parameter("threshold").toDouble();
+  _minimalFFTLength = parameter("minimalFFTLength").toBool();
 
   // Work out Q value for Filter bank
   _dQ = 1/(pow(2,(1/(double)_binsPerOctave))-1);
   // Number of Constant Q bins
   _uK = (unsigned int) ceil(_binsPerOctave * log(_maxFrequency/_minFrequency)/log(2.0));
 
-  _FFTLength = (int) pow(2, nextpow2(ceil(_dQ *_sampleRate/_minFrequency)));
+  // the FFT length must hold the longest kernel, of the lowest frequency
+  int kernelLength = (int) ceil(_dQ *_sampleRate/_minFrequency);
+  if (_minimalFFTLength) {
+    _FFTLength = FFTNPlan::nextFastSize(kernelLength);
+  }
+  else {
+    _FFTLength = (int) pow(2, nextpow2(kernelLength));
+  }
   _hop = _FFTLength/8; // hop size is window length divided by 32
 
-  SparseKernel *sk = new SparseKernel();
+  SparseKernel& sk = _sparseKernel;
+  sk._sparseKernelRows.assign(1, 0);
+  sk._sparseKernelIs.clear();
+  sk._sparseKernelReal.clear();
+  sk._sparseKernelImag.clear();
 
   // Initialise temporal kernel with zeros, twice length to deal with complex numbers
   vector<complex<double> > hammingWindow(_FFTLength, complex<Real>(0, 0));
   vector<complex<Real> > transfHammingWindowR(_FFTLength, complex<Real>(0, 0));
 
-  sk->_sparseKernelIs.reserve( _FFTLength*2 );
-  sk->_sparseKernelJs.reserve( _FFTLength*2 );
-  sk->_sparseKernelReal.reserve( _FFTLength*2 );
-  sk->_sparseKernelImag.reserve( _FFTLength*2 );
+  sk._sparseKernelRows.reserve( _uK+1 );
+  sk._sparseKernelIs.reserve( _FFTLength*2 );
+  sk._sparseKernelReal.reserve( _FFTLength*2 );
+  sk._sparseKernelImag.reserve( _FFTLength*2 );
 
   // For each bin value k, calculate temporal kernel, take its fft to
   // calculate the spectral kernel then threshold it to make it sparse and
-  // add it to the sparse kernels matrix
+  // add it to the sparse kernels matrix, one row after the other
   double squareThreshold = _threshold * _threshold;
 
-  for (unsigned k=_uK; k--; ) {
+  for (unsigned k=0; k<_uK; k++) {
 
     // Compute a hamming window
     hammingWindow.assign(_FFTLength, complex<Real>(0, 0));
@@ -149,19 +265,19 @@ void ConstantQ::configure() {
       transfHammingWindow.push_back(transfHammingWindow[ind--]);
     }
 
-    for (int j=0; j<_FFTLength; j++) {
+    // FFT bin j multiplies the input value _FFTLength-j-1, so that going
+    // backwards sorts the row by input index
+    for (int j=_FFTLength; j--; ) {
       // Perform thresholding
       const double squaredBin = squaredModule( transfHammingWindow[j]);
       if (squaredBin <= squareThreshold) continue;
 
-      // Insert non-zero position indexes, doubled because they are floats
-      sk->_sparseKernelIs.push_back(j);
-      sk->_sparseKernelJs.push_back(k);
+      sk._sparseKernelIs.push_back(_FFTLength - j - 1);
 
       // Take conjugate, normalise and add to array sparkernel
-      sk->_sparseKernelReal.push_back(transfHammingWindow[j].real()/_FFTLength);
-      sk->_sparseKernelImag.push_back(-transfHammingWindow[j].imag()/_FFTLength);
+      sk._sparseKernelReal.push_back(transfHammingWindow[j].real()/_FFTLength);
+      sk._sparseKernelImag.push_back(-transfHammingWindow[j].imag()/_FFTLength);
     }
+    sk._sparseKernelRows.push_back((int)sk._sparseKernelIs.size());
   }
-  m_sparseKernel = sk;
 }
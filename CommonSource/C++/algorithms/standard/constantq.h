@@ -47,16 +47,22 @@ class ConstantQ : public Algorithm {
   unsigned int _hop;
   unsigned int _binsPerOctave;  
   unsigned int _FFTLength;
+  bool _minimalFFTLength;
   unsigned int _uK; // Number of constant Q bins
 
+  // Sparse spectral kernel, in compressed sparse row (CSR) format: the
+  // coefficients of constant Q bin k are at [_sparseKernelRows[k],
+  // _sparseKernelRows[k+1]), sorted by the index of the input value they
+  // multiply, which is in _sparseKernelIs.
   struct SparseKernel {
-    std::vector<double> _sparseKernelReal;
-    std::vector<double> _sparseKernelImag;
-    std::vector<unsigned> _sparseKernelIs; 
-    std::vector<unsigned> _sparseKernelJs;
+    std::vector<int> _sparseKernelRows;
+    std::vector<int> _sparseKernelIs;
+    std::vector<Real> _sparseKernelReal;
+    std::vector<Real> _sparseKernelImag;
   };
 
-  SparseKernel *m_sparseKernel;
+  SparseKernel _sparseKernel;
+  std::vector<Real> _batchFrames; // frames interleaved to be transformed together
 
   double hamming(int len, int n) {
     return 0.54 - 0.46*cos(2 * M_PI * n / len);
@@ -64,15 +70,14 @@ class ConstantQ : public Algorithm {
 
  public:
   ConstantQ() {
-    declareInput(_signal, "frame", "the input frame (complex)");
-    declareOutput(_constantQ, "constantq", "the Constant Q transform of the input frame");
+    declareInput(_signal, "frame", "the input frame (complex), or several frames one after the other");
+    declareOutput(_constantQ, "constantq", "the Constant Q transform of the input frame, or of each input frame one after the other");
 
     _fft = AlgorithmFactory::create("FFTC"); //FFT with complex input
   }
 
   ~ConstantQ() {
     delete _fft;
-//    if (m_sparseKernel) delete m_sparseKernel;
   }
 
   int sizeFFT() { return _FFTLength; }
@@ -83,6 +88,7 @@ class ConstantQ : public Algorithm {
     declareParameter("binsPerOctave", "the number of bins per octave", "[1,inf)", 24);    
     declareParameter("sampleRate", "the desired sampling rate [Hz]", "[0,inf)", 44100.);  
     declareParameter("threshold", "threshold value", "[0,inf)", 0.0005);       
+    declareParameter("minimalFFTLength", "whether to use the smallest FFT length which holds the longest kernel and only has 2, 3, 5 and 7 as prime factors, instead of the next power of 2", "{true,false}", false);
   }
 
   void compute();
@@ -32,8 +32,18 @@ const char* DCT::description = DOC("This algorithm computes the Discrete Cosine
 "Note: The 'inputSize' parameter is only used as an optimization when the algorithm is configured. "
 "The DCT will automatically adjust to the size of any input.\n"
 "\n"
+"The DCT is computed as a product with the DCT matrix, or with an FFT of the input size when there are many output coefficients and the input size is even, which is faster [2].\n"
+"\n"
 "References:\n"
-"  [1] Discrete cosine transform - Wikipedia, the free encyclopedia, http://en.wikipedia.org/wiki/Discrete_cosine_transform");
+"  [1] Discrete cosine transform - Wikipedia, the free encyclopedia, http://en.wikipedia.org/wiki/Discrete_cosine_transform\n"
+"  [2] J. Makhoul, \"A fast cosine transform in one and two dimensions,\" IEEE Transactions on Acoustics, Speech, and Signal Processing, vol. 28, no. 1, pp. 27-34, 1980.");
+
+
+// Number of output coefficients from which the FFT is faster than the
+// product with the DCT matrix, which costs a multiply-add per input value and
+// output coefficient, while the FFT costs about as much as 30 of them per
+// input value, whatever the size.
+static const int MIN_FFT_OUTPUT_SIZE = 32;
 
 
 void DCT::configure() {
@@ -41,25 +51,37 @@ void DCT::configure() {
   _outputSize = parameter("outputSize").toInt();
   _type = parameter("dctType").toInt();
   _lifter = parameter("liftering").toInt();
-  if (_type == 2){
-    createDctTableII(inputSize, _outputSize);
+  createDct(inputSize);
+}
+
+void DCT::createDct(int inputSize) {
+  if (_type != 2 && _type != 3) {
+    throw EssentiaException("Bad DCT type.");
   }
-  else if (_type == 3){
-    createDctTableIII(inputSize, _outputSize);
+
+  _inputSize = inputSize;
+  _dctTable.clear();
+  _plan.reset();
+
+  if (inputSize % 2 == 0 && _outputSize >= MIN_FFT_OUTPUT_SIZE) {
+    createDctFFT(inputSize, _outputSize);
+  }
+  else if (_type == 2){
+    createDctTableII(inputSize, _outputSize);
   }
   else {
-    throw EssentiaException("Bad DCT type.");
+    createDctTableIII(inputSize, _outputSize);
   }
 }
 
 void DCT::createDctTableII(int inputSize, int outputSize) {
-  // simple implementation using matrix multiplication, can probably be sped up
-  // using a library like FFTW, for instance.
+  // matrix multiplication, used for small numbers of output coefficients
+  // (see createDctFFT() otherwise)
   if (outputSize > inputSize) {
     throw EssentiaException("DCT: 'outputSize' is greater than 'inputSize'. You can only compute the DCT with an output size smaller than the input size (i.e. you can only compress information)");
   }
 
-  _dctTable = vector<vector<Real> >(outputSize, vector<Real>(inputSize));
+  _dctTable.resize(outputSize * inputSize);
 
   // scale for index = 0
   Real scale0 = 1.0 / sqrt(Real(inputSize));
@@ -73,19 +95,19 @@ void DCT::createDctTableII(int inputSize, int outputSize) {
     Real freqMultiplier = Real(M_PI / inputSize * i);
 
     for (int j=0; j<inputSize; ++j) {
-      _dctTable[i][j] = (Real)(scale * cos( freqMultiplier * ((Real)j + 0.5) ));
+      _dctTable[i*inputSize + j] = (Real)(scale * cos( freqMultiplier * ((Real)j + 0.5) ));
     }
   }
 }
 
 void DCT::createDctTableIII(int inputSize, int outputSize) {
-  // simple implementation using matrix multiplication, can probably be sped up
-  // using a library like FFTW, for instance.
+  // matrix multiplication, used for small numbers of output coefficients
+  // (see createDctFFT() otherwise)
   if (outputSize > inputSize) {
     throw EssentiaException("DCT: 'outputSize' is greater than 'inputSize'. You can only compute the DCT with an output size smaller than the input size (i.e. you can only compress information)");
   }
 
-  _dctTable = vector<vector<Real> >(outputSize, vector<Real>(inputSize));
+  _dctTable.resize(outputSize * inputSize);
 /*
   // scale for index = 0
   Real scale0 = 1.0 / sqrt(Real(inputSize));
@@ -114,12 +136,36 @@ void DCT::createDctTableIII(int inputSize, int outputSize) {
      Real freqMultiplier = Real(M_PI / inputSize * i);
 
      for (int j=0; j<inputSize; ++j) {
-       _dctTable[i][j] = (Real)(scale * cos( freqMultiplier * ( (Real)j + 0.5) ) );
+       _dctTable[i*inputSize + j] = (Real)(scale * cos( freqMultiplier * ( (Real)j + 0.5) ) );
 
      }
    }
 }
 
+void DCT::createDctFFT(int inputSize, int outputSize) {
+  if (outputSize > inputSize) {
+    throw EssentiaException("DCT: 'outputSize' is greater than 'inputSize'. You can only compute the DCT with an output size smaller than the input size (i.e. you can only compress information)");
+  }
+
+  // same scales as the tables of both types
+  double scale0 = (_type == 2) ? 1.0 / sqrt(double(inputSize)) : sqrt(2.0/inputSize);
+  double scale1 = sqrt(2.0/inputSize);
+
+  _twiddleRe.resize(outputSize);
+  _twiddleIm.resize(outputSize);
+  for (int k=0; k<outputSize; ++k) {
+    double scale = (k==0) ? scale0 : scale1;
+    double phase = M_PI * k / (2.0 * inputSize);
+    _twiddleRe[k] = Real(scale * cos(phase));
+    _twiddleIm[k] = Real(scale * sin(phase));
+  }
+
+  _plan = RealFFTNPlan::cached(inputSize);
+  _reordered.resize(inputSize);
+  _spectrum.resize(inputSize/2 + 1);
+  _work.resize(_plan->workSize());
+}
+
 
 void DCT::compute() {
 
@@ -131,26 +177,35 @@ void DCT::compute() {
     throw EssentiaException("DCT: input array cannot be of size 0");
   }
 
-  if (_dctTable.empty() ||
-      inputSize != int(_dctTable[0].size()) ||
-      _outputSize != int(_dctTable.size())) {
-    if (_type == 2){
-      createDctTableII(inputSize, _outputSize);
-    }
-    else if (_type == 3){
-      createDctTableIII(inputSize, _outputSize);
-    }
-    else {
-      throw EssentiaException("Bad DCT type.");
-    }
+  if (inputSize != _inputSize) {
+    createDct(inputSize);
   }
 
   dct.resize(_outputSize);
 
-  for (int i=0; i<_outputSize; ++i) {
-    dct[i] = 0.0;
-    for (int j=0; j<inputSize; ++j) {
-      dct[i] += array[j] * _dctTable[i][j];
+  if (_plan) {
+    // the even input values, followed by the odd ones reversed, have an FFT
+    // whose bin k times exp(-i*pi*k/(2*inputSize)) has the DCT coefficient k
+    // as real part
+    for (int j=0; j<inputSize/2; ++j) {
+      _reordered[j] = array[2*j];
+      _reordered[inputSize-1-j] = array[2*j+1];
+    }
+    _plan->forward(&_reordered[0], &_spectrum[0], &_work[0]);
+
+    // the bins above inputSize/2 are the conjugates of those below
+    int half = min(_outputSize, inputSize/2 + 1);
+    for (int i=0; i<half; ++i) {
+      dct[i] = _spectrum[i].real() * _twiddleRe[i] + _spectrum[i].imag() * _twiddleIm[i];
+    }
+    for (int i=half; i<_outputSize; ++i) {
+      const complex<Real>& bin = _spectrum[inputSize - i];
+      dct[i] = bin.real() * _twiddleRe[i] - bin.imag() * _twiddleIm[i];
+    }
+  }
+  else {
+    for (int i=0; i<_outputSize; ++i) {
+      dct[i] = dotProduct(&_dctTable[i*inputSize], &array[0], inputSize);
     }
   }
 
@@ -21,6 +21,8 @@
 #define ESSENTIA_DCT_H
 
 #include "algorithm.h"
+#include "fftnplan.h"
+#include <complex>
 
 namespace essentia {
 namespace standard {
@@ -55,10 +57,22 @@ class DCT : public Algorithm {
  protected:
   int _outputSize;
   Real _lifter;
+  int _inputSize;
+  void createDct(int inputSize);
   void createDctTableII(int inputSize, int outputSize);
   void createDctTableIII(int inputSize, int outputSize);
-  std::vector<std::vector<Real> > _dctTable;
+  void createDctFFT(int inputSize, int outputSize);
+  // outputSize rows of inputSize coefficients, one after the other
+  std::vector<Real> _dctTable;
   int _type;
+
+  // FFT path, used for large numbers of coefficients: the scaled twiddle
+  // factors scale_k*exp(-i*pi*k/(2*inputSize)) of each output coefficient
+  std::shared_ptr<const RealFFTNPlan> _plan;
+  std::vector<Real> _twiddleRe, _twiddleIm;
+  std::vector<Real> _reordered;
+  std::vector<std::complex<Real> > _spectrum;
+  std::vector<Real> _work;
 };
 
 } // namespace essentia
@@ -19,6 +19,7 @@
 
 #include "ffta.h"
 #include "essentia.h"
+#include "fftplancache.h"
 
 using namespace std;
 using namespace essentia;
@@ -29,7 +30,7 @@ const char* FFTA::category = "Standard";
 const char* FFTA::description = DOC("This algorithm computes the positive complex short-term Fourier transform (STFT) of an array using the FFT algorithm. The resulting fft has a size of (s/2)+1, where s is the size of the input frame.\n"
 "At the moment FFT can only be computed on frames which size is even and non zero, otherwise an exception is thrown.\n"
 "\n"
-"FFT computation will be carried out using the Accelerate Framework [3]"
+"FFT computation will be carried out using the Accelerate Framework [3] for sizes which are a power of 2, and using the built-in mixed-radix FFT otherwise."
 "\n"
 "References:\n"
 "  [1] Fast Fourier transform - Wikipedia, the free encyclopedia, http://en.wikipedia.org/wiki/Fft\n\n"
@@ -37,17 +38,19 @@ const char* FFTA::description = DOC("This algorithm computes the positive comple
 "  [3] vDSP Programming Guide -- from Apple https://developer.apple.com/library/ios/documentation/Performance/Conceptual/vDSP_Programming_Guide/UsingFourierTransforms/UsingFourierTransforms.html"
                                     );
 
-ForcedMutex FFTA::globalFFTAMutex;
+shared_ptr<OpaqueFFTSetup> FFTA::cachedSetup(int size, bool real) {
+  // the same setup computes both directions
+  return FFTPlanCache::get<OpaqueFFTSetup>("accelerate", size, FFTPlanCache::Forward, real, [size]() {
+    return shared_ptr<OpaqueFFTSetup>(vDSP_create_fftsetup(log2(size), 0), vDSP_destroy_fftsetup);
+  });
+}
 
 FFTA::~FFTA() {
-  ForcedMutexLocker lock(globalFFTAMutex);
-
   // we might have called essentia::shutdown() before this algorithm goes out
   // of scope, so make sure we're not doing stupid things here
   // This will cause a memory leak then, but it is definitely a better choice
   // than a crash (right, right??? :-) )
   if (essentia::isInitialized()) {
-      vDSP_destroy_fftsetup(fftSetup);
       free(accelBuffer.realp);
       free(accelBuffer.imagp);
   }
@@ -64,16 +67,22 @@ void FFTA::compute() {
     throw EssentiaException("FFT: Input size cannot be 0");
   }
  
-  if (fftSetup == NULL || _fftPlanSize != size) {
+  if ((!fftSetup && !_plan) || _fftPlanSize != size) {
     createFFTObject(size);
   }
+
+  if (_plan) {
+    fft.resize(size/2+1);
+    _plan->forward(&signal[0], &fft[0], &_work[0]);
+    return;
+  }
     
     // Scramble-pack the real data into complex buffer in just the way that's
     // required by the real-to-complex FFT function that follows.
     vDSP_ctoz((DSPComplex*)&signal[0], 2, &accelBuffer, 1, size/2);
     
     // Do real->complex forward FFT
-    vDSP_fft_zrip(fftSetup, &accelBuffer, 1, logSize, FFT_FORWARD);
+    vDSP_fft_zrip(fftSetup.get(), &accelBuffer, 1, logSize, FFT_FORWARD);
     
 
     fft.resize(size/2+1);
@@ -99,14 +108,21 @@ void FFTA::configure() {
 }
 
 void FFTA::createFFTObject(int size) {
-  ForcedMutexLocker lock(globalFFTAMutex);
-
   // This is only needed because at the moment we return half of the spectrum,
   // which means that there are 2 different input signals that could yield the
   // same FFT...
   if (size % 2 == 1) {
     throw EssentiaException("FFT: can only compute FFT of arrays which have an even size");
   }
+
+  if (!FFTNPlan::isPowerOfTwo(size)) {
+    _plan = RealFFTNPlan::cached(size);
+    _work.resize(_plan->workSize());
+    fftSetup.reset();
+    _fftPlanSize = size;
+    return;
+  }
+  _plan.reset();
     
     free(accelBuffer.realp);
     free(accelBuffer.imagp);
@@ -116,13 +132,7 @@ void FFTA::createFFTObject(int size) {
     
     logSize = log2(size);
     
-    //With vDSP you only need to create a new fft if you've increased the size
-  if (fftSetup == nullptr) {
-      fftSetup = vDSP_create_fftsetup( logSize, 0 );
-  } else if(size > _fftPlanSize) {
-      vDSP_destroy_fftsetup(fftSetup);
-      fftSetup = vDSP_create_fftsetup( logSize, 0 );
-  }
+    fftSetup = cachedSetup(size, true);
     
     _fftPlanSize = size;
 }
@@ -22,7 +22,9 @@
 
 #include "algorithm.h"
 #include "threading.h"
+#include "fftnplan.h"
 #include <complex>
+#include <memory>
 #include <Accelerate/Accelerate.h>
 
 namespace essentia {
@@ -39,7 +41,6 @@ class FFTA : public Algorithm {
         declareInput(_signal, "frame", "the input audio frame");
         declareOutput(_fft, "fft", "the FFT of the input frame");
         
-        fftSetup = NULL;
         accelBuffer.realp = NULL;
         accelBuffer.imagp = NULL;
         _fftPlanSize = 0;
@@ -58,16 +59,26 @@ class FFTA : public Algorithm {
   static const char* category;
   static const char* description;
 
+  /**
+   * Returns the vDSP setup for transforms of the given size from the
+   * FFTPlanCache.
+   */
+  static std::shared_ptr<OpaqueFFTSetup> cachedSetup(int size, bool real);
+
  protected:
   friend class IFFTA;
-  static ForcedMutex globalFFTAMutex;
 
-    FFTSetup fftSetup;
+    std::shared_ptr<OpaqueFFTSetup> fftSetup;
     
     int logSize;
     int _fftPlanSize;    
     DSPSplitComplex accelBuffer;
 
+  // vDSP only computes power of 2 transforms, the other sizes use the
+  // built-in FFT
+  std::shared_ptr<const RealFFTNPlan> _plan;
+  std::vector<Real> _work;
+
   void createFFTObject(int size);
 };
 
@@ -0,0 +1,167 @@
+/*
+ * Copyright (C) 2006-2016  Music Technology Group - Universitat Pompeu Fabra
+ *
+ * This file is part of Essentia
+ *
+ * Essentia is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ */
+
+#include "fftbatch.h"
+
+using namespace std;
+
+namespace essentia {
+namespace standard {
+
+const char* FFTBatch::name = "FFTBatch";
+const char* FFTBatch::category = "Standard";
+const char* FFTBatch::description = DOC("This algorithm computes the positive complex short-term Fourier transform (STFT) of several consecutive frames at once, using the FFT algorithm. The input contains the frames one after the other, and the output their FFTs one after the other, with (s/2)+1 values for each frame of size s.\n"
+"\n"
+"Transforming several frames in one call is faster than transforming them one by one with the FFT algorithm, as the frames are processed together by the vector instructions of the processor. The streaming version takes its input frame by frame, and transforms them by batches of batchSize frames.\n"
+"\n"
+"The frame size must be even, and the input size must be a multiple of the frame size, otherwise an exception is thrown.\n"
+"\n"
+"References:\n"
+"  [1] Fast Fourier transform - Wikipedia, the free encyclopedia, http://en.wikipedia.org/wiki/Fft\n\n"
+"  [2] Fast Fourier Transform -- from Wolfram MathWorld, http://mathworld.wolfram.com/FastFourierTransform.html");
+
+
+void FFTBatch::configure() {
+  _size = parameter("size").toInt();
+  if (_size % 2 != 0) {
+    throw EssentiaException("FFTBatch: the frame size must be even");
+  }
+
+  _plan = RealFFTNPlan::cached(_size);
+  _work.resize(_plan->batchWorkSize());
+}
+
+void FFTBatch::compute() {
+
+  const vector<Real>& frames = _frames.get();
+  vector<complex<Real> >& ffts = _ffts.get();
+
+  if (frames.size() % _size != 0) {
+    throw EssentiaException("FFTBatch: the input size must be a multiple of the frame size");
+  }
+
+  int nframes = (int)frames.size() / _size;
+  ffts.resize(nframes * (_size/2+1));
+  if (nframes == 0) return;
+
+  _plan->forwardBatch(&frames[0], nframes, &ffts[0], &_work[0]);
+}
+
+} // namespace standard
+} // namespace essentia
+
+
+namespace essentia {
+namespace streaming {
+
+const char* FFTBatch::name = standard::FFTBatch::name;
+const char* FFTBatch::category = standard::FFTBatch::category;
+const char* FFTBatch::description = standard::FFTBatch::description;
+
+
+void FFTBatch::configure() {
+  _batchSize = parameter("batchSize").toInt();
+
+  int size = parameter("size").toInt();
+  if (size % 2 == 0) {
+    _plan = RealFFTNPlan::cached(size);
+  }
+
+  reset();
+}
+
+void FFTBatch::reset() {
+  Algorithm::reset();
+  _frame.setAcquireSize(_batchSize);
+  _frame.setReleaseSize(_batchSize);
+  _fft.setAcquireSize(_batchSize);
+  _fft.setReleaseSize(_batchSize);
+}
+
+AlgorithmStatus FFTBatch::process() {
+  AlgorithmStatus status = acquireData();
+
+  if (status != OK) {
+    if (!shouldStop()) return status;
+
+    // at the end of the stream, transform the frames which are left even if
+    // there are not enough of them to fill a batch
+    int available = _frame.available();
+    if (available == 0) return NO_INPUT;
+
+    _frame.setAcquireSize(available);
+    _frame.setReleaseSize(available);
+    _fft.setAcquireSize(available);
+    _fft.setReleaseSize(available);
+
+    return process();
+  }
+
+  const vector<vector<Real> >& frames = _frame.tokens();
+
+  // consecutive frames of the same size are transformed together
+  int first = 0;
+  for (int i=1; i<=(int)frames.size(); i++) {
+    if (i == (int)frames.size() || frames[i].size() != frames[first].size()) {
+      transform(first, i);
+      first = i;
+    }
+  }
+
+  releaseData();
+  return OK;
+}
+
+/**
+ * Transforms the acquired frames [first, last), which have the same size.
+ */
+void FFTBatch::transform(int first, int last) {
+  const vector<vector<Real> >& frames = _frame.tokens();
+  vector<vector<complex<Real> > >& ffts = _fft.tokens();
+
+  int size = (int)frames[first].size();
+  if (size == 0) {
+    throw EssentiaException("FFTBatch: Input size cannot be 0");
+  }
+  if (size % 2 != 0) {
+    throw EssentiaException("FFTBatch: the frame size must be even");
+  }
+
+  if (!_plan || _plan->size() != size) {
+    _plan = RealFFTNPlan::cached(size);
+  }
+  _work.resize(_plan->batchWorkSize());
+
+  int nframes = last - first;
+  _frames.resize(nframes * size);
+  _ffts.resize(nframes * (size/2+1));
+
+  for (int i=0; i<nframes; i++) {
+    copy(frames[first+i].begin(), frames[first+i].end(), _frames.begin() + i*size);
+  }
+
+  _plan->forwardBatch(&_frames[0], nframes, &_ffts[0], &_work[0]);
+
+  for (int i=0; i<nframes; i++) {
+    ffts[first+i].assign(_ffts.begin() + i*(size/2+1), _ffts.begin() + (i+1)*(size/2+1));
+  }
+}
+
+} // namespace streaming
+} // namespace essentia
@@ -0,0 +1,104 @@
+/*
+ * Copyright (C) 2006-2016  Music Technology Group - Universitat Pompeu Fabra
+ *
+ * This file is part of Essentia
+ *
+ * Essentia is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ */
+
+#ifndef ESSENTIA_FFTBATCH_H
+#define ESSENTIA_FFTBATCH_H
+
+#include "algorithm.h"
+#include "fftnplan.h"
+#include <complex>
+
+namespace essentia {
+namespace standard {
+
+class FFTBatch : public Algorithm {
+
+ protected:
+  Input<std::vector<Real> > _frames;
+  Output<std::vector<std::complex<Real> > > _ffts;
+
+ public:
+  FFTBatch() {
+    declareInput(_frames, "frames", "the input audio frames, one after the other");
+    declareOutput(_ffts, "ffts", "the FFTs of the input frames, one after the other");
+  }
+
+  void declareParameters() {
+    declareParameter("size", "the size of the input frames (must be even)", "[2,inf)", 1024);
+  }
+
+  void compute();
+  void configure();
+
+  static const char* name;
+  static const char* category;
+  static const char* description;
+
+ protected:
+  int _size;
+  std::shared_ptr<const RealFFTNPlan> _plan;
+  std::vector<Real> _work;
+};
+
+} // namespace standard
+} // namespace essentia
+
+#include "streamingalgorithm.h"
+
+namespace essentia {
+namespace streaming {
+
+class FFTBatch : public Algorithm {
+
+ protected:
+  Sink<std::vector<Real> > _frame;
+  Source<std::vector<std::complex<Real> > > _fft;
+
+  int _batchSize;
+  std::shared_ptr<const RealFFTNPlan> _plan;
+  std::vector<Real> _frames;
+  std::vector<std::complex<Real> > _ffts;
+  std::vector<Real> _work;
+
+  void transform(int first, int last);
+
+ public:
+  FFTBatch() {
+    declareInput(_frame, "frame", "the input audio frame");
+    declareOutput(_fft, "fft", "the FFT of the input frame");
+  }
+
+  void declareParameters() {
+    declareParameter("size", "the expected size of the input frames. This is purely optional and only targeted at optimizing the creation time of the FFT object", "[2,inf)", 1024);
+    declareParameter("batchSize", "the number of frames transformed together", "[1,inf)", 16);
+  }
+
+  void reset();
+  void configure();
+  AlgorithmStatus process();
+
+  static const char* name;
+  static const char* category;
+  static const char* description;
+};
+
+} // namespace streaming
+} // namespace essentia
+
+#endif // ESSENTIA_FFTBATCH_H
@@ -18,6 +18,7 @@
  */
 
 #include "fftca.h"
+#include "ffta.h"
 #include "essentia.h"
 
 using namespace std;
@@ -29,7 +30,7 @@ const char* FFTCA::category = "Standard";
 const char* FFTCA::description = DOC("This algorithm computes the positive complex short-term Fourier transform (STFT) of an array using the FFT algorithm. The resulting fft has a size of (s/2)+1, where s is the size of the input frame.\n"
                                      "At the moment FFT can only be computed on frames which size is even and non zero, otherwise an exception is thrown.\n"
                                      "\n"
-                                     "FFT computation will be carried out using the Accelerate Framework [3]"
+                                     "FFT computation will be carried out using the Accelerate Framework [3] for sizes which are a power of 2, and using the built-in mixed-radix FFT otherwise."
                                      "\n"
                                      "References:\n"
                                      "  [1] Fast Fourier transform - Wikipedia, the free encyclopedia, http://en.wikipedia.org/wiki/Fft\n\n"
@@ -37,17 +38,12 @@ const char* FFTCA::description = DOC("This algorithm computes the positive compl
                                      "  [3] vDSP Programming Guide -- from Apple https://developer.apple.com/library/ios/documentation/Performance/Conceptual/vDSP_Programming_Guide/UsingFourierTransforms/UsingFourierTransforms.html"
                                      );
 
-ForcedMutex FFTCA::globalFFTCAMutex;
-
 FFTCA::~FFTCA() {
-  ForcedMutexLocker lock(globalFFTCAMutex);
-
   // we might have called essentia::shutdown() before this algorithm goes out
   // of scope, so make sure we're not doing stupid things here
   // This will cause a memory leak then, but it is definitely a better choice
   // than a crash (right, right??? :-) )
   if (essentia::isInitialized()) {
-    vDSP_destroy_fftsetup(fftSetup);
     free(accelBuffer.realp);
     free(accelBuffer.imagp);
   }
@@ -64,7 +60,7 @@ void FFTCA::compute() {
     throw EssentiaException("FFTC: Input size cannot be 0");
   }
 
-  if (_fftPlanSize != size  || fftSetup == NULL) {
+  if (_fftPlanSize != size || (!fftSetup && !_plan)) {
     createFFTObject(size);
   }
 
@@ -73,7 +69,12 @@ void FFTCA::compute() {
 
   vDSP_ctoz(castSignal, 2, &accelBuffer, 1, (vDSP_Length)size);
 
-  vDSP_fft_zip(fftSetup, &accelBuffer, 1, logSize, FFT_FORWARD);
+  if (_plan) {
+    _plan->forward(accelBuffer.realp, accelBuffer.imagp, &_workRe[0], &_workIm[0]);
+  }
+  else {
+    vDSP_fft_zip(fftSetup.get(), &accelBuffer, 1, logSize, FFT_FORWARD);
+  }
 
   fft.resize(size/2+1);
 
@@ -89,8 +90,6 @@ void FFTCA::configure() {
 }
 
 void FFTCA::createFFTObject(int size) {
-  ForcedMutexLocker lock(globalFFTCAMutex);
-
   // This is only needed because at the moment we return half of the spectrum,
   // which means that there are 2 different input signals that could yield the
   // same FFT...
@@ -104,15 +103,19 @@ void FFTCA::createFFTObject(int size) {
   accelBuffer.realp         = (float *) malloc(sizeof(float) * size);
   accelBuffer.imagp         = (float *) malloc(sizeof(float) * size);
 
+  if (!FFTNPlan::isPowerOfTwo(size)) {
+    _plan = FFTNPlan::cached(size);
+    _workRe.resize(_plan->workSize());
+    _workIm.resize(_plan->workSize());
+    fftSetup.reset();
+    _fftPlanSize = size;
+    return;
+  }
+  _plan.reset();
+
   logSize = log2(size);
 
-  //With vDSP you only need to create a new fft if you've increased the size
-  if (fftSetup == nullptr) {
-    fftSetup = vDSP_create_fftsetup( logSize, 0 );
-  } else if(size > _fftPlanSize) {
-    vDSP_destroy_fftsetup(fftSetup);
-    fftSetup = vDSP_create_fftsetup( logSize, 0 );
-  }
+  fftSetup = FFTA::cachedSetup(size, false);
 
   _fftPlanSize = size;
 
@@ -22,7 +22,9 @@
 
 #include "algorithm.h"
 #include "threading.h"
+#include "fftnplan.h"
 #include <complex>
+#include <memory>
 #include <Accelerate/Accelerate.h>
 
 namespace essentia {
@@ -41,7 +43,7 @@ namespace essentia {
 
                 accelBuffer.realp = NULL;
                 accelBuffer.imagp = NULL;
-                fftSetup = NULL;
+                _fftPlanSize = 0;
             }
 
             ~FFTCA();
@@ -59,14 +61,18 @@ namespace essentia {
 
         protected:
             friend class IFFTCA;
-            static ForcedMutex globalFFTCAMutex;
 
-            FFTSetup fftSetup;
+            std::shared_ptr<OpaqueFFTSetup> fftSetup;
 
             int logSize;
             int _fftPlanSize;
             DSPSplitComplex accelBuffer;
 
+            // vDSP only computes power of 2 transforms, the other sizes use
+            // the built-in FFT, on accelBuffer
+            std::shared_ptr<const FFTNPlan> _plan;
+            std::vector<Real> _workRe, _workIm;
+
             void createFFTObject(int size);
         };
 
@@ -0,0 +1,87 @@
+/*
+ * Copyright (C) 2006-2016  Music Technology Group - Universitat Pompeu Fabra
+ *
+ * This file is part of Essentia
+ *
+ * Essentia is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ */
+
+#include "fftcn.h"
+
+using namespace std;
+using namespace essentia;
+using namespace standard;
+
+const char* FFTCN::name = "FFTC";
+const char* FFTCN::category = "Standard";
+const char* FFTCN::description = DOC("This algorithm computes the positive complex short-term Fourier transform (STFT) of a complex array using the FFT algorithm. The resulting fft has a size of (s/2)+1, where s is the size of the input frame.\n"
+"At the moment FFT can only be computed on frames which size is even and non zero, otherwise an exception is thrown.\n"
+"\n"
+"FFT computation will be carried out using the built-in mixed-radix FFT, which does not need any external library. Sizes which only have 2, 3, 5 and 7 as prime factors are the fastest, other sizes are computed with Bluestein's algorithm.\n"
+"\n"
+"References:\n"
+"  [1] Fast Fourier transform - Wikipedia, the free encyclopedia, http://en.wikipedia.org/wiki/Fft\n\n"
+"  [2] Fast Fourier Transform -- from Wolfram MathWorld, http://mathworld.wolfram.com/FastFourierTransform.html");
+
+
+void FFTCN::compute() {
+
+  const std::vector<std::complex<Real> >& signal = _signal.get();
+  std::vector<std::complex<Real> >& fft = _fft.get();
+
+  // check if input is OK
+  int size = int(signal.size());
+  if (size == 0) {
+    throw EssentiaException("FFTC: Input size cannot be 0");
+  }
+
+  if (!_plan || _plan->size() != size) {
+    createFFTObject(size);
+  }
+
+  for (int i=0; i<size; i++) {
+    _re[i] = signal[i].real();
+    _im[i] = signal[i].imag();
+  }
+
+  _plan->forward(&_re[0], &_im[0], &_workRe[0], &_workIm[0]);
+
+  fft.resize(size/2+1);
+  for (int i=0; i<(int)fft.size(); i++) {
+    fft[i] = complex<Real>(_re[i], _im[i]);
+  }
+}
+
+void FFTCN::configure() {
+  // the size is only a hint, unsupported sizes are reported when computing
+  int size = parameter("size").toInt();
+  if (size >= 2 && size % 2 == 0) {
+    createFFTObject(size);
+  }
+}
+
+void FFTCN::createFFTObject(int size) {
+  // This is only needed because at the moment we return half of the spectrum,
+  // which means that there are 2 different input signals that could yield the
+  // same FFT...
+  if (size % 2 == 1) {
+    throw EssentiaException("FFTC: can only compute FFT of arrays which have an even size");
+  }
+
+  _plan = FFTNPlan::cached(size);
+  _re.resize(size);
+  _im.resize(size);
+  _workRe.resize(_plan->workSize());
+  _workIm.resize(_plan->workSize());
+}
@@ -0,0 +1,75 @@
+/*
+ * Copyright (C) 2006-2016  Music Technology Group - Universitat Pompeu Fabra
+ *
+ * This file is part of Essentia
+ *
+ * Essentia is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ */
+
+#include "fftn.h"
+
+using namespace std;
+using namespace essentia;
+using namespace standard;
+
+const char* FFTN::name = "FFT";
+const char* FFTN::category = "Standard";
+const char* FFTN::description = DOC("This algorithm computes the positive complex short-term Fourier transform (STFT) of an array using the FFT algorithm. The resulting fft has a size of (s/2)+1, where s is the size of the input frame.\n"
+"At the moment FFT can only be computed on frames which size is even and non zero, otherwise an exception is thrown.\n"
+"\n"
+"FFT computation will be carried out using the built-in mixed-radix FFT, which does not need any external library. Sizes which only have 2, 3, 5 and 7 as prime factors are the fastest, other sizes are computed with Bluestein's algorithm.\n"
+"\n"
+"References:\n"
+"  [1] Fast Fourier transform - Wikipedia, the free encyclopedia, http://en.wikipedia.org/wiki/Fft\n\n"
+"  [2] Fast Fourier Transform -- from Wolfram MathWorld, http://mathworld.wolfram.com/FastFourierTransform.html");
+
+
+void FFTN::compute() {
+
+  const std::vector<Real>& signal = _signal.get();
+  std::vector<std::complex<Real> >& fft = _fft.get();
+
+  // check if input is OK
+  int size = int(signal.size());
+  if (size == 0) {
+    throw EssentiaException("FFT: Input size cannot be 0");
+  }
+
+  if (!_plan || _plan->size() != size) {
+    createFFTObject(size);
+  }
+
+  fft.resize(size/2+1);
+  _plan->forward(&signal[0], &fft[0], &_work[0]);
+}
+
+void FFTN::configure() {
+  // the size is only a hint, unsupported sizes are reported when computing
+  int size = parameter("size").toInt();
+  if (size >= 2 && size % 2 == 0) {
+    createFFTObject(size);
+  }
+}
+
+void FFTN::createFFTObject(int size) {
+  // This is only needed because at the moment we return half of the spectrum,
+  // which means that there are 2 different input signals that could yield the
+  // same FFT...
+  if (size % 2 == 1) {
+    throw EssentiaException("FFT: can only compute FFT of arrays which have an even size");
+  }
+
+  _plan = RealFFTNPlan::cached(size);
+  _work.resize(_plan->workSize());
+}
@@ -0,0 +1,715 @@
+/*
+ * Copyright (C) 2006-2016  Music Technology Group - Universitat Pompeu Fabra
+ *
+ * This file is part of Essentia
+ *
+ * Essentia is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ */
+
+#include <cmath>
+#include <cstring>
+#include "fftnplan.h"
+#include "fftplancache.h"
+
+using namespace std;
+
+// On x86-64 Linux, the passes are compiled both for the baseline (SSE2) and
+// for AVX2, and the version matching the CPU is selected when loading.
+#if defined(__GNUC__) && !defined(__clang__) && defined(__x86_64__) && defined(__linux__)
+#  define FFTN_KERNEL __attribute__((target_clones("avx2","default")))
+#else
+#  define FFTN_KERNEL
+#endif
+
+// the butterflies of the kernels are inlined in each of their versions
+#if defined(__GNUC__)
+#  define FFTN_INLINE inline __attribute__((always_inline))
+#else
+#  define FFTN_INLINE inline
+#endif
+
+// the loops over the elements of a butterfly have a constant length, and are
+// unrolled so that these elements stay in registers
+#if defined(__clang__)
+#  define FFTN_UNROLL _Pragma("unroll")
+#elif defined(__GNUC__) && __GNUC__ >= 8
+#  define FFTN_UNROLL _Pragma("GCC unroll 8")
+#else
+#  define FFTN_UNROLL
+#endif
+
+namespace essentia {
+
+// The butterflies work on blocks of 4 consecutive Reals, which GCC and clang
+// compile to SSE, AVX or NEON vector instructions depending on the target.
+#if defined(__GNUC__)
+typedef Real Block __attribute__((vector_size(4*sizeof(Real))));
+static const int BLOCK_SIZE = 4;
+static inline Real element(const Block& b, int i) { return b[i]; }
+#else
+typedef Real Block;
+static const int BLOCK_SIZE = 1;
+static inline Real element(const Block& b, int i) { return b; }
+#endif
+
+template <typename T=Block>
+static inline T load(const Real* x) {
+  T b;
+  memcpy(&b, x, sizeof(T));
+  return b;
+}
+
+template <typename T>
+static inline void store(Real* x, const T& b) {
+  memcpy(x, &b, sizeof(T));
+}
+
+/**
+ * One radix-4 Stockham pass: the sub-transforms of the given length, whose
+ * elements are @c stride apart, are split into 4 sub-transforms of a quarter
+ * of that length, written to y.
+ */
+FFTN_KERNEL
+static void radix4Pass(int length, int stride,
+                       const Real* __restrict xr, const Real* __restrict xi,
+                       Real* __restrict yr, Real* __restrict yi,
+                       const Real* w1r, const Real* w1i,
+                       const Real* w2r, const Real* w2i,
+                       const Real* w3r, const Real* w3i) {
+  const int m = length / 4;
+  const int s = stride;
+
+  if (s == 1) {
+    // first pass: there is a different twiddle factor for each butterfly, so
+    // loop over them to keep contiguous inputs
+    for (int p=0; p<m; p++) {
+      Real ar = xr[p],     ai = xi[p];
+      Real br = xr[p+m],   bi = xi[p+m];
+      Real cr = xr[p+2*m], ci = xi[p+2*m];
+      Real dr = xr[p+3*m], di = xi[p+3*m];
+
+      Real apcr = ar + cr, apci = ai + ci;
+      Real amcr = ar - cr, amci = ai - ci;
+      Real bpdr = br + dr, bpdi = bi + di;
+      // j*(b-d)
+      Real jbmdr = di - bi, jbmdi = br - dr;
+
+      Real y1r = amcr - jbmdr, y1i = amci - jbmdi;
+      Real y2r = apcr - bpdr,  y2i = apci - bpdi;
+      Real y3r = amcr + jbmdr, y3i = amci + jbmdi;
+
+      yr[4*p]   = apcr + bpdr;
+      yi[4*p]   = apci + bpdi;
+      yr[4*p+1] = y1r*w1r[p] - y1i*w1i[p];
+      yi[4*p+1] = y1r*w1i[p] + y1i*w1r[p];
+      yr[4*p+2] = y2r*w2r[p] - y2i*w2i[p];
+      yi[4*p+2] = y2r*w2i[p] + y2i*w2r[p];
+      yr[4*p+3] = y3r*w3r[p] - y3i*w3i[p];
+      yi[4*p+3] = y3r*w3i[p] + y3i*w3r[p];
+    }
+    return;
+  }
+
+  for (int p=0; p<m; p++) {
+    const Real c1r = w1r[p], c1i = w1i[p];
+    const Real c2r = w2r[p], c2i = w2i[p];
+    const Real c3r = w3r[p], c3i = w3i[p];
+
+    const Real* ar = xr + s*p;       const Real* ai = xi + s*p;
+    const Real* br = xr + s*(p+m);   const Real* bi = xi + s*(p+m);
+    const Real* cr = xr + s*(p+2*m); const Real* ci = xi + s*(p+2*m);
+    const Real* dr = xr + s*(p+3*m); const Real* di = xi + s*(p+3*m);
+
+    Real* y0r = yr + s*(4*p);   Real* y0i = yi + s*(4*p);
+    Real* y1r = yr + s*(4*p+1); Real* y1i = yi + s*(4*p+1);
+    Real* y2r = yr + s*(4*p+2); Real* y2i = yi + s*(4*p+2);
+    Real* y3r = yr + s*(4*p+3); Real* y3i = yi + s*(4*p+3);
+
+    // the stride is a multiple of 4 here (a power of 4 times the number of
+    // interleaved signals)
+    for (int q=0; q<s; q+=BLOCK_SIZE) {
+      Block a_r = load(ar+q), a_i = load(ai+q);
+      Block b_r = load(br+q), b_i = load(bi+q);
+      Block c_r = load(cr+q), c_i = load(ci+q);
+      Block d_r = load(dr+q), d_i = load(di+q);
+
+      Block apcr = a_r + c_r, apci = a_i + c_i;
+      Block amcr = a_r - c_r, amci = a_i - c_i;
+      Block bpdr = b_r + d_r, bpdi = b_i + d_i;
+      Block jbmdr = d_i - b_i, jbmdi = b_r - d_r;
+
+      Block t1r = amcr - jbmdr, t1i = amci - jbmdi;
+      Block t2r = apcr - bpdr,  t2i = apci - bpdi;
+      Block t3r = amcr + jbmdr, t3i = amci + jbmdi;
+
+      store(y0r+q, apcr + bpdr);
+      store(y0i+q, apci + bpdi);
+      store(y1r+q, t1r*c1r - t1i*c1i);
+      store(y1i+q, t1r*c1i + t1i*c1r);
+      store(y2r+q, t2r*c2r - t2i*c2i);
+      store(y2i+q, t2r*c2i + t2i*c2r);
+      store(y3r+q, t3r*c3r - t3i*c3i);
+      store(y3i+q, t3r*c3i + t3i*c3r);
+    }
+  }
+}
+
+/**
+ * The butterfly of an odd radix R, on the elements of x which are @c xs
+ * apart, written to y @c ys apart and multiplied by the twiddle factors,
+ * which are @c ws apart. T is either a Real or a Block of Reals, and so is W,
+ * the type of the twiddle factors.
+ *
+ * The inputs are combined in symmetric pairs: x_j + x_{R-j} contributes to
+ * the real part of the DFT matrix (the cosines), and x_j - x_{R-j} to its
+ * imaginary part (the sines), which halves the number of multiplications.
+ */
+template <int R, typename T, typename W>
+static FFTN_INLINE void oddButterfly(const Real* xr, const Real* xi, int xs,
+                                     Real* yr, Real* yi, int ys,
+                                     const Real* cosines, const Real* sines,
+                                     const Real* wr, const Real* wi, int ws) {
+  const int H = (R-1) / 2;
+  T sumr[H], sumi[H], difr[H], difi[H];
+
+  T x0r = load<T>(xr), x0i = load<T>(xi);
+  T y0r = x0r, y0i = x0i;
+
+  FFTN_UNROLL
+  for (int j=1; j<=H; j++) {
+    T ar = load<T>(xr + j*xs),     ai = load<T>(xi + j*xs);
+    T br = load<T>(xr + (R-j)*xs), bi = load<T>(xi + (R-j)*xs);
+    sumr[j-1] = ar + br; sumi[j-1] = ai + bi;
+    difr[j-1] = ar - br; difi[j-1] = ai - bi;
+    y0r += sumr[j-1];    y0i += sumi[j-1];
+  }
+
+  store(yr, y0r);
+  store(yi, y0i);
+
+  FFTN_UNROLL
+  for (int k=1; k<=H; k++) {
+    // X[k] = A - iB and X[R-k] = A + iB
+    T ar = x0r + sumr[0]*cosines[k], ai = x0i + sumi[0]*cosines[k];
+    T br = difr[0]*sines[k],         bi = difi[0]*sines[k];
+
+    FFTN_UNROLL
+    for (int j=2; j<=H; j++) {
+      int n = (j*k) % R;
+      ar += sumr[j-1]*cosines[n]; ai += sumi[j-1]*cosines[n];
+      br += difr[j-1]*sines[n];   bi += difi[j-1]*sines[n];
+    }
+
+    T ukr = ar + bi, uki = ai - br;
+    T vkr = ar - bi, vki = ai + br;
+
+    W wkr = load<W>(wr + (k-1)*ws),   wki = load<W>(wi + (k-1)*ws);
+    W wnr = load<W>(wr + (R-k-1)*ws), wni = load<W>(wi + (R-k-1)*ws);
+
+    store(yr + k*ys, ukr*wkr - uki*wki);
+    store(yi + k*ys, ukr*wki + uki*wkr);
+    store(yr + (R-k)*ys, vkr*wnr - vki*wni);
+    store(yi + (R-k)*ys, vkr*wni + vki*wnr);
+  }
+}
+
+/**
+ * One Stockham pass of an odd radix R, same as radix4Pass(). The twiddle
+ * factors w^kp are at index (k-1)*length/R + p.
+ */
+template <int R>
+static FFTN_INLINE void oddPass(int length, int stride,
+                                const Real* __restrict xr, const Real* __restrict xi,
+                                Real* __restrict yr, Real* __restrict yi,
+                                const Real* wr, const Real* wi) {
+  const int m = length / R;
+  const int s = stride;
+
+  Real cosines[R], sines[R];
+  for (int n=0; n<R; n++) {
+    cosines[n] = (Real)cos(2*M_PI*n / R);
+    sines[n] = (Real)sin(2*M_PI*n / R);
+  }
+
+  if (s < BLOCK_SIZE) {
+    // first passes: the butterflies are computed on blocks of consecutive
+    // values of p, whose elements are gathered into contiguous arrays
+    Real ar[R*BLOCK_SIZE], ai[R*BLOCK_SIZE], br[R*BLOCK_SIZE], bi[R*BLOCK_SIZE];
+
+    for (int q=0; q<s; q++) {
+      int p = 0;
+      for (; p+BLOCK_SIZE<=m; p+=BLOCK_SIZE) {
+        FFTN_UNROLL
+        for (int j=0; j<R; j++) {
+          FFTN_UNROLL
+          for (int i=0; i<BLOCK_SIZE; i++) {
+            ar[j*BLOCK_SIZE + i] = xr[s*(p+i + j*m) + q];
+            ai[j*BLOCK_SIZE + i] = xi[s*(p+i + j*m) + q];
+          }
+        }
+        oddButterfly<R, Block, Block>(ar, ai, BLOCK_SIZE, br, bi, BLOCK_SIZE,
+                                      cosines, sines, wr+p, wi+p, m);
+        FFTN_UNROLL
+        for (int k=0; k<R; k++) {
+          FFTN_UNROLL
+          for (int i=0; i<BLOCK_SIZE; i++) {
+            yr[s*(R*(p+i) + k) + q] = br[k*BLOCK_SIZE + i];
+            yi[s*(R*(p+i) + k) + q] = bi[k*BLOCK_SIZE + i];
+          }
+        }
+      }
+      for (; p<m; p++) {
+        oddButterfly<R, Real, Real>(xr + s*p + q, xi + s*p + q, s*m,
+                                    yr + s*R*p + q, yi + s*R*p + q, s,
+                                    cosines, sines, wr+p, wi+p, m);
+      }
+    }
+    return;
+  }
+
+  for (int p=0; p<m; p++) {
+    const Real* ar = xr + s*p; const Real* ai = xi + s*p;
+    Real* br = yr + s*R*p;     Real* bi = yi + s*R*p;
+    int q = 0;
+
+    // the stride is not a multiple of 4 when the pass comes after another
+    // odd one, the remaining elements are then transformed one by one
+    for (; q+BLOCK_SIZE<=s; q+=BLOCK_SIZE) {
+      oddButterfly<R, Block, Real>(ar+q, ai+q, s*m, br+q, bi+q, s, cosines, sines, wr+p, wi+p, m);
+    }
+    for (; q<s; q++) {
+      oddButterfly<R, Real, Real>(ar+q, ai+q, s*m, br+q, bi+q, s, cosines, sines, wr+p, wi+p, m);
+    }
+  }
+}
+
+FFTN_KERNEL
+static void radix3Pass(int length, int stride, const Real* xr, const Real* xi,
+                       Real* yr, Real* yi, const Real* wr, const Real* wi) {
+  oddPass<3>(length, stride, xr, xi, yr, yi, wr, wi);
+}
+
+FFTN_KERNEL
+static void radix5Pass(int length, int stride, const Real* xr, const Real* xi,
+                       Real* yr, Real* yi, const Real* wr, const Real* wi) {
+  oddPass<5>(length, stride, xr, xi, yr, yi, wr, wi);
+}
+
+FFTN_KERNEL
+static void radix7Pass(int length, int stride, const Real* xr, const Real* xi,
+                       Real* yr, Real* yi, const Real* wr, const Real* wi) {
+  oddPass<7>(length, stride, xr, xi, yr, yi, wr, wi);
+}
+
+/**
+ * The last pass of the sizes which have an odd power of 2 as a factor, where
+ * the twiddle factor is 1.
+ */
+FFTN_KERNEL
+static void radix2Pass(int stride,
+                       const Real* __restrict xr, const Real* __restrict xi,
+                       Real* __restrict yr, Real* __restrict yi) {
+  const int s = stride;
+  int q = 0;
+
+  for (; q+BLOCK_SIZE<=s; q+=BLOCK_SIZE) {
+    Block ar = load(xr+q), ai = load(xi+q);
+    Block br = load(xr+q+s), bi = load(xi+q+s);
+    store(yr+q, ar + br);
+    store(yi+q, ai + bi);
+    store(yr+q+s, ar - br);
+    store(yi+q+s, ai - bi);
+  }
+
+  for (; q<s; q++) {
+    yr[q]   = xr[q] + xr[q+s];
+    yi[q]   = xi[q] + xi[q+s];
+    yr[q+s] = xr[q] - xr[q+s];
+    yi[q+s] = xi[q] - xi[q+s];
+  }
+}
+
+
+FFTNPlan::FFTNPlan(int size) : _size(size) {
+  if (size < 1) {
+    throw EssentiaException("FFTNPlan: size must be positive, got ", size);
+  }
+
+  // the radix-4 passes come first, so that the stride of all the passes but
+  // the first one is a multiple of 4, then the odd radices, and the radix-2
+  // pass of odd powers of 2 comes last, where it needs no twiddle factors
+  vector<int> radices;
+  int n = size;
+  while (n % 4 == 0) { radices.push_back(4); n /= 4; }
+  bool radix2 = (n % 2 == 0);
+  if (radix2) n /= 2;
+  const int oddRadices[] = { 3, 5, 7 };
+  for (int i=0; i<3; i++) {
+    while (n % oddRadices[i] == 0) { radices.push_back(oddRadices[i]); n /= oddRadices[i]; }
+  }
+  if (radix2) radices.push_back(2);
+
+  if (n != 1) {
+    initBluestein();
+    return;
+  }
+
+  int length = size;
+  int stride = 1;
+
+  for (int i=0; i<(int)radices.size(); i++) {
+    Pass pass;
+    pass.radix = radices[i];
+    pass.length = length;
+    pass.stride = stride;
+
+    int m = length / pass.radix;
+    pass.twiddleRe.resize((pass.radix-1)*m);
+    pass.twiddleIm.resize((pass.radix-1)*m);
+
+    for (int k=1; k<pass.radix; k++) {
+      for (int p=0; p<m; p++) {
+        double theta = -2*M_PI*k*p / length;
+        pass.twiddleRe[(k-1)*m + p] = (Real)cos(theta);
+        pass.twiddleIm[(k-1)*m + p] = (Real)sin(theta);
+      }
+    }
+
+    _passes.push_back(pass);
+    length /= pass.radix;
+    stride *= pass.radix;
+  }
+}
+
+
+/**
+ * Sets up Bluestein's algorithm, which computes the transform as the
+ * convolution of the signal multiplied by a chirp with the conjugate chirp,
+ * through power of 2 transforms of at least 2*size-1 points.
+ */
+void FFTNPlan::initBluestein() {
+  int length = 1;
+  while (length < 2*_size-1) length *= 2;
+  _bluestein = make_shared<const FFTNPlan>(length);
+
+  // exp(-i*pi*n^2/size), with n^2 reduced modulo 2*size to keep the angles
+  // accurate
+  _chirpRe.resize(_size);
+  _chirpIm.resize(_size);
+  for (int n=0; n<_size; n++) {
+    long long n2 = ((long long)n*n) % (2*(long long)_size);
+    double theta = -M_PI*n2 / _size;
+    _chirpRe[n] = (Real)cos(theta);
+    _chirpIm[n] = (Real)sin(theta);
+  }
+
+  // the conjugate chirp, wrapped around for the negative indices
+  _filterRe.assign(length, Real(0));
+  _filterIm.assign(length, Real(0));
+  for (int n=0; n<_size; n++) {
+    _filterRe[n] = _chirpRe[n];
+    _filterIm[n] = -_chirpIm[n];
+    if (n > 0) {
+      _filterRe[length-n] = _chirpRe[n];
+      _filterIm[length-n] = -_chirpIm[n];
+    }
+  }
+
+  vector<Real> workRe(length), workIm(length);
+  _bluestein->forward(&_filterRe[0], &_filterIm[0], &workRe[0], &workIm[0]);
+
+  // the normalization of the inverse transform is done once here
+  for (int n=0; n<length; n++) {
+    _filterRe[n] /= length;
+    _filterIm[n] /= length;
+  }
+}
+
+
+int FFTNPlan::nextFastSize(int size) {
+  if (size <= 8) {
+    int n = 1;
+    while (n < size) n *= 2;
+    return n;
+  }
+
+  for (int n=(size+7)/8*8; ; n+=8) {
+    int m = n;
+    while (m % 2 == 0) m /= 2;
+    while (m % 3 == 0) m /= 3;
+    while (m % 5 == 0) m /= 5;
+    while (m % 7 == 0) m /= 7;
+    if (m == 1) return n;
+  }
+}
+
+
+// the plans compute both directions, so they are all cached as forward plans
+shared_ptr<const FFTNPlan> FFTNPlan::cached(int size) {
+  return FFTPlanCache::get<FFTNPlan>("builtin", size, FFTPlanCache::Forward, false,
+                                     [size]() { return make_shared<FFTNPlan>(size); });
+}
+
+
+void FFTNPlan::forwardInterleaved(Real* re, Real* im, Real* workRe, Real* workIm, int lanes) const {
+  if (_bluestein) {
+    bluestein(re, im, workRe, workIm, lanes);
+    return;
+  }
+
+  Real* xr = re;     Real* xi = im;
+  Real* yr = workRe; Real* yi = workIm;
+
+  for (int i=0; i<(int)_passes.size(); i++) {
+    const Pass& pass = _passes[i];
+
+    // the twiddle factors only depend on the position in the sub-transforms,
+    // so interleaved signals are transformed as if the stride was larger
+    int stride = pass.stride * lanes;
+
+    const Real* wr = pass.twiddleRe.empty() ? 0 : &pass.twiddleRe[0];
+    const Real* wi = pass.twiddleIm.empty() ? 0 : &pass.twiddleIm[0];
+    const int m = pass.length / pass.radix;
+
+    switch (pass.radix) {
+      case 4:
+        radix4Pass(pass.length, stride, xr, xi, yr, yi,
+                   wr, wi, wr + m, wi + m, wr + 2*m, wi + 2*m);
+        break;
+      case 3: radix3Pass(pass.length, stride, xr, xi, yr, yi, wr, wi); break;
+      case 5: radix5Pass(pass.length, stride, xr, xi, yr, yi, wr, wi); break;
+      case 7: radix7Pass(pass.length, stride, xr, xi, yr, yi, wr, wi); break;
+      default: radix2Pass(stride, xr, xi, yr, yi); break;
+    }
+
+    swap(xr, yr);
+    swap(xi, yi);
+  }
+
+  // each pass ping-pongs between the arrays, the result might be in the work
+  // arrays
+  if (xr != re) {
+    memcpy(re, xr, _size*lanes*sizeof(Real));
+    memcpy(im, xi, _size*lanes*sizeof(Real));
+  }
+}
+
+
+void FFTNPlan::bluestein(Real* re, Real* im, Real* workRe, Real* workIm, int lanes) const {
+  const int length = _bluestein->size();
+  Real* ar = workRe; Real* ai = workIm;
+  Real* br = workRe + length*lanes; Real* bi = workIm + length*lanes;
+
+  // a = x * chirp, zero-padded
+  for (int n=0; n<_size; n++) {
+    const Real cr = _chirpRe[n], ci = _chirpIm[n];
+    for (int l=0; l<lanes; l++) {
+      const Real xr = re[n*lanes + l], xi = im[n*lanes + l];
+      ar[n*lanes + l] = xr*cr - xi*ci;
+      ai[n*lanes + l] = xr*ci + xi*cr;
+    }
+  }
+  fill(ar + _size*lanes, ar + length*lanes, Real(0));
+  fill(ai + _size*lanes, ai + length*lanes, Real(0));
+
+  // convolution with the conjugate chirp
+  _bluestein->forwardInterleaved(ar, ai, br, bi, lanes);
+
+  for (int n=0; n<length; n++) {
+    const Real fr = _filterRe[n], fi = _filterIm[n];
+    for (int l=0; l<lanes; l++) {
+      const Real xr = ar[n*lanes + l], xi = ai[n*lanes + l];
+      ar[n*lanes + l] = xr*fr - xi*fi;
+      ai[n*lanes + l] = xr*fi + xi*fr;
+    }
+  }
+
+  _bluestein->forwardInterleaved(ai, ar, bi, br, lanes);
+
+  // X = chirp * (a conv filter)
+  for (int n=0; n<_size; n++) {
+    const Real cr = _chirpRe[n], ci = _chirpIm[n];
+    for (int l=0; l<lanes; l++) {
+      const Real xr = ar[n*lanes + l], xi = ai[n*lanes + l];
+      re[n*lanes + l] = xr*cr - xi*ci;
+      im[n*lanes + l] = xr*ci + xi*cr;
+    }
+  }
+}
+
+
+RealFFTNPlan::RealFFTNPlan(int size) : _size(size), _plan(max(size/2, 1)) {
+  if (size < 2 || size % 2 != 0) {
+    throw EssentiaException("RealFFTNPlan: size must be even and non zero, got ", size);
+  }
+
+  int half = size / 2;
+  _twiddleRe.resize(half);
+  _twiddleIm.resize(half);
+  for (int k=0; k<half; k++) {
+    double theta = -2*M_PI*k / size;
+    _twiddleRe[k] = (Real)cos(theta);
+    _twiddleIm[k] = (Real)sin(theta);
+  }
+}
+
+
+shared_ptr<const RealFFTNPlan> RealFFTNPlan::cached(int size) {
+  return FFTPlanCache::get<RealFFTNPlan>("builtin", size, FFTPlanCache::Forward, true,
+                                         [size]() { return make_shared<RealFFTNPlan>(size); });
+}
+
+
+void RealFFTNPlan::forward(const Real* input, complex<Real>* output, Real* work) const {
+  const int half = _size / 2;
+  Real* zr = work;
+  Real* zi = work + half;
+
+  // the even samples go into the real part, the odd ones into the imaginary one
+  for (int k=0; k<half; k++) {
+    zr[k] = input[2*k];
+    zi[k] = input[2*k+1];
+  }
+
+  _plan.forward(zr, zi, work + 2*half, work + 2*half + _plan.workSize());
+  split(zr, zi, output);
+}
+
+
+void RealFFTNPlan::forwardBatch(const Real* input, int nframes, complex<Real>* output, Real* work) const {
+  const int half = _size / 2;
+  const int lanes = BATCH_LANES;
+  Real* zr = work;
+  Real* zi = work + half*lanes;
+
+  int frame = 0;
+  for (; frame+lanes <= nframes; frame += lanes) {
+    const Real* frames = input + frame*_size;
+
+    for (int k=0; k<half; k++) {
+      for (int l=0; l<lanes; l++) {
+        zr[k*lanes + l] = frames[l*_size + 2*k];
+        zi[k*lanes + l] = frames[l*_size + 2*k+1];
+      }
+    }
+
+    Real* workRe = work + 2*half*lanes;
+    Real* workIm = workRe + _plan.workSize()*lanes;
+    _plan.forwardInterleaved(zr, zi, workRe, workIm, lanes);
+
+    splitInterleaved(zr, zi, output + frame*(half+1));
+  }
+
+  // the remaining frames are transformed one by one
+  for (; frame<nframes; frame++) {
+    forward(input + frame*_size, output + frame*(half+1), work);
+  }
+}
+
+
+/**
+ * Same as split() for the BATCH_LANES interleaved transforms computed by
+ * forwardBatch(), processing the lanes in blocks.
+ */
+void RealFFTNPlan::splitInterleaved(const Real* zr, const Real* zi, complex<Real>* output) const {
+  const int half = _size / 2;
+  const int lanes = BATCH_LANES;
+  for (int l=0; l<lanes; l++) {
+    complex<Real>* out = output + l*(half+1);
+    out[0]    = complex<Real>(zr[l] + zi[l], 0);
+    out[half] = complex<Real>(zr[l] - zi[l], 0);
+  }
+
+  for (int k=1; k<half; k++) {
+    const Real* zkr = zr + k*lanes;        const Real* zki = zi + k*lanes;
+    const Real* znr = zr + (half-k)*lanes; const Real* zni = zi + (half-k)*lanes;
+    const Real wr = _twiddleRe[k], wi = _twiddleIm[k];
+
+    for (int l=0; l<lanes; l+=BLOCK_SIZE) {
+      Block er  = (load(zkr+l) + load(znr+l)) * Real(0.5);
+      Block ei  = (load(zki+l) - load(zni+l)) * Real(0.5);
+      Block or_ = (load(zki+l) + load(zni+l)) * Real(0.5);
+      Block oi  = (load(znr+l) - load(zkr+l)) * Real(0.5);
+
+      Block xr = er + or_*wr - oi*wi;
+      Block xi = ei + or_*wi + oi*wr;
+
+      for (int j=0; j<BLOCK_SIZE; j++) {
+        output[(l+j)*(half+1) + k] = complex<Real>(element(xr, j), element(xi, j));
+      }
+    }
+  }
+}
+
+
+/**
+ * Computes the spectrum of a real signal from the FFT Z of the complex signal
+ * made of its even and odd samples.
+ */
+void RealFFTNPlan::split(const Real* zr, const Real* zi, complex<Real>* output) const {
+  const int half = _size / 2;
+
+  output[0]    = complex<Real>(zr[0] + zi[0], 0);
+  output[half] = complex<Real>(zr[0] - zi[0], 0);
+
+  for (int k=1; k<half; k++) {
+    // even part E = (Z[k] + conj(Z[half-k])) / 2
+    // odd part  O = (Z[k] - conj(Z[half-k])) / 2i
+    Real er = (zr[k] + zr[half-k]) * Real(0.5);
+    Real ei = (zi[k] - zi[half-k]) * Real(0.5);
+    Real or_ = (zi[k] + zi[half-k]) * Real(0.5);
+    Real oi = (zr[half-k] - zr[k]) * Real(0.5);
+
+    // X[k] = E + w^k O
+    output[k] = complex<Real>(er + or_*_twiddleRe[k] - oi*_twiddleIm[k],
+                              ei + or_*_twiddleIm[k] + oi*_twiddleRe[k]);
+  }
+}
+
+
+void RealFFTNPlan::inverse(const complex<Real>* input, Real* output, Real* work) const {
+  const int half = _size / 2;
+  Real* zr = work;
+  Real* zi = work + half;
+
+  for (int k=0; k<half; k++) {
+    const complex<Real>& x = input[k];
+    const complex<Real>& y = input[half-k];
+
+    // 2E = X[k] + conj(X[half-k]), 2O = (X[k] - conj(X[half-k])) * w^-k
+    Real er = x.real() + y.real();
+    Real ei = x.imag() - y.imag();
+    Real dr = x.real() - y.real();
+    Real di = x.imag() + y.imag();
+    Real or_ = dr*_twiddleRe[k] + di*_twiddleIm[k];
+    Real oi = di*_twiddleRe[k] - dr*_twiddleIm[k];
+
+    // Z = 2E + 2iO
+    zr[k] = er - oi;
+    zi[k] = ei + or_;
+  }
+
+  // the imaginary parts of the DC and Nyquist bins are ignored
+  zi[0] = input[0].real() - input[half].real();
+  zr[0] = input[0].real() + input[half].real();
+
+  _plan.inverse(zr, zi, work + 2*half, work + 2*half + _plan.workSize());
+
+  for (int k=0; k<half; k++) {
+    output[2*k]   = zr[k];
+    output[2*k+1] = zi[k];
+  }
+}
+
+} // namespace essentia
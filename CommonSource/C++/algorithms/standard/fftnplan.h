@@ -0,0 +1,190 @@
+/*
+ * Copyright (C) 2006-2016  Music Technology Group - Universitat Pompeu Fabra
+ *
+ * This file is part of Essentia
+ *
+ * Essentia is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ */
+
+#ifndef ESSENTIA_FFTNPLAN_H
+#define ESSENTIA_FFTNPLAN_H
+
+#include <vector>
+#include <complex>
+#include <memory>
+#include "types.h"
+
+namespace essentia {
+
+/**
+ * Plan of the in-tree complex FFT used by the FFTN family of algorithms.
+ *
+ * The transform works on split complex arrays (real and imaginary parts in
+ * separate arrays) with mixed-radix Stockham autosort passes of radix 4, 3, 5
+ * and 7, plus a final radix-2 pass for odd powers of 2. The passes do not
+ * need any bit reversal and their inner loops run over contiguous arrays, so
+ * that they are vectorized by the compiler (SSE2 or AVX2, chosen at runtime,
+ * on x86-64 and NEON on ARM).
+ *
+ * Sizes which have a prime factor larger than 7 are transformed with
+ * Bluestein's algorithm, as a convolution computed with power of 2 transforms
+ * of at least twice the size. This is several times slower than a transform
+ * of a nearby size returned by nextFastSize().
+ *
+ * A plan only holds the twiddle factors and is never modified once created,
+ * the work buffers being given by the caller.
+ */
+class FFTNPlan {
+ public:
+  explicit FFTNPlan(int size);
+
+  int size() const { return _size; }
+
+  /**
+   * Returns the number of Reals needed for each of the work arrays.
+   */
+  int workSize() const { return _bluestein ? 2*_bluestein->size() : _size; }
+
+  /**
+   * Computes the forward transform of (re, im) in place. The work arrays must
+   * have workSize() elements each.
+   */
+  void forward(Real* re, Real* im, Real* workRe, Real* workIm) const {
+    forwardInterleaved(re, im, workRe, workIm, 1);
+  }
+
+  /**
+   * Computes the forward transforms of @c lanes signals at once, in place.
+   * The signals are interleaved: element i of signal l is at index
+   * i*lanes + l, so that each pass runs over all the signals in parallel. The
+   * signal arrays must have size()*lanes elements and the work arrays
+   * workSize()*lanes elements, and @c lanes must be 1 or a multiple of 4.
+   */
+  void forwardInterleaved(Real* re, Real* im, Real* workRe, Real* workIm, int lanes) const;
+
+  /**
+   * Computes the unnormalized inverse transform of (re, im) in place.
+   */
+  void inverse(Real* re, Real* im, Real* workRe, Real* workIm) const {
+    // swapping the real and imaginary parts turns a forward transform into
+    // an inverse one
+    forward(im, re, workIm, workRe);
+  }
+
+  static bool isPowerOfTwo(int size) { return size > 0 && (size & (size-1)) == 0; }
+
+  /**
+   * Returns the smallest size greater than or equal to @c size which is only
+   * made of the factors 2, 3, 5 and 7, and so does not need Bluestein's
+   * algorithm. Above 8, the size is a multiple of 8: the first pass is then a
+   * radix-4 one, even for the complex transform of half the size used by the
+   * real FFT, and all the following passes run on blocks, which makes these
+   * sizes about as fast per element as powers of 2.
+   */
+  static int nextFastSize(int size);
+
+  /**
+   * Returns the plan of the given size from the FFTPlanCache, shared by all
+   * the algorithms using the built-in FFT.
+   */
+  static std::shared_ptr<const FFTNPlan> cached(int size);
+
+ protected:
+  struct Pass {
+    int radix;
+    int length; // length of the sub-transforms in this pass
+    int stride;
+    // twiddle factors w^kp for k in [1, radix) and p in [0, length/radix),
+    // at index (k-1)*length/radix + p
+    std::vector<Real> twiddleRe, twiddleIm;
+  };
+
+  int _size;
+  std::vector<Pass> _passes;
+
+  // Bluestein's algorithm: the power of 2 plan of the convolution, the chirp
+  // exp(-i*pi*n^2/size), and the normalized transform of its conjugate
+  std::shared_ptr<const FFTNPlan> _bluestein;
+  std::vector<Real> _chirpRe, _chirpIm;
+  std::vector<Real> _filterRe, _filterIm;
+
+  void initBluestein();
+  void bluestein(Real* re, Real* im, Real* workRe, Real* workIm, int lanes) const;
+};
+
+
+/**
+ * Plan of the in-tree real FFT, for even sizes. A real signal of size N is
+ * transformed with a complex FFT of size N/2, whose output is then split into
+ * the spectrum of the even and odd samples.
+ */
+class RealFFTNPlan {
+ public:
+  explicit RealFFTNPlan(int size);
+
+  int size() const { return _size; }
+
+  /**
+   * Returns the number of Reals needed for the work buffer.
+   */
+  int workSize() const { return 2*(_size/2 + _plan.workSize()); }
+
+  /**
+   * Number of frames transformed together by forwardBatch().
+   */
+  static const int BATCH_LANES = 8;
+
+  /**
+   * Returns the number of Reals needed for the work buffer of forwardBatch().
+   */
+  int batchWorkSize() const { return workSize()*BATCH_LANES; }
+
+  /**
+   * Returns the plan of the given size from the FFTPlanCache.
+   */
+  static std::shared_ptr<const RealFFTNPlan> cached(int size);
+
+  /**
+   * Computes the size/2+1 positive frequencies of the spectrum of @c input.
+   */
+  void forward(const Real* input, std::complex<Real>* output, Real* work) const;
+
+  /**
+   * Computes the spectra of the @c nframes consecutive frames of size()
+   * samples in @c input, and writes them consecutively to @c output, with
+   * size/2+1 values per frame. The frames are transformed BATCH_LANES at a
+   * time, interleaved (see FFTNPlan::forwardInterleaved()).
+   */
+  void forwardBatch(const Real* input, int nframes, std::complex<Real>* output, Real* work) const;
+
+  /**
+   * Computes the unnormalized real signal whose positive frequencies are the
+   * size/2+1 values of @c input. The imaginary parts of the DC and Nyquist
+   * bins are ignored.
+   */
+  void inverse(const std::complex<Real>* input, Real* output, Real* work) const;
+
+ protected:
+  int _size;
+  FFTNPlan _plan;
+  // exp(-2*pi*i*k/size) for k in [0, size/2)
+  std::vector<Real> _twiddleRe, _twiddleIm;
+
+  void split(const Real* zr, const Real* zi, std::complex<Real>* output) const;
+  void splitInterleaved(const Real* zr, const Real* zi, std::complex<Real>* output) const;
+};
+
+} // namespace essentia
+
+#endif // ESSENTIA_FFTNPLAN_H
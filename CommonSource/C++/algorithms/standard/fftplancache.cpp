@@ -0,0 +1,120 @@
+/*
+ * Copyright (C) 2006-2016  Music Technology Group - Universitat Pompeu Fabra
+ *
+ * This file is part of Essentia
+ *
+ * Essentia is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ */
+
+#include <algorithm>
+#include "fftplancache.h"
+
+using namespace std;
+
+namespace essentia {
+
+const int FFTPlanCache::RecentPlans;
+ForcedMutex FFTPlanCache::_mutex;
+map<FFTPlanCache::Key, FFTPlanCache::Entry> FFTPlanCache::_plans;
+FFTPlanCache::RecentList FFTPlanCache::_recent;
+int FFTPlanCache::_sweepSize = 4 * FFTPlanCache::RecentPlans;
+
+
+shared_ptr<void> FFTPlanCache::find(const Key& key) {
+  ForcedMutexLocker lock(_mutex);
+
+  map<Key, Entry>::iterator it = _plans.find(key);
+  if (it == _plans.end()) return shared_ptr<void>();
+
+  shared_ptr<void> plan = it->second.plan.lock();
+  if (plan) touch(it, plan);
+  return plan;
+}
+
+
+shared_ptr<void> FFTPlanCache::insert(const Key& key, const shared_ptr<void>& plan) {
+  ForcedMutexLocker lock(_mutex);
+
+  map<Key, Entry>::iterator it = _plans.find(key);
+  if (it == _plans.end()) {
+    if ((int)_plans.size() >= _sweepSize) {
+      removeExpired();
+      _sweepSize = max(4 * RecentPlans, 2 * (int)_plans.size());
+    }
+    it = _plans.insert(make_pair(key, Entry(_recent.end()))).first;
+  }
+
+  // another thread may have built the same plan in the meantime
+  shared_ptr<void> result = it->second.plan.lock();
+  if (!result) {
+    result = plan;
+    it->second.plan = result;
+  }
+
+  touch(it, result);
+  return result;
+}
+
+
+void FFTPlanCache::touch(map<Key, Entry>::iterator entry, const shared_ptr<void>& plan) {
+  if (entry->second.recent != _recent.end()) {
+    _recent.splice(_recent.begin(), _recent, entry->second.recent);
+    return;
+  }
+
+  _recent.push_front(make_pair(entry->first, plan));
+  entry->second.recent = _recent.begin();
+
+  if ((int)_recent.size() > RecentPlans) {
+    map<Key, Entry>::iterator oldest = _plans.find(_recent.back().first);
+    oldest->second.recent = _recent.end();
+    _recent.pop_back();
+    // no algorithm uses the plan anymore, it has been freed
+    if (oldest->second.plan.expired()) _plans.erase(oldest);
+  }
+}
+
+
+void FFTPlanCache::removeExpired() {
+  map<Key, Entry>::iterator it = _plans.begin();
+  while (it != _plans.end()) {
+    // no algorithm uses the plan anymore, it has been freed
+    if (it->second.plan.expired()) _plans.erase(it++);
+    else ++it;
+  }
+}
+
+
+void FFTPlanCache::clear() {
+  ForcedMutexLocker lock(_mutex);
+
+  for (map<Key, Entry>::iterator it = _plans.begin(); it != _plans.end(); ++it) {
+    it->second.recent = _recent.end();
+  }
+  _recent.clear();
+  removeExpired();
+}
+
+
+int FFTPlanCache::size() {
+  ForcedMutexLocker lock(_mutex);
+
+  int count = 0;
+  for (map<Key, Entry>::const_iterator it = _plans.begin(); it != _plans.end(); ++it) {
+    if (!it->second.plan.expired()) count++;
+  }
+  return count;
+}
+
+} // namespace essentia
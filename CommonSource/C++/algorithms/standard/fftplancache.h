@@ -0,0 +1,133 @@
+/*
+ * Copyright (C) 2006-2016  Music Technology Group - Universitat Pompeu Fabra
+ *
+ * This file is part of Essentia
+ *
+ * Essentia is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ */
+
+#ifndef ESSENTIA_FFTPLANCACHE_H
+#define ESSENTIA_FFTPLANCACHE_H
+
+#include <list>
+#include <map>
+#include <memory>
+#include <string>
+#include "types.h"
+#include "threading.h"
+
+namespace essentia {
+
+/**
+ * Process-wide cache of FFT plans, shared by all the instances of the FFT
+ * algorithms, so that a plan is only built once per process for a given
+ * backend, size, direction and kind of transform (real or complex).
+ *
+ * Plans are reference-counted: the algorithms hold a shared pointer to the
+ * plan they use. The cache also keeps the RecentPlans most recently used
+ * plans, so that an algorithm reconfigured back to a size it used before does
+ * not build its plan again. The other plans are freed as soon as no algorithm
+ * uses them anymore.
+ *
+ * Plans are built without the cache being locked, so that the other plans can
+ * be looked up meanwhile. If two threads build the same plan at the same time,
+ * both get the one inserted first.
+ *
+ * As the same plan is used concurrently by several algorithms, possibly from
+ * several threads, a plan must not be modified once it has been built: all
+ * the buffers an FFT needs belong to the algorithm using it.
+ */
+class FFTPlanCache {
+ public:
+  enum Direction { Forward, Inverse };
+
+  /**
+   * Returns the plan for the given key, built with @\c create() (which returns
+   * a std::shared_ptr<Plan>) if it is not in the cache yet. A given backend
+   * must always use the same Plan type.
+   */
+  template <typename Plan, typename Create>
+  static std::shared_ptr<Plan> get(const std::string& backend, int size,
+                                   Direction direction, bool real,
+                                   Create create) {
+    Key key(backend, size, direction, real);
+
+    std::shared_ptr<void> plan = find(key);
+    if (!plan) plan = insert(key, create());
+
+    return std::static_pointer_cast<Plan>(plan);
+  }
+
+  /**
+   * Drops the recently used plans, so that only those used by an algorithm
+   * remain.
+   */
+  static void clear();
+
+  /**
+   * Returns the number of plans in the cache, ie: which are used by at least
+   * one algorithm or have been used recently.
+   */
+  static int size();
+
+  // the number of plans kept after their last algorithm has released them
+  static const int RecentPlans = 16;
+
+ protected:
+  struct Key {
+    std::string backend;
+    int size;
+    Direction direction;
+    bool real;
+
+    Key(const std::string& b, int s, Direction d, bool r) :
+      backend(b), size(s), direction(d), real(r) {}
+
+    bool operator<(const Key& other) const {
+      if (backend != other.backend) return backend < other.backend;
+      if (size != other.size) return size < other.size;
+      if (direction != other.direction) return direction < other.direction;
+      return real < other.real;
+    }
+  };
+
+  // the recently used plans, most recent first
+  typedef std::list<std::pair<Key, std::shared_ptr<void> > > RecentList;
+
+  struct Entry {
+    std::weak_ptr<void> plan;
+    // where the plan is in _recent, or _recent.end() if it is not there
+    RecentList::iterator recent;
+
+    Entry(RecentList::iterator r) : recent(r) {}
+  };
+
+  static ForcedMutex _mutex;
+  static std::map<Key, Entry> _plans;
+  static RecentList _recent;
+  // the number of entries from which the expired ones are dropped when adding
+  // a new one, so that dropping them is amortized over the insertions
+  static int _sweepSize;
+
+  static std::shared_ptr<void> find(const Key& key);
+  static std::shared_ptr<void> insert(const Key& key, const std::shared_ptr<void>& plan);
+
+  // must be called with _mutex locked
+  static void touch(std::map<Key, Entry>::iterator entry, const std::shared_ptr<void>& plan);
+  static void removeExpired();
+};
+
+} // namespace essentia
+
+#endif // ESSENTIA_FFTPLANCACHE_H
@@ -165,8 +165,16 @@ void FrameCutter::reset() {
 
   _audio.setAcquireSize(_frameSize);
   _audio.setReleaseSize(_hopSize);
-  _frames.setAcquireSize(1);
-  _frames.setReleaseSize(1);
+  setOutputSizes(1);
+}
+
+// derived algorithms may produce one token per frame on other outputs than
+// the frame one, so all the outputs always move together
+void FrameCutter::setOutputSizes(int size) {
+  for (int i=0; i<(int)_outputs.size(); i++) {
+    _outputs[i].second->setAcquireSize(size);
+    _outputs[i].second->setReleaseSize(size);
+  }
 }
 
 FrameCutter::SilenceType FrameCutter::typeFromString(const std::string& name) const {
@@ -253,8 +261,7 @@ AlgorithmStatus FrameCutter::process() {
     int howmuch = min(_startIndex - _streamIndex, skipSize);
     _audio.setAcquireSize(howmuch);
     _audio.setReleaseSize(howmuch);
-    _frames.setAcquireSize(0);
-    _frames.setReleaseSize(0);
+    setOutputSizes(0);
 
     if (acquireData() != OK) return NO_INPUT;
 
@@ -299,8 +306,7 @@ AlgorithmStatus FrameCutter::process() {
     }
   }
 
-  _frames.setAcquireSize(1);
-  _frames.setReleaseSize(1);
+  setOutputSizes(1);
   _audio.setAcquireSize(acquireSize);
   _audio.setReleaseSize(releaseSize);
 
@@ -386,6 +392,8 @@ AlgorithmStatus FrameCutter::process() {
     }
   }
 
+  processFrame(frame);
+
   EXEC_DEBUG("produced frame; releasing");
   releaseData();
   _streamIndex += _audio.releaseSize();
@@ -102,6 +102,15 @@ class FrameCutter : public Algorithm {
 
   SilenceType _silentFrames;
 
+  void setOutputSizes(int size);
+
+  /**
+   * Called on each frame produced, right before it is released. Derived
+   * algorithms can use it to compute their additional outputs from the frame
+   * without going through another buffer.
+   */
+  virtual void processFrame(std::vector<AudioSample>& /*frame*/) {}
+
 
  public:
   FrameCutter() {
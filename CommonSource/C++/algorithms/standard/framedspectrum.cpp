@@ -0,0 +1,76 @@
+/*
+ * Copyright (C) 2006-2016  Music Technology Group - Universitat Pompeu Fabra
+ *
+ * This file is part of Essentia
+ *
+ * Essentia is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ */
+
+#include "framedspectrum.h"
+
+using namespace std;
+
+namespace essentia {
+namespace streaming {
+
+const char* FramedSpectrum::name = "FramedSpectrum";
+const char* FramedSpectrum::category = "Spectral";
+const char* FramedSpectrum::description = DOC("This algorithm slices the input stream into frames, windows them and computes their magnitude spectrum. It outputs both the frames, exactly as the FrameCutter algorithm would, and their spectrum, which is identical to the one obtained by connecting FrameCutter, Windowing and Spectrum in a chain.\n"
+"\n"
+"As the frames are windowed and transformed as soon as they are cut, the spectrum is computed without the intermediate buffers, and the extra process() calls, of the chain. If the frames are not needed, their output should be connected to NOWHERE.\n"
+"\n"
+"The size of the spectrum is (frameSize + zeroPadding)/2 + 1. See FrameCutter, Windowing and Spectrum for the details of each step.");
+
+
+FramedSpectrum::FramedSpectrum() : FrameCutter() {
+  declareOutput(_spectrum, 1, "spectrum", "the magnitude spectrum of the windowed frames");
+
+  _windowing = standard::AlgorithmFactory::create("Windowing");
+  _spectrumAlgo = standard::AlgorithmFactory::create("Spectrum");
+}
+
+FramedSpectrum::~FramedSpectrum() {
+  delete _windowing;
+  delete _spectrumAlgo;
+}
+
+void FramedSpectrum::configure() {
+  FrameCutter::configure();
+
+  int zeroPadding = parameter("zeroPadding").toInt();
+
+  _windowing->configure("size", _frameSize,
+                        "zeroPadding", zeroPadding,
+                        "type", parameter("windowType"),
+                        "zeroPhase", parameter("zeroPhase"),
+                        "normalized", parameter("normalized"));
+  _spectrumAlgo->configure("size", _frameSize + zeroPadding);
+
+  // the windowed frame only lives between the two algorithms, so it can be
+  // allocated once and bound to both of them here
+  _windowedFrame.resize(_frameSize + zeroPadding);
+  _windowing->output("frame").set(_windowedFrame);
+  _spectrumAlgo->input("frame").set(_windowedFrame);
+}
+
+void FramedSpectrum::processFrame(vector<AudioSample>& frame) {
+  _windowing->input("frame").set(frame);
+  _windowing->compute();
+
+  _spectrumAlgo->output("spectrum").set(_spectrum.firstToken());
+  _spectrumAlgo->compute();
+}
+
+} // namespace streaming
+} // namespace essentia
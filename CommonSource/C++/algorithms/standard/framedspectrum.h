@@ -0,0 +1,62 @@
+/*
+ * Copyright (C) 2006-2016  Music Technology Group - Universitat Pompeu Fabra
+ *
+ * This file is part of Essentia
+ *
+ * Essentia is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ */
+
+#ifndef ESSENTIA_FRAMEDSPECTRUM_H
+#define ESSENTIA_FRAMEDSPECTRUM_H
+
+#include "framecutter.h"
+
+namespace essentia {
+namespace streaming {
+
+class FramedSpectrum : public FrameCutter {
+
+ protected:
+  Source<std::vector<Real> > _spectrum;
+
+  standard::Algorithm* _windowing;
+  standard::Algorithm* _spectrumAlgo;
+  std::vector<Real> _windowedFrame;
+
+  void processFrame(std::vector<AudioSample>& frame);
+
+ public:
+  FramedSpectrum();
+  ~FramedSpectrum();
+
+  void declareParameters() {
+    FrameCutter::declareParameters();
+    declareParameter("windowType", "the window type, which can be 'hamming', 'hann', 'triangular', 'square' or 'blackmanharrisXX'", "{hamming,hann,triangular,square,blackmanharris62,blackmanharris70,blackmanharris74,blackmanharris92}", "hann");
+    declareParameter("zeroPadding", "the size of the zero-padding of the windowed frame", "[0,inf)", 0);
+    declareParameter("zeroPhase", "a boolean value that enables zero-phase windowing", "{true,false}", true);
+    declareParameter("normalized", "a boolean value to specify whether to normalize windows (to have an area of 1) and then scale by a factor of 2", "{true,false}", true);
+  }
+
+  void configure();
+
+  static const char* name;
+  static const char* category;
+  static const char* description;
+
+};
+
+} // namespace streaming
+} // namespace essentia
+
+#endif // ESSENTIA_FRAMEDSPECTRUM_H
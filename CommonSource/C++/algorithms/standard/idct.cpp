@@ -37,9 +37,17 @@ const char* IDCT::description = DOC("This algorithm computes the Inverse Discret
 "Note: The 'inputSize' parameter is only used as an optimization when the algorithm is configured. "
 "The IDCT will automatically adjust to the size of any input.\n"
 "\n"
+"The IDCT is computed as a product with the IDCT matrix, or with an inverse FFT of the output size when there are many input coefficients and the output size is even, which is faster [3].\n"
+"\n"
 "References:\n"
 "  [1] Discrete cosine transform - Wikipedia, the free encyclopedia, http://en.wikipedia.org/wiki/Discrete_cosine_transform \n"
-"  [2] HTK book, chapter 5.6 , http://speech.ee.ntu.edu.tw/homework/DSP_HW2-1/htkbook.pdf");
+"  [2] HTK book, chapter 5.6 , http://speech.ee.ntu.edu.tw/homework/DSP_HW2-1/htkbook.pdf\n"
+"  [3] J. Makhoul, \"A fast cosine transform in one and two dimensions,\" IEEE Transactions on Acoustics, Speech, and Signal Processing, vol. 28, no. 1, pp. 27-34, 1980.");
+
+
+// Number of input coefficients from which the inverse FFT is faster than the
+// product with the IDCT matrix (see the DCT algorithm).
+static const int MIN_FFT_INPUT_SIZE = 32;
 
 
 void IDCT::configure() {
@@ -47,25 +55,37 @@ void IDCT::configure() {
   _outputSize = parameter("outputSize").toInt();
   _type = parameter("dctType").toInt();
   _lifter = parameter("liftering").toInt();
-  if (_type == 2){
-    createIDctTableII(inputSize, _outputSize);
+  createIDct(inputSize);
+}
+
+void IDCT::createIDct(int inputSize) {
+  if (_type != 2 && _type != 3) {
+    throw EssentiaException("IDCT: Bad DCT type.");
   }
-  else if (_type == 3){
-    createIDctTableIII(inputSize, _outputSize);
+
+  _inputSize = inputSize;
+  _idctTable.clear();
+  _plan.reset();
+
+  if (_outputSize % 2 == 0 && inputSize >= MIN_FFT_INPUT_SIZE) {
+    createIDctFFT(inputSize, _outputSize);
+  }
+  else if (_type == 2){
+    createIDctTableII(inputSize, _outputSize);
   }
   else {
-    throw EssentiaException("IDCT: Bad DCT type.");
+    createIDctTableIII(inputSize, _outputSize);
   }
 }
 
 void IDCT::createIDctTableII(int inputSize, int outputSize) {
-  // simple implementation using matrix multiplication, can probably be sped up
-  // using a library like FFTW, for instance.
+  // matrix multiplication, used for small numbers of input coefficients
+  // (see createIDctFFT() otherwise)
   if (outputSize < inputSize) {
     throw EssentiaException("IDCT: 'outputSize' is smaller than 'inputSize'. You can only compute the IDCT with an output size greater or equal than the input size");
   }
 
-  _idctTable = vector<vector<Real> >(outputSize, vector<Real>(inputSize));
+  _idctTable.resize(outputSize * inputSize);
 
   // scale for index = 0
   Real scale0 = 1.0 / sqrt(Real(outputSize));
@@ -79,19 +99,19 @@ void IDCT::createIDctTableII(int inputSize, int outputSize) {
     Real freqMultiplier = Real(M_PI / outputSize * i);
 
     for (int j=0; j<outputSize; ++j) {
-      _idctTable[j][i] = (Real)(scale * cos( freqMultiplier * ((Real)j + 0.5) ));
+      _idctTable[j*inputSize + i] = (Real)(scale * cos( freqMultiplier * ((Real)j + 0.5) ));
     }
   }
 }
 
 void IDCT::createIDctTableIII(int inputSize, int outputSize) {
-  // simple implementation using matrix multiplication, can probably be sped up
-  // using a library like FFTW, for instance.
+  // matrix multiplication, used for small numbers of input coefficients
+  // (see createIDctFFT() otherwise)
   if (outputSize < inputSize) {
     throw EssentiaException("IDCT: 'outputSize' is smaller than 'inputSize'. You can only compute the IDCT with an output size greater or equal than the input size");
   }
 
-  _idctTable = vector<vector<Real> >(outputSize, vector<Real>(inputSize));
+  _idctTable.resize(outputSize * inputSize);
   // This implementation is used instead of the referenced in order to match the behaviour of the HTK
   // http://speech.ee.ntu.edu.tw/homework/DSP_HW2-1/htkbook.pdf
 
@@ -101,19 +121,50 @@ void IDCT::createIDctTableIII(int inputSize, int outputSize) {
      Real freqMultiplier = Real(M_PI / outputSize * i);
      Real scale = (i == 0) ? scaleDefault/2 : scaleDefault;
      for (int j=0; j<outputSize; ++j) {
-       _idctTable[j][i] = (Real)(scale * cos( freqMultiplier * ( (Real)j + 0.5) ) );
+       _idctTable[j*inputSize + i] = (Real)(scale * cos( freqMultiplier * ( (Real)j + 0.5) ) );
 
      }
    }
 }
 
+void IDCT::createIDctFFT(int inputSize, int outputSize) {
+  if (outputSize < inputSize) {
+    throw EssentiaException("IDCT: 'outputSize' is smaller than 'inputSize'. You can only compute the IDCT with an output size greater or equal than the input size");
+  }
+
+  // same scales as the tables of both types, halved for the coefficients
+  // which appear twice in the spectrum given to the inverse FFT
+  double scale0 = (_type == 2) ? 1.0 / sqrt(double(outputSize)) : sqrt(2.0/outputSize) / 2;
+  double scale1 = sqrt(2.0/outputSize) / 2;
+
+  _weights.resize(inputSize);
+  for (int i=0; i<inputSize; ++i) {
+    _weights[i] = Real((i==0) ? scale0 : scale1);
+  }
+
+  int nbins = outputSize/2 + 1;
+  _twiddleRe.resize(nbins);
+  _twiddleIm.resize(nbins);
+  for (int k=0; k<nbins; ++k) {
+    double phase = M_PI * k / (2.0 * outputSize);
+    _twiddleRe[k] = Real(cos(phase));
+    _twiddleIm[k] = Real(sin(phase));
+  }
+
+  _plan = RealFFTNPlan::cached(outputSize);
+  _spectrum.resize(nbins);
+  _reordered.resize(outputSize);
+  _work.resize(_plan->workSize());
+}
+
 
 void IDCT::compute() {
 
   const vector<Real>& input = _dct.get();
   vector<Real>& idct = _idct.get();
 
-  vector<Real> dct = input;
+  _lifted = input;
+  vector<Real>& dct = _lifted;
 
   int inputSize = int(input.size());
 
@@ -121,18 +172,8 @@ void IDCT::compute() {
     throw EssentiaException("IDCT: input array cannot be of size 0");
   }
 
-  if (_idctTable.empty() ||
-      inputSize != int(_idctTable[0].size()) ||
-      _outputSize != int(_idctTable.size())) {
-    if (_type == 2){
-      createIDctTableII(inputSize, _outputSize);
-    }
-    else if (_type == 3){
-      createIDctTableIII(inputSize, _outputSize);
-    }
-    else {
-      throw EssentiaException("Bad DCT type.");
-    }
+  if (inputSize != _inputSize) {
+    createIDct(inputSize);
   }
 
   idct.resize(_outputSize);
@@ -144,10 +185,28 @@ void IDCT::compute() {
     }
   }
 
-  for (int j=0; j<_outputSize; ++j) {
-    idct[j] = 0.0;
-    for (int i=0; i<inputSize; ++i) {
-      idct[j] += dct[i] * _idctTable[j][i];
+  if (_plan) {
+    // the spectrum whose bin k is exp(i*pi*k/(2*N))*(a_k - i*a_(N-k)), a
+    // being the weighted input padded with zeros to N = outputSize values,
+    // has an inverse FFT made of the even output values followed by the odd
+    // ones reversed
+    int nbins = _outputSize/2 + 1;
+    for (int k=0; k<nbins; ++k) {
+      Real a = (k < inputSize) ? _weights[k] * dct[k] : 0;
+      Real b = (k > 0 && _outputSize-k < inputSize) ? _weights[_outputSize-k] * dct[_outputSize-k] : 0;
+      _spectrum[k] = complex<Real>(a*_twiddleRe[k] + b*_twiddleIm[k],
+                                   a*_twiddleIm[k] - b*_twiddleRe[k]);
+    }
+    _plan->inverse(&_spectrum[0], &_reordered[0], &_work[0]);
+
+    for (int j=0; j<_outputSize/2; ++j) {
+      idct[2*j] = _reordered[j];
+      idct[2*j+1] = _reordered[_outputSize-1-j];
+    }
+  }
+  else {
+    for (int j=0; j<_outputSize; ++j) {
+      idct[j] = dotProduct(&_idctTable[j*inputSize], &dct[0], inputSize);
     }
   }
 
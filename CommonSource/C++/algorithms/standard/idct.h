@@ -21,6 +21,8 @@
 #define ESSENTIA_IDCT_H
 
 #include "algorithm.h"
+#include "fftnplan.h"
+#include <complex>
 
 namespace essentia {
 namespace standard {
@@ -55,10 +57,24 @@ class IDCT : public Algorithm {
  protected:
   int _outputSize;
   Real _lifter;
+  int _inputSize;
+  void createIDct(int inputSize);
   void createIDctTableII(int inputSize, int outputSize);
   void createIDctTableIII(int inputSize, int outputSize);
-  std::vector<std::vector<Real> > _idctTable;
+  void createIDctFFT(int inputSize, int outputSize);
+  // outputSize rows of inputSize coefficients, one after the other
+  std::vector<Real> _idctTable;
   int _type;
+  std::vector<Real> _lifted;
+
+  // FFT path, used for large numbers of coefficients: the weight of each
+  // input coefficient, and exp(i*pi*k/(2*outputSize)) for the FFT bins k
+  std::shared_ptr<const RealFFTNPlan> _plan;
+  std::vector<Real> _weights;
+  std::vector<Real> _twiddleRe, _twiddleIm;
+  std::vector<std::complex<Real> > _spectrum;
+  std::vector<Real> _reordered;
+  std::vector<Real> _work;
 };
 
 } // namespace essentia
@@ -30,7 +30,7 @@ const char* IFFTA::description = DOC("This algorithm calculates the inverse shor
 "\n"
 "An exception is thrown if the input's size is not larger than 1.\n"
 "\n"
-"FFT computation will be carried out using the Accelerate Framework [3]"
+"FFT computation will be carried out using the Accelerate Framework [3] for sizes which are a power of 2, and using the built-in mixed-radix FFT otherwise."
 "\n"
 "References:\n"
 "  [1] Fast Fourier transform - Wikipedia, the free encyclopedia, http://en.wikipedia.org/wiki/Fft\n\n"
@@ -40,9 +40,6 @@ const char* IFFTA::description = DOC("This algorithm calculates the inverse shor
 
 
 IFFTA::~IFFTA() {
-  ForcedMutexLocker lock(FFTA::globalFFTAMutex);
-
-    vDSP_destroy_fftsetup(fftSetup);
     free(accelBuffer.realp);
     free(accelBuffer.imagp);
 }
@@ -57,11 +54,16 @@ void IFFTA::compute() {
   if (size <= 0) {
     throw EssentiaException("IFFT: Input size cannot be 0 or 1");
   }
-  if ((fftSetup == 0) ||
-      ((fftSetup != 0) && _fftPlanSize != size)) {
+  if ((!fftSetup && !_plan) || _fftPlanSize != size) {
     createFFTObject(size);
   }
 
+  if (_plan) {
+    signal.resize(size);
+    _plan->inverse(&fft[0], &signal[0], &_work[0]);
+    return;
+  }
+
     //Pack
     accelBuffer.realp[0] = fft[0].real();
     accelBuffer.imagp[0] = fft[fft.size()-1].real();
@@ -71,7 +73,7 @@ void IFFTA::compute() {
         accelBuffer.imagp[i] = fft[i].imag();
     }
 
-    vDSP_fft_zrip(fftSetup, &accelBuffer, 1, logSize, FFT_INVERSE);
+    vDSP_fft_zrip(fftSetup.get(), &accelBuffer, 1, logSize, FFT_INVERSE);
 
     // copy result from plan to output vector
     signal.resize(size);
@@ -84,7 +86,14 @@ void IFFTA::configure() {
 }
 
 void IFFTA::createFFTObject(int size) {
-  ForcedMutexLocker lock(FFTA::globalFFTAMutex);
+  if (!FFTNPlan::isPowerOfTwo(size)) {
+    _plan = RealFFTNPlan::cached(size);
+    _work.resize(_plan->workSize());
+    fftSetup.reset();
+    _fftPlanSize = size;
+    return;
+  }
+  _plan.reset();
 
     //Delete stuff before assigning
     free(accelBuffer.realp);
@@ -95,14 +104,7 @@ void IFFTA::createFFTObject(int size) {
 
     logSize = log2(size);
 
-    //With vDSP you only need to create a new fft if you've increased the size
-    if (fftSetup == nullptr) {
-        fftSetup = vDSP_create_fftsetup( logSize, 0 );
-    } else if(size > _fftPlanSize) {
-        vDSP_destroy_fftsetup(fftSetup);
-
-        fftSetup = vDSP_create_fftsetup( logSize, 0 );
-    }
+    fftSetup = FFTA::cachedSetup(size, true);
 
     _fftPlanSize = size;
 }
@@ -22,7 +22,9 @@
 
 #include "algorithm.h"
 #include "threading.h"
+#include "fftnplan.h"
 #include <complex>
+#include <memory>
 #include <Accelerate/Accelerate.h>
 
 namespace essentia {
@@ -39,7 +41,6 @@ class IFFTA : public Algorithm {
     declareInput(_fft, "fft", "the input frame");
     declareOutput(_signal, "frame", "the IFFT of the input frame");
       
-      fftSetup = NULL;
       accelBuffer.realp = NULL;
       accelBuffer.imagp = NULL;
       _fftPlanSize = 0;
@@ -64,7 +65,7 @@ class IFFTA : public Algorithm {
 //  std::complex<Real>* _input;
 //  Real* _output;
 
-    FFTSetup fftSetup;
+    std::shared_ptr<OpaqueFFTSetup> fftSetup;
     
     int logSize;
     
@@ -72,6 +73,11 @@ class IFFTA : public Algorithm {
     
     DSPSplitComplex accelBuffer;    
 
+  // vDSP only computes power of 2 transforms, the other sizes use the
+  // built-in FFT
+  std::shared_ptr<const RealFFTNPlan> _plan;
+  std::vector<Real> _work;
+
   void createFFTObject(int size);
 };
 
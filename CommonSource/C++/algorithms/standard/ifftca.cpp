@@ -19,6 +19,7 @@
 
 #include "ifftca.h"
 #include "fftca.h"
+#include "fftplancache.h"
 
 using namespace std;
 using namespace essentia;
@@ -30,7 +31,7 @@ const char* IFFTCA::description = DOC("This algorithm calculates the inverse sho
 "\n"
 "An exception is thrown if the input's size is not larger than 1.\n"
 "\n"
-"FFT computation will be carried out using the Accelerate Framework [3]"
+"FFT computation will be carried out using the Accelerate Framework [3] for sizes which are a power of 2, and using the built-in mixed-radix FFT otherwise."
 "\n"
 "References:\n"
 "  [1] Fast Fourier transform - Wikipedia, the free encyclopedia, http://en.wikipedia.org/wiki/Fft\n\n"
@@ -40,9 +41,6 @@ const char* IFFTCA::description = DOC("This algorithm calculates the inverse sho
 
 
 IFFTCA::~IFFTCA() {
-  ForcedMutexLocker lock(FFTCA::globalFFTCAMutex);
-
-    vDSP_DFT_DestroySetup(fftSetup);
     free(accelBuffer.realp);
     free(accelBuffer.imagp);
     free(outputBuffer.realp);
@@ -59,17 +57,32 @@ void IFFTCA::compute() {
   if (size <= 0) {
     throw EssentiaException("IFFTC: Input size cannot be 0 or 1");
   }
-  if ((fftSetup == 0) ||
-      ((fftSetup != 0) && _fftPlanSize != size)) {
+  if ((!fftSetup && !_plan) || _fftPlanSize != size) {
     createFFTObject(size);
   }
 
+  if (_plan) {
+    // the input is padded with zeros, as in the built-in IFFTC
+    for (int i=0; i<size; i++) {
+      accelBuffer.realp[i] = i < (int)fft.size() ? fft[i].real() : 0;
+      accelBuffer.imagp[i] = i < (int)fft.size() ? fft[i].imag() : 0;
+    }
+
+    _plan->inverse(accelBuffer.realp, accelBuffer.imagp, &_workRe[0], &_workIm[0]);
+
+    signal.resize(size);
+    for (int i=0; i<size; i++) {
+      signal[i] = complex<Real>(accelBuffer.realp[i], accelBuffer.imagp[i]);
+    }
+    return;
+  }
+
     for(int i=0; i<fft.size(); i++) {
         accelBuffer.realp[i] = fft[i].real();
         accelBuffer.imagp[i] = fft[i].imag();
     }
 
-    vDSP_DFT_Execute(fftSetup, accelBuffer.realp, accelBuffer.imagp, outputBuffer.realp, outputBuffer.imagp);
+    vDSP_DFT_Execute(fftSetup.get(), accelBuffer.realp, accelBuffer.imagp, outputBuffer.realp, outputBuffer.imagp);
 
     // copy result from plan to output vector
     signal.resize(size);
@@ -86,8 +99,6 @@ void IFFTCA::configure() {
 }
 
 void IFFTCA::createFFTObject(int size) {
-  ForcedMutexLocker lock(FFTCA::globalFFTCAMutex);
-
     //Delete stuff before assigning
     free(accelBuffer.realp);
     free(accelBuffer.imagp);
@@ -99,14 +110,22 @@ void IFFTCA::createFFTObject(int size) {
     outputBuffer.realp        = (float *) malloc(sizeof(float) * size);
     outputBuffer.imagp        = (float *) malloc(sizeof(float) * size);
 
-    logSize = log2(size);
+    if (!FFTNPlan::isPowerOfTwo(size)) {
+      _plan = FFTNPlan::cached(size);
+      _workRe.resize(_plan->workSize());
+      _workIm.resize(_plan->workSize());
+      fftSetup.reset();
+      _fftPlanSize = size;
+      return;
+    }
+    _plan.reset();
 
-    //With vDSP you only need to create a new fft if you've increased the size
-    if(size > _fftPlanSize) {
-        vDSP_DFT_DestroySetup(fftSetup);
+    logSize = log2(size);
 
-        fftSetup = vDSP_DFT_zop_CreateSetup(NULL, (vDSP_Length)size, vDSP_DFT_INVERSE);
-    }
+    fftSetup = FFTPlanCache::get<vDSP_DFT_SetupStruct>("accelerate_dft", size, FFTPlanCache::Inverse, false, [size]() {
+        return shared_ptr<vDSP_DFT_SetupStruct>(vDSP_DFT_zop_CreateSetup(NULL, (vDSP_Length)size, vDSP_DFT_INVERSE),
+                                                vDSP_DFT_DestroySetup);
+    });
 
     _fftPlanSize = size;
 }
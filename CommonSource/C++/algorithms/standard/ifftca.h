@@ -22,7 +22,9 @@
 
 #include "algorithm.h"
 #include "threading.h"
+#include "fftnplan.h"
 #include <complex>
+#include <memory>
 #include <Accelerate/Accelerate.h>
 
 namespace essentia {
@@ -39,7 +41,6 @@ class IFFTCA : public Algorithm {
     declareInput(_fft, "fft", "the input frame (complex)");
     declareOutput(_signal, "frame", "the IFFT of the input frame (complex)");
       
-      fftSetup = NULL;
       accelBuffer.realp = NULL;
       accelBuffer.imagp = NULL;
       outputBuffer.realp = NULL;
@@ -66,7 +67,7 @@ class IFFTCA : public Algorithm {
 //  std::complex<Real>* _input;
 //  Real* _output;
 
-    vDSP_DFT_Setup fftSetup;
+    std::shared_ptr<vDSP_DFT_SetupStruct> fftSetup;
     
     int logSize;
     
@@ -75,6 +76,11 @@ class IFFTCA : public Algorithm {
     DSPSplitComplex accelBuffer;
     DSPSplitComplex outputBuffer;
 
+  // vDSP only computes power of 2 transforms, the other sizes use the
+  // built-in FFT, on accelBuffer
+  std::shared_ptr<const FFTNPlan> _plan;
+  std::vector<Real> _workRe, _workIm;
+
   void createFFTObject(int size);
 };
 
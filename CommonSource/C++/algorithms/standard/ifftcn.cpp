@@ -0,0 +1,86 @@
+/*
+ * Copyright (C) 2006-2016  Music Technology Group - Universitat Pompeu Fabra
+ *
+ * This file is part of Essentia
+ *
+ * Essentia is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ */
+
+#include "ifftcn.h"
+
+using namespace std;
+using namespace essentia;
+using namespace standard;
+
+const char* IFFTCN::name = "IFFTC";
+const char* IFFTCN::category = "Standard";
+const char* IFFTCN::description = DOC("This algorithm calculates the inverse short-term Fourier transform (STFT) of an array of complex values using the FFT algorithm. The resulting frame has a size of (s-1)*2, where s is the size of the input fft frame, the input being padded with zeros. The inverse Fourier transform is not defined for frames which size is less than 2 samples. Otherwise an exception is thrown.\n"
+"\n"
+"An exception is thrown if the input's size is not larger than 1.\n"
+"\n"
+"FFT computation will be carried out using the built-in mixed-radix FFT, which does not need any external library. Sizes which only have 2, 3, 5 and 7 as prime factors are the fastest, other sizes are computed with Bluestein's algorithm.\n"
+"\n"
+"References:\n"
+"  [1] Fast Fourier transform - Wikipedia, the free encyclopedia, http://en.wikipedia.org/wiki/Fft\n\n"
+"  [2] Fast Fourier Transform -- from Wolfram MathWorld, http://mathworld.wolfram.com/FastFourierTransform.html");
+
+
+void IFFTCN::compute() {
+
+  const std::vector<std::complex<Real> >& fft = _fft.get();
+  std::vector<std::complex<Real> >& signal = _signal.get();
+
+  // check if input is OK
+  int size = ((int)fft.size()-1)*2;
+  if (size <= 0) {
+    throw EssentiaException("IFFTC: Input size cannot be 0 or 1");
+  }
+  if (!_plan || _plan->size() != size) {
+    createFFTObject(size);
+  }
+
+  for (int i=0; i<(int)fft.size(); i++) {
+    _re[i] = fft[i].real();
+    _im[i] = fft[i].imag();
+  }
+  fill(_re.begin() + fft.size(), _re.end(), Real(0));
+  fill(_im.begin() + fft.size(), _im.end(), Real(0));
+
+  _plan->inverse(&_re[0], &_im[0], &_workRe[0], &_workIm[0]);
+
+  signal.resize(size);
+  for (int i=0; i<size; i++) {
+    signal[i] = complex<Real>(_re[i], _im[i]);
+  }
+}
+
+void IFFTCN::configure() {
+  // the size is only a hint, unsupported sizes are reported when computing
+  int size = parameter("size").toInt();
+  if (size >= 2 && size % 2 == 0) {
+    createFFTObject(size);
+  }
+}
+
+void IFFTCN::createFFTObject(int size) {
+  if (size < 2 || size % 2 != 0) {
+    throw EssentiaException("IFFTC: can only compute IFFT of arrays which have an even size");
+  }
+
+  _plan = FFTNPlan::cached(size);
+  _re.resize(size);
+  _im.resize(size);
+  _workRe.resize(_plan->workSize());
+  _workIm.resize(_plan->workSize());
+}
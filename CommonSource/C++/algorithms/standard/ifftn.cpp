@@ -0,0 +1,74 @@
+/*
+ * Copyright (C) 2006-2016  Music Technology Group - Universitat Pompeu Fabra
+ *
+ * This file is part of Essentia
+ *
+ * Essentia is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ */
+
+#include "ifftn.h"
+
+using namespace std;
+using namespace essentia;
+using namespace standard;
+
+const char* IFFTN::name = "IFFT";
+const char* IFFTN::category = "Standard";
+const char* IFFTN::description = DOC("This algorithm calculates the inverse short-term Fourier transform (STFT) of an array of complex values using the FFT algorithm. The resulting frame has a size of (s-1)*2, where s is the size of the input fft frame. The inverse Fourier transform is not defined for frames which size is less than 2 samples. Otherwise an exception is thrown.\n"
+"\n"
+"An exception is thrown if the input's size is not larger than 1.\n"
+"\n"
+"The result is not normalized: the IFFT of the FFT of a frame is the frame multiplied by its size.\n"
+"\n"
+"FFT computation will be carried out using the built-in mixed-radix FFT, which does not need any external library. Sizes which only have 2, 3, 5 and 7 as prime factors are the fastest, other sizes are computed with Bluestein's algorithm.\n"
+"\n"
+"References:\n"
+"  [1] Fast Fourier transform - Wikipedia, the free encyclopedia, http://en.wikipedia.org/wiki/Fft\n\n"
+"  [2] Fast Fourier Transform -- from Wolfram MathWorld, http://mathworld.wolfram.com/FastFourierTransform.html");
+
+
+void IFFTN::compute() {
+
+  const std::vector<std::complex<Real> >& fft = _fft.get();
+  std::vector<Real>& signal = _signal.get();
+
+  // check if input is OK
+  int size = ((int)fft.size()-1)*2;
+  if (size <= 0) {
+    throw EssentiaException("IFFT: Input size cannot be 0 or 1");
+  }
+  if (!_plan || _plan->size() != size) {
+    createFFTObject(size);
+  }
+
+  signal.resize(size);
+  _plan->inverse(&fft[0], &signal[0], &_work[0]);
+}
+
+void IFFTN::configure() {
+  // the size is only a hint, unsupported sizes are reported when computing
+  int size = parameter("size").toInt();
+  if (size >= 2 && size % 2 == 0) {
+    createFFTObject(size);
+  }
+}
+
+void IFFTN::createFFTObject(int size) {
+  if (size < 2 || size % 2 != 0) {
+    throw EssentiaException("IFFT: can only compute IFFT of arrays which have an even size");
+  }
+
+  _plan = RealFFTNPlan::cached(size);
+  _work.resize(_plan->workSize());
+}
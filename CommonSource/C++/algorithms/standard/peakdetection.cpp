@@ -19,7 +19,6 @@
 
 #include "peakdetection.h"
 #include "essentiamath.h"
-#include "peak.h"
 
 using namespace essentia;
 using namespace standard;
@@ -42,16 +41,42 @@ void PeakDetection::configure() {
   _maxPeaks = parameter("maxPeaks").toInt();
   _range = parameter("range").toReal();
   _interpolate = parameter("interpolate").toBool();
-  _orderBy = parameter("orderBy").toLower();
+
+  std::string orderBy = parameter("orderBy").toLower();
+  if (orderBy == "position") {
+    _orderBy = Position;
+  }
+  else if (orderBy == "amplitude") {
+    _orderBy = Amplitude;
+  }
+  else {
+    throw EssentiaException("PeakDetection: Unsupported ordering type: '" + orderBy + "'");
+  }
 
   if (_minPos >= _maxPos) {
     throw EssentiaException("PeakDetection: The minimum position has to be less than the maximum position");
   }
+}
 
-  // blunt test to make sure some compiler which we won't name isn't going berserk...
-  std::vector<Peak> v;
-  v.resize(1);
-  assert(v.size() == 1);
+/**
+ * Returns the first index in [begin, end) whose value is above the threshold,
+ * or end if there is none. The values are tested by blocks of 8 without early
+ * exit, so that the test of a block is vectorized.
+ */
+int PeakDetection::nextAboveThreshold(const Real* array, int begin, int end, Real threshold) {
+  const int blockSize = 8;
+  int i = begin;
+  for (; i + blockSize <= end; i += blockSize) {
+    bool above = false;
+    for (int k=0; k<blockSize; k++) {
+      above |= array[i+k] > threshold;
+    }
+    if (above) break;
+  }
+  while (i < end && !(array[i] > threshold)) {
+    i++;
+  }
+  return i;
 }
 
 void PeakDetection::compute() {
@@ -71,8 +96,12 @@ void PeakDetection::compute() {
   // which makes more sense in general?
   const Real scale = _range / (Real)(size - 1);
 
-  std::vector<Peak> peaks;
-  peaks.reserve(size);
+  std::vector<Peak>& peaks = _peaks;
+  peaks.clear();
+
+  // peaks are found by ascending position, so when ordering by position the
+  // search stops as soon as there are enough of them
+  const int maxFoundPeaks = _orderBy == Position ? _maxPeaks : size;
 
   // we want to round up to the next integer instead of simple truncation,
   // otherwise the peak frequency at i can be lower than _minPos
@@ -86,6 +115,12 @@ void PeakDetection::compute() {
   }
 
   while(true) {
+    // a peak is above the threshold, so skip the values which are not: the
+    // search then climbs from the value before the first one which is
+    if (i+1 < size-1 && !(array[i+1] > _threshold)) {
+      i = nextAboveThreshold(&array[0], i+1, size-1, _threshold) - 1;
+    }
+
     // going down
     while (i+1 < size-1 && array[i] >= array[i+1]) {
       i++;
@@ -132,6 +167,9 @@ void PeakDetection::compute() {
         break;
 
       peaks.push_back(Peak(resultPos, resultVal));
+
+      if ((int)peaks.size() >= maxFoundPeaks)
+        break;
     }
 
     // nothing found, start loop again
@@ -167,18 +205,19 @@ void PeakDetection::compute() {
   // we only want this many peaks
   int nWantedPeaks = std::min((int)_maxPeaks, (int)peaks.size());
 
-  if (_orderBy == "amplitude") {
+  if (_orderBy == Amplitude) {
     // sort peaks by magnitude, in case of equality,
     // return the one having smaller position
-    std::sort(peaks.begin(), peaks.end(),
-              ComparePeakMagnitude<std::greater<Real>, std::less<Real> >());
-  }
-  else if (_orderBy == "position") {
-    // they're already sorted by position
-  }
-  else {
-    throw EssentiaException("PeakDetection: Unsupported ordering type: '" + _orderBy + "'");
+    ComparePeakMagnitude<std::greater<Real>, std::less<Real> > compare;
+
+    // only the wanted peaks need to be sorted: select them first, in linear
+    // time, when there are fewer of them than detected peaks
+    if (nWantedPeaks < (int)peaks.size()) {
+      std::nth_element(peaks.begin(), peaks.begin() + nWantedPeaks, peaks.end(), compare);
+    }
+    std::sort(peaks.begin(), peaks.begin() + nWantedPeaks, compare);
   }
+  // otherwise they're already sorted by position
 
   peakPosition.resize(nWantedPeaks);
   peakValue.resize(nWantedPeaks);
@@ -21,6 +21,7 @@
 #define ESSENTIA_PEAKDETECTION_H
 
 #include "algorithm.h"
+#include "peak.h"
 
 namespace essentia {
 namespace standard {
@@ -38,7 +39,11 @@ class PeakDetection : public Algorithm {
   int _maxPeaks;
   Real _range;
   bool _interpolate;
-  std::string _orderBy;
+  enum OrderBy { Position, Amplitude } _orderBy;
+
+  // the detected peaks, kept between calls so that compute() does not
+  // allocate once it has seen the largest number of peaks
+  std::vector<util::Peak> _peaks;
 
  public:
   PeakDetection() {
@@ -66,6 +71,7 @@ class PeakDetection : public Algorithm {
 
 private:
   void interpolate(const Real leftVal, const Real middleVal, const Real rightVal, int currentBin, Real& resultVal, Real& resultBin) const;
+  static int nextAboveThreshold(const Real* array, int begin, int end, Real threshold);
 
 };
 
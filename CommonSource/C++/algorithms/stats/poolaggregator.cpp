@@ -22,6 +22,10 @@
 #include "essentiamath.h"
 #include "essentiautil.h"
 #include "../../essentia/utils/tnt/tnt2essentiautils.h"
+#include <atomic>
+#include <exception>
+#include <memory>
+#include <thread>
 
 using namespace std;
 using namespace essentia;
@@ -60,18 +64,16 @@ const char* PoolAggregator::description = DOC("This algorithm performs statistic
 );
 
 
-// initialize supported statistics set
-const char* supportedStats[] =
+// names of the statistics, in the order of PoolAggregator::Statistic
+const char* statisticNames[] =
   {"min", "max", "median", "mean", "var", "stdev", "skew", "kurt",
    "dmean", "dvar", "dmean2", "dvar2",
    "cov", "icov",
    "copy", "value", "last"};
-vector<string> tmp = arrayToVector<string>(supportedStats);
-const set<string> PoolAggregator::_supportedStats(tmp.begin(), tmp.end());
 
 void addMatrixAsVectorVector(Pool& p, const string& key, const TNT::Array2D<Real>& mat) {
   for (int i=0; i<int(mat.dim1()); ++i) {
-    vector<Real> v(mat.dim1());
+    vector<Real> v(mat.dim2());
     for (int j=0; j<int(mat.dim2()); ++j) {
       v[j] = mat[i][j];
     }
@@ -79,48 +81,174 @@ void addMatrixAsVectorVector(Pool& p, const string& key, const TNT::Array2D<Real
   }
 }
 
+namespace {
 
-void PoolAggregator::aggregateSingleRealPool(const Pool& input, Pool& output) {
-  const map<string, Real>& realPool = input.getSingleRealPool();
+#define STAT(s) (1u << PoolAggregator::s)
 
-  for (map<string,Real>::const_iterator it = realPool.begin();
-       it != realPool.end();
-       ++it) {
-    string key = it->first;
-    Real data = it->second;
-    output.set(key, data);
+// statistics which need the mean, the central moments and the derivatives
+const unsigned int meanStats = STAT(Mean) | STAT(Var) | STAT(Stdev) | STAT(Skew) | STAT(Kurt);
+const unsigned int momentStats = STAT(Var) | STAT(Stdev) | STAT(Skew) | STAT(Kurt);
+const unsigned int derivativeStats = STAT(DMean) | STAT(DVar) | STAT(DMean2) | STAT(DVar2);
+const unsigned int secondDerivativeStats = STAT(DMean2) | STAT(DVar2);
+
+#undef STAT
+
+/**
+ * Computes the mean of the columns of @c frames, and the sums of the powers
+ * 2, 3 (if @c m3 is not null) and 4 (if @c m4 is not null) of the deviations
+ * from it, in a single pass over the frames after the one of meanFrames().
+ */
+void momentsFrames(const FrameMatrix& frames, vector<Real>& mean,
+                   vector<Real>& m2, vector<Real>* m3, vector<Real>* m4) {
+  mean = meanFrames(frames);
+  int vsize = (int)mean.size();
+
+  m2.assign(vsize, 0.0);
+  if (m3) m3->assign(vsize, 0.0);
+  if (m4) m4->assign(vsize, 0.0);
+
+  for (int i=0; i<frames.size(); i++) {
+    const Real* frame = frames[i];
+    for (int j=0; j<vsize; j++) {
+      Real diff = frame[j] - mean[j];
+      m2[j] += diff*diff;
+    }
+    if (m3) {
+      for (int j=0; j<vsize; j++) {
+        Real diff = frame[j] - mean[j];
+        (*m3)[j] += diff*diff*diff;
+      }
+    }
+    if (m4) {
+      for (int j=0; j<vsize; j++) {
+        Real diff = frame[j] - mean[j];
+        (*m4)[j] += diff*diff*diff*diff;
+      }
+    }
   }
 }
 
-void PoolAggregator::aggregateRealPool(const Pool& input, Pool& output) {
-  PoolOf(Real) realPool = input.getRealPool();
+// The descriptors of the Real and VectorReal pools are aggregated in two
+// steps: compute() computes the statistics of one descriptor, possibly on
+// another thread, and write() then adds them to the output pool, in the
+// order of the descriptors.
+
+struct RealAggregation {
+  const string* key;
+  const vector<Real>* data;
+  const PoolAggregator::Plan* plan;
+  Real values[PoolAggregator::NumberOfStatistics];
+  exception_ptr error;
+
+  void run() {
+    try { compute(); }
+    catch (...) { error = current_exception(); }
+  }
 
-  for (PoolOf(Real)::const_iterator it = realPool.begin();
-       it != realPool.end();
-       ++it) {
-    string key = it->first;
-    vector<Real> data = it->second;
-    int dsize = int(data.size());
+  void compute();
+  void write(Pool& output) const;
+};
+
+struct VectorRealAggregation {
+  const string* key;
+  const FrameMatrix* data;
+  const PoolAggregator::Plan* plan;
+  vector<Real> values[PoolAggregator::NumberOfStatistics];
+  vector<vector<Real> > cov, icov;
+  // computes cov and icov, created beforehand by the calling thread as the
+  // algorithm factory is not thread-safe
+  unique_ptr<Algorithm> singleGaussian;
+  exception_ptr error;
+
+  void run() {
+    try { compute(); }
+    catch (...) { error = current_exception(); }
+  }
 
-    // mean, variance, and standard deviation
+  void compute();
+  void write(Pool& output) const;
+};
+
+template <typename Task>
+void runTaskQueue(vector<Task>* tasks, atomic<size_t>* next) {
+  for (size_t i=(*next)++; i<tasks->size(); i=(*next)++) {
+    (*tasks)[i].run();
+  }
+}
+
+// runs the tasks on up to @c threads threads, including the calling one
+template <typename Task>
+void runTasks(vector<Task>& tasks, int threads) {
+  atomic<size_t> next(0);
+  vector<thread> workers;
+  int nWorkers = min(threads, (int)tasks.size()) - 1;
+  for (int t=0; t<nWorkers; t++) {
+    workers.push_back(thread(runTaskQueue<Task>, &tasks, &next));
+  }
+  runTaskQueue(&tasks, &next);
+  for (int t=0; t<(int)workers.size(); t++) {
+    workers[t].join();
+  }
+}
+
+// writes the statistics of the tasks, rethrowing the exception of the first
+// one which failed, after writing those of the descriptors before it
+template <typename Task>
+void writeTasks(const vector<Task>& tasks, Pool& output) {
+  for (int i=0; i<(int)tasks.size(); i++) {
+    if (tasks[i].error) rethrow_exception(tasks[i].error);
+    tasks[i].write(output);
+  }
+}
+
+void RealAggregation::compute() {
+  const vector<Real>& data = *this->data;
+  const PoolAggregator::Plan& plan = *this->plan;
+  int dsize = int(data.size());
+
+  if (plan.hasAny(meanStats)) {
     Real meanVal = mean(data);
-    Real varianceVal = variance(data, meanVal);
-    Real stdevVal = sqrt(varianceVal);
+    values[PoolAggregator::Mean] = meanVal;
 
-    // median
-    Real medianVal = median(data);
+    // variance, standard deviation, skewness and kurtosis from the central
+    // moments, computed in a single pass
+    if (plan.hasAny(momentStats)) {
+      Real m2 = 0.0, m3 = 0.0, m4 = 0.0;
+      for (int i=0; i<dsize; i++) {
+        Real temp = data[i] - meanVal;
+        m2 += temp * temp;
+        m3 += temp * temp * temp;
+        m4 += temp * temp * temp * temp;
+      }
+      m2 /= dsize; m3 /= dsize; m4 /= dsize;
+
+      Real skewnessVal = skewnessFromMoments(m2, m3);
+      if (std::isnan(skewnessVal) || std::isinf(skewnessVal)) skewnessVal = 0;
+      Real kurtosisVal = m4 / (m2*m2) - 3;
+      if (std::isnan(kurtosisVal) || std::isinf(kurtosisVal)) kurtosisVal = 0;
+
+      values[PoolAggregator::Var] = m2;
+      values[PoolAggregator::Stdev] = sqrt(m2);
+      values[PoolAggregator::Skew] = skewnessVal;
+      values[PoolAggregator::Kurt] = kurtosisVal;
+    }
+  }
 
-    // skewness and kurtosis
-    Real skewnessVal = skewness(data, meanVal);
-    Real kurtosisVal = kurtosis(data, meanVal);
+  if (plan.has(PoolAggregator::Median)) {
+    values[PoolAggregator::Median] = median(data);
+  }
 
-    // min and max
+  if (plan.has(PoolAggregator::Min) || plan.has(PoolAggregator::Max)) {
     Real minVal = data[0], maxVal = data[0];
     for (int i=1; i<dsize; ++i) {
       minVal = min(minVal, data[i]);
       maxVal = max(maxVal, data[i]);
     }
+    values[PoolAggregator::Min] = minVal;
+    values[PoolAggregator::Max] = maxVal;
+  }
 
+  if (plan.hasAny(derivativeStats)) {
     // derived mean & var
     vector<Real> derived(dsize > 1 ? dsize-1 : 1, 0.0);
     vector<Real> derived2(dsize > 2 ? dsize-2 : 1, 0.0);
@@ -132,257 +260,295 @@ void PoolAggregator::aggregateRealPool(const Pool& input, Pool& output) {
       derived2[i] = derived[i+1] - derived[i];
     }
 
-    Real dmeanVal, d2meanVal, dvarianceVal, d2varianceVal;
-
     // we need to perform the absolute value conversion before taking the
     // variance so that the mean and variance caclulation both use the absolute
     // value technique and thus consistent
     for (int i=0; i<(int)derived.size(); i++) derived[i] = abs(derived[i]);
     for (int i=0; i<(int)derived2.size(); i++) derived2[i] = abs(derived2[i]);
-    dmeanVal = mean(derived);
-    d2meanVal = mean(derived2);
-    dvarianceVal = variance(derived, mean(derived));
-    d2varianceVal = variance(derived2, mean(derived2));
-
-    // figure out which computed stats to add to the output pool
-    const vector<string>& stats = getStats(key);
-    for (int i=0; i<(int)stats.size(); ++i) {
-      if      (stats[i] == "mean")   output.set(key + ".mean", meanVal);
-      else if (stats[i] == "median") output.set(key + ".median", medianVal);
-      else if (stats[i] == "min")    output.set(key + ".min", minVal);
-      else if (stats[i] == "max")    output.set(key + ".max", maxVal);
-      else if (stats[i] == "var")    output.set(key + ".var", varianceVal);
-      else if (stats[i] == "stdev")  output.set(key + ".stdev", stdevVal);    
-      else if (stats[i] == "skew")   output.set(key + ".skew", skewnessVal);
-      else if (stats[i] == "kurt")   output.set(key + ".kurt", kurtosisVal);
-      else if (stats[i] == "dmean")  output.set(key + ".dmean", dmeanVal);
-      else if (stats[i] == "dvar")   output.set(key + ".dvar", dvarianceVal);
-      else if (stats[i] == "dmean2") output.set(key + ".dmean2", d2meanVal);
-      else if (stats[i] == "dvar2")  output.set(key + ".dvar2", d2varianceVal);
-      else if (stats[i] == "copy") {
-        for (int i=0; i<int(data.size()); ++i) {
-          output.add(key, data[i]);
-        }
-      }
-      else if (stats[i] == "value") {
-        string subkey = key + ".value";
-        for (int i=0; i<int(data.size()); ++i) {
-          output.add(subkey, data[i]);
-        }
-      }
-      else if (stats[i] == "last") {
-        output.set(key, data.back());
-      }
-    }
-  }
-}
-
-void PoolAggregator::aggregateSingleVectorRealPool(const Pool& input, Pool& output) {
-  const map<string, vector<Real> >& vectorRealPool = input.getSingleVectorRealPool();
-  for (map<string, vector<Real> >::const_iterator it = vectorRealPool.begin();
-       it != vectorRealPool.end();
-       ++it) {
 
-    string key = it->first;
-    vector<Real> data = it->second;
-    output.set(key, data);
+    Real dmeanVal = mean(derived);
+    Real d2meanVal = mean(derived2);
+    values[PoolAggregator::DMean] = dmeanVal;
+    values[PoolAggregator::DMean2] = d2meanVal;
+    values[PoolAggregator::DVar] = variance(derived, dmeanVal);
+    values[PoolAggregator::DVar2] = variance(derived2, d2meanVal);
   }
 }
 
-void PoolAggregator::aggregateVectorRealPool(const Pool& input, Pool& output) {
-  PoolOf(vector<Real>) vectorRealPool = input.getVectorRealPool();
-
-  for (PoolOf(vector<Real>)::const_iterator it = vectorRealPool.begin();
-       it != vectorRealPool.end();
-       ++it) {
-
-    string key = it->first;
-    vector<vector<Real> > data = it->second;
-    int dsize = (int)data.size();
-
-    if (dsize == 0) continue;
+void RealAggregation::write(Pool& output) const {
+  const string& key = *this->key;
+  const vector<Real>& data = *this->data;
+  const PoolAggregator::Plan& plan = *this->plan;
 
-    // if pool value consists of only one vector, don't perform aggregation,
-    // just add it to the output
-    //if (dsize == 1) {
-    //  output.add(key, data[0]);
-    //  continue;
-    //}
+  for (int i=0; i<(int)plan.stats.size(); ++i) {
+    switch (plan.stats[i]) {
+      case PoolAggregator::Copy:
+        for (int j=0; j<int(data.size()); ++j) output.add(key, data[j]);
+        break;
 
-    int vsize = (int)data[0].size();
+      case PoolAggregator::Value:
+        for (int j=0; j<int(data.size()); ++j) output.add(key + ".value", data[j]);
+        break;
 
-    // check if all the vectors are the same size, otherwise skip the descriptor
-    bool skipDescriptor = false;
-    for (int i=1; i<dsize; ++i) {
-      if ((int)data[i].size() != vsize) {
-        E_WARNING("PoolAggregator: not aggregating \"" << key << "\" because it has frames of different sizes");
-        skipDescriptor = true;
+      case PoolAggregator::Last:
+        output.set(key, data.back());
         break;
-      }
-    }
-    if (skipDescriptor) continue;
 
+      case PoolAggregator::Cov:
+      case PoolAggregator::ICov:
+        // only defined for vectors
+        break;
 
-    // mean & var
-    vector<Real> meanVals = meanFrames(data);
-    vector<Real> varVals = varianceFrames(data);
+      default:
+        output.set(key + "." + plan.names[i], values[plan.stats[i]]);
+    }
+  }
+}
 
-    // stdev
-    vector<Real> stdevVals(varVals);
-    std::transform(stdevVals.begin(), stdevVals.end(), stdevVals.begin(), static_cast<Real (*)(Real)>(std::sqrt));
+void VectorRealAggregation::compute() {
+  const FrameMatrix& data = *this->data;
+  const PoolAggregator::Plan& plan = *this->plan;
+  int dsize = data.size();
+  int vsize = data.width();
+
+  if (plan.hasAny(momentStats)) {
+    // mean, and the central moments computed in a single pass
+    vector<Real> m2, m3, m4;
+    momentsFrames(data, values[PoolAggregator::Mean], m2,
+                  plan.has(PoolAggregator::Skew) ? &m3 : 0,
+                  plan.has(PoolAggregator::Kurt) ? &m4 : 0);
+
+    vector<Real>& varVals = values[PoolAggregator::Var];
+    varVals.resize(vsize);
+    for (int j=0; j<vsize; j++) varVals[j] = m2[j] / dsize;
+
+    vector<Real>& stdevVals = values[PoolAggregator::Stdev];
+    stdevVals.resize(vsize);
+    for (int j=0; j<vsize; j++) stdevVals[j] = sqrt(varVals[j]);
+
+    if (plan.has(PoolAggregator::Skew)) {
+      vector<Real>& skewnessVals = values[PoolAggregator::Skew];
+      skewnessVals.resize(vsize);
+      for (int j=0; j<vsize; j++) skewnessVals[j] = skewnessFromMoments(varVals[j], m3[j] / dsize);
+    }
 
-    // median
-    vector<Real> medianVals = medianFrames(data);
+    if (plan.has(PoolAggregator::Kurt)) {
+      vector<Real>& kurtosisVals = values[PoolAggregator::Kurt];
+      kurtosisVals.resize(vsize);
+      for (int j=0; j<vsize; j++) kurtosisVals[j] = (m4[j] / dsize) / (varVals[j]*varVals[j]) - 3;
+    }
+  }
+  else if (plan.has(PoolAggregator::Mean)) {
+    values[PoolAggregator::Mean] = meanFrames(data);
+  }
 
-    // skewness & kurtosis
-    vector<Real> skewnessVals = skewnessFrames(data);
-    vector<Real> kurtosisVals = kurtosisFrames(data);
+  if (plan.has(PoolAggregator::Median)) {
+    values[PoolAggregator::Median] = medianFrames(data);
+  }
 
-    // min & max
-    vector<Real> minVals(vsize, 0.0), maxVals(vsize, 0.0);
-    for (int j=0; j<vsize; j++) minVals[j] = maxVals[j] = data[0][j]; // init values
+  if (plan.has(PoolAggregator::Min) || plan.has(PoolAggregator::Max)) {
+    vector<Real> minVals(data.frame(0)), maxVals(data.frame(0));
     for (int i=1; i<dsize; i++) {
       for (int j=0; j<vsize; j++) {
         minVals[j] = min(data[i][j], minVals[j]);
         maxVals[j] = max(data[i][j], maxVals[j]);
       }
     }
+    values[PoolAggregator::Min].swap(minVals);
+    values[PoolAggregator::Max].swap(maxVals);
+  }
 
+  if (plan.hasAny(derivativeStats)) {
     // derived mean & var
-    vector<vector<Real> > derived(dsize > 1 ? dsize-1 : 1, vector<Real>(vsize, 0.0));
-    vector<vector<Real> > derived2(dsize > 2 ? dsize-2 : 1, vector<Real>(vsize, 0.0));
+    FrameMatrix derived(dsize > 1 ? dsize-1 : 1, vsize);
 
     // first derivative
     for (int i=0; i<dsize-1; i++) {
       for (int j=0; j<vsize; j++) {
-        derived[i][j] += data[i+1][j] - data[i][j];
+        derived[i][j] = data[i+1][j] - data[i][j];
       }
     }
 
-    // second derivative
-    for (int i=0; i<dsize-2; i++) {
-      for (int j=0; j<vsize; j++) {
-        derived2[i][j] += derived[i+1][j] - derived[i][j];
+    if (plan.hasAny(secondDerivativeStats)) {
+      FrameMatrix derived2(dsize > 2 ? dsize-2 : 1, vsize);
+
+      // second derivative
+      for (int i=0; i<dsize-2; i++) {
+        for (int j=0; j<vsize; j++) {
+          derived2[i][j] = abs(derived[i+1][j] - derived[i][j]);
+        }
       }
+
+      vector<Real> m2;
+      momentsFrames(derived2, values[PoolAggregator::DMean2], m2, 0, 0);
+      for (int j=0; j<vsize; j++) m2[j] /= (Real)derived2.size();
+      values[PoolAggregator::DVar2].swap(m2);
     }
 
-    for (int i=0; i<int(derived.size()); i++) {
-      for (int j=0; j<int(derived[i].size()); j++) {
+    for (int i=0; i<derived.size(); i++) {
+      for (int j=0; j<vsize; j++) {
         derived[i][j] = abs(derived[i][j]);
       }
     }
 
-    for (int i=0; i<int(derived2.size()); i++) {
-      for (int j=0; j<int(derived2[i].size()); j++) {
-        derived2[i][j] = abs(derived2[i][j]);
+    vector<Real> m2;
+    momentsFrames(derived, values[PoolAggregator::DMean], m2, 0, 0);
+    for (int j=0; j<vsize; j++) m2[j] /= (Real)derived.size();
+    values[PoolAggregator::DVar].swap(m2);
+  }
+
+  // only compute cov and icov matrix if asked, because it could throw an
+  // exception if matrix is singular...
+  if (plan.has(PoolAggregator::Cov) || plan.has(PoolAggregator::ICov)) {
+    cov.resize(vsize);
+    icov.resize(vsize);
+
+    // create an Array2D and copy all the data values into it
+    TNT::Array2D<Real> frames(dsize, vsize);
+    for (int i=0; i<dsize; i++) {
+      for (int j=0; j<vsize; j++) {
+        frames[i][j] = data[i][j];
       }
     }
 
-    vector<Real> dmeanVals = meanFrames(derived);
-    vector<Real> d2meanVals = meanFrames(derived2);
-    vector<Real> dvarVals = varianceFrames(derived);
-    vector<Real> d2varVals = varianceFrames(derived2);
-
-    // only compute cov and icov matrix if asked, because it could throw an
-    // exception if matrix is singular...
-    const vector<string>& stats = getStats(key);
+    vector<Real> framesMean; // not used
+    TNT::Array2D<Real> covTnt, icovTnt;
+
+    Algorithm* sg = singleGaussian.get();
+    sg->input("matrix").set(frames);
+    sg->output("mean").set(framesMean);
+    sg->output("covariance").set(covTnt);
+    sg->output("inverseCovariance").set(icovTnt);
+
+    sg->compute();
+
+    // convert the Array2D back into vector<vector<Real> >
+    int covSize = covTnt.dim1();
+    for (int i=0; i<covSize; ++i) {
+      cov[i].resize(covSize);
+      icov[i].resize(covSize);
+      for (int j=0; j<covSize; ++j) {
+        cov[i][j] = covTnt[i][j];
+        icov[i][j] = icovTnt[i][j];
+      }
+    }
+  }
+}
 
-    vector<vector<Real> > cov(vsize), icov(vsize);
+void VectorRealAggregation::write(Pool& output) const {
+  const string& key = *this->key;
+  const FrameMatrix& data = *this->data;
+  const PoolAggregator::Plan& plan = *this->plan;
 
-    if (contains(stats, string("cov")) || contains(stats, string("icov"))) {
+  for (int i=0; i<(int)plan.stats.size(); ++i) {
+    string subkey = key + "." + plan.names[i];
 
-      // create an Array2D and copy all the data values into it
-      TNT::Array2D<Real> frames(dsize, vsize);
-      for (int i=0; i<dsize; i++) {
-        for (int j=0; j<vsize; j++) {
-          frames[i][j] = data[i][j];
-        }
-      }
+    switch (plan.stats[i]) {
+      case PoolAggregator::Cov:
+        for (int j=0; j<int(cov.size()); ++j) output.add(subkey, cov[j]);
+        break;
 
-      vector<Real> framesMean; // not used
-      TNT::Array2D<Real> covTnt, icovTnt;
+      case PoolAggregator::ICov:
+        for (int j=0; j<int(icov.size()); ++j) output.add(subkey, icov[j]);
+        break;
 
-      Algorithm* sg = AlgorithmFactory::create("SingleGaussian");
-      sg->input("matrix").set(frames);
-      sg->output("mean").set(framesMean);
-      sg->output("covariance").set(covTnt);
-      sg->output("inverseCovariance").set(icovTnt);
+      case PoolAggregator::Copy:
+        // don't use the subkey in this case, just key
+        for (int j=0; j<data.size(); ++j) output.add(key, data.frame(j));
+        break;
 
-      sg->compute();
+      case PoolAggregator::Value:
+        for (int j=0; j<data.size(); ++j) output.add(subkey, data.frame(j));
+        break;
 
-      delete sg;
+      case PoolAggregator::Last:
+        output.set(key, data.frame(data.size()-1));
+        break;
 
-      // convert the Array2D back into vector<vector<Real> >
-      //for (int i=0; i<dsize; ++i) {
-      int covSize = covTnt.dim1();
-      for (int i=0; i<covSize; ++i) {
-        cov[i].resize(covSize);
-        icov[i].resize(covSize);
-        for (int j=0; j<covSize; ++j) {
-          cov[i][j] = covTnt[i][j];
-          icov[i][j] = icovTnt[i][j];
-        }
+      default: {
+        const vector<Real>& vals = values[plan.stats[i]];
+        for (int j=0; j<int(vals.size()); ++j) output.add(subkey, vals[j]);
       }
     }
+  }
+}
 
-    // Now add all the computed statistics into the output pool
-    for (int i=0; i<(int)stats.size(); ++i) {
-      string subkey = key + "." + stats[i];
-
-      if (stats[i] == "mean")
-        for (int j=0; j<int(meanVals.size()); ++j) output.add(subkey, meanVals[j]);
+} // namespace
 
-      else if (stats[i] == "median")
-        for (int j=0; j<int(medianVals.size()); ++j) output.add(subkey, medianVals[j]);
-    
-      else if (stats[i] == "min")
-        for (int j=0; j<int(minVals.size()); ++j) output.add(subkey, minVals[j]);
 
-      else if (stats[i] == "max")
-        for (int j=0; j<int(maxVals.size()); ++j) output.add(subkey, maxVals[j]);
+void PoolAggregator::aggregateSingleRealPool(const Pool& input, Pool& output) {
+  const map<string, Real>& realPool = input.getSingleRealPool();
 
-      else if (stats[i] == "var")
-        for (int j=0; j<int(varVals.size()); ++j) output.add(subkey, varVals[j]);
+  for (map<string,Real>::const_iterator it = realPool.begin();
+       it != realPool.end();
+       ++it) {
+    output.set(it->first, it->second);
+  }
+}
 
-      else if (stats[i] == "stdev")
-        for (int j=0; j<int(stdevVals.size()); ++j) output.add(subkey, stdevVals[j]);
+void PoolAggregator::aggregateRealPool(const Pool& input, Pool& output) {
+  const PoolOf(Real)& realPool = input.getRealPool();
 
-      else if (stats[i] == "skew")
-        for (int j=0; j<int(skewnessVals.size()); ++j) output.add(subkey, skewnessVals[j]);
+  vector<RealAggregation> tasks(realPool.size());
+  int i = 0;
+  for (PoolOf(Real)::const_iterator it = realPool.begin();
+       it != realPool.end();
+       ++it, ++i) {
+    tasks[i].key = &it->first;
+    tasks[i].data = &it->second;
+    tasks[i].plan = &getPlan(it->first);
+  }
 
-      else if (stats[i] == "kurt")
-        for (int j=0; j<int(kurtosisVals.size()); ++j) output.add(subkey, kurtosisVals[j]);
+  runTasks(tasks, _threads);
+  writeTasks(tasks, output);
+}
 
-      else if (stats[i] == "dmean")
-        for (int j=0; j<int(dmeanVals.size()); ++j) output.add(subkey, dmeanVals[j]);
+void PoolAggregator::aggregateSingleVectorRealPool(const Pool& input, Pool& output) {
+  const map<string, vector<Real> >& vectorRealPool = input.getSingleVectorRealPool();
+  for (map<string, vector<Real> >::const_iterator it = vectorRealPool.begin();
+       it != vectorRealPool.end();
+       ++it) {
+    output.set(it->first, it->second);
+  }
+}
 
-      else if (stats[i] == "dvar")
-        for (int j=0; j<int(dvarVals.size()); ++j) output.add(subkey, dvarVals[j]);
+void PoolAggregator::aggregateVectorRealPool(const Pool& input, Pool& output) {
+  // the frames are read where the pool stores them, contiguously, which it
+  // cannot do for the descriptors whose frames have different sizes
+  const map<string, FrameMatrix>& framesPool = input.getVectorRealFramesPool();
+
+  vector<string> descNames = input.descriptorNames();
+  for (int i=0; i<(int)descNames.size(); ++i) {
+    if (framesPool.find(descNames[i]) == framesPool.end() &&
+        input.contains<vector<vector<Real> > >(descNames[i])) {
+      E_WARNING("PoolAggregator: not aggregating \"" << descNames[i] << "\" because it has frames of different sizes");
+    }
+  }
 
-      else if (stats[i] == "dmean2")
-        for (int j=0; j<int(d2meanVals.size()); ++j) output.add(subkey, d2meanVals[j]);
+  vector<VectorRealAggregation> tasks;
+  tasks.reserve(framesPool.size());
 
-      else if (stats[i] == "dvar2")
-        for (int j=0; j<int(d2varVals.size()); ++j) output.add(subkey, d2varVals[j]);
+  for (map<string, FrameMatrix>::const_iterator it = framesPool.begin();
+       it != framesPool.end();
+       ++it) {
 
-      else if (stats[i] == "cov")
-        for (int j=0; j<vsize; ++j) output.add(subkey, cov[j]);
+    const string& key = it->first;
+    const FrameMatrix& data = it->second;
 
-      else if (stats[i] == "icov")
-        for (int j=0; j<vsize; ++j) output.add(subkey, icov[j]);
+    if (data.empty()) continue;
 
-      else if (stats[i] == "copy")
-        // don't use the subkey in this case, just key
-        for (int j=0; j<int(data.size()); ++j) output.add(key, data[j]);
+    tasks.push_back(VectorRealAggregation());
+    tasks.back().key = &key;
+    tasks.back().data = &data;
+    tasks.back().plan = &getPlan(key);
 
-      else if (stats[i] == "value")
-        for (int j=0; j<int(data.size()); ++j) output.add(subkey, data[j]);
-      
-      else if (stats[i] == "last") {
-        output.set(key, data.back());
-      }
+    if (tasks.back().plan->has(Cov) || tasks.back().plan->has(ICov)) {
+      tasks.back().singleGaussian.reset(AlgorithmFactory::create("SingleGaussian"));
     }
   }
+
+  runTasks(tasks, _threads);
+  writeTasks(tasks, output);
 }
 
 
@@ -429,14 +595,14 @@ void PoolAggregator::aggregateVectorStringPool(const Pool& input, Pool& output)
 }
 
 void PoolAggregator::aggregateArray2DRealPool(const Pool& input, Pool& output) {
-  PoolOf(TNT::Array2D<Real>) Array2DRealPool = input.getArray2DRealPool();
+  const PoolOf(TNT::Array2D<Real>)& Array2DRealPool = input.getArray2DRealPool();
 
   for (PoolOf(TNT::Array2D<Real>)::const_iterator it = Array2DRealPool.begin();
        it != Array2DRealPool.end();
        ++it) {
 
-    string key = it->first;
-    vector<TNT::Array2D<Real> > data = it->second;
+    const string& key = it->first;
+    const vector<TNT::Array2D<Real> >& data = it->second;
     // get frames:
     int dsize = (int)data.size();
 
@@ -465,163 +631,168 @@ void PoolAggregator::aggregateArray2DRealPool(const Pool& input, Pool& output) {
     }
     if (skipDescriptor) continue;
 
-    // mean:
-    TNT::Array2D<Real> meanMat = meanMatrix(data);
-    // var:
-    TNT::Array2D<Real> varMat = varianceMatrix(data, meanMat);
+    const Plan& plan = getPlan(key);
+
+    TNT::Array2D<Real> meanMat, varMat;
+    if (plan.has(Mean) || plan.has(Var)) {
+      // mean:
+      meanMat = meanMatrix(data);
+      // var:
+      varMat = varianceMatrix(data, meanMat);
+    }
 
     // min & max: computes the minimum/maximum number at each position:
     TNT::Array2D<Real> minMat(dim1, dim2), maxMat(dim1, dim2);
-    for (int row=0; row<dim1; row++) {
-      for (int col=0; col<dim2; col++) {
-        minMat[row][col] = maxMat[row][col] = data[0][row][col]; // init values
-      }
-    }
-    for (int i=1; i<dsize; i++) {
+    if (plan.has(Min) || plan.has(Max)) {
       for (int row=0; row<dim1; row++) {
         for (int col=0; col<dim2; col++) {
-          minMat[row][col] = min(data[i][row][col], minMat[row][col]);
-          maxMat[row][col] = max(data[i][row][col], maxMat[row][col]);
+          minMat[row][col] = maxMat[row][col] = data[0][row][col]; // init values
+        }
+      }
+      for (int i=1; i<dsize; i++) {
+        for (int row=0; row<dim1; row++) {
+          for (int col=0; col<dim2; col++) {
+            minMat[row][col] = min(data[i][row][col], minMat[row][col]);
+            maxMat[row][col] = max(data[i][row][col], maxMat[row][col]);
+          }
         }
       }
     }
 
-    // derived mean & var
-    vector<TNT::Array2D<Real>* > derived(dsize > 1 ? dsize-1 : 1);
-    vector<TNT::Array2D<Real>* > derived2(dsize > 2 ? dsize-2 : 1);
+    TNT::Array2D<Real> dmeanMat, d2meanMat, dvarMat, d2varMat;
+    if (plan.hasAny((1u << DMean) | (1u << DVar) | (1u << DMean2) | (1u << DVar2))) {
+      // derived mean & var
+      vector<TNT::Array2D<Real>* > derived(dsize > 1 ? dsize-1 : 1);
+      vector<TNT::Array2D<Real>* > derived2(dsize > 2 ? dsize-2 : 1);
 
-    // first derivative
-    for (int i=0; i<dsize-1; i++) {
-      derived[i] = new TNT::Array2D<Real>(data[i+1] - data[i]);
-    }
+      // first derivative
+      for (int i=0; i<dsize-1; i++) {
+        derived[i] = new TNT::Array2D<Real>(data[i+1] - data[i]);
+      }
 
-    // second derivative
-    for (int i=0; i<dsize-2; i++) {
-        derived2[i] = new TNT::Array2D<Real>(*derived[i+1] - *derived[i]);
-    }
+      // second derivative
+      for (int i=0; i<dsize-2; i++) {
+          derived2[i] = new TNT::Array2D<Real>(*derived[i+1] - *derived[i]);
+      }
 
-    for (int i=0; i<int(derived.size()); i++) {
-      for (int row=0; row<derived[i]->dim1(); row++) {
-        for (int col=0; col<derived[i]->dim2(); col++) {
-          (*derived[i])[row][col] = abs((*derived[i])[row][col]);
+      for (int i=0; i<int(derived.size()); i++) {
+        for (int row=0; row<derived[i]->dim1(); row++) {
+          for (int col=0; col<derived[i]->dim2(); col++) {
+            (*derived[i])[row][col] = abs((*derived[i])[row][col]);
+          }
         }
       }
-    }
 
-    // this could be done in the nested for-loops from above.. should we?
-    for (int i=0; i<int(derived2.size()); i++) {
-      for (int row=0; row<derived2[i]->dim1(); row++) {
-        for (int col=0; col<derived2[i]->dim2(); col++) {
-          (*derived2[i])[row][col] = abs((*derived2[i])[row][col]);
+      // this could be done in the nested for-loops from above.. should we?
+      for (int i=0; i<int(derived2.size()); i++) {
+        for (int row=0; row<derived2[i]->dim1(); row++) {
+          for (int col=0; col<derived2[i]->dim2(); col++) {
+            (*derived2[i])[row][col] = abs((*derived2[i])[row][col]);
+          }
         }
       }
-    }
 
-    TNT::Array2D<Real> dmeanMat = meanMatrix(derived);
-    TNT::Array2D<Real> d2meanMat = meanMatrix(derived2);
-    TNT::Array2D<Real> dvarMat = varianceMatrix(derived, meanMatrix(derived));
-    TNT::Array2D<Real> d2varMat = varianceMatrix(derived2, meanMatrix(derived2));
+      dmeanMat = meanMatrix(derived);
+      d2meanMat = meanMatrix(derived2);
+      dvarMat = varianceMatrix(derived, dmeanMat);
+      d2varMat = varianceMatrix(derived2, d2meanMat);
 
-    for (int i=0; i<(int)derived.size(); i++) delete derived[i];
-    for (int i=0; i<(int)derived2.size(); i++) delete derived2[i];
+      for (int i=0; i<(int)derived.size(); i++) delete derived[i];
+      for (int i=0; i<(int)derived2.size(); i++) delete derived2[i];
+    }
 
     // cov and icov matrix : not implemented yet
-    const vector<string>& stats = getStats(key);
-
-    if (contains(stats, string("cov")) || contains(stats, string("icov"))) {
+    if (plan.has(Cov) || plan.has(ICov)) {
       E_WARNING("PoolAggregator: Covariance and inverse covariance for vectors of matrices are not yet implemented");
     }
 
     // Now add all the computed statistics into the output pool
-    for (int i=0; i<int(stats.size()); ++i) {
-      string subkey = key + "." + stats[i];
-      if (stats[i] == "mean") addMatrixAsVectorVector(output, subkey, meanMat);
-      else if (stats[i] == "median") { 
-        // TODO not implemented
-        E_WARNING("PoolAggregator: median is not implemented for Array2D");
-      }
-      else if (stats[i] == "min") addMatrixAsVectorVector(output, subkey, minMat);
-      else if (stats[i] == "max") addMatrixAsVectorVector(output, subkey, maxMat);
-      else if (stats[i] == "var") addMatrixAsVectorVector(output, subkey, varMat);
-      else if (stats[i] == "stdev") { 
-        // TODO not implemented
-        E_WARNING("PoolAggregator: stdev is not implemented for Array2D");
+    for (int i=0; i<int(plan.stats.size()); ++i) {
+      string subkey = key + "." + plan.names[i];
+      switch (plan.stats[i]) {
+        case Mean: addMatrixAsVectorVector(output, subkey, meanMat); break;
+        case Median:
+          // TODO not implemented
+          E_WARNING("PoolAggregator: median is not implemented for Array2D");
+          break;
+        case Min: addMatrixAsVectorVector(output, subkey, minMat); break;
+        case Max: addMatrixAsVectorVector(output, subkey, maxMat); break;
+        case Var: addMatrixAsVectorVector(output, subkey, varMat); break;
+        case Stdev:
+          // TODO not implemented
+          E_WARNING("PoolAggregator: stdev is not implemented for Array2D");
+          break;
+        case DMean: addMatrixAsVectorVector(output, subkey, dmeanMat); break;
+        case DVar: addMatrixAsVectorVector(output, subkey, dvarMat); break;
+        case DMean2: addMatrixAsVectorVector(output, subkey, d2meanMat); break;
+        case DVar2: addMatrixAsVectorVector(output, subkey, d2varMat); break;
+        case Cov:
+          // TODO not implemented
+          E_WARNING("PoolAggregator: cov is not implemented for Array2D");
+          break;
+        case ICov:
+          // TODO not implemented
+          E_WARNING("PoolAggregator: cov is not implemented for Array2D");
+          break;
+        case Copy:
+          for (int j=0; j<int(data.size()); ++j) output.add(key, data[j]);
+          break;
+        case Value:
+          for (int j=0; j<int(data.size()); ++j) output.add(subkey, data[j]);
+          break;
+        default:
+          break;
       }
-      else if (stats[i] == "dmean") addMatrixAsVectorVector(output, subkey, dmeanMat);
-      else if (stats[i] == "dvar") addMatrixAsVectorVector(output, subkey, dvarMat);
-      else if (stats[i] == "dmean2") addMatrixAsVectorVector(output, subkey, d2meanMat);
-      else if (stats[i] == "dvar2") addMatrixAsVectorVector(output, subkey, d2varMat);
-      else if (stats[i] == "cov") { 
-        // TODO not implemented
-        E_WARNING("PoolAggregator: cov is not implemented for Array2D");
-      }
-      else if (stats[i] == "icov") { 
-        // TODO not implemented
-        E_WARNING("PoolAggregator: cov is not implemented for Array2D");
-      }
-      else if (stats[i] == "copy")
-        for (int j=0; j<int(data.size()); ++j) output.add(key, data[j]);
-      else if (stats[i] == "value")
-        for (int j=0; j<int(data.size()); ++j) output.add(subkey, data[j]);
     }
   }
 }
 
 void PoolAggregator::configure() {
-  _defaultStats = parameter("defaultStats").toVectorString();
-  _exceptions = parameter("exceptions").toMapVectorString();
+  _defaultPlan = parsePlan(parameter("defaultStats").toVectorString());
+
+  // make sure there are no duplicate keys in 'exceptions'
+  // make sure there are no unsupported statistics in the values of 'exceptions'
+  _exceptionPlans.clear();
+  map<string, vector<string> > exceptions = parameter("exceptions").toMapVectorString();
+  for (map<string, vector<string> >::const_iterator it = exceptions.begin();
+       it != exceptions.end();
+       ++it) {
+    _exceptionPlans[it->first] = parsePlan(it->second);
+  }
+
+  _threads = parameter("threads").toInt();
+  if (_threads == 0) _threads = max(1, (int)thread::hardware_concurrency());
+}
 
-  // if the default stats includes the 'copy' statistical unit, make sure it
-  // is the only one
-  if (indexOf<string>(_defaultStats, "copy") != -1 &&
-      int(_defaultStats.size()) != 1) {
+PoolAggregator::Plan PoolAggregator::parsePlan(const vector<string>& stats) {
+  // if the stats include the 'copy' statistical unit, make sure it is the
+  // only one
+  if (indexOf<string>(stats, "copy") != -1 && int(stats.size()) != 1) {
     throw EssentiaException("PoolAggregator: the 'copy' aggregation statistic "
                             "is exclusive, it cannot be used with other "
                             "statistics for the same descriptor");
   }
 
-  if (indexOf<string>(_defaultStats, "last") != -1 &&
-      int(_defaultStats.size()) != 1) {
+  if (indexOf<string>(stats, "last") != -1 && int(stats.size()) != 1) {
     throw EssentiaException("PoolAggregator: the 'last' aggregation statistic "
                             "is exclusive, it cannot be used with other "
                             "statistics for the same descriptor");
   }
 
-  // make sure there are no unsupported statistics in 'defaultStats'
-  for (int i=0; i<(int)_defaultStats.size(); ++i) {
-    if (_supportedStats.find(_defaultStats[i]) == _supportedStats.end()) {
-      throw EssentiaException("PoolAggregator: unsupported aggregation statistic: '" + _defaultStats[i] + "'");
-    }
-  }
-
-  // make sure there are no duplicate keys in 'exceptions'
-  // make sure there are no unsupported statistics in the values of 'exceptions'
-  set<string> keys;
-  for (map<string, vector<string> >::const_iterator it = _exceptions.begin();
-       it != _exceptions.end();
-       ++it) {
-    const vector<string>& exceptionStats = it->second;
-
-    if (indexOf<string>(exceptionStats, "copy") != -1 &&
-        int(exceptionStats.size()) != 1) {
-      throw EssentiaException("PoolAggregator: the 'copy' aggregation statistic "
-                              "is exclusive, it cannot be used with other "
-                              "statistics for the same descriptor");
-    }
-
-    if (indexOf<string>(exceptionStats, "last") != -1 &&
-        int(exceptionStats.size()) != 1) {
-      throw EssentiaException("PoolAggregator: the 'last' aggregation statistic "
-                              "is exclusive, it cannot be used with other "
-                              "statistics for the same descriptor");
+  // make sure there are no unsupported statistics
+  Plan plan;
+  for (int i=0; i<(int)stats.size(); ++i) {
+    int stat = 0;
+    while (stat < NumberOfStatistics && stats[i] != statisticNames[stat]) stat++;
+    if (stat == NumberOfStatistics) {
+      throw EssentiaException("PoolAggregator: unsupported aggregation statistic: '" + stats[i] + "'");
     }
 
-    for (int i=0; i<(int)exceptionStats.size(); ++i) {
-      if (_supportedStats.find(exceptionStats[i]) == _supportedStats.end()) {
-        throw EssentiaException("PoolAggregator: unsupported aggregation statistic: '" + exceptionStats[i] + "'");
-      }
-    }
+    plan.names.push_back(stats[i]);
+    plan.stats.push_back(Statistic(stat));
+    plan.mask |= 1u << stat;
   }
+  return plan;
 }
 
 
@@ -639,11 +810,12 @@ void PoolAggregator::compute() {
 }
 
 
-const vector<string>& PoolAggregator::getStats(const string& key) const {
-  if (_exceptions.count(key) > 0) {
-    return (*(_exceptions.find(key))).second;
+const PoolAggregator::Plan& PoolAggregator::getPlan(const string& key) const {
+  map<string, Plan>::const_iterator it = _exceptionPlans.find(key);
+  if (it != _exceptionPlans.end()) {
+    return it->second;
   }
   else {
-    return _defaultStats;
+    return _defaultPlan;
   }
 }
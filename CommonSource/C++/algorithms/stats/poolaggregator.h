@@ -20,7 +20,6 @@
 #ifndef ESSENTIA_POOLAGGREGATOR_H
 #define ESSENTIA_POOLAGGREGATOR_H
 
-#include <set>
 #include "algorithm.h"
 #include "pool.h"
 
@@ -29,6 +28,30 @@ namespace standard {
 
 class PoolAggregator : public Algorithm {
 
+ public:
+  enum Statistic {
+    Min, Max, Median, Mean, Var, Stdev, Skew, Kurt,
+    DMean, DVar, DMean2, DVar2,
+    Cov, ICov,
+    Copy, Value, Last,
+    NumberOfStatistics
+  };
+
+  /**
+   * The statistics to compute for a descriptor, parsed once from their names
+   * in configure().
+   */
+  struct Plan {
+    std::vector<std::string> names;
+    std::vector<Statistic> stats;
+    unsigned int mask;
+
+    Plan() : mask(0) {}
+
+    bool has(Statistic stat) const { return (mask & (1u << stat)) != 0; }
+    bool hasAny(unsigned int stats) const { return (mask & stats) != 0; }
+  };
+
  protected:
   Input<Pool> _input;
   Output<Pool> _output;
@@ -41,11 +64,12 @@ class PoolAggregator : public Algorithm {
   void aggregateSingleStringPool(const Pool& input, Pool& output);
   void aggregateStringPool(const Pool& input, Pool& output);
   void aggregateVectorStringPool(const Pool& input, Pool& output);
-  const std::vector<std::string>& getStats(const std::string& key) const;
+  const Plan& getPlan(const std::string& key) const;
+  static Plan parsePlan(const std::vector<std::string>& stats);
 
-  std::vector<std::string> _defaultStats;
-  std::map<std::string, std::vector<std::string> > _exceptions;
-  static const std::set<std::string> _supportedStats;
+  Plan _defaultPlan;
+  std::map<std::string, Plan> _exceptionPlans;
+  int _threads;
 
  public:
   PoolAggregator() {
@@ -59,6 +83,7 @@ class PoolAggregator : public Algorithm {
 
     declareParameter("defaultStats", "the default statistics to be computed for each descriptor in the input pool", "", defaultStats);
     declareParameter("exceptions", "a mapping between descriptor names (no duplicates) and the types of statistics to be computed for those descriptors (e.g. { 14, lowlevel.gain : [var, min, dmean] })", "", std::map<std::string, std::vector<std::string> >());
+    declareParameter("threads", "the number of threads used to aggregate the descriptors in parallel (0 to use one thread per core)", "[0,inf)", 1);
   }
 
   void compute();
@@ -24,6 +24,22 @@ using namespace std;
 using namespace essentia;
 using namespace standard;
 
+namespace {
+
+// orders the (frame, peak index) of salient peaks by descending salience,
+// and then by ascending peak index
+class CompareSalience {
+  const vector<Real>& _values;
+ public:
+  CompareSalience(const vector<Real>& values) : _values(values) {}
+  bool operator()(const pair<size_t, size_t>& p1, const pair<size_t, size_t>& p2) const {
+    if (_values[p1.second] != _values[p2.second]) return _values[p1.second] > _values[p2.second];
+    return p1.second < p2.second;
+  }
+};
+
+} // namespace
+
 const char* PitchContours::name = "PitchContours";
 const char* PitchContours::category = "Pitch";
 const char* PitchContours::description = DOC("This algorithm tracks a set of predominant pitch contours of an audio signal. This algorithm is intended to receive its \"frequencies\" and \"magnitudes\" inputs from the PitchSalienceFunctionPeaks algorithm outputs aggregated over all frames in the sequence. The output is a vector of estimated melody pitch values.\n"
@@ -96,29 +112,16 @@ void PitchContours::compute() {
   // compute pitch contours
 
   // per-frame filtering
-  _salientPeaksBins.clear();
-  _salientPeaksValues.clear();
-  _nonSalientPeaksBins.clear();
-  _nonSalientPeaksValues.clear();
-
-  _salientPeaksBins.resize(_numberFrames);
-  _salientPeaksValues.resize(_numberFrames);
-  _nonSalientPeaksBins.resize(_numberFrames);
-  _nonSalientPeaksValues.resize(_numberFrames);
-
+  vector<Real> frameMinSalienceThresholds(_numberFrames, 0.0);
   vector<pair<size_t, size_t> > salientInFrame;
 
   for (size_t i=0; i<_numberFrames; i++) {
     if (peakSaliences[i].size() == 0) { // avoiding that argmax will return 0 on empty vector
       continue;
     }
-    Real frameMinSalienceThreshold = _peakFrameThreshold * peakSaliences[i][argmax(peakSaliences[i])];
+    frameMinSalienceThresholds[i] = _peakFrameThreshold * peakSaliences[i][argmax(peakSaliences[i])];
     for (size_t j=0; j<peakBins[i].size(); j++) {
-      if (peakSaliences[i][j] < frameMinSalienceThreshold) {
-        _nonSalientPeaksBins[i].push_back(peakBins[i][j]);
-        _nonSalientPeaksValues[i].push_back(peakSaliences[i][j]);
-      }
-      else {
+      if (peakSaliences[i][j] >= frameMinSalienceThresholds[i]) {
         salientInFrame.push_back(make_pair(i,j));
       }
     }
@@ -135,20 +138,41 @@ void PitchContours::compute() {
   Real salienceMean = mean(allPeakValues);
   Real overallMeanSalienceThreshold = salienceMean - stddev(allPeakValues, salienceMean) * _peakDistributionThreshold;
 
-  // distribution-based filtering
-  for (size_t i=0; i<salientInFrame.size(); i++) {
-    size_t ii = salientInFrame[i].first;
-    size_t jj = salientInFrame[i].second;
-    if (peakSaliences[ii][jj] < overallMeanSalienceThreshold) {
-      _nonSalientPeaksBins[ii].push_back(peakBins[ii][jj]);
-      _nonSalientPeaksValues[ii].push_back(peakSaliences[ii][jj]);
+  // distribution-based filtering: in each frame, the peaks below the
+  // per-frame threshold come first among the non-salient ones, followed by
+  // those below the overall threshold
+  _salientPeaks.clear();
+  _nonSalientPeaks.clear();
+  _salientPeaksOrder.clear();
+
+  for (size_t i=0; i<_numberFrames; i++) {
+    const vector<Real>& saliences = peakSaliences[i];
+
+    for (size_t j=0; j<saliences.size(); j++) {
+      if (saliences[j] < frameMinSalienceThresholds[i]) {
+        _nonSalientPeaks.add(peakBins[i][j], saliences[j]);
+      }
     }
-    else {
-      _salientPeaksBins[ii].push_back(peakBins[ii][jj]);
-      _salientPeaksValues[ii].push_back(peakSaliences[ii][jj]);
+    for (size_t j=0; j<saliences.size(); j++) {
+      if (saliences[j] < frameMinSalienceThresholds[i]) {
+        continue;
+      }
+      if (saliences[j] < overallMeanSalienceThreshold) {
+        _nonSalientPeaks.add(peakBins[i][j], saliences[j]);
+      }
+      else {
+        _salientPeaksOrder.push_back(make_pair(i, _salientPeaks.bins.size()));
+        _salientPeaks.add(peakBins[i][j], saliences[j]);
+      }
     }
+
+    _salientPeaks.endFrame();
+    _nonSalientPeaks.endFrame();
   }
 
+  sort(_salientPeaksOrder.begin(), _salientPeaksOrder.end(), CompareSalience(_salientPeaks.values));
+  _nextSalientPeak = 0;
+
   // peak streaming
   while(true) {
     size_t index = 0;
@@ -173,17 +197,17 @@ void PitchContours::compute() {
   }
 }
 
-int PitchContours::findNextPeak(vector<vector<Real> >& peaksBins, vector<Real>& contourBins, size_t i, bool backward) {
-  // order = 1 to search forewards, = -1 to search backwards
-  // i refers to a frame to search in for the next peak
+int PitchContours::findNextPeak(const PeakStore& peaks, Real previousBin, size_t i) {
+  // i refers to a frame to search in for the peak closest to previousBin
   Real distance;
   int best_peak_j = -1;
-  Real previousBin;
   Real bestPeakDistance = _pitchContinuityInBins;
 
-  for (size_t j=0; j<peaksBins[i].size(); j++) {
-    previousBin = backward ? contourBins.front() : contourBins.back();
-    distance = abs(previousBin - peaksBins[i][j]);
+  for (size_t j=peaks.frameBegin[i]; j<peaks.frameBegin[i+1]; j++) {
+    if (peaks.removed[j]) {
+      continue;
+    }
+    distance = abs(previousBin - peaks.bins[j]);
 
     if (distance < bestPeakDistance) {
       best_peak_j = (int)j;
@@ -193,51 +217,40 @@ int PitchContours::findNextPeak(vector<vector<Real> >& peaksBins, vector<Real>&
   return best_peak_j;
 }
 
-void PitchContours::removePeak(vector<vector<Real> >& peaksBins, vector<vector<Real> >& peaksValues, size_t i, int j) {
-  peaksBins[i].erase(peaksBins[i].begin() + j);
-  peaksValues[i].erase(peaksValues[i].begin() + j);
-}
-
 void PitchContours::trackPitchContour(size_t& index, vector<Real>& contourBins, vector<Real>& contourSaliences) {
-  // find the highest salient peak through all frames
-  size_t max_i = 0;
-  int max_j = 0;
-  Real maxSalience = 0;
-
-  for (size_t i=0; i<_numberFrames; i++) {
-    if (_salientPeaksValues[i].size() > 0) {
-      int j = argmax(_salientPeaksValues[i]);
-      if (_salientPeaksValues[i][j] > maxSalience) {
-        maxSalience = _salientPeaksValues[i][j];
-        max_i = i;
-        max_j = j;
-      }
-    }
+  // find the highest salient peak through all frames, which is the first one
+  // in _salientPeaksOrder not used by a contour yet
+  while (_nextSalientPeak < _salientPeaksOrder.size() &&
+         _salientPeaks.removed[_salientPeaksOrder[_nextSalientPeak].second]) {
+    _nextSalientPeak++;
   }
-  if (maxSalience == 0) {
+  if (_nextSalientPeak == _salientPeaksOrder.size() ||
+      _salientPeaks.values[_salientPeaksOrder[_nextSalientPeak].second] == 0) {
     // no salient peaks left in the set -> no new contours added
     return;
   }
+  size_t max_i = _salientPeaksOrder[_nextSalientPeak].first;
+  size_t max_j = _salientPeaksOrder[_nextSalientPeak].second;
 
   vector<pair<size_t,int> > removeNonSalientPeaks;
 
   // start new contour with this peak
   index = max_i; // the starting index of the contour
-  contourBins.push_back(_salientPeaksBins[index][max_j]);
-  contourSaliences.push_back(_salientPeaksValues[index][max_j]);
+  contourBins.push_back(_salientPeaks.bins[max_j]);
+  contourSaliences.push_back(_salientPeaks.values[max_j]);
   // remove the peak from salient peaks
-  removePeak(_salientPeaksBins, _salientPeaksValues, index, max_j);
+  _salientPeaks.removed[max_j] = true;
 
   // track forwards in time
   int gap=0, best_peak_j;
   for (size_t i=index+1; i<_numberFrames; i++) {
     // find salient peaks in the next frame
-    best_peak_j = findNextPeak(_salientPeaksBins, contourBins, i);
+    best_peak_j = findNextPeak(_salientPeaks, contourBins.back(), i);
     if (best_peak_j >= 0) {
       // salient peak was found
-      contourBins.push_back(_salientPeaksBins[i][best_peak_j]);
-      contourSaliences.push_back(_salientPeaksValues[i][best_peak_j]);
-      removePeak(_salientPeaksBins, _salientPeaksValues, i, best_peak_j);
+      contourBins.push_back(_salientPeaks.bins[best_peak_j]);
+      contourSaliences.push_back(_salientPeaks.values[best_peak_j]);
+      _salientPeaks.removed[best_peak_j] = true;
       gap = 0;
     }
     else {
@@ -247,10 +260,10 @@ void PitchContours::trackPitchContour(size_t& index, vector<Real>& contourBins,
         // this frame would already exceed the gap --> stop forward tracking
         break;
       }
-      best_peak_j = findNextPeak(_nonSalientPeaksBins, contourBins, i);
+      best_peak_j = findNextPeak(_nonSalientPeaks, contourBins.back(), i);
       if (best_peak_j >= 0) {
-        contourBins.push_back(_nonSalientPeaksBins[i][best_peak_j]);
-        contourSaliences.push_back(_nonSalientPeaksValues[i][best_peak_j]);
+        contourBins.push_back(_nonSalientPeaks.bins[best_peak_j]);
+        contourSaliences.push_back(_nonSalientPeaks.values[best_peak_j]);
         removeNonSalientPeaks.push_back(make_pair(i, best_peak_j));
         gap += 1;
       }
@@ -261,10 +274,8 @@ void PitchContours::trackPitchContour(size_t& index, vector<Real>& contourBins,
   }
   // remove all included non-salient peaks from the tail of the contour,
   // as the contour should always finish with a salient peak
-  for (int g=0; g<gap; g++) { // FIXME is using erase() faster?
-    contourBins.pop_back();
-    contourSaliences.pop_back();
-  }
+  contourBins.resize(contourBins.size() - gap);
+  contourSaliences.resize(contourSaliences.size() - gap);
 
   // track backwards in time
   if (index == 0) {
@@ -278,15 +289,22 @@ void PitchContours::trackPitchContour(size_t& index, vector<Real>& contourBins,
     return;
   }
 
+  // the peaks found backwards are appended here in reverse order, and
+  // inserted at the beginning of the contour at once
+  vector<Real> backwardBins;
+  vector<Real> backwardSaliences;
+
   gap = 0;
   for (size_t i=index-1;;) {
+    Real previousBin = backwardBins.empty() ? contourBins.front() : backwardBins.back();
+
     // find salient peaks in the previous frame
-    best_peak_j = findNextPeak(_salientPeaksBins, contourBins, i, true);
+    best_peak_j = findNextPeak(_salientPeaks, previousBin, i);
     if (best_peak_j >= 0) {
-      // salient peak was found, insert forward contourBins.insert(contourBins.begin(), _salientPeaksBins[i][best_peak_j]);
-      contourBins.insert(contourBins.begin(), _salientPeaksBins[i][best_peak_j]);
-      contourSaliences.insert(contourSaliences.begin(), _salientPeaksValues[i][best_peak_j]);
-      removePeak(_salientPeaksBins, _salientPeaksValues, i, best_peak_j);
+      // salient peak was found
+      backwardBins.push_back(_salientPeaks.bins[best_peak_j]);
+      backwardSaliences.push_back(_salientPeaks.values[best_peak_j]);
+      _salientPeaks.removed[best_peak_j] = true;
       index--;
       gap = 0;
     } else {
@@ -295,10 +313,10 @@ void PitchContours::trackPitchContour(size_t& index, vector<Real>& contourBins,
         // this frame would already exceed the gap --> stop backward tracking
         break;
       }
-      best_peak_j = findNextPeak(_nonSalientPeaksBins, contourBins, i, true);
+      best_peak_j = findNextPeak(_nonSalientPeaks, previousBin, i);
       if (best_peak_j >= 0) {
-        contourBins.insert(contourBins.begin(), _nonSalientPeaksBins[i][best_peak_j]);
-        contourSaliences.insert(contourSaliences.begin(), _nonSalientPeaksValues[i][best_peak_j]);
+        backwardBins.push_back(_nonSalientPeaks.bins[best_peak_j]);
+        backwardSaliences.push_back(_nonSalientPeaks.values[best_peak_j]);
         removeNonSalientPeaks.push_back(make_pair(i, best_peak_j));
         index--;
         gap += 1;
@@ -319,18 +337,19 @@ void PitchContours::trackPitchContour(size_t& index, vector<Real>& contourBins,
   }
   // remove non-salient peaks for the beginning of the contour,
   // as the contour should start with a salient peak
-  contourBins.erase(contourBins.begin(), contourBins.begin() + gap);
-  contourSaliences.erase(contourSaliences.begin(), contourSaliences.begin() + gap);
+  backwardBins.resize(backwardBins.size() - gap);
+  backwardSaliences.resize(backwardSaliences.size() - gap);
   index += gap;
 
+  contourBins.insert(contourBins.begin(), backwardBins.rbegin(), backwardBins.rend());
+  contourSaliences.insert(contourSaliences.begin(), backwardSaliences.rbegin(), backwardSaliences.rend());
+
   // remove all employed non-salient peaks for the list of available peaks
   for(size_t r=0; r<removeNonSalientPeaks.size(); r++) {
     size_t i_p = removeNonSalientPeaks[r].first;
     if (i_p < index || i_p > index + contourBins.size()) {
       continue;
     }
-    int j_p = removeNonSalientPeaks[r].second;
-    removePeak(_nonSalientPeaksBins, _nonSalientPeaksValues, i_p, j_p);
+    _nonSalientPeaks.removed[removeNonSalientPeaks[r].second] = true;
   }
 }
-
@@ -43,10 +43,40 @@ class PitchContours : public Algorithm {
   Real _peakDistributionThreshold;
   //Real _timeContinuity;
 
-  std::vector<std::vector<Real> > _salientPeaksBins;
-  std::vector<std::vector<Real> > _salientPeaksValues;
-  std::vector<std::vector<Real> > _nonSalientPeaksBins;
-  std::vector<std::vector<Real> > _nonSalientPeaksValues;
+  // peaks of all the frames, stored one frame after the other: the peaks of
+  // frame i are at indexes [frameBegin[i], frameBegin[i+1]). The peaks added
+  // to a contour are only marked as removed, so that the indexes of the
+  // other peaks do not change.
+  struct PeakStore {
+    std::vector<size_t> frameBegin;
+    std::vector<Real> bins;
+    std::vector<Real> values;
+    std::vector<bool> removed;
+
+    void clear() {
+      frameBegin.assign(1, 0);
+      bins.clear();
+      values.clear();
+      removed.clear();
+    }
+
+    void add(Real bin, Real value) {
+      bins.push_back(bin);
+      values.push_back(value);
+      removed.push_back(false);
+    }
+
+    void endFrame() { frameBegin.push_back(bins.size()); }
+  };
+
+  PeakStore _salientPeaks;
+  PeakStore _nonSalientPeaks;
+
+  // (frame, peak index) of the salient peaks, by descending salience, and
+  // the first one which may not have been removed yet: each contour starts
+  // from the highest salient peak left
+  std::vector<std::pair<size_t, size_t> > _salientPeaksOrder;
+  size_t _nextSalientPeak;
 
   Real _timeContinuityInFrames;
   Real _minDurationInFrames;
@@ -54,8 +84,7 @@ class PitchContours : public Algorithm {
   size_t _numberFrames;
   Real _frameDuration;
 
-  void removePeak(std::vector<std::vector<Real> >& peaksBins, std::vector<std::vector<Real> >& peaksValues, size_t i, int j);
-  int findNextPeak(std::vector<std::vector<Real> >& peaksBins, std::vector<Real>& contoursBins, size_t i, bool backward=false);
+  int findNextPeak(const PeakStore& peaks, Real previousBin, size_t i);
   void trackPitchContour(size_t& index, std::vector<Real>& contourBins, std::vector <Real>& contourSaliences);
 
  public:
@@ -130,9 +130,7 @@ namespace streaming {
 class PitchMelodia : public AlgorithmComposite {
 
  protected:
-  Algorithm* _frameCutter;
-  Algorithm* _windowing;
-  Algorithm* _spectrum;
+  Algorithm* _framedSpectrum;
   Algorithm* _spectralPeaks;
   Algorithm* _pitchSalienceFunction;
   Algorithm* _pitchSalienceFunctionPeaks;
@@ -154,7 +152,7 @@ class PitchMelodia : public AlgorithmComposite {
    ~PitchMelodia();
 
   void declareProcessOrder() {
-    declareProcessStep(ChainFrom(_frameCutter));
+    declareProcessStep(ChainFrom(_framedSpectrum));
     declareProcessStep(SingleShot(this));
   }
 
@@ -42,10 +42,22 @@ void PitchSalienceFunction::configure() {
     _harmonicWeights.push_back(pow(_harmonicWeight, h));
   }
 
+  // log2(frequency / (h+1)) = log2(frequency) - log2(h+1), so that the cent
+  // bins of all the sub-harmonics of a peak only need one log2
+  _harmonicBinOffsets.resize(_numberHarmonics);
+  for (int h=0; h<_numberHarmonics; h++) {
+    _harmonicBinOffsets[h] = _binsInOctave * log2(Real(h+1));
+  }
+
   _nearestBinsWeights.resize(_binsInSemitone + 1);
   for (int b=0; b <= _binsInSemitone; b++) {
     _nearestBinsWeights[b] = pow(cos((Real(b)/_binsInSemitone)* M_PI/2), 2);
   }
+
+  _spreadWeights.resize(2*_binsInSemitone + 1);
+  for (int b=-_binsInSemitone; b <= _binsInSemitone; b++) {
+    _spreadWeights[b + _binsInSemitone] = _nearestBinsWeights[abs(b)];
+  }
 }
 
 void PitchSalienceFunction::compute() {
@@ -86,31 +98,42 @@ void PitchSalienceFunction::compute() {
     if (magnitudes[i] <= minMagnitude) {
       continue;
     }
-    Real magnitudeFactor = pow(magnitudes[i], _magnitudeCompression);
+    Real magnitudeFactor = _magnitudeCompression == 1.0 ? magnitudes[i] : pow(magnitudes[i], _magnitudeCompression);
 
     // find all bins where this peak contributes salience
     // these bins are (sub)harmonics of the peak frequency
     // propagate salience to nearest bins within +- one semitone
 
+    // unrounded cent bin of the peak frequency. The +0.5 term is used instead
+    // of +1 (as in [1]) to center 0th bin to 55Hz:
+    // floor(1200 * log2(frequency / _referenceFrequency) / _binResolution + 0.5)
+    //    --> 1200 * (log2(frequency) - log2(_referenceFrequency)) / _binResolution + 0.5
+    //    --> 1200 * log2(frequency) / _binResolution + (0.5 - 1200 * log2(_referenceFrequency) / _binResolution)
+    Real peakBin = _binsInOctave * log2(frequencies[i]) + _referenceTerm;
+
     for (int h=0; h<_numberHarmonics; h++) {
-      int h_bin = frequencyToCentBin(frequencies[i] / (h+1));
+      int h_bin = (int) floor(peakBin - _harmonicBinOffsets[h]);
       if (h_bin < 0) {
         break;
       }
 
-      for(int b=max(0, h_bin-_binsInSemitone); b <= min(_numberBins-1, h_bin+_binsInSemitone); b++) {
-        salienceFunction[b] += magnitudeFactor * _nearestBinsWeights[abs(b-h_bin)] * _harmonicWeights[h];
+      // add the spread weights, scaled by the salience of this harmonic,
+      // to the bins from h_bin-_binsInSemitone to h_bin+_binsInSemitone
+      int bBegin = max(0, h_bin-_binsInSemitone);
+      int bEnd = min(_numberBins, h_bin+_binsInSemitone+1);
+      if (bBegin >= bEnd) {
+        continue;
+      }
+
+      Real harmonicSalience = magnitudeFactor * _harmonicWeights[h];
+      const Real* weights = &_spreadWeights[bBegin - h_bin + _binsInSemitone];
+      Real* salience = &salienceFunction[bBegin];
+
+      for (int b=0; b<bEnd-bBegin; b++) {
+        salience[b] += harmonicSalience * weights[b];
       }
     }
 
   }
 }
 
-int PitchSalienceFunction::frequencyToCentBin(Real frequency) {
-  // +0.5 term is used instead of +1 (as in [1]) to center 0th bin to 55Hz
-  // formula: floor(1200 * log2(frequency / _referenceFrequency) / _binResolution + 0.5)
-  //    --> 1200 * (log2(frequency) - log2(_referenceFrequency)) / _binResolution + 0.5
-  //    --> 1200 * log2(frequency) / _binResolution + (0.5 - 1200 * log2(_referenceFrequency) / _binResolution)
-  return floor(_binsInOctave * log2(frequency) + _referenceTerm);
-}
-
@@ -42,14 +42,14 @@ class PitchSalienceFunction : public Algorithm {
 
   std::vector<Real> _harmonicWeights;     // precomputed vector of weights for n-th harmonics
   std::vector<Real> _nearestBinsWeights;  // precomputed vector of weights for salience propagation to nearest bins
+  std::vector<Real> _spreadWeights;       // _nearestBinsWeights mirrored, for the bins from -_binsInSemitone to +_binsInSemitone
+  std::vector<Real> _harmonicBinOffsets;  // precomputed offsets in bins from a frequency to its sub-harmonics
   int _numberBins;
   int _binsInSemitone;                // number of bins in a semitone
   Real _binsInOctave;                 // number of bins in an octave
   Real _referenceTerm;                // precomputed addition term used for Hz to cent bin conversion
   Real _magnitudeThresholdLinear;     // fraction of maximum magnitude in frame corresponding to _magnitudeCompression difference in dBs
 
-  int frequencyToCentBin(Real frequency);
-
  public:
   PitchSalienceFunction() {
     declareInput(_frequencies, "frequencies", "the frequencies of the spectral peaks [Hz]");
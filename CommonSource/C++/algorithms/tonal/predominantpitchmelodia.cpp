@@ -260,9 +260,7 @@ namespace streaming {
 PredominantPitchMelodia::PredominantPitchMelodia() : AlgorithmComposite() {
 
   AlgorithmFactory& factory = AlgorithmFactory::instance();
-  _frameCutter                = factory.create("FrameCutter");
-  _windowing                  = factory.create("Windowing");
-  _spectrum                   = factory.create("Spectrum");
+  _framedSpectrum             = factory.create("FramedSpectrum");
   _spectralPeaks              = factory.create("SpectralPeaks");
   _pitchSalienceFunction      = factory.create("PitchSalienceFunction");
   _pitchSalienceFunctionPeaks = factory.create("PitchSalienceFunctionPeaks");
@@ -279,12 +277,11 @@ PredominantPitchMelodia::PredominantPitchMelodia() : AlgorithmComposite() {
   declareOutput(_pitchConfidence, "pitchConfidence", "confidence with which the pitch was detected");
 
   // Connect input proxy
-  _signal >> _frameCutter->input("signal");
+  _signal >> _framedSpectrum->input("signal");
 
   // Connect frame-wize algorithms
-  _frameCutter->output("frame")   >> _windowing->input("frame");
-  _windowing->output("frame")     >> _spectrum->input("frame");
-  _spectrum->output("spectrum")   >> _spectralPeaks->input("spectrum");
+  _framedSpectrum->output("frame")      >> NOWHERE;
+  _framedSpectrum->output("spectrum")   >> _spectralPeaks->input("spectrum");
 
   _spectralPeaks->output("frequencies")                 >> _pitchSalienceFunction->input("frequencies");
   _spectralPeaks->output("magnitudes")                  >> _pitchSalienceFunction->input("magnitudes");
@@ -292,7 +289,7 @@ PredominantPitchMelodia::PredominantPitchMelodia() : AlgorithmComposite() {
   _pitchSalienceFunctionPeaks->output("salienceBins")   >> PC(_pool, "internal.saliencebins");
   _pitchSalienceFunctionPeaks->output("salienceValues") >> PC(_pool, "internal.saliencevalues");
 
-  //_network = new scheduler::Network(_frameCutter);
+  //_network = new scheduler::Network(_framedSpectrum);
 
   // Connect track-wise algorithms // TODO It is yet not possible to stream
   // from a Pool, but it would be a nice option to add in the future. Currently,
@@ -347,16 +344,13 @@ void PredominantPitchMelodia::configure() {
   bool guessUnvoiced = parameter("guessUnvoiced").toBool();
 
   // Pre-processing
-  _frameCutter->configure("frameSize", frameSize,
-                          "hopSize", hopSize,
-                          "startFromZero", false);
+  _framedSpectrum->configure("frameSize", frameSize,
+                             "hopSize", hopSize,
+                             "startFromZero", false,
+                             "windowType", windowType,
+                             "zeroPadding", (zeroPaddingFactor-1) * frameSize);
 
-  _windowing->configure("size", frameSize,
-                        "zeroPadding", (zeroPaddingFactor-1) * frameSize,
-                        "type", windowType);
   // Spectral peaks
-  _spectrum->configure("size", frameSize * zeroPaddingFactor);
-
   _spectralPeaks->configure("minFrequency", 1,
                             "maxFrequency", 20000,
                             "maxPeaks", maxSpectralPeaks,
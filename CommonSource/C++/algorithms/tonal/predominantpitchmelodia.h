@@ -131,9 +131,7 @@ namespace streaming {
 class PredominantPitchMelodia : public AlgorithmComposite {
 
  protected:
-  Algorithm* _frameCutter;
-  Algorithm* _windowing;
-  Algorithm* _spectrum;
+  Algorithm* _framedSpectrum;
   Algorithm* _spectralPeaks;
   Algorithm* _pitchSalienceFunction;
   Algorithm* _pitchSalienceFunctionPeaks;
@@ -155,7 +153,7 @@ class PredominantPitchMelodia : public AlgorithmComposite {
    ~PredominantPitchMelodia();
 
   void declareProcessOrder() {
-    declareProcessStep(ChainFrom(_frameCutter));
+    declareProcessStep(ChainFrom(_framedSpectrum));
     declareProcessStep(SingleShot(this));
   }
 
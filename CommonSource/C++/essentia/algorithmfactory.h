@@ -141,6 +141,31 @@ class ESSENTIA_API EssentiaFactory {
     }
   };
 
+  /**
+   * Registers an algorithm in place of the one registered under the same name,
+   * without warning. This is meant for switching between several
+   * implementations of the same algorithm (see setFFTBackend()), whereas
+   * overwriting an algorithm with a Registrar is most probably a mistake.
+   */
+  template <typename ConcreteProduct, typename ReferenceConcreteProduct = ConcreteProduct>
+  static void replace() {
+    AlgorithmInfo<BaseAlgorithm> entry;
+    entry.create = &Registrar<ConcreteProduct, ReferenceConcreteProduct>::create;
+    entry.name = ReferenceConcreteProduct::name;
+    entry.description = ReferenceConcreteProduct::description;
+    entry.category = ReferenceConcreteProduct::category;
+
+    CreatorMap& algoMap = instance()._map;
+    if (algoMap.find(entry.name) != algoMap.end()) {
+      algoMap[entry.name] = entry;
+      E_DEBUG(EFactory, "Replaced registered algorithm " << entry.name);
+    }
+    else {
+      algoMap.insert(entry.name, entry);
+      E_DEBUG(EFactory, "Registered algorithm " << entry.name);
+    }
+  }
+
 
   static EssentiaFactory& instance();
 
@@ -67,6 +67,14 @@ namespace streaming {
   void ESSENTIA_API registerAlgorithm();
 }
 
+/**
+ * Selects the implementation of the FFT, IFFT, FFTC and IFFTC algorithms
+ * created from then on: "accelerate" for Apple's Accelerate framework, which
+ * is the default on Apple platforms, or "builtin" for the in-tree FFT, which
+ * is the default elsewhere. Must be called after init().
+ */
+void ESSENTIA_API setFFTBackend(const std::string& backend);
+
 class TypeMap {
  public:
 
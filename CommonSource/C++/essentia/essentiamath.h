@@ -137,6 +137,26 @@ template <typename T> T sum(const std::vector<T>& array) {
   return sum(array, 0, (int)array.size());
 }
 
+/**
+ * returns the dot product of the n values at x and y. The products are
+ * accumulated in 4 independent sums, so that the loop is vectorized.
+ */
+template <typename T> T dotProduct(const T* x, const T* y, int n) {
+  T sum[4] = { 0, 0, 0, 0 };
+  int i = 0;
+
+  for (; i+4<=n; i+=4) {
+    for (int k=0; k<4; k++) sum[k] += x[i+k] * y[i+k];
+  }
+
+  // do the rest of the loop
+  for (; i<n; i++) {
+    sum[0] += x[i] * y[i];
+  }
+
+  return (sum[0] + sum[1]) + (sum[2] + sum[3]);
+}
+
 /**
  * returns the mean of an array.
  */
@@ -206,6 +226,27 @@ std::vector<T> meanFrames(const std::vector<std::vector<T> >& frames, int beginI
   return result;
 }
 
+/**
+ * returns the median of a non-empty array, whose values are reordered. Only
+ * the middle values are selected, with nth_element(), instead of sorting the
+ * whole array.
+ */
+template <typename T> T medianInPlace(std::vector<T>& array) {
+  uint size = (unsigned int)array.size();
+  typename std::vector<T>::iterator middle = array.begin() + size/2;
+  std::nth_element(array.begin(), middle, array.end());
+
+  // array size is an even number: the other middle value is the largest one
+  // before it
+  if (size % 2 == 0) {
+    return (*std::max_element(array.begin(), middle) + *middle) / 2;
+  }
+  // array size is an odd number
+  else {
+    return *middle;
+  }
+}
+
 // returns the median of frames
 template <typename T>
 std::vector<T> medianFrames(const std::vector<std::vector<T> >& frames, int beginIdx=0, int endIdx=-1) {
@@ -230,16 +271,41 @@ std::vector<T> medianFrames(const std::vector<std::vector<T> >& frames, int begi
     for (; it!=end; ++it) {
       temp.push_back((*it)[i]);
     }
-    std::sort(temp.begin(), temp.end());
+    result[i] = medianInPlace(temp);
+  }
+  return result;
+}
 
-    // array size is an odd number
-    if (fsize % 2 == 0.0) {
-      result[i] = (temp[uint(fsize/2 - 1)] + temp[uint(fsize/2)]) / 2;
-    }
-    // array size is an even number
-    else {
-      result[i] = temp[uint(fsize/2)];
-    }
+// returns the mean of frames stored contiguously
+inline std::vector<Real> meanFrames(const FrameMatrix& frames) {
+  if (frames.empty()) {
+    throw EssentiaException("trying to calculate mean of empty array of frames");
+  }
+
+  int vsize = frames.width();
+  std::vector<Real> result(vsize, (Real)0.0);
+  for (int i=0; i<frames.size(); i++) {
+    const Real* frame = frames[i];
+    for (int j=0; j<vsize; j++) result[j] += frame[j];
+  }
+  for (int j=0; j<vsize; j++) result[j] /= frames.size();
+
+  return result;
+}
+
+// returns the median of frames stored contiguously
+inline std::vector<Real> medianFrames(const FrameMatrix& frames) {
+  if (frames.empty()) {
+    throw EssentiaException("trying to calculate mean of empty array of frames");
+  }
+
+  int vsize = frames.width();
+  std::vector<Real> result(vsize, (Real)0.0);
+  std::vector<Real> temp(frames.size());
+
+  for (int j=0; j<vsize; j++) {
+    for (int i=0; i<frames.size(); i++) temp[i] = frames[i][j];
+    result[j] = medianInPlace(temp);
   }
   return result;
 }
@@ -271,6 +337,11 @@ std::vector<T> varianceFrames(const std::vector<std::vector<T> >& frames) {
 }
 
 
+// returns the skewness given the second and third central moments
+template <typename T> T skewnessFromMoments(const T m2, const T m3) {
+  return m3 / pow(m2, (T)1.5);
+}
+
 template <typename T>
 std::vector<T> skewnessFrames(const std::vector<std::vector<T> >& frames) {
   if (frames.empty()) {
@@ -296,7 +367,7 @@ std::vector<T> skewnessFrames(const std::vector<std::vector<T> >& frames) {
   for (uint j=0; j<vsize; j++) {
     m2[j] /= nframes;
     m3[j] /= nframes;
-    result[j] = m3[j] / pow(m2[j], (T)1.5);
+    result[j] = skewnessFromMoments(m2[j], m3[j]);
   }
 
   return result;
@@ -339,20 +410,8 @@ template <typename T> T median(const std::vector<T>& array) {
   if (array.empty())
     throw EssentiaException("trying to calculate median of empty array");
 
-  // median has sense only on sorted array
-  std::vector<T> sorted_array = array;
-  std::sort(sorted_array.begin(), sorted_array.end());
-
-  uint size = (unsigned int)sorted_array.size();
-
-  // array size is an odd number
-  if (size % 2 == 0.0) {
-    return (sorted_array[uint(size/2 - 1)] + sorted_array[uint(size/2)]) / 2;
-  }
-  // array size is an even number
-  else {
-    return sorted_array[uint(size/2)];
-  }
+  std::vector<T> values = array;
+  return medianInPlace(values);
 }
 
 // returns the absolute value of each element of the array
@@ -458,7 +517,7 @@ template <typename T> T skewness(const std::vector<T>& array, const T mean) {
 
   m2 /= n; m3 /= n;
 
-  T result = m3 / pow(m2, (T)1.5);
+  T result = skewnessFromMoments(m2, m3);
   if (std::isnan(result) || std::isinf(result)) return 0;
   return result;
 }
@@ -27,11 +27,52 @@ using namespace TNT;
 
 namespace essentia {
 
+Pool::Pool(const Pool& pool) : _vectorRealViewComplete(false), _storageVersion() {
+  *this = pool;
+}
+
+Pool& Pool::operator=(const Pool& pool) {
+  if (&pool == this) return *this;
+
+  _poolSingleReal = pool._poolSingleReal;
+  _poolSingleString = pool._poolSingleString;
+  _poolSingleVectorReal = pool._poolSingleVectorReal;
+  _poolSingleVectorString = pool._poolSingleVectorString;
+  _poolReal = pool._poolReal;
+  _poolVectorReal = pool._poolVectorReal;
+  _poolVectorRealFrames = pool._poolVectorRealFrames;
+  _vectorRealView = pool._vectorRealView;
+  _vectorRealViewComplete = pool._vectorRealViewComplete;
+  _poolString = pool._poolString;
+  _poolVectorString = pool._poolVectorString;
+  _poolArray2DReal = pool._poolArray2DReal;
+  _poolStereoSample = pool._poolStereoSample;
+
+  // the values of the registered descriptors found in @c pool, or in the
+  // previous values of this one, are not those of this pool
+  _registered = pool._registered;
+  _registeredIds = pool._registeredIds;
+  for (int i=0; i<(int)_registered.size(); i++) {
+    _registered[i].storage = NoStorage;
+    _registered[i].values = 0;
+    _registered[i].owner = 0;
+    _registered[i].version = 0;
+  }
+  for (int i=0; i<NumberOfStorages; i++) _storageVersion[i] = pool._storageVersion[i];
+
+  setConcurrent(pool.isConcurrent());
+
+  return *this;
+}
+
 void Pool::clear() {
   GLOBAL_LOCK;
 
   _poolReal.clear();
   _poolVectorReal.clear();
+  _poolVectorRealFrames.clear();
+  _vectorRealView.clear();
+  _vectorRealViewComplete = false;
   _poolString.clear();
   _poolVectorString.clear();
   _poolArray2DReal.clear();
@@ -40,6 +81,20 @@ void Pool::clear() {
   _poolSingleString.clear();
   _poolSingleVectorReal.clear();
   _poolSingleVectorString.clear();  
+  for (int i=0; i<NumberOfStorages; i++) _storageVersion[i]++;
+}
+
+void Pool::setConcurrent(bool concurrent) {
+  mutexReal.setEnabled(concurrent);
+  mutexVectorReal.setEnabled(concurrent);
+  mutexString.setEnabled(concurrent);
+  mutexVectorString.setEnabled(concurrent);
+  mutexArray2DReal.setEnabled(concurrent);
+  mutexStereoSample.setEnabled(concurrent);
+  mutexSingleReal.setEnabled(concurrent);
+  mutexSingleString.setEnabled(concurrent);
+  mutexSingleVectorReal.setEnabled(concurrent);
+  mutexSingleVectorString.setEnabled(concurrent);
 }
 
 void Pool::checkIntegrity() const {
@@ -64,37 +119,55 @@ void Pool::checkIntegrity() const {
 // one of the sub-pools, as enforced by checkIntegrity
 void Pool::remove(const string& name) {
 
-  #define SEARCH_AND_DESTROY(t, tname)                                         \
+  #define SEARCH_AND_DESTROY(t, tname, storage)                                \
   {                                                                            \
-    MutexLocker lock(mutex##tname);                                            \
+    ConditionalMutexLocker lock(mutex##tname);                                 \
     map<string, t >::iterator i = _pool##tname.find(name);                     \
     if (i != _pool##tname.end()) {                                             \
       _pool##tname.erase(i);                                                   \
+      _storageVersion[storage]++;                                              \
       return;                                                                  \
     }                                                                          \
   }
 
-  SEARCH_AND_DESTROY(Real, SingleReal);
-  SEARCH_AND_DESTROY(vector<Real>, Real);
-  SEARCH_AND_DESTROY(vector<Real>, SingleVectorReal);
-  SEARCH_AND_DESTROY(vector<vector<Real> >, VectorReal);
+  SEARCH_AND_DESTROY(Real, SingleReal, NoStorage);
+  SEARCH_AND_DESTROY(vector<Real>, Real, RealStorage);
+  SEARCH_AND_DESTROY(vector<Real>, SingleVectorReal, NoStorage);
+
+  {
+    ConditionalMutexLocker lock(mutexVectorReal);
+    invalidateVectorRealView(name);
+    PoolOf(vector<Real>)::iterator vectors = _poolVectorReal.find(name);
+    if (vectors != _poolVectorReal.end()) {
+      _poolVectorReal.erase(vectors);
+      _storageVersion[VectorRealStorage]++;
+      return;
+    }
+    map<string, FrameMatrix>::iterator i = _poolVectorRealFrames.find(name);
+    if (i != _poolVectorRealFrames.end()) {
+      _poolVectorRealFrames.erase(i);
+      _storageVersion[VectorRealFramesStorage]++;
+      return;
+    }
+  }
 
-  SEARCH_AND_DESTROY(string, SingleString);
-  SEARCH_AND_DESTROY(vector<string>, String);
-  SEARCH_AND_DESTROY(vector<string>, SingleVectorString);
-  SEARCH_AND_DESTROY(vector<vector<string> >, VectorString);
+  SEARCH_AND_DESTROY(string, SingleString, NoStorage);
+  SEARCH_AND_DESTROY(vector<string>, String, StringStorage);
+  SEARCH_AND_DESTROY(vector<string>, SingleVectorString, NoStorage);
+  SEARCH_AND_DESTROY(vector<vector<string> >, VectorString, VectorStringStorage);
 
-  SEARCH_AND_DESTROY(vector<TNT::Array2D<Real> >, Array2DReal);
-  SEARCH_AND_DESTROY(vector<StereoSample>, StereoSample);
+  SEARCH_AND_DESTROY(vector<TNT::Array2D<Real> >, Array2DReal, Array2DRealStorage);
+  SEARCH_AND_DESTROY(vector<StereoSample>, StereoSample, StereoSampleStorage);
 
   #undef SEARCH_AND_DESTROY
 }
 
 void Pool::removeNamespace(const string& ns) {
 
-  #define SEARCH_AND_DESTROY(t, tname)                              \
+  #define SEARCH_AND_DESTROY(t, tname, storage)                     \
   {                                                                 \
-    MutexLocker lock(mutex##tname);                                 \
+    ConditionalMutexLocker lock(mutex##tname);                      \
+    _storageVersion[storage]++;                                     \
     map<string, t >::iterator it = _pool##tname.begin();            \
     int pos = 0;                                                    \
     /*temp iterator that keeps track of the position in the map*/   \
@@ -115,18 +188,30 @@ void Pool::removeNamespace(const string& ns) {
     }                                                               \
   }
 
-  SEARCH_AND_DESTROY(Real, SingleReal);
-  SEARCH_AND_DESTROY(vector<Real>, Real);
-  SEARCH_AND_DESTROY(vector<Real>, SingleVectorReal);
-  SEARCH_AND_DESTROY(vector<vector<Real> >, VectorReal);
+  SEARCH_AND_DESTROY(Real, SingleReal, NoStorage);
+  SEARCH_AND_DESTROY(vector<Real>, Real, RealStorage);
+  SEARCH_AND_DESTROY(vector<Real>, SingleVectorReal, NoStorage);
+  SEARCH_AND_DESTROY(vector<vector<Real> >, VectorReal, VectorRealStorage);
 
-  SEARCH_AND_DESTROY(string, SingleString);
-  SEARCH_AND_DESTROY(vector<string>, String);
-  SEARCH_AND_DESTROY(vector<string>, SingleVectorString);  
-  SEARCH_AND_DESTROY(vector<vector<string> >, VectorString);
+  {
+    ConditionalMutexLocker lock(mutexVectorReal);
+    _storageVersion[VectorRealFramesStorage]++;
+    _vectorRealView.clear();
+    _vectorRealViewComplete = false;
+    map<string, FrameMatrix>::iterator it = _poolVectorRealFrames.begin();
+    while (it != _poolVectorRealFrames.end()) {
+      if (it->first.find(ns+".") == 0) _poolVectorRealFrames.erase(it++);
+      else ++it;
+    }
+  }
+
+  SEARCH_AND_DESTROY(string, SingleString, NoStorage);
+  SEARCH_AND_DESTROY(vector<string>, String, StringStorage);
+  SEARCH_AND_DESTROY(vector<string>, SingleVectorString, NoStorage);  
+  SEARCH_AND_DESTROY(vector<vector<string> >, VectorString, VectorStringStorage);
 
-  SEARCH_AND_DESTROY(vector<TNT::Array2D<Real> >, Array2DReal);
-  SEARCH_AND_DESTROY(vector<StereoSample>, StereoSample);
+  SEARCH_AND_DESTROY(vector<TNT::Array2D<Real> >, Array2DReal, Array2DRealStorage);
+  SEARCH_AND_DESTROY(vector<StereoSample>, StereoSample, StereoSampleStorage);
 
   #undef SEARCH_AND_DESTROY
 }
@@ -138,7 +223,7 @@ vector<string> Pool::descriptorNames() const {
 
   #define ADD_DESC_NAMES(type, tname)                                          \
   {                                                                            \
-    MutexLocker lock(mutex##tname);                                            \
+    ConditionalMutexLocker lock(mutex##tname);                                 \
     descNames.resize(descNames.size() + _pool##tname.size());                  \
     for (map<string, type >::const_iterator it = _pool##tname.begin();         \
          it != _pool##tname.end();                                             \
@@ -151,6 +236,15 @@ vector<string> Pool::descriptorNames() const {
   ADD_DESC_NAMES(vector<Real>, Real);
   ADD_DESC_NAMES(vector<Real>, SingleVectorReal);
   ADD_DESC_NAMES(vector<vector<Real> >, VectorReal);
+  {
+    ConditionalMutexLocker lock(mutexVectorReal);
+    descNames.resize(descNames.size() + _poolVectorRealFrames.size());
+    for (map<string, FrameMatrix>::const_iterator it = _poolVectorRealFrames.begin();
+         it != _poolVectorRealFrames.end();
+         ++it) {
+      descNames[i++] = it->first;
+    }
+  }
   ADD_DESC_NAMES(string, SingleString);
   ADD_DESC_NAMES(vector<string>, String);
   ADD_DESC_NAMES(vector<string>, SingleVectorString);  
@@ -167,7 +261,7 @@ vector<string> Pool::descriptorNames(const std::string& ns) const {
   vector<string> descNames;
   #define ADD_DESC_NAMES(type, tname)                            \
   {                                                              \
-    MutexLocker lock(mutex##tname);                              \
+    ConditionalMutexLocker lock(mutex##tname);                   \
     map<string, type>::const_iterator it = _pool##tname.begin(); \
     while (it != _pool##tname.end()) {                           \
       if (it->first.find(ns+".") == 0)                           \
@@ -180,6 +274,14 @@ vector<string> Pool::descriptorNames(const std::string& ns) const {
   ADD_DESC_NAMES(vector<Real>, Real);
   ADD_DESC_NAMES(vector<Real>, SingleVectorReal);
   ADD_DESC_NAMES(vector<vector<Real> >, VectorReal);
+  {
+    ConditionalMutexLocker lock(mutexVectorReal);
+    for (map<string, FrameMatrix>::const_iterator it = _poolVectorRealFrames.begin();
+         it != _poolVectorRealFrames.end();
+         ++it) {
+      if (it->first.find(ns+".") == 0) descNames.push_back(it->first);
+    }
+  }
   ADD_DESC_NAMES(string, SingleString);
   ADD_DESC_NAMES(vector<string>, String);
   ADD_DESC_NAMES(vector<string>, SingleVectorString);
@@ -197,6 +299,7 @@ vector<string> Pool::descriptorNames(const std::string& ns) const {
 vector<string> Pool::descriptorNamesNoLocking() const {
   vector<string> descNames(_poolReal.size()         +
                            _poolVectorReal.size()   +
+                           _poolVectorRealFrames.size() +
                            _poolString.size()       +
                            _poolVectorString.size() +
                            _poolArray2DReal.size()  +
@@ -218,6 +321,7 @@ vector<string> Pool::descriptorNamesNoLocking() const {
   ADD_DESC_NAMES(vector<Real>, Real);
   ADD_DESC_NAMES(vector<Real>, SingleVectorReal);
   ADD_DESC_NAMES(vector<vector<Real> >, VectorReal);
+  ADD_DESC_NAMES(FrameMatrix, VectorRealFrames);
   ADD_DESC_NAMES(string, SingleString);
   ADD_DESC_NAMES(vector<string>, String);
   ADD_DESC_NAMES(vector<string>, SingleVectorString);
@@ -231,30 +335,71 @@ vector<string> Pool::descriptorNamesNoLocking() const {
   return descNames;
 }
 
-void Pool::validateKey(const string& name) {
-  std::vector<std::string> allNames = descriptorNamesNoLocking();
-  for (int i=0; i<int(allNames.size()); ++i) {
-    /* first check if name already exists in another sub-pool */
-    if (name == allNames[i]) {
-      throw EssentiaException("Pool: Cannot set/add/merge value to the pool under "
-                              "the name '"+name+"' because that name already exists but "
-                              "contains a different data type than value");
-    }
-    /* now check if adding this new key will result in a parent descriptor
-     * having a value and child descriptors (there are 2 cases where this can
-     * happen)*/
-    if ( name.find(allNames[i] + ".") == 0 ) {
-      throw EssentiaException("Pool: Cannot set/add/merge value to the pool under the name '"+name+
-                              "' because '"+name+"' has a parent descriptor name already in "
-                              "the pool (e.g. '"+allNames[i]+"')");
-    }
+namespace {
 
-    if ( allNames[i].find(name+".") == 0 ) {
-      throw EssentiaException("Pool: Cannot add/set/merge value to the pool under "
-                              "the name '"+name+"' because '"+name+"' has child descriptor "
-                              "names (e.g. '"+allNames[i]+"')");
-    }
+// returns the name in @c pool which is @c name, one of its parents or one of
+// its children, or null if there is none. The names are sorted, so that only
+// the parents (the prefixes of @c name before a '.') and the first name after
+// those of the children are looked up, instead of going through all of them.
+template <typename PoolType>
+const string* conflictingName(const PoolType& pool, const string& name) {
+  typename PoolType::const_iterator it = pool.find(name);
+  if (it != pool.end()) return &it->first;
+
+  for (string::size_type dot = name.find('.'); dot != string::npos; dot = name.find('.', dot+1)) {
+    it = pool.find(name.substr(0, dot));
+    if (it != pool.end()) return &it->first;
+  }
+
+  string prefix = name + ".";
+  it = pool.lower_bound(prefix);
+  if (it != pool.end() && it->first.compare(0, prefix.size(), prefix) == 0) return &it->first;
+
+  return 0;
+}
+
+} // namespace
+
+void Pool::validateKey(const string& name) {
+  const string* conflict = 0;
+
+  #define FIND_CONFLICT(tname) \
+  if (!conflict) conflict = conflictingName(_pool##tname, name);
+
+  FIND_CONFLICT(SingleReal);
+  FIND_CONFLICT(Real);
+  FIND_CONFLICT(SingleVectorReal);
+  FIND_CONFLICT(VectorReal);
+  FIND_CONFLICT(VectorRealFrames);
+  FIND_CONFLICT(SingleString);
+  FIND_CONFLICT(String);
+  FIND_CONFLICT(SingleVectorString);
+  FIND_CONFLICT(VectorString);
+  FIND_CONFLICT(Array2DReal);
+  FIND_CONFLICT(StereoSample);
+
+  #undef FIND_CONFLICT
+
+  if (!conflict) return;
+
+  /* first check if name already exists in another sub-pool */
+  if (name == *conflict) {
+    throw EssentiaException("Pool: Cannot set/add/merge value to the pool under "
+                            "the name '"+name+"' because that name already exists but "
+                            "contains a different data type than value");
+  }
+  /* now check if adding this new key will result in a parent descriptor
+   * having a value and child descriptors (there are 2 cases where this can
+   * happen)*/
+  if ( name.find(*conflict + ".") == 0 ) {
+    throw EssentiaException("Pool: Cannot set/add/merge value to the pool under the name '"+name+
+                            "' because '"+name+"' has a parent descriptor name already in "
+                            "the pool (e.g. '"+*conflict+"')");
   }
+
+  throw EssentiaException("Pool: Cannot add/set/merge value to the pool under "
+                          "the name '"+name+"' because '"+name+"' has child descriptor "
+                          "names (e.g. '"+*conflict+"')");
 }
 
 #define SPECIALIZE_ADD_IMPL(type, tname)                                     \
@@ -263,7 +408,7 @@ void Pool::add(const string& name, const type& value, bool validityCheck) {  \
   /* first check if the pool has ever seen this key before, if it has, we can
    * just add it, if not, we need to run some validation tests */            \
   {                                                                          \
-    MutexLocker lock(mutex##tname);                                          \
+    ConditionalMutexLocker lock(mutex##tname);                               \
     if (validityCheck && !isValid(value)) {                                  \
       throw EssentiaException("Pool::add value contains invalid numbers (NaN or inf)");\
     }                                                                        \
@@ -274,17 +419,225 @@ void Pool::add(const string& name, const type& value, bool validityCheck) {  \
   }                                                                          \
   /* validating will require checking all sub-pools, acquire a global lock*/ \
   GLOBAL_LOCK                                                                \
-  validateKey(name);                                                         \
+  /* the key may have been added since the sub-pool was unlocked */          \
+  if (_pool##tname.find(name) == _pool##tname.end()) validateKey(name);      \
   _pool##tname[name].push_back(value);                                       \
 }
 
 
 SPECIALIZE_ADD_IMPL(Real, Real);
-SPECIALIZE_ADD_IMPL(vector<Real>, VectorReal);
 SPECIALIZE_ADD_IMPL(string, String);
 SPECIALIZE_ADD_IMPL(vector<string>, VectorString);
 SPECIALIZE_ADD_IMPL(StereoSample, StereoSample);
 
+// special add for vector<Real>
+// the frames are stored in a FrameMatrix, as long as they have the same size,
+// instead of being allocated one by one
+void Pool::add(const string& name, const vector<Real>& value, bool validityCheck) {
+  /* first check if the pool has ever seen this key before, if it has, we can
+   * just add it, if not, we need to run some validation tests */
+  {
+    ConditionalMutexLocker lock(mutexVectorReal);
+    if (validityCheck && !isValid(value)) {
+      throw EssentiaException("Pool::add value contains invalid numbers (NaN or inf)");
+    }
+    map<string, FrameMatrix>::iterator frames = _poolVectorRealFrames.find(name);
+    if (frames != _poolVectorRealFrames.end()) {
+      addVectorReal(frames, &value, 1);
+      return;
+    }
+    PoolOf(vector<Real>)::iterator vectors = _poolVectorReal.find(name);
+    if (vectors != _poolVectorReal.end()) {
+      invalidateVectorRealView(name);
+      vectors->second.push_back(value);
+      return;
+    }
+  }
+  GLOBAL_LOCK
+  // the key may have been added since the sub-pool was unlocked
+  map<string, FrameMatrix>::iterator frames = _poolVectorRealFrames.find(name);
+  PoolOf(vector<Real>)::iterator vectors = _poolVectorReal.find(name);
+  if (frames != _poolVectorRealFrames.end()) addVectorReal(frames, &value, 1);
+  else {
+    invalidateVectorRealView(name);
+    if (vectors != _poolVectorReal.end()) vectors->second.push_back(value);
+    else {
+      validateKey(name);
+      _poolVectorRealFrames[name].push_back(value);
+    }
+  }
+}
+
+template <>
+void Pool::append(const string& name, const vector<vector<Real> >& values) {
+  {
+    ConditionalMutexLocker lock(mutexVectorReal);
+    map<string, FrameMatrix>::iterator frames = _poolVectorRealFrames.find(name);
+    if (frames != _poolVectorRealFrames.end()) {
+      addVectorReal(frames, values.data(), (int)values.size());
+      return;
+    }
+    PoolOf(vector<Real>)::iterator vectors = _poolVectorReal.find(name);
+    if (vectors != _poolVectorReal.end()) {
+      invalidateVectorRealView(name);
+      vectors->second.insert(vectors->second.end(), values.begin(), values.end());
+      return;
+    }
+  }
+
+  GLOBAL_LOCK
+  // the key may have been added since the sub-pool was unlocked
+  PoolOf(vector<Real>)::iterator vectors = _poolVectorReal.find(name);
+  if (vectors != _poolVectorReal.end()) {
+    invalidateVectorRealView(name);
+    vectors->second.insert(vectors->second.end(), values.begin(), values.end());
+    return;
+  }
+  map<string, FrameMatrix>::iterator frames = _poolVectorRealFrames.find(name);
+  if (frames == _poolVectorRealFrames.end()) {
+    validateKey(name);
+    frames = _poolVectorRealFrames.insert(make_pair(name, FrameMatrix())).first;
+  }
+  addVectorReal(frames, values.data(), (int)values.size());
+}
+
+// adds frames to those stored in a FrameMatrix, which are moved to a vector
+// of vectors as soon as one of them has another size
+void Pool::addVectorReal(map<string, FrameMatrix>::iterator frames,
+                         const vector<Real>* values, int size) {
+  invalidateVectorRealView(frames->first);
+  FrameMatrix& matrix = frames->second;
+  int i = 0;
+  for (; i<size; i++) {
+    if (!matrix.empty() && (int)values[i].size() != matrix.width()) break;
+    matrix.push_back(values[i]);
+  }
+  if (i == size) return;
+
+  vector<vector<Real> >& vectors = unpackVectorReal(frames)->second;
+  vectors.insert(vectors.end(), values + i, values + size);
+}
+
+PoolOf(vector<Real>)::iterator Pool::unpackVectorReal(map<string, FrameMatrix>::iterator frames) {
+  const FrameMatrix& matrix = frames->second;
+  PoolOf(vector<Real>)::iterator vectors =
+    _poolVectorReal.insert(make_pair(frames->first, vector<vector<Real> >())).first;
+
+  vectors->second.resize(matrix.size());
+  for (int i=0; i<matrix.size(); i++) {
+    vectors->second[i].assign(matrix[i], matrix[i] + matrix.width());
+  }
+
+  _poolVectorRealFrames.erase(frames);
+  _storageVersion[VectorRealFramesStorage]++;
+  return vectors;
+}
+
+void Pool::unpackVectorReal(const string& name) {
+  map<string, FrameMatrix>::iterator frames = _poolVectorRealFrames.find(name);
+  if (frames != _poolVectorRealFrames.end()) unpackVectorReal(frames);
+}
+
+// moves the frames of @c name back to poolVectorRealFrames, if they have the
+// same size
+void Pool::packVectorReal(const string& name) {
+  PoolOf(vector<Real>)::iterator vectors = _poolVectorReal.find(name);
+  if (vectors == _poolVectorReal.end()) return;
+
+  const vector<vector<Real> >& values = vectors->second;
+  int size = (int)values.size();
+  int width = size > 0 ? (int)values[0].size() : 0;
+  for (int i=1; i<size; i++) {
+    if ((int)values[i].size() != width) return;
+  }
+
+  map<string, FrameMatrix>::iterator frames =
+    _poolVectorRealFrames.insert(make_pair(name, FrameMatrix(size, width))).first;
+  for (int i=0; i<size; i++) {
+    std::copy(values[i].begin(), values[i].end(), frames->second[i]);
+  }
+
+  _poolVectorReal.erase(vectors);
+  _storageVersion[VectorRealStorage]++;
+}
+
+// returns the frames of poolVectorRealFrames as a vector of vectors, which is
+// cached until the descriptor is written to
+const vector<vector<Real> >& Pool::vectorRealView(map<string, FrameMatrix>::const_iterator frames) const {
+  PoolOf(vector<Real>)::iterator view = _vectorRealView.find(frames->first);
+  if (view != _vectorRealView.end()) return view->second;
+
+  const FrameMatrix& matrix = frames->second;
+  view = _vectorRealView.insert(make_pair(frames->first, vector<vector<Real> >(matrix.size()))).first;
+  for (int i=0; i<matrix.size(); i++) {
+    view->second[i].assign(matrix[i], matrix[i] + matrix.width());
+  }
+  return view->second;
+}
+
+// drops the cached vectors of @c name, before it is written to
+void Pool::invalidateVectorRealView(const string& name) {
+  _vectorRealViewComplete = false;
+  if (!_vectorRealView.empty()) _vectorRealView.erase(name);
+}
+
+template <>
+const vector<vector<Real> >& Pool::value(const string& name) const {
+  ConditionalMutexLocker lock(mutexVectorReal);
+  PoolOf(vector<Real>)::const_iterator vectors = _poolVectorReal.find(name);
+  if (vectors != _poolVectorReal.end()) {
+    return vectors->second;
+  }
+  map<string, FrameMatrix>::const_iterator frames = _poolVectorRealFrames.find(name);
+  if (frames != _poolVectorRealFrames.end()) {
+    return vectorRealView(frames);
+  }
+
+  ostringstream msg;
+  msg << "Descriptor name '" << name << "' of type "
+      << nameOfType(typeid(vector<vector<Real> >)) << " not found";
+  throw EssentiaException(msg);
+}
+
+const FrameMatrix& Pool::frames(const string& name) const {
+  ConditionalMutexLocker lock(mutexVectorReal);
+  map<string, FrameMatrix>::const_iterator result = _poolVectorRealFrames.find(name);
+  if (result != _poolVectorRealFrames.end()) {
+    return result->second;
+  }
+  if (_poolVectorReal.find(name) != _poolVectorReal.end()) {
+    throw EssentiaException("Pool: the frames of '", name, "' have different sizes and cannot be stored contiguously");
+  }
+
+  ostringstream msg;
+  msg << "Descriptor name '" << name << "' of type "
+      << nameOfType(typeid(vector<vector<Real> >)) << " not found";
+  throw EssentiaException(msg);
+}
+
+const PoolOf(vector<Real>)& Pool::getVectorRealPool() const {
+  ConditionalMutexLocker lock(mutexVectorReal);
+  if (!_vectorRealViewComplete) {
+    for (map<string, FrameMatrix>::const_iterator it = _poolVectorRealFrames.begin();
+         it != _poolVectorRealFrames.end();
+         ++it) {
+      vectorRealView(it);
+    }
+    for (PoolOf(vector<Real>)::const_iterator it = _poolVectorReal.begin();
+         it != _poolVectorReal.end();
+         ++it) {
+      if (_vectorRealView.find(it->first) == _vectorRealView.end()) _vectorRealView.insert(*it);
+    }
+    _vectorRealViewComplete = true;
+  }
+  return _vectorRealView;
+}
+
+const map<string, FrameMatrix>& Pool::getVectorRealFramesPool() const {
+  ConditionalMutexLocker lock(mutexVectorReal);
+  return _poolVectorRealFrames;
+}
+
 // special add for Array2d<Real>
 // Array2D needs a special add that cannot be implemented in the macro because
 // we need to call the function copy(), or otherwise we only get references
@@ -292,7 +645,7 @@ void Pool::add(const string& name, const Array2D<Real>& value, bool validityChec
   /* first check if the pool has ever seen this key before, if it has, we can
    * just add it, if not, we need to run some validation tests */
   {
-    MutexLocker lock(mutexArray2DReal);
+    ConditionalMutexLocker lock(mutexArray2DReal);
     if (validityCheck && !isValid(value)) {
       throw EssentiaException("Pool::add array contains invalid numbers (NaN or inf)");
     }
@@ -302,17 +655,208 @@ void Pool::add(const string& name, const Array2D<Real>& value, bool validityChec
     }
   }
   GLOBAL_LOCK
-  validateKey(name);
+  // the key may have been added since the sub-pool was unlocked
+  if (_poolArray2DReal.find(name) == _poolArray2DReal.end()) validateKey(name);
   _poolArray2DReal[name].push_back(value.copy());
 }
 
+DescriptorHandle Pool::registerDescriptor(const string& name) {
+  GLOBAL_LOCK
+
+  unordered_map<string, int>::const_iterator it = _registeredIds.find(name);
+  if (it != _registeredIds.end()) return DescriptorHandle(it->second, name);
+
+  RegisteredDescriptor desc;
+  desc.name = name;
+  desc.storage = NoStorage;
+  desc.values = 0;
+  desc.owner = 0;
+  desc.version = 0;
+
+  int id = (int)_registered.size();
+  _registered.push_back(desc);
+  _registeredIds[name] = id;
+  return DescriptorHandle(id, name);
+}
+
+string Pool::registeredName(const DescriptorHandle& handle) const {
+  if (!handle.isValid()) {
+    throw EssentiaException("Pool: invalid descriptor handle");
+  }
+  return handle._name;
+}
+
+// whether @c handle was registered by this pool (or by the pool it is a copy
+// of), rather than by another one, with which its id has nothing to do
+// WARNING: this function assumes that one of the sub-pools is locked
+bool Pool::isRegistered(const DescriptorHandle& handle) const {
+  return handle._id >= 0 && handle._id < (int)_registered.size() &&
+         _registered[handle._id].name == handle._name;
+}
+
+// returns the values of a registered descriptor if they are in the sub-pool
+// @c storage, where they were found, or null if they have to be looked up
+void* Pool::registeredValues(const DescriptorHandle& handle, Storage storage) {
+  if (!handle.isValid()) {
+    throw EssentiaException("Pool: invalid descriptor handle");
+  }
+  if (!isRegistered(handle)) return 0;
+  const RegisteredDescriptor& desc = _registered[handle._id];
+  if (desc.storage != storage || desc.owner != this || desc.version != _storageVersion[storage]) return 0;
+  return desc.values;
+}
+
+template <typename PoolType>
+void Pool::findRegisteredValues(const DescriptorHandle& handle, Storage storage, PoolType& pool) {
+  if (!isRegistered(handle)) return;
+  RegisteredDescriptor& desc = _registered[handle._id];
+  typename PoolType::iterator it = pool.find(desc.name);
+  if (it == pool.end()) return;
+
+  desc.storage = storage;
+  desc.values = &it->second;
+  desc.owner = this;
+  desc.version = _storageVersion[storage];
+}
+
+void Pool::findRegisteredVectorReal(const DescriptorHandle& handle) {
+  findRegisteredValues(handle, VectorRealFramesStorage, _poolVectorRealFrames);
+  findRegisteredValues(handle, VectorRealStorage, _poolVectorReal);
+}
+
+// the values are added directly to those of the registered descriptor, once
+// they have been found by adding the first one by name
+#define SPECIALIZE_ADD_HANDLE_IMPL(type, tname)                                             \
+void Pool::add(const DescriptorHandle& handle, const type& value, bool validityCheck) {     \
+  string name;                                                                              \
+  {                                                                                         \
+    ConditionalMutexLocker lock(mutex##tname);                                              \
+    vector<type>* values = (vector<type>*)registeredValues(handle, tname##Storage);         \
+    if (values) {                                                                           \
+      if (validityCheck && !isValid(value)) {                                               \
+        throw EssentiaException("Pool::add value contains invalid numbers (NaN or inf)");   \
+      }                                                                                     \
+      values->push_back(value);                                                             \
+      return;                                                                               \
+    }                                                                                       \
+    name = registeredName(handle);                                                          \
+  }                                                                                         \
+  add(name, value, validityCheck);                                                          \
+  ConditionalMutexLocker lock(mutex##tname);                                                \
+  findRegisteredValues(handle, tname##Storage, _pool##tname);                               \
+}
+
+SPECIALIZE_ADD_HANDLE_IMPL(Real, Real);
+SPECIALIZE_ADD_HANDLE_IMPL(string, String);
+SPECIALIZE_ADD_HANDLE_IMPL(vector<string>, VectorString);
+SPECIALIZE_ADD_HANDLE_IMPL(StereoSample, StereoSample);
+
+void Pool::add(const DescriptorHandle& handle, const vector<Real>& value, bool validityCheck) {
+  string name;
+  {
+    ConditionalMutexLocker lock(mutexVectorReal);
+    FrameMatrix* frames = (FrameMatrix*)registeredValues(handle, VectorRealFramesStorage);
+    vector<vector<Real> >* vectors = (vector<vector<Real> >*)registeredValues(handle, VectorRealStorage);
+    // a frame of another size moves the frames, which is left to add() by name
+    if (frames && !frames->empty() && (int)value.size() != frames->width()) frames = 0;
+
+    if (frames || vectors) {
+      if (validityCheck && !isValid(value)) {
+        throw EssentiaException("Pool::add value contains invalid numbers (NaN or inf)");
+      }
+      invalidateVectorRealView(handle._name);
+      if (frames) frames->push_back(value);
+      else vectors->push_back(value);
+      return;
+    }
+    name = registeredName(handle);
+  }
+  add(name, value, validityCheck);
+  ConditionalMutexLocker lock(mutexVectorReal);
+  findRegisteredVectorReal(handle);
+}
+
+void Pool::add(const DescriptorHandle& handle, const Array2D<Real>& value, bool validityCheck) {
+  string name;
+  {
+    ConditionalMutexLocker lock(mutexArray2DReal);
+    vector<Array2D<Real> >* values = (vector<Array2D<Real> >*)registeredValues(handle, Array2DRealStorage);
+    if (values) {
+      if (validityCheck && !isValid(value)) {
+        throw EssentiaException("Pool::add array contains invalid numbers (NaN or inf)");
+      }
+      values->push_back(value.copy());
+      return;
+    }
+    name = registeredName(handle);
+  }
+  add(name, value, validityCheck);
+  ConditionalMutexLocker lock(mutexArray2DReal);
+  findRegisteredValues(handle, Array2DRealStorage, _poolArray2DReal);
+}
+
+#define SPECIALIZE_APPEND_HANDLE_IMPL(type, tname)                                          \
+template <>                                                                                 \
+void Pool::append(const DescriptorHandle& handle, const vector<type>& values) {             \
+  string name;                                                                              \
+  {                                                                                         \
+    ConditionalMutexLocker lock(mutex##tname);                                              \
+    vector<type>* v = (vector<type>*)registeredValues(handle, tname##Storage);              \
+    if (v) {                                                                                \
+      v->insert(v->end(), values.begin(), values.end());                                    \
+      return;                                                                               \
+    }                                                                                       \
+    name = registeredName(handle);                                                          \
+  }                                                                                         \
+  append(name, values);                                                                     \
+  ConditionalMutexLocker lock(mutex##tname);                                                \
+  findRegisteredValues(handle, tname##Storage, _pool##tname);                               \
+}
+
+SPECIALIZE_APPEND_HANDLE_IMPL(Real, Real);
+SPECIALIZE_APPEND_HANDLE_IMPL(string, String);
+SPECIALIZE_APPEND_HANDLE_IMPL(vector<string>, VectorString);
+SPECIALIZE_APPEND_HANDLE_IMPL(StereoSample, StereoSample);
+
+template <>
+void Pool::append(const DescriptorHandle& handle, const vector<vector<Real> >& values) {
+  string name;
+  {
+    ConditionalMutexLocker lock(mutexVectorReal);
+    FrameMatrix* frames = (FrameMatrix*)registeredValues(handle, VectorRealFramesStorage);
+    vector<vector<Real> >* vectors = (vector<vector<Real> >*)registeredValues(handle, VectorRealStorage);
+
+    if (frames) {
+      int width = frames->empty() && !values.empty() ? (int)values[0].size() : frames->width();
+      int i = 0;
+      while (i < (int)values.size() && (int)values[i].size() == width) i++;
+      // a frame of another size moves the frames, which is left to append() by name
+      if (i < (int)values.size()) frames = 0;
+    }
+
+    if (frames || vectors) invalidateVectorRealView(handle._name);
+    if (frames) {
+      for (int i=0; i<(int)values.size(); i++) frames->push_back(values[i]);
+      return;
+    }
+    if (vectors) {
+      vectors->insert(vectors->end(), values.begin(), values.end());
+      return;
+    }
+    name = registeredName(handle);
+  }
+  append(name, values);
+  ConditionalMutexLocker lock(mutexVectorReal);
+  findRegisteredVectorReal(handle);
+}
+
 #define SPECIALIZE_SET_IMPL(type, tname)                                     \
 void Pool::set(const string& name, const type& value, bool validityCheck) {  \
                                                                              \
   /* first check if the pool has ever seen this key before, if it has, we can
    * just set it, if not, we need to run some validation tests */            \
   {                                                                          \
-    MutexLocker lock(mutexSingle##tname);                                    \
+    ConditionalMutexLocker lock(mutexSingle##tname);                         \
     if (validityCheck && !isValid(value)) {                                  \
       throw EssentiaException("Pool::set value contains invalid numbers (NaN or inf)");\
     }                                                                        \
@@ -322,7 +866,10 @@ void Pool::set(const string& name, const type& value, bool validityCheck) {  \
     }                                                                        \
   }                                                                          \
   GLOBAL_LOCK                                                                \
-  validateKey(name);                                                         \
+  /* the key may have been set since the sub-pool was unlocked */            \
+  if (_poolSingle##tname.find(name) == _poolSingle##tname.end()) {           \
+    validateKey(name);                                                       \
+  }                                                                          \
   _poolSingle##tname[name] = value;                                          \
 }
 
@@ -335,12 +882,13 @@ SPECIALIZE_SET_IMPL(vector<string>, VectorString)
 void Pool::merge(Pool& p, const string& mergeType) {
 
   #define MERGE_POOL(t, tname) {                                                     \
+    const map<string, vector<t> >& subPool = p.get##tname##Pool();                   \
     vector<string> descNames;                                                        \
-    descNames.reserve(p.get##tname##Pool().size());                                  \
+    descNames.reserve(subPool.size());                                               \
     {                                                                                \
-      MutexLocker lock(p.mutex##tname);                                              \
-      for (map<string, vector<t> >::const_iterator it = p.get##tname##Pool().begin();\
-           it != p.get##tname##Pool().end();                                         \
+      ConditionalMutexLocker lock(p.mutex##tname);                                   \
+      for (map<string, vector<t> >::const_iterator it = subPool.begin();             \
+           it != subPool.end();                                                      \
            ++it) {                                                                   \
         descNames.push_back(it->first);                                              \
       }                                                                              \
@@ -354,7 +902,7 @@ void Pool::merge(Pool& p, const string& mergeType) {
     vector<string> descNames;                                                \
     descNames.reserve(p.get##tname##Pool().size());                          \
     {                                                                        \
-      MutexLocker lock(p.mutex##tname);                                    \
+      ConditionalMutexLocker lock(p.mutex##tname);                         \
       for (map<string, t>::const_iterator it = p.get##tname##Pool().begin(); \
            it != p.get##tname##Pool().end();                                 \
            ++it) {                                                           \
@@ -375,7 +923,39 @@ void Pool::merge(Pool& p, const string& mergeType) {
   // multiple value:
   MERGE_POOL(Real, Real);
   MERGE_POOL(string, String);
-  MERGE_POOL(vector<Real>, VectorReal);
+  // the frames of p are copied from where it stores them, instead of being
+  // read through its cached vectors of vectors
+  {
+    vector<string> descNames;
+    {
+      ConditionalMutexLocker lock(p.mutexVectorReal);
+      descNames.reserve(p._poolVectorRealFrames.size() + p._poolVectorReal.size());
+      for (map<string, FrameMatrix>::const_iterator it = p._poolVectorRealFrames.begin();
+           it != p._poolVectorRealFrames.end();
+           ++it) {
+        descNames.push_back(it->first);
+      }
+      for (PoolOf(vector<Real>)::const_iterator it = p._poolVectorReal.begin();
+           it != p._poolVectorReal.end();
+           ++it) {
+        descNames.push_back(it->first);
+      }
+    }
+    for (int i=0; i < int(descNames.size()); ++i) {
+      vector<vector<Real> > values;
+      {
+        ConditionalMutexLocker lock(p.mutexVectorReal);
+        map<string, FrameMatrix>::const_iterator frames = p._poolVectorRealFrames.find(descNames[i]);
+        PoolOf(vector<Real>)::const_iterator vectors = p._poolVectorReal.find(descNames[i]);
+        if (frames != p._poolVectorRealFrames.end()) {
+          values.resize(frames->second.size());
+          for (int j=0; j<frames->second.size(); j++) values[j] = frames->second.frame(j);
+        }
+        else if (vectors != p._poolVectorReal.end()) values = vectors->second;
+      }
+      merge(descNames[i], values, mergeType);
+    }
+  }
   MERGE_POOL(vector<string>, VectorString);
   MERGE_POOL(StereoSample, StereoSample);
   MERGE_POOL(TNT::Array2D<Real>, Array2DReal);
@@ -384,14 +964,18 @@ void Pool::merge(Pool& p, const string& mergeType) {
   #undef MERGE_POOL
 }
 
-#define SPECIALIZE_MERGE_IMPL(type, tname)                                                             \
+// the statement @c unpack is run before looking for the descriptor, and the
+// statement @c pack once it has been merged, with the sub-pool locked
+#define SPECIALIZE_MERGE_IMPL(type, tname, unpack, pack)                                               \
 void Pool::merge(const string& name, const vector<type>& value, const string& mergeType) {             \
   if (value.empty()) return;                                                                           \
                                                                                                        \
-  /* first check if the pool has ever seen this key before, if it has, we can
-   * just add it, if not, we need to run some validation tests */                                      \
+  /* the key needs to be validated against all the sub-pools if it is new, and
+   * merging is not frequent enough to first look for it with its sub-pool only
+   * locked */                                                                                         \
+  GLOBAL_LOCK                                                                                          \
   {                                                                                                    \
-    MutexLocker lock(mutex##tname);                                                                    \
+    unpack                                                                                             \
     map<string, vector<type> >::iterator it = _pool##tname.find(name);                                 \
     if (it != _pool##tname.end()) {                                                                    \
       if (mergeType == "") {                                                                           \
@@ -408,6 +992,7 @@ void Pool::merge(const string& name, const vector<type>& value, const string& me
       else if (mergeType == "replace") {                                                               \
         _pool##tname.erase(it);                                                                        \
         _pool##tname.insert(make_pair(name, value));                                                   \
+        _storageVersion[tname##Storage]++;                                                             \
       }                                                                                                \
       else if (mergeType=="interleave") {                                                              \
         if (value.size() != _pool##tname[name].size()) {                                               \
@@ -415,6 +1000,7 @@ void Pool::merge(const string& name, const vector<type>& value, const string& me
         }                                                                                              \
         vector<type> temp = _pool##tname[name];                                                        \
         _pool##tname.erase(it);\
+        _storageVersion[tname##Storage]++;                                                             \
         _pool##tname[name].push_back(temp[0]);                                                         \
         _pool##tname[name].push_back(value[0]);                                                        \
         _pool##tname[name].reserve(2*temp.size());                                                     \
@@ -422,36 +1008,40 @@ void Pool::merge(const string& name, const vector<type>& value, const string& me
           _pool##tname[name].push_back(temp[i]);                                                       \
           _pool##tname[name].push_back(value[i]);                                                      \
         }                                                                                              \
+        pack                                                                                           \
         return;\
       }                                                                                                \
       else {                                                                                           \
         throw EssentiaException("Pool::merge, unknown merge type: ", mergeType);                       \
       }                                                                                                \
+      pack                                                                                             \
       return;                                                                                          \
     }                                                                                                  \
   }                                                                                                    \
-  GLOBAL_LOCK                                                                                          \
   validateKey(name);                                                                                   \
   _pool##tname[name].push_back(value[0]);                                                              \
   _pool##tname[name].reserve(value.size());                                                            \
   for (int i=1; i<(int)value.size(); ++i) {                                                            \
     _pool##tname[name].push_back(value[i]);                                                            \
   }                                                                                                    \
+  pack                                                                                                 \
 }
 
-SPECIALIZE_MERGE_IMPL(Real, Real);
-SPECIALIZE_MERGE_IMPL(vector<Real>, VectorReal);
-SPECIALIZE_MERGE_IMPL(string, String);
-SPECIALIZE_MERGE_IMPL(vector<string>, VectorString);
-SPECIALIZE_MERGE_IMPL(StereoSample, StereoSample);
+SPECIALIZE_MERGE_IMPL(Real, Real, , );
+SPECIALIZE_MERGE_IMPL(vector<Real>, VectorReal,
+                      invalidateVectorRealView(name); unpackVectorReal(name);,
+                      packVectorReal(name););
+SPECIALIZE_MERGE_IMPL(string, String, , );
+SPECIALIZE_MERGE_IMPL(vector<string>, VectorString, , );
+SPECIALIZE_MERGE_IMPL(StereoSample, StereoSample, , );
 
 #define SPECIALIZE_MERGE_SINGLE_IMPL(type, tname)                                                      \
 void Pool::mergeSingle(const string& name, const type& value, const string& mergeType) {               \
                                                                                                        \
-  /* first check if the pool has ever seen this key before, if it has, we can
-   * just add it, if not, we need to run some validation tests */                                      \
+  /* the key needs to be validated against all the sub-pools if it is new, see
+   * merge() */                                                                                        \
+  GLOBAL_LOCK                                                                                          \
   {                                                                                                    \
-    MutexLocker lock(mutexSingle##tname);                                                              \
     map<string, type>::iterator it = _poolSingle##tname.find(name);                                    \
     if (it != _poolSingle##tname.end()) {                                                              \
       if (mergeType == "replace") {                                                                    \
@@ -466,7 +1056,6 @@ void Pool::mergeSingle(const string& name, const type& value, const string& merg
       return;                                                                                          \
     }                                                                                                  \
   }                                                                                                    \
-  GLOBAL_LOCK                                                                                          \
   validateKey(name);                                                                                   \
   _poolSingle##tname.insert(make_pair(name, value));                                                   \
 }
@@ -478,10 +1067,10 @@ SPECIALIZE_MERGE_SINGLE_IMPL(vector<string>, VectorString)
 
 
 void Pool::merge(const string& name, const vector<Array2D<Real> >& value, const string& mergeType) {
-  /* first check if the pool has ever seen this key before, if it has, we can
-   * just add it, if not, we need to run some validation tests */
+  // the key needs to be validated against all the sub-pools if it is new, see
+  // merge() above
+  GLOBAL_LOCK
   {
-    MutexLocker lock(mutexArray2DReal);
     map<string, vector<Array2D<Real> > >::iterator it = _poolArray2DReal.find(name);
     if (it != _poolArray2DReal.end()) {
       if (mergeType == "") {
@@ -497,6 +1086,7 @@ void Pool::merge(const string& name, const vector<Array2D<Real> >& value, const
       }
       else if (mergeType == "replace") {
         _poolArray2DReal.erase(it);
+        _storageVersion[Array2DRealStorage]++;
         _poolArray2DReal[name].reserve(value.size());
         for(int i=0; i<int(value.size()); i++) {
           _poolArray2DReal[name].push_back(value[i].copy());
@@ -508,6 +1098,7 @@ void Pool::merge(const string& name, const vector<Array2D<Real> >& value, const
         }
         vector<Array2D<Real> > temp = _poolArray2DReal[name];
         _poolArray2DReal.erase(it);
+        _storageVersion[Array2DRealStorage]++;
         _poolArray2DReal[name].push_back(temp[0].copy());
         _poolArray2DReal[name].push_back(value[0].copy());
         _poolArray2DReal[name].reserve(2*temp.size());
@@ -523,7 +1114,6 @@ void Pool::merge(const string& name, const vector<Array2D<Real> >& value, const
       return;
     }
   }
-  GLOBAL_LOCK
   validateKey(name);
   _poolArray2DReal[name].push_back(value[0].copy());
   _poolArray2DReal[name].reserve(value.size());
@@ -535,7 +1125,7 @@ void Pool::merge(const string& name, const vector<Array2D<Real> >& value, const
 bool Pool::isSingleValue(const string& name) {
   #define SEARCH_SINGLE(t, tname)                                              \
   {                                                                            \
-    MutexLocker lock(mutex##tname);                                            \
+    ConditionalMutexLocker lock(mutex##tname);                                 \
     map<string, t >::iterator i = _pool##tname.find(name);                     \
     if (i != _pool##tname.end()) {                                             \
       return true;                                                             \
@@ -20,6 +20,7 @@
 #ifndef ESSENTIA_POOL_H
 #define ESSENTIA_POOL_H
 
+#include <unordered_map>
 #include "types.h"
 #include "threading.h"
 #include "utils/tnt/tnt.h"
@@ -34,9 +35,31 @@ namespace essentia {
 
 typedef std::string DescriptorName;
 
+/**
+ * Handle of a descriptor name interned by a Pool, with which values can be
+ * added to the descriptor without looking up its name. It is returned by
+ * Pool::registerDescriptor(), and is meant to be used with that Pool (or with
+ * a copy of it). Another Pool looks its name up instead, as add() by name.
+ */
+class DescriptorHandle {
+ public:
+  DescriptorHandle() : _id(-1) {}
+
+  bool isValid() const { return _id >= 0; }
+
+ protected:
+  DescriptorHandle(int id, const std::string& name) : _id(id), _name(name) {}
+
+  int _id;
+  std::string _name;
+
+  friend class Pool;
+};
+
 /**
  * The pool is a storage structure which can hold frames of all kinds of
- * descriptors. A Pool instance is thread-safe.
+ * descriptors. A Pool can be written by several threads at the same time once
+ * it has been made concurrent with setConcurrent(), see below.
  *
  * More specifically, a Pool maps descriptor names to data. A descriptor name
  * is a period ('.') delimited string of identifiers that are associated with
@@ -76,19 +99,46 @@ typedef std::string DescriptorName;
  * statistics on the data in the Pool. Similarly, the file generated by YamlOutput can be restored
  * into a Pool using the YamlInput algorithm.
  *
+ * The frames of a descriptor made of vectors of Reals are stored contiguously
+ * in a FrameMatrix as long as they all have the same size, which frames()
+ * returns without copying them. When they are read as a vector of vectors
+ * instead, with value() or getVectorRealPool(), they are copied to a cached
+ * vector of vectors, which is dropped as soon as the descriptor is written
+ * to. Reading the frames never moves them, so the references returned by
+ * frames() remain valid until the descriptor is written to, and those
+ * returned by value() and getVectorRealPool() as well.
+ *
+ * Descriptors to which many values are added, eg: a frame at a time, can be
+ * registered with registerDescriptor(), which returns a handle with which they
+ * are added to the values of the descriptor directly, instead of looking up
+ * its name in the sub-pool.
+ *
+ * A concurrent pool locks each sub-pool while it is being read or written, so
+ * that values can be added to different descriptors, or to the same one, from
+ * several threads at the same time. Only the values of a descriptor added by
+ * the same thread are kept in the order in which they were added, so each
+ * descriptor should have a single writer for the pool to be the same from one
+ * run to the other (eg: one PoolStorage per descriptor). Otherwise, each
+ * thread can write to a pool of its own, which are then merged into the
+ * shared one in a fixed order, with merge(). The references returned by the
+ * accessors (value(), frames(), get*Pool(), ...) and copies of the pool must
+ * not be used while other threads write to it. A pool which is not
+ * concurrent does not lock anything, and must only be used by one thread at a
+ * time.
+ *
  * For each type, the pool has its own public mutex (i.e. mutexReal, mutexVectorReal, etc.)
  * If locking the pool globally or partially, lock should be acquired in the following order:
  *
- *         MutexLocker lockReal(mutexReal)
- *         MutexLocker lockVectorReal(mutexVectorReal)
- *         MutexLocker lockString(mutexString)
- *         MutexLocker lockVectorString(mutexVectorString)
- *         MutexLocker lockArray2DReal(mutexArray2DReal)
- *         MutexLocker lockStereoSample(mutexStereoSample)
- *         MutexLocker lockSingleReal(mutexSingleReal)
- *         MutexLocker lockSingleString(mutexSingleString)
- *         MutexLocker lockSingleVectorReal(mutexSingleVectorReal)
- *         MutexLocker lockSingleVectorString(mutexSingleVectorString)
+ *         ConditionalMutexLocker lockReal(mutexReal)
+ *         ConditionalMutexLocker lockVectorReal(mutexVectorReal)
+ *         ConditionalMutexLocker lockString(mutexString)
+ *         ConditionalMutexLocker lockVectorString(mutexVectorString)
+ *         ConditionalMutexLocker lockArray2DReal(mutexArray2DReal)
+ *         ConditionalMutexLocker lockStereoSample(mutexStereoSample)
+ *         ConditionalMutexLocker lockSingleReal(mutexSingleReal)
+ *         ConditionalMutexLocker lockSingleString(mutexSingleString)
+ *         ConditionalMutexLocker lockSingleVectorReal(mutexSingleVectorReal)
+ *         ConditionalMutexLocker lockSingleVectorString(mutexSingleVectorString)
  *
  * To release the locks, the order should be reversed!
  *
@@ -104,15 +154,74 @@ class Pool {
 
   // maps for vectors of values:
   PoolOf(Real) _poolReal;
+  // the frames of a descriptor made of vectors of Reals are either in
+  // _poolVectorRealFrames, if they have the same size, or in _poolVectorReal
+  // otherwise. Only the writes move them from one to the other.
   PoolOf(std::vector<Real>) _poolVectorReal;
+  std::map<std::string, FrameMatrix> _poolVectorRealFrames;
+  // the frames of _poolVectorRealFrames read as vectors of vectors, and, once
+  // getVectorRealPool() has been called and until a descriptor is written to
+  // (_vectorRealViewComplete), a copy of _poolVectorReal. Guarded by
+  // mutexVectorReal.
+  mutable PoolOf(std::vector<Real>) _vectorRealView;
+  mutable bool _vectorRealViewComplete;
   PoolOf(std::string) _poolString;
   PoolOf(std::vector<std::string>) _poolVectorString;
   PoolOf(TNT::Array2D<Real>) _poolArray2DReal;
   PoolOf(StereoSample) _poolStereoSample;
 
+  // the sub-pools of vectors of values, in which the values of a registered
+  // descriptor can be
+  enum Storage {
+    NoStorage,
+    RealStorage, VectorRealStorage, VectorRealFramesStorage,
+    StringStorage, VectorStringStorage,
+    Array2DRealStorage, StereoSampleStorage,
+    NumberOfStorages
+  };
+
+  // a descriptor name interned by registerDescriptor(), and where its values
+  // were found in the sub-pools. They are still there as long as the pool is
+  // the same (a copy, or a pool assigned to, forgets where they were) and the
+  // version of their sub-pool has not changed. The descriptors are registered with all the sub-pools locked, so
+  // that they can be read with any of them locked.
+  struct RegisteredDescriptor {
+    std::string name;
+    Storage storage;
+    void* values;
+    const Pool* owner;
+    unsigned int version;
+  };
+
+  std::vector<RegisteredDescriptor> _registered;
+  std::unordered_map<std::string, int> _registeredIds;
+
+  // changed whenever values are erased from a sub-pool, or moved to another
+  // one, so that those of the registered descriptors are looked up again.
+  // Each version is guarded by the mutex of its sub-pool.
+  unsigned int _storageVersion[NumberOfStorages];
+
   // WARNING: this function assumes that all sub-pools are locked
   std::vector<std::string> descriptorNamesNoLocking() const;
 
+  // WARNING: these functions assume that mutexVectorReal is locked
+  void addVectorReal(std::map<std::string, FrameMatrix>::iterator frames,
+                     const std::vector<Real>* values, int size);
+  PoolOf(std::vector<Real>)::iterator unpackVectorReal(std::map<std::string, FrameMatrix>::iterator frames);
+  void unpackVectorReal(const std::string& name);
+  void packVectorReal(const std::string& name);
+  const std::vector<std::vector<Real> >& vectorRealView(std::map<std::string, FrameMatrix>::const_iterator frames) const;
+  void invalidateVectorRealView(const std::string& name);
+
+  // WARNING: these functions assume that the sub-pool @c storage is locked
+  bool isRegistered(const DescriptorHandle& handle) const;
+  void* registeredValues(const DescriptorHandle& handle, Storage storage);
+  template <typename PoolType>
+  void findRegisteredValues(const DescriptorHandle& handle, Storage storage, PoolType& pool);
+  void findRegisteredVectorReal(const DescriptorHandle& handle);
+
+  std::string registeredName(const DescriptorHandle& handle) const;
+
   /**
    * helper function for key validation when adding/setting/merging values to
    * the pool
@@ -122,9 +231,29 @@ class Pool {
 
  public:
 
-  mutable Mutex mutexReal, mutexVectorReal, mutexString, mutexVectorString,
-                mutexArray2DReal, mutexStereoSample,
-                mutexSingleReal, mutexSingleString, mutexSingleVectorReal, mutexSingleVectorString;
+  Pool() : _vectorRealViewComplete(false), _storageVersion() {}
+
+  /**
+   * Copies the values and the registered descriptors of @e pool, so that the
+   * handles it returned can be used with the copy as well. The values of the
+   * registered descriptors are looked up again in the copy.
+   */
+  Pool(const Pool& pool);
+  Pool& operator=(const Pool& pool);
+
+  mutable ConditionalMutex mutexReal, mutexVectorReal, mutexString, mutexVectorString,
+                           mutexArray2DReal, mutexStereoSample,
+                           mutexSingleReal, mutexSingleString, mutexSingleVectorReal, mutexSingleVectorString;
+
+  /**
+   * Makes the pool lock its sub-pools, so that several threads can write to
+   * it at the same time, if @e concurrent is true, or stop locking them
+   * otherwise (the default). This must be called while no other thread uses
+   * the pool.
+   */
+  void setConcurrent(bool concurrent);
+
+  bool isConcurrent() const { return mutexReal.enabled(); }
 
   /**
    * Adds @e value to the Pool under @e name
@@ -173,6 +302,43 @@ class Pool {
   template <typename T>
   void append(const std::string& name, const std::vector<T>& values);
 
+  /**
+   * \brief Interns the descriptor name @e name.
+   *
+   * @returns a handle with which values can be added to the descriptor, with
+   *          add() and append(), without looking up its name. It remains
+   *          valid as long as the pool exists, even if the descriptor is
+   *          removed or the pool cleared, and can be used with the copies of
+   *          the pool too. Registering the same name again returns the same
+   *          handle.
+   * @remark Registering a name does not add the descriptor to the pool, nor
+   *         check that it could be added: this is done by the first value
+   *         added with the handle.
+   */
+  DescriptorHandle registerDescriptor(const std::string& name);
+
+  /** @copydoc add(const std::string&,const Real&,bool) */
+  void add(const DescriptorHandle& handle, const Real& value, bool validityCheck = false);
+
+  /** @copydoc add(const std::string&,const Real&,bool) */
+  void add(const DescriptorHandle& handle, const std::vector<Real>& value, bool validityCheck = false);
+
+  /** @copydoc add(const std::string&,const Real&,bool) */
+  void add(const DescriptorHandle& handle, const std::string& value, bool validityCheck = false);
+
+  /** @copydoc add(const std::string&,const Real&,bool) */
+  void add(const DescriptorHandle& handle, const std::vector<std::string>& value, bool validityCheck = false);
+
+  /** @copydoc add(const std::string&,const Real&,bool) */
+  void add(const DescriptorHandle& handle, const TNT::Array2D<Real>& value, bool validityCheck = false);
+
+  /** @copydoc add(const std::string&,const Real&,bool) */
+  void add(const DescriptorHandle& handle, const StereoSample& value, bool validityCheck = false);
+
+  /** @copydoc append(const std::string&,const std::vector<T>&) */
+  template <typename T>
+  void append(const DescriptorHandle& handle, const std::vector<T>& values);
+
   /**
    * \brief Sets the value of a descriptor name.
    *
@@ -286,6 +452,15 @@ class Pool {
   template <typename T>
   bool contains(const std::string& name) const;
 
+  /**
+   * @returns the frames of the descriptor @e name, made of vectors of Reals,
+   *          stored contiguously. The reference remains valid until the
+   *          descriptor is written to.
+   * @remark An EssentiaException is thrown if the frames do not all have the
+   *         same size.
+   */
+  const FrameMatrix& frames(const std::string& name) const;
+
   /**
    * @returns a vector containing all descriptor names in the Pool
    */
@@ -305,9 +480,18 @@ class Pool {
 
   /**
    * @returns a map where the key is a descriptor name and the values are
-   *          of type vector<Real>
+   *          of type vector<Real>. It is a copy of the frames, cached until
+   *          the next write to the descriptors of vectors of Reals, so prefer
+   *          getVectorRealFramesPool() when reading them.
+   */
+  const PoolOf(std::vector<Real>)& getVectorRealPool() const;
+
+  /**
+   * @returns a map where the key is a descriptor name and the values are the
+   *          frames of vectors of Reals, stored contiguously. The descriptors
+   *          whose frames have different sizes are not in it.
    */
-  const PoolOf(std::vector<Real>)& getVectorRealPool() const { return _poolVectorReal; }
+  const std::map<std::string, FrameMatrix>& getVectorRealFramesPool() const;
 
   /**
    * @returns a std::map where the key is a descriptor name and the values are
@@ -383,7 +567,7 @@ class Pool {
 #define SPECIALIZE_VALUE(type, tname)                                          \
 template <>                                                                    \
 inline const type& Pool::value(const std::string& name) const {                \
-  MutexLocker lock(mutex##tname);                                              \
+  ConditionalMutexLocker lock(mutex##tname);                                   \
   std::map<std::string,type >::const_iterator result = _pool##tname.find(name);\
   if (result == _pool##tname.end()) {                                          \
     std::ostringstream msg;                                                    \
@@ -397,18 +581,22 @@ inline const type& Pool::value(const std::string& name) const {                \
 SPECIALIZE_VALUE(Real, SingleReal);
 SPECIALIZE_VALUE(std::string, SingleString);
 //SPECIALIZE_VALUE(std::vector<std::string>, String);
-SPECIALIZE_VALUE(std::vector<std::vector<Real> >, VectorReal);
 SPECIALIZE_VALUE(std::vector<std::vector<std::string> >, VectorString);
 SPECIALIZE_VALUE(std::vector<TNT::Array2D<Real> >, Array2DReal);
 SPECIALIZE_VALUE(std::vector<StereoSample>, StereoSample);
 
+// This value function is not under the macro above because the frames may
+// have to be read from poolVectorRealFrames
+template<>
+const std::vector<std::vector<Real> >& Pool::value(const std::string& name) const;
+
 // This value function is not under the macro above because it needs to check
 // in two separate sub-pools (poolReal and poolSingleVectorReal)
 template<>
 inline const std::vector<Real>& Pool::value(const std::string& name) const {
   std::map<std::string, std::vector<Real> >::const_iterator result;
   {
-    MutexLocker lock(mutexReal);
+    ConditionalMutexLocker lock(mutexReal);
     result = _poolReal.find(name);
     if (result != _poolReal.end()) {
       return result->second;
@@ -416,7 +604,7 @@ inline const std::vector<Real>& Pool::value(const std::string& name) const {
   }
 
   {
-    MutexLocker lock(mutexSingleVectorReal);
+    ConditionalMutexLocker lock(mutexSingleVectorReal);
     result = _poolSingleVectorReal.find(name);
     if (result != _poolSingleVectorReal.end()) {
       return result->second;
@@ -435,7 +623,7 @@ template<>
 inline const std::vector<std::string>& Pool::value(const std::string& name) const {
   std::map<std::string, std::vector<std::string> >::const_iterator result;
   {
-    MutexLocker lock(mutexString);
+    ConditionalMutexLocker lock(mutexString);
     result = _poolString.find(name);
     if (result != _poolString.end()) {
       return result->second;
@@ -443,7 +631,7 @@ inline const std::vector<std::string>& Pool::value(const std::string& name) cons
   }
 
   {
-    MutexLocker lock(mutexSingleVectorString);
+    ConditionalMutexLocker lock(mutexSingleVectorString);
     result = _poolSingleVectorString.find(name);
     if (result != _poolSingleVectorString.end()) {
       return result->second;
@@ -460,7 +648,7 @@ inline const std::vector<std::string>& Pool::value(const std::string& name) cons
 #define SPECIALIZE_CONTAINS(type, tname)                                       \
 template <>                                                                    \
 inline bool Pool::contains<type>(const std::string& name) const {              \
-  MutexLocker lock(mutex##tname);                                              \
+  ConditionalMutexLocker lock(mutex##tname);                                   \
   std::map<std::string,type >::const_iterator result = _pool##tname.find(name);\
   if (result == _pool##tname.end()) {                                          \
     return false;                                                              \
@@ -471,18 +659,26 @@ inline bool Pool::contains<type>(const std::string& name) const {              \
 SPECIALIZE_CONTAINS(Real, SingleReal);
 SPECIALIZE_CONTAINS(std::string, SingleString);
 //SPECIALIZE_CONTAINS(std::vector<std::string>, String);
-SPECIALIZE_CONTAINS(std::vector<std::vector<Real> >, VectorReal);
 SPECIALIZE_CONTAINS(std::vector<std::vector<std::string> >, VectorString);
 SPECIALIZE_CONTAINS(std::vector<TNT::Array2D<Real> >, Array2DReal);
 SPECIALIZE_CONTAINS(std::vector<StereoSample>, StereoSample);
 
+// This contains function is not under the macro above because it needs to
+// check in two separate sub-pools (poolVectorReal and poolVectorRealFrames)
+template <>
+inline bool Pool::contains<std::vector<std::vector<Real> > >(const std::string& name) const {
+  ConditionalMutexLocker lock(mutexVectorReal);
+  return _poolVectorReal.find(name) != _poolVectorReal.end() ||
+         _poolVectorRealFrames.find(name) != _poolVectorRealFrames.end();
+}
+
 // This value function is not under the macro above because it needs to check
 // in two separate sub-pools (poolReal and poolSingleVectorReal)
 template<>
 inline bool Pool::contains<std::vector<Real> >(const std::string& name) const {
   std::map<std::string, std::vector<Real> >::const_iterator result;
   {
-    MutexLocker lock(mutexReal);
+    ConditionalMutexLocker lock(mutexReal);
     result = _poolReal.find(name);
     if (result != _poolReal.end()) {
       return true;
@@ -490,7 +686,7 @@ inline bool Pool::contains<std::vector<Real> >(const std::string& name) const {
   }
 
   {
-    MutexLocker lock(mutexSingleVectorReal);
+    ConditionalMutexLocker lock(mutexSingleVectorReal);
     result = _poolSingleVectorReal.find(name);
     if (result != _poolSingleVectorReal.end()) {
       return true;
@@ -507,7 +703,7 @@ template<>
 inline bool Pool::contains<std::vector<std::string> >(const std::string& name) const {
   std::map<std::string, std::vector<std::string> >::const_iterator result;
   {
-    MutexLocker lock(mutexString);
+    ConditionalMutexLocker lock(mutexString);
     result = _poolString.find(name);
     if (result != _poolString.end()) {
       return true;
@@ -515,7 +711,7 @@ inline bool Pool::contains<std::vector<std::string> >(const std::string& name) c
   }
 
   {
-    MutexLocker lock(mutexSingleVectorString);
+    ConditionalMutexLocker lock(mutexSingleVectorString);
     result = _poolSingleVectorString.find(name);
     if (result != _poolSingleVectorString.end()) {
       return true;
@@ -527,17 +723,17 @@ inline bool Pool::contains<std::vector<std::string> >(const std::string& name) c
 
 // Used to get a lock over all sub-pools, make sure to update this when adding
 // a new sub-pool
-#define GLOBAL_LOCK                                         \
-MutexLocker lockReal(mutexReal);                            \
-MutexLocker lockVectorReal(mutexVectorReal);                \
-MutexLocker lockString(mutexString);                        \
-MutexLocker lockVectorString(mutexVectorString);            \
-MutexLocker lockArray2DReal(mutexArray2DReal);              \
-MutexLocker lockStereoSample(mutexStereoSample);            \
-MutexLocker lockSingleReal(mutexSingleReal);                \
-MutexLocker lockSingleString(mutexSingleString);            \
-MutexLocker lockSingleVectorReal(mutexSingleVectorReal);    \
-MutexLocker lockSingleVectorString(mutexSingleVectorString);
+#define GLOBAL_LOCK                                                    \
+ConditionalMutexLocker lockReal(mutexReal);                            \
+ConditionalMutexLocker lockVectorReal(mutexVectorReal);                \
+ConditionalMutexLocker lockString(mutexString);                        \
+ConditionalMutexLocker lockVectorString(mutexVectorString);            \
+ConditionalMutexLocker lockArray2DReal(mutexArray2DReal);              \
+ConditionalMutexLocker lockStereoSample(mutexStereoSample);            \
+ConditionalMutexLocker lockSingleReal(mutexSingleReal);                \
+ConditionalMutexLocker lockSingleString(mutexSingleString);            \
+ConditionalMutexLocker lockSingleVectorReal(mutexSingleVectorReal);    \
+ConditionalMutexLocker lockSingleVectorString(mutexSingleVectorString);
 
 
 
@@ -550,7 +746,7 @@ inline void Pool::append(const std::string& name, const std::vector<T>& values)
 template <>                                                                           \
 inline void Pool::append(const std::string& name, const std::vector<type>& values) {  \
   {                                                                                   \
-    MutexLocker lock(mutex##tname);                                                   \
+    ConditionalMutexLocker lock(mutex##tname);                                        \
     PoolOf(type)::iterator result = _pool##tname.find(name);                          \
     if (result != _pool##tname.end()) {                                               \
                                                                                       \
@@ -563,17 +759,38 @@ inline void Pool::append(const std::string& name, const std::vector<type>& value
   }                                                                                   \
                                                                                       \
   GLOBAL_LOCK                                                                         \
-  validateKey(name);                                                                  \
-  _pool##tname[name] = values;                                                        \
+  /* the descriptor may have been added since the sub-pool was unlocked */            \
+  if (_pool##tname.find(name) == _pool##tname.end()) validateKey(name);               \
+  std::vector<type>& v = _pool##tname[name];                                          \
+  v.insert(v.end(), values.begin(), values.end());                                    \
 }
 
 
 SPECIALIZE_APPEND(Real, Real);
-SPECIALIZE_APPEND(std::vector<Real>, VectorReal);
 SPECIALIZE_APPEND(std::string, String);
 SPECIALIZE_APPEND(std::vector<std::string>, VectorString);
 SPECIALIZE_APPEND(StereoSample, StereoSample);
 
+// the frames of vectors of Reals are stored contiguously, see Pool::add
+template <>
+void Pool::append(const std::string& name, const std::vector<std::vector<Real> >& values);
+
+template<typename T>
+inline void Pool::append(const DescriptorHandle& handle, const std::vector<T>& values) {
+  throw EssentiaException("Pool::append not implemented for type: ", nameOfType(typeid(T)));
+}
+
+template <>
+void Pool::append(const DescriptorHandle& handle, const std::vector<Real>& values);
+template <>
+void Pool::append(const DescriptorHandle& handle, const std::vector<std::vector<Real> >& values);
+template <>
+void Pool::append(const DescriptorHandle& handle, const std::vector<std::string>& values);
+template <>
+void Pool::append(const DescriptorHandle& handle, const std::vector<std::vector<std::string> >& values);
+template <>
+void Pool::append(const DescriptorHandle& handle, const std::vector<StereoSample>& values);
+
 /// @endcond
 
 } // namespace essentia
@@ -18,8 +18,11 @@
  */
 
 #include <stack>
+#include <thread>
 #include "network.h"
 #include "graphutils.h"
+#include "parallelexecutor.h"
+#include "networkprofiler.h"
 #include "../streaming/streamingalgorithm.h"
 #include "../streaming/streamingalgorithmcomposite.h"
 using namespace std;
@@ -169,7 +172,16 @@ Network* Network::lastCreated = 0;
 Network::Network(Algorithm* generator, bool takeOwnership) : _takeOwnership(takeOwnership),
                                                              _generator(generator),
                                                              _visibleNetworkRoot(0),
-                                                             _executionNetworkRoot(0) {
+                                                             _executionNetworkRoot(0),
+                                                             _executor(0),
+                                                             _pipelineGenerator(false),
+                                                             _generatorAhead(false),
+                                                             _profiling(false),
+                                                             _profiler(0),
+                                                             _adaptiveBuffers(false),
+                                                             _warmupSteps(32),
+                                                             _warmupLeft(0),
+                                                             _mergeDuplicates(false) {
   lastCreated = this;
 
   // 1- find the simple list of algorithms connected in this network
@@ -183,10 +195,14 @@ Network::Network(Algorithm* generator, bool takeOwnership) : _takeOwnership(take
 
 Network::~Network() {
   if (lastCreated == this) lastCreated = 0;
+  delete _profiler;
   clear();
 }
 
 void Network::clear() {
+  // give the algorithms back as they were connected
+  unmergeDuplicateAlgorithms();
+
   if (_takeOwnership) {
     deleteAlgorithms();
   }
@@ -232,9 +248,42 @@ bool algorithmHasProduced(Algorithm* algo, EssentiaMap<SourceBase*, int>& produc
   return hasProduced;
 }
 
-void Network::run() {
+void Network::run(int numThreads) {
   runPrepare();
-  while (runStep());
+
+  if (numThreads == 0) numThreads = (int)std::thread::hardware_concurrency();
+
+  if (numThreads > 1) {
+    ParallelExecutor executor(_executionNetworkRoot, numThreads, _profiler);
+    _executor = &executor;
+
+    // _warmupLeft only changes between steps, while no node is running
+    executor.setReschedulingCallback([this](Algorithm* algo) {
+      if (_warmupLeft > 0) recordRescheduling(algo);
+    });
+
+    // the generator can only run at the same time as its readers if they do
+    // not share anything else than concurrent buffers
+    const Algorithm::OutputMap& outputs = _toposortedNetwork[0]->outputs();
+    _pipelineGenerator = !outputs.empty();
+    for (int i=0; i<(int)outputs.size(); i++) {
+      if (!outputs[i].second->isConcurrentBuffer()) _pipelineGenerator = false;
+    }
+
+    try {
+      while (runStep());
+    }
+    catch (...) {
+      _executor = 0;
+      _pipelineGenerator = _generatorAhead = false;
+      throw;
+    }
+    _executor = 0;
+    _pipelineGenerator = false;
+  }
+  else {
+    while (runStep());
+  }
 
   string dash(24, '-');
   E_DEBUG(ENetwork, dash << " Final buffer states " << dash);
@@ -243,9 +292,17 @@ void Network::run() {
 
 void Network::runPrepare() {
   // 1- build the execution network here as internal configuration of some
-  //    algorithms might have changed since we constructed the Network
+  //    algorithms might have changed since we constructed the Network. The
+  //    previous merges are undone for the same reason.
+  unmergeDuplicateAlgorithms();
   buildExecutionNetwork();
 
+  // 1b- merge the algorithms which compute the same thing, and rebuild the
+  //     execution network without the ones that have been disconnected
+  if (_mergeDuplicates && mergeDuplicateAlgorithms() > 0) {
+    buildExecutionNetwork();
+  }
+
   // 2- get a linear ordering on the newly constructed execution network
   topologicalSortExecutionNetwork();
 
@@ -255,6 +312,11 @@ void Network::runPrepare() {
   // 4- resize the buffers depending on the requirements of the connected sinks
   checkBufferSizes();
 
+  // start a new profile, if asked to
+  delete _profiler;
+  _profiler = 0;
+  if (_profiling) _profiler = new NetworkProfiler(_toposortedNetwork);
+
 #if DEBUGGING_ENABLED
   for (int i=0; i<(int)_toposortedNetwork.size(); i++) _toposortedNetwork[i]->nProcess = 0;
 #endif
@@ -268,7 +330,9 @@ bool Network::runStep() {
 
   streaming::Algorithm* gen = _toposortedNetwork[0];
 
-  if(gen->shouldStop()) return false;
+  // if the generator has been run ahead, the nodes still need to consume what
+  // it produced, even if that was its last step
+  if(gen->shouldStop() && !_generatorAhead) return false;
 
 #if DEBUGGING_ENABLED
   string dash(24, '-');
@@ -278,17 +342,28 @@ bool Network::runStep() {
   E_DEBUG(ENetwork, "-------- Running generator loop index " << gen->nProcess << " --------");
 
   E_DEBUG(EScheduler, dash << " Buffer states before running generator, nProcess = " << gen->nProcess << " " << dash);
-  printNetworkBufferFillState();
+  printBufferFillState();
 #endif
 
-  // first run the generator once
-  gen->process();
+  // during the warm-up phase of the adaptive buffer sizing, look at how the
+  // buffers are used within the step
+  bool warmingUp = _warmupLeft > 0;
+  if (warmingUp) startBufferObservation();
 
-  bool endOfStream = gen->shouldStop();
+  // first run the generator once, unless the executor already did it
+  if (_generatorAhead) _generatorAhead = false;
+  else {
+    if (_profiler) _profiler->process(gen);
+    else gen->process();
 
 #if DEBUGGING_ENABLED
-  gen->nProcess++;
+    gen->nProcess++;
+#endif
+  }
 
+  bool endOfStream = gen->shouldStop();
+
+#if DEBUGGING_ENABLED
   if (endOfStream) E_DEBUG(ENetwork, "Generator " << gen->name() << " run " <<
                            gen->nProcess << " times, shouldStop = true " <<
                            "(end of stream reached, and all tokens produced)");
@@ -298,6 +373,17 @@ bool Network::runStep() {
 #endif
 
   // then run each algorithm as many times as needed for them to consume everything on their input
+  if (_executor) {
+    // run the generator for the next step at the same time, except while the
+    // buffers are being observed, as it would make the observation meaningless
+    _generatorAhead = _pipelineGenerator && !endOfStream && _warmupLeft == 0;
+    _executor->runNodes(endOfStream, _generatorAhead);
+    E_DEBUG(EScheduler, dash << " Buffer states after running the generator and all the nodes " << dash);
+    printBufferFillState();
+    if (warmingUp) endBufferObservation(endOfStream);
+    return true;
+  }
+
   stack<int> runStack;
   runStack.push(1);
   while (!runStack.empty()) {
@@ -310,7 +396,8 @@ bool Network::runStep() {
       _toposortedNetwork[i]->shouldStop(endOfStream && runStack.empty());
       AlgorithmStatus status;
       do {
-        status = _toposortedNetwork[i]->process();
+        status = _profiler ? _profiler->process(_toposortedNetwork[i])
+                           : _toposortedNetwork[i]->process();
 
 #if DEBUGGING_ENABLED
         if (status == OK || status == FINISHED) _toposortedNetwork[i]->nProcess++;
@@ -323,6 +410,7 @@ bool Network::runStep() {
         // as long as we have at least 1 index value on the stack
         if (status == NO_OUTPUT) {
           runStack.push(i);
+          if (warmingUp) recordRescheduling(_toposortedNetwork[i]);
           E_DEBUG(EScheduler, "Rescheduling algorithm " << _toposortedNetwork[i]->name() <<
                   " on generator frame " << gen->nProcess <<
                   " to run later, output buffers temporarily full");
@@ -333,7 +421,7 @@ bool Network::runStep() {
           E_WARNING("You may want to consider resizing one of the output buffers of " <<
                     "this algorithm for better performance");
           */
-          printNetworkBufferFillState();
+          printBufferFillState();
         }
       } while (status == OK);
 
@@ -341,6 +429,7 @@ bool Network::runStep() {
   }
   E_DEBUG(EScheduler, dash << " Buffer states after running the generator and all the nodes " << dash);
   printBufferFillState();
+  if (warmingUp) endBufferObservation(endOfStream);
   return true;
 }
 
@@ -361,6 +450,8 @@ Algorithm* Network::findAlgorithm(const std::string& name) {
 
 
 void Network::reset() {
+  unmergeDuplicateAlgorithms();
+
   NodeVector nodes = depthFirstSearch(_visibleNetworkRoot);
   for (NodeVector::iterator node = nodes.begin(); node != nodes.end(); ++node) {
     (*node)->algorithm()->reset();
@@ -370,6 +461,10 @@ void Network::reset() {
 void Network::deleteAlgorithms() {
   E_DEBUG(ENetwork, "Network::deleteAlgorithms()");
 
+  // the merged algorithms are still part of the visible network once they
+  // have been connected back
+  unmergeDuplicateAlgorithms();
+
   NodeVector nodes = depthFirstSearch(_visibleNetworkRoot);
   for (NodeVector::iterator node = nodes.begin(); node != nodes.end(); ++node) {
     E_DEBUG(ENetwork, "deleting " << (*node)->algorithm()->name());
@@ -920,6 +1015,9 @@ void Network::checkConnections() {
 
   for (int i=0; i<(int)algos.size(); i++) {
     Algorithm* algo = algos[i];
+    // merged algorithms have been disconnected on purpose
+    if (contains(_mergedAlgorithms, algo)) continue;
+
     for (Algorithm::OutputMap::const_iterator output = algo->outputs().begin();
          output != algo->outputs().end();
          ++output) {
@@ -936,6 +1034,165 @@ void Network::checkConnections() {
 }
 
 
+// algorithms which use random numbers, directly or through the algorithms
+// they create internally: two instances do not compute the same thing
+static const char* nondeterministicAlgorithms[] = {
+  "AudioOnsetsMarker", "BeatTrackerDegara", "BeatTrackerMultiFeature", "NoiseAdder",
+  "ReplayGain", "RhythmDescriptors", "RhythmExtractor", "RhythmExtractor2013",
+  "StochasticModelSynth", "TempoTapDegara"
+};
+
+bool Network::isMergeable(Algorithm* algo) {
+  for (int i=0; i<(int)ARRAY_SIZE(nondeterministicAlgorithms); i++) {
+    if (algo->name() == nondeterministicAlgorithms[i]) return false;
+  }
+
+  if (algo->name() == "FrameCutter" && algo->parameter("silentFrames").toString() == "noise") {
+    return false;
+  }
+
+  return true;
+}
+
+bool Network::areDuplicates(Algorithm* algo1, Algorithm* algo2) {
+  if (algo1 == algo2 || algo1->name() != algo2->name()) return false;
+  if (!isMergeable(algo1)) return false;
+
+  // algorithms without inputs are generators and those without outputs write
+  // their results somewhere else (eg: in a Pool), they can't be merged
+  if (algo1->inputs().empty() || algo1->outputs().empty()) return false;
+
+  if (algo1->inputs().size() != algo2->inputs().size() ||
+      algo1->outputs().size() != algo2->outputs().size()) return false;
+
+  for (int i=0; i<(int)algo1->inputs().size(); i++) {
+    SinkBase& input1 = algo1->input(i);
+    SinkBase& input2 = algo2->input(i);
+    if (!input1.source() || input1.source() != input2.source()) return false;
+    if (dynamic_cast<SinkProxyBase*>(&input1) || dynamic_cast<SinkProxyBase*>(&input2)) return false;
+  }
+
+  for (int i=0; i<(int)algo1->outputs().size(); i++) {
+    SourceBase& output1 = algo1->output(i);
+    SourceBase& output2 = algo2->output(i);
+    if (output1.isProxied() || output2.isProxied()) return false;
+    if (dynamic_cast<SourceProxyBase*>(&output1) || dynamic_cast<SourceProxyBase*>(&output2)) return false;
+  }
+
+  const ParameterMap& params = algo1->defaultParameters();
+  for (ParameterMap::const_iterator it = params.begin(); it != params.end(); ++it) {
+    if (algo1->parameter(it->first) != algo2->parameter(it->first)) return false;
+  }
+
+  return true;
+}
+
+
+void Network::mergeAlgorithm(Algorithm* algo, Algorithm* into) {
+  E_DEBUG(ENetwork, "merging " << algo->name() << " (" << algo << ") into " << into->name() << " (" << into << ")");
+
+  MergedConnections connections;
+  connections.into = into;
+
+  // move the sinks to the outputs of the algorithm which is kept
+  for (int i=0; i<(int)algo->outputs().size(); i++) {
+    SourceBase& output = algo->output(i);
+    vector<SinkBase*> sinks = output.sinks();
+    for (int j=0; j<(int)sinks.size(); j++) {
+      disconnect(output, *sinks[j]);
+      connect(into->output(i), *sinks[j]);
+    }
+    connections.sinks.push_back(sinks);
+  }
+
+  // and disconnect the duplicate one from its sources, which also takes it out
+  // of the execution network
+  for (int i=0; i<(int)algo->inputs().size(); i++) {
+    SinkBase& input = algo->input(i);
+    connections.sources.push_back(input.source());
+    disconnect(*input.source(), input);
+  }
+
+  _mergedAlgorithms.push_back(algo);
+  _mergedConnections.push_back(connections);
+}
+
+
+void Network::unmergeDuplicateAlgorithms() {
+  if (_mergedAlgorithms.empty()) return;
+
+  // an algorithm merged later might be connected to one merged before, so
+  // undo the merges in reverse order
+  for (int m=(int)_mergedAlgorithms.size()-1; m>=0; m--) {
+    Algorithm* algo = _mergedAlgorithms[m];
+    const MergedConnections& connections = _mergedConnections[m];
+
+    E_DEBUG(ENetwork, "unmerging " << algo->name() << " (" << algo << ") from " << connections.into->name() << " (" << connections.into << ")");
+
+    for (int i=0; i<(int)connections.sources.size(); i++) {
+      connect(*connections.sources[i], algo->input(i));
+    }
+
+    for (int i=0; i<(int)connections.sinks.size(); i++) {
+      const vector<SinkBase*>& sinks = connections.sinks[i];
+      for (int j=0; j<(int)sinks.size(); j++) {
+        disconnect(connections.into->output(i), *sinks[j]);
+        connect(algo->output(i), *sinks[j]);
+      }
+    }
+  }
+
+  _mergedAlgorithms.clear();
+  _mergedConnections.clear();
+}
+
+
+int Network::mergeDuplicateAlgorithms() {
+  // only consider the algorithms which are visible at the top level and which
+  // are actually run
+  vector<Algorithm*> executed = depthFirstMap(_executionNetworkRoot, returnAlgorithm);
+  set<Algorithm*> executedSet(executed.begin(), executed.end());
+  vector<Algorithm*> visible = depthFirstMap(_visibleNetworkRoot, returnAlgorithm);
+
+  map<string, vector<Algorithm*> > candidates; // algorithm name → algorithms of that type
+  for (int i=0; i<(int)visible.size(); i++) {
+    Algorithm* algo = visible[i];
+    if (algo == _generator || executedSet.find(algo) == executedSet.end()) continue;
+    if (dynamic_cast<AlgorithmComposite*>(algo)) continue;
+    candidates[algo->name()].push_back(algo);
+  }
+
+  // merging two algorithms can make the algorithms connected to their outputs
+  // duplicates of each other, so loop until nothing changes anymore
+  int merged = 0;
+  bool changed = true;
+  while (changed) {
+    changed = false;
+    for (map<string, vector<Algorithm*> >::iterator it = candidates.begin(); it != candidates.end(); ++it) {
+      vector<Algorithm*>& algos = it->second;
+      for (int i=1; i<(int)algos.size(); i++) {
+        for (int j=0; j<i; j++) {
+          if (areDuplicates(algos[j], algos[i])) {
+            mergeAlgorithm(algos[i], algos[j]);
+            algos.erase(algos.begin() + i);
+            i--;
+            merged++;
+            changed = true;
+            break;
+          }
+        }
+      }
+    }
+  }
+
+  if (merged > 0) {
+    E_INFO("Network: merged " << merged << " duplicate algorithms");
+  }
+
+  return merged;
+}
+
+
 void Network::printBufferFillState() {
   if (!E_ACTIVE(EScheduler)) return;
 
@@ -966,6 +1223,21 @@ void Network::printBufferFillState() {
   }
 }
 
+void Network::setConcurrentBuffers(bool concurrent) {
+  vector<Algorithm*> algos = depthFirstMap(executionNetworkRoot(), returnAlgorithm);
+
+  for (int i=0; i<(int)algos.size(); i++) {
+    Algorithm* algo = algos[i];
+    for (Algorithm::OutputMap::const_iterator output = algo->outputs().begin();
+         output != algo->outputs().end();
+         ++output) {
+      // proxies do not own a buffer, the source they proxy will be switched by its own algorithm
+      if (dynamic_cast<SourceProxyBase*>(output->second)) continue;
+      output->second->setConcurrentBuffer(concurrent);
+    }
+  }
+}
+
 void printNetworkBufferFillState() {
   if (!Network::lastCreated) {
     E_WARNING("No network created, or last created network has been deleted...");
@@ -1049,9 +1321,140 @@ void Network::checkBufferSizes() {
       source->setBufferInfo(sbuf);
     }
   }
+
+  // start the warm-up phase of the adaptive mode
+  _bufferObservations.clear();
+  _warmupLeft = 0;
+
+  if (_adaptiveBuffers) {
+    for (int i=0; i<(int)algos.size(); i++) {
+      for (Algorithm::OutputMap::const_iterator output = algos[i]->outputs().begin();
+           output != algos[i]->outputs().end();
+           ++output) {
+        // proxies do not own a buffer, the source they proxy will be observed by its own algorithm
+        if (dynamic_cast<SourceProxyBase*>(output->second)) continue;
+
+        BufferObservation obs;
+        obs.source = output->second;
+        obs.startOccupancy = obs.startProduced = 0;
+        obs.peakOccupancy = obs.maxAcquireSize = obs.reschedulings = 0;
+        _bufferObservations.push_back(obs);
+      }
+    }
+    _warmupLeft = _warmupSteps;
+  }
+
   E_DEBUG(ENetwork, "checking buffer sizes ok");
 }
 
 
+void Network::setAdaptiveBufferSizes(bool adaptive, int warmupSteps) {
+  if (warmupSteps < 1) {
+    throw EssentiaException("Network: the number of warm-up steps for adaptive buffer sizes should be at least 1");
+  }
+  _adaptiveBuffers = adaptive;
+  _warmupSteps = warmupSteps;
+}
+
+void Network::startBufferObservation() {
+  for (int i=0; i<(int)_bufferObservations.size(); i++) {
+    BufferObservation& obs = _bufferObservations[i];
+    obs.startOccupancy = obs.source->bufferInfo().size - obs.source->available();
+    obs.startProduced = obs.source->totalProduced();
+  }
+}
+
+void Network::recordRescheduling(Algorithm* algo) {
+  for (int i=0; i<(int)_bufferObservations.size(); i++) {
+    BufferObservation& obs = _bufferObservations[i];
+    if (obs.source->parent() == algo && obs.source->available() < obs.source->acquireSize()) {
+      obs.reschedulings++;
+    }
+  }
+}
+
+void Network::endBufferObservation(bool endOfStream) {
+  for (int i=0; i<(int)_bufferObservations.size(); i++) {
+    BufferObservation& obs = _bufferObservations[i];
+    SourceBase* source = obs.source;
+
+    // the children of an algorithm only run after it in a step, so if it had
+    // not been rescheduled, the buffer would have had to hold everything that
+    // was in there at the beginning plus everything produced during the step
+    int needed = obs.startOccupancy + source->totalProduced() - obs.startProduced;
+    obs.peakOccupancy = max(obs.peakOccupancy, needed);
+
+    obs.maxAcquireSize = max(obs.maxAcquireSize, source->acquireSize());
+    const vector<SinkBase*>& sinks = source->sinks();
+    for (int j=0; j<(int)sinks.size(); j++) {
+      obs.maxAcquireSize = max(obs.maxAcquireSize, sinks[j]->acquireSize());
+    }
+  }
+
+  // also resize if the stream ended during the warm-up, so that the next run
+  // of the network gets the benefits
+  if (--_warmupLeft == 0 || endOfStream) {
+    _warmupLeft = 0;
+    resizeObservedBuffers();
+  }
+}
+
+void Network::resizeObservedBuffers() {
+  long long memoryBefore = 0, memoryAfter = 0;
+  int nresized = 0;
+
+  for (int i=0; i<(int)_bufferObservations.size(); i++) {
+    const BufferObservation& obs = _bufferObservations[i];
+    SourceBase* source = obs.source;
+    BufferInfo info = source->bufferInfo();
+    BufferInfo chosen = info;
+
+    chosen.maxContiguousElements = max(info.maxContiguousElements, obs.maxAcquireSize);
+
+    // leave some headroom for rates varying more than during the warm-up
+    if (obs.peakOccupancy > info.size) {
+      chosen.size = obs.peakOccupancy + obs.peakOccupancy / 4;
+    }
+    chosen.size = max(chosen.size, chosen.maxContiguousElements + 1);
+
+    memoryBefore += (long long)(info.size + info.maxContiguousElements) * source->tokenSize();
+    memoryAfter += (long long)(chosen.size + chosen.maxContiguousElements) * source->tokenSize();
+
+    if (chosen.size == info.size && chosen.maxContiguousElements == info.maxContiguousElements) continue;
+
+    E_DEBUG(ENetwork, "Adaptive buffer sizes: resizing buffer of " << source->fullName()
+            << " from " << info.size << "/" << info.maxContiguousElements
+            << " to " << chosen.size << "/" << chosen.maxContiguousElements
+            << " (" << obs.reschedulings << " reschedulings during warm-up)");
+
+    source->setBufferInfo(chosen);
+    nresized++;
+  }
+
+  E_DEBUG(ENetwork, "Adaptive buffer sizes: resized " << nresized << " out of " << _bufferObservations.size()
+          << " buffers, buffer memory is now " << memoryAfter / 1024 << " kB (was "
+          << memoryBefore / 1024 << " kB)");
+
+  _bufferObservations.clear();
+}
+
+long long Network::bufferMemory() const {
+  vector<Algorithm*> algos = depthFirstMap(_executionNetworkRoot, returnAlgorithm);
+  long long memory = 0;
+
+  for (int i=0; i<(int)algos.size(); i++) {
+    for (Algorithm::OutputMap::const_iterator output = algos[i]->outputs().begin();
+         output != algos[i]->outputs().end();
+         ++output) {
+      if (dynamic_cast<SourceProxyBase*>(output->second)) continue;
+      BufferInfo info = output->second->bufferInfo();
+      memory += (long long)(info.size + info.maxContiguousElements) * output->second->tokenSize();
+    }
+  }
+
+  return memory;
+}
+
+
 } // namespace scheduler
 } // namespace essentia
@@ -33,6 +33,13 @@ class AlgorithmComposite;
 class SourceBase;
 
 } // namespace streaming
+
+namespace scheduler {
+
+class ParallelExecutor;
+class NetworkProfiler;
+
+} // namespace scheduler
 } // namespace essentia
 
 
@@ -115,8 +122,16 @@ class Network {
    * the source generator are processed by all the algorithms.
    *
    * Internally it just calls runPrepare and then runStep repeatedly.
+   *
+   * If @c numThreads is greater than 1, the nodes of the execution network
+   * are run on a pool of that many threads (see ParallelExecutor): each time
+   * the generator has produced tokens, all the nodes whose parents are done
+   * can be run concurrently. A value of 0 uses as many threads as there are
+   * cores on the machine. If the outputs of the generator are concurrent
+   * buffers (see setConcurrentBuffers()), the generator also produces the
+   * tokens of the next step while the nodes consume those of the current one.
    */
-  void run();
+  void run(int numThreads = 1);
 
   /**
    * Does the preparation needed to process the tokens of the network
@@ -196,6 +211,77 @@ class Network {
    */
   void printBufferFillState();
 
+  /**
+   * Switch all the buffers of the execution network to ConcurrentPhantomBuffers
+   * (or back to the default PhantomBuffers), so that their writer and readers
+   * can run on different threads. Needs to be called before running the network.
+   * This lets run() run the generator ahead of the other nodes when it uses
+   * more than one thread.
+   */
+  void setConcurrentBuffers(bool concurrent);
+
+  /**
+   * Enable or disable the profiling of the network. When enabled, the next call
+   * to run() (or runPrepare()) creates a NetworkProfiler which records the calls
+   * to process() of all the algorithms in the execution network.
+   */
+  void setProfiling(bool enabled) { _profiling = enabled; }
+  bool isProfiling() const { return _profiling; }
+
+  /**
+   * Returns the profiler of the last run, 0 if profiling was not enabled.
+   */
+  NetworkProfiler* profiler() const { return _profiler; }
+
+  /**
+   * Enable or disable the adaptive mode of checkBufferSizes(). In this mode,
+   * the first @c warmupSteps calls to runStep() of each run are used to record,
+   * for each buffer, how many tokens it needs to hold during a step and the
+   * largest acquire sizes of its source and sinks. The buffers are then resized
+   * (keeping their content) so that for the rest of the run no algorithm needs
+   * to be rescheduled because its output buffers are full. Buffers are only
+   * ever grown, and keep their new size for the following runs.
+   */
+  void setAdaptiveBufferSizes(bool adaptive, int warmupSteps = 32);
+  bool isAdaptiveBufferSizes() const { return _adaptiveBuffers; }
+
+  /**
+   * Returns the memory taken by all the buffers of the execution network, in
+   * bytes. For tokens which are containers (eg: vectors), only the size of the
+   * container itself is taken into account, not the memory it points to.
+   */
+  long long bufferMemory() const;
+
+  /**
+   * Enable or disable the merging of duplicate algorithms, which is done by
+   * runPrepare() and is disabled by default. Two algorithms are duplicates if
+   * they have the same type and parameters and their inputs are connected to
+   * the same sources, in which case they compute exactly the same thing. All
+   * the sinks connected to the outputs of one of them are then connected to the
+   * other one instead, and the first one is disconnected from the network so
+   * that it is not run anymore. This is repeated until no duplicates are left,
+   * so that identical chains of algorithms (eg: FrameCutter → Windowing →
+   * Spectrum) are merged as a whole.
+   *
+   * Only algorithms which are visible at the top level of the network are
+   * considered (ie: composites and the algorithms inside them are left
+   * untouched). Algorithms which use random numbers (eg: NoiseAdder, or a
+   * FrameCutter adding noise to silent frames) are never merged, the other
+   * ones are assumed to be deterministic.
+   *
+   * The merges are undone by reset() and clear(), and at the beginning of each
+   * runPrepare(), which then looks for duplicates again, so that changes to the
+   * parameters or to this setting are taken into account.
+   */
+  void setMergeDuplicates(bool merge) { _mergeDuplicates = merge; }
+  bool isMergeDuplicates() const { return _mergeDuplicates; }
+
+  /**
+   * Returns the algorithms which have been disconnected from the network
+   * because they were duplicates of another one (see setMergeDuplicates()).
+   */
+  const std::vector<streaming::Algorithm*>& mergedAlgorithms() const { return _mergedAlgorithms; }
+
   /**
    * Last instance of Network created, 0 if it has been deleted or if
    * no network has been created yet.
@@ -209,6 +295,75 @@ class Network {
   NetworkNode* _executionNetworkRoot;
   std::vector<streaming::Algorithm*> _toposortedNetwork;
 
+  /**
+   * Executor used by runStep() to run the nodes after the generator, only
+   * set while running in parallel (see run()), 0 otherwise.
+   */
+  ParallelExecutor* _executor;
+
+  /**
+   * Whether the generator is run ahead of the nodes by the executor, and
+   * whether it has already been run for the next step.
+   */
+  bool _pipelineGenerator;
+  bool _generatorAhead;
+
+  bool _profiling;
+  NetworkProfiler* _profiler;
+
+  /**
+   * What has been observed of a buffer during the warm-up phase of the adaptive
+   * buffer sizing (see setAdaptiveBufferSizes()).
+   */
+  struct BufferObservation {
+    streaming::SourceBase* source;
+    int startOccupancy;  // number of unread tokens at the beginning of the step
+    int startProduced;   // number of tokens produced at the beginning of the step
+    int peakOccupancy;   // max number of tokens the buffer had to hold in a step
+    int maxAcquireSize;  // of the source and all its sinks
+    int reschedulings;   // number of times the source algorithm was rescheduled while this buffer was full
+  };
+
+  bool _adaptiveBuffers;
+  int _warmupSteps;
+  int _warmupLeft;
+  std::vector<BufferObservation> _bufferObservations;
+
+  void startBufferObservation();
+  // can be called concurrently for different algorithms (see ParallelExecutor)
+  void recordRescheduling(streaming::Algorithm* algo);
+  void endBufferObservation(bool endOfStream);
+  void resizeObservedBuffers();
+
+  bool _mergeDuplicates;
+  std::vector<streaming::Algorithm*> _mergedAlgorithms;
+
+  /**
+   * How a merged algorithm was connected, so that it can be put back in place.
+   */
+  struct MergedConnections {
+    streaming::Algorithm* into;
+    std::vector<streaming::SourceBase*> sources;          // connected to each of its inputs
+    std::vector<std::vector<streaming::SinkBase*> > sinks; // connected to each of its outputs
+  };
+  std::vector<MergedConnections> _mergedConnections; // in the same order as _mergedAlgorithms
+
+  /**
+   * Merge the duplicate algorithms of the execution network, and return the
+   * number of algorithms which have been merged. The execution network needs
+   * to be rebuilt afterwards if it is not 0.
+   */
+  int mergeDuplicateAlgorithms();
+  static bool isMergeable(streaming::Algorithm* algo);
+  static bool areDuplicates(streaming::Algorithm* algo1, streaming::Algorithm* algo2);
+  void mergeAlgorithm(streaming::Algorithm* algo, streaming::Algorithm* into);
+
+  /**
+   * Reconnect the merged algorithms the way they were before being merged,
+   * in the reverse order of the merges.
+   */
+  void unmergeDuplicateAlgorithms();
+
   /**
    * Build the network of visibly connected algorithms (ie: do not enter composite
    * algorithms) and stores its root in @c _visibleNetworkRoot.
@@ -250,6 +405,8 @@ class Network {
    * Check for all the connections that the source buffer size (phantom size,
    * actually) is at least as big as the preferred size of the connected sink.
    * If not, it automatically resizes the source buffer.
+   * In adaptive mode, it also starts the warm-up phase which will resize the
+   * buffers depending on their actual usage (see setAdaptiveBufferSizes()).
    */
   void checkBufferSizes();
 
@@ -0,0 +1,279 @@
+/*
+ * Copyright (C) 2006-2016  Music Technology Group - Universitat Pompeu Fabra
+ *
+ * This file is part of Essentia
+ *
+ * Essentia is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ */
+
+#include <chrono>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <ctime>
+#include "networkprofiler.h"
+using namespace std;
+using namespace essentia;
+using namespace essentia::streaming;
+
+namespace essentia {
+namespace scheduler {
+
+// wall clock time, in seconds
+static inline double wallTime() {
+  return chrono::duration<double>(chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// CPU time consumed by the calling thread, in seconds
+static inline double threadCpuTime() {
+#ifdef OS_WIN32
+  FILETIME creation, exit, kernel, user;
+  GetThreadTimes(GetCurrentThread(), &creation, &exit, &kernel, &user);
+  ULARGE_INTEGER k, u;
+  k.LowPart = kernel.dwLowDateTime; k.HighPart = kernel.dwHighDateTime;
+  u.LowPart = user.dwLowDateTime;   u.HighPart = user.dwHighDateTime;
+  return (k.QuadPart + u.QuadPart) * 1e-7;
+#else
+  timespec ts;
+  clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+#endif
+}
+
+static string jsonString(const string& s) {
+  ostringstream result;
+  result << '"';
+  for (int i=0; i<(int)s.size(); i++) {
+    switch (s[i]) {
+    case '"':  result << "\\\""; break;
+    case '\\': result << "\\\\"; break;
+    case '\n': result << "\\n";  break;
+    case '\t': result << "\\t";  break;
+    default:   result << s[i];
+    }
+  }
+  result << '"';
+  return result.str();
+}
+
+static const char* statusName(AlgorithmStatus status) {
+  switch (status) {
+  case OK:        return "OK";
+  case PASS:      return "PASS";
+  case FINISHED:  return "FINISHED";
+  case NO_INPUT:  return "NO_INPUT";
+  case NO_OUTPUT: return "NO_OUTPUT";
+  }
+  return "UNKNOWN";
+}
+
+static int totalConsumed(const Algorithm* algo) {
+  int total = 0;
+  for (int i=0; i<(int)algo->inputs().size(); i++) total += algo->inputs()[i].second->totalConsumed();
+  return total;
+}
+
+static int totalProduced(const Algorithm* algo) {
+  int total = 0;
+  for (int i=0; i<(int)algo->outputs().size(); i++) total += algo->outputs()[i].second->totalProduced();
+  return total;
+}
+
+
+NetworkProfiler::NetworkProfiler(const vector<Algorithm*>& algos, int maxTraceEvents) :
+  _algos(algos), _maxTraceEvents(maxTraceEvents), _startTime(wallTime()) {
+
+  _stats.resize(_algos.size());
+  _consumedAtStart.resize(_algos.size());
+  _producedAtStart.resize(_algos.size());
+
+  for (int i=0; i<(int)_algos.size(); i++) {
+    Algorithm* algo = _algos[i];
+    _index[algo] = i;
+
+    NodeStats& s = _stats[i];
+    s.name = algo->name();
+    s.calls = s.ok = s.noInput = s.noOutput = s.finished = 0;
+    s.wallTime = s.cpuTime = 0.0;
+    s.tokensConsumed = s.tokensProduced = 0;
+
+    for (Algorithm::OutputMap::const_iterator output = algo->outputs().begin();
+         output != algo->outputs().end();
+         ++output) {
+      BufferStats b;
+      b.name = output->first;
+      b.size = output->second->bufferInfo().size;
+      b.peak = 0;
+      s.buffers.push_back(b);
+    }
+
+    _consumedAtStart[i] = totalConsumed(algo);
+    _producedAtStart[i] = totalProduced(algo);
+  }
+
+  if (_maxTraceEvents > 0) _trace.reserve(std::min(_maxTraceEvents, 65536));
+}
+
+
+AlgorithmStatus NetworkProfiler::process(Algorithm* algo) {
+  map<Algorithm*, int>::const_iterator it = _index.find(algo);
+  if (it == _index.end()) return algo->process();
+
+  int idx = it->second;
+  NodeStats& s = _stats[idx];
+
+  double wallStart = wallTime();
+  double cpuStart = threadCpuTime();
+
+  AlgorithmStatus status = algo->process();
+
+  double cpuEnd = threadCpuTime();
+  double wallEnd = wallTime();
+
+  s.calls++;
+  s.wallTime += wallEnd - wallStart;
+  s.cpuTime += cpuEnd - cpuStart;
+
+  switch (status) {
+  case OK:        s.ok++;       break;
+  case FINISHED:  s.finished++; break;
+  case NO_INPUT:  s.noInput++;  break;
+  case NO_OUTPUT: s.noOutput++; break;
+  default: break;
+  }
+
+  // buffers only get fuller when we write to them, so we only need to check here
+  for (int i=0; i<(int)s.buffers.size(); i++) {
+    SourceBase* source = algo->outputs()[i].second;
+    int used = s.buffers[i].size - source->available();
+    if (used > s.buffers[i].peak) s.buffers[i].peak = used;
+  }
+
+  // calls which did not do anything would only clutter the trace
+  if (_maxTraceEvents > 0 && status != NO_INPUT) {
+    ForcedMutexLocker lock(_traceMutex);
+    if ((int)_trace.size() < _maxTraceEvents) {
+      map<std::thread::id, int>::iterator tid = _threadIds.find(std::this_thread::get_id());
+      if (tid == _threadIds.end()) {
+        tid = _threadIds.insert(make_pair(std::this_thread::get_id(), (int)_threadIds.size())).first;
+      }
+
+      TraceEvent event;
+      event.node = idx;
+      event.tid = tid->second;
+      event.start = (wallStart - _startTime) * 1e6;
+      event.duration = (wallEnd - wallStart) * 1e6;
+      event.status = status;
+      _trace.push_back(event);
+    }
+  }
+
+  return status;
+}
+
+
+vector<NetworkProfiler::NodeStats> NetworkProfiler::stats() const {
+  vector<NodeStats> result = _stats;
+
+  for (int i=0; i<(int)_algos.size(); i++) {
+    result[i].tokensConsumed = totalConsumed(_algos[i]) - _consumedAtStart[i];
+    result[i].tokensProduced = totalProduced(_algos[i]) - _producedAtStart[i];
+  }
+
+  return result;
+}
+
+
+string NetworkProfiler::toJson() const {
+  vector<NodeStats> nodes = stats();
+  ostringstream json;
+  json << setprecision(9);
+
+  json << "{\n  \"nodes\": [";
+  for (int i=0; i<(int)nodes.size(); i++) {
+    const NodeStats& s = nodes[i];
+    json << (i ? "," : "") << "\n    {"
+         << "\"name\": " << jsonString(s.name)
+         << ", \"calls\": " << s.calls
+         << ", \"ok\": " << s.ok
+         << ", \"noInput\": " << s.noInput
+         << ", \"noOutput\": " << s.noOutput
+         << ", \"finished\": " << s.finished
+         << ", \"wallTime\": " << s.wallTime
+         << ", \"cpuTime\": " << s.cpuTime
+         << ", \"tokensConsumed\": " << s.tokensConsumed
+         << ", \"tokensProduced\": " << s.tokensProduced
+         << ", \"buffers\": [";
+    for (int j=0; j<(int)s.buffers.size(); j++) {
+      json << (j ? ", " : "")
+           << "{\"name\": " << jsonString(s.buffers[j].name)
+           << ", \"size\": " << s.buffers[j].size
+           << ", \"peak\": " << s.buffers[j].peak << "}";
+    }
+    json << "]}";
+  }
+  json << "\n  ]\n}\n";
+
+  return json.str();
+}
+
+
+string NetworkProfiler::toChromeTrace() const {
+  ForcedMutexLocker lock(_traceMutex);
+  ostringstream json;
+  json << fixed << setprecision(3);
+
+  json << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [";
+
+  // name the threads, so that the main one is easy to spot
+  bool first = true;
+  for (map<std::thread::id, int>::const_iterator it = _threadIds.begin(); it != _threadIds.end(); ++it) {
+    json << (first ? "" : ",") << "\n{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 0, \"tid\": " << it->second
+         << ", \"args\": {\"name\": \"" << (it->second == 0 ? "scheduler" : "worker") << " " << it->second << "\"}}";
+    first = false;
+  }
+
+  for (int i=0; i<(int)_trace.size(); i++) {
+    const TraceEvent& e = _trace[i];
+    json << (first ? "" : ",") << "\n{\"name\": " << jsonString(_stats[e.node].name)
+         << ", \"cat\": \"process\", \"ph\": \"X\", \"pid\": 0, \"tid\": " << e.tid
+         << ", \"ts\": " << e.start << ", \"dur\": " << e.duration
+         << ", \"args\": {\"status\": \"" << statusName(e.status) << "\"}}";
+    first = false;
+  }
+
+  json << "\n]}\n";
+
+  return json.str();
+}
+
+
+static void writeFile(const string& filename, const string& contents) {
+  ofstream file(filename.c_str());
+  if (!file.is_open()) {
+    throw EssentiaException("NetworkProfiler: could not open file for writing: ", filename);
+  }
+  file << contents;
+}
+
+void NetworkProfiler::writeJson(const string& filename) const {
+  writeFile(filename, toJson());
+}
+
+void NetworkProfiler::writeChromeTrace(const string& filename) const {
+  writeFile(filename, toChromeTrace());
+}
+
+} // namespace scheduler
+} // namespace essentia
@@ -0,0 +1,121 @@
+/*
+ * Copyright (C) 2006-2016  Music Technology Group - Universitat Pompeu Fabra
+ *
+ * This file is part of Essentia
+ *
+ * Essentia is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ */
+
+#ifndef ESSENTIA_SCHEDULER_NETWORKPROFILER_H
+#define ESSENTIA_SCHEDULER_NETWORKPROFILER_H
+
+#include <vector>
+#include <map>
+#include <string>
+#include <thread>
+#include "../streaming/streamingalgorithm.h"
+#include "../threading.h"
+
+namespace essentia {
+namespace scheduler {
+
+/**
+ * The NetworkProfiler collects per-algorithm statistics while a Network is
+ * running: number of calls to process() and their return status, wall and CPU
+ * time spent in them, tokens consumed and produced, and the peak occupancy of
+ * each output buffer. It can also record every call to process() as a trace
+ * event, so that the run can be inspected in chrome://tracing.
+ *
+ * It is created by the Network in runPrepare() if profiling has been enabled
+ * with Network::setProfiling(). Each algorithm is only ever run by one thread
+ * at a time, so statistics are gathered without any locking.
+ */
+class NetworkProfiler {
+ public:
+  struct BufferStats {
+    std::string name;
+    int size;
+    int peak; // maximum number of tokens waiting to be read
+  };
+
+  struct NodeStats {
+    std::string name;
+    int calls;
+    int ok, noInput, noOutput, finished;
+    double wallTime; // in seconds
+    double cpuTime;  // in seconds
+    int tokensConsumed;
+    int tokensProduced;
+    std::vector<BufferStats> buffers;
+  };
+
+  /**
+   * @param algos the algorithms to profile, in the order in which they should appear
+   * @param maxTraceEvents maximum number of trace events recorded, 0 disables them
+   */
+  NetworkProfiler(const std::vector<streaming::Algorithm*>& algos, int maxTraceEvents = 1000000);
+
+  /**
+   * Calls process() on the given algorithm and records its statistics.
+   */
+  streaming::AlgorithmStatus process(streaming::Algorithm* algo);
+
+  /**
+   * Returns the statistics of all the algorithms, up to now.
+   */
+  std::vector<NodeStats> stats() const;
+
+  /**
+   * Returns the statistics as a JSON document.
+   */
+  std::string toJson() const;
+
+  /**
+   * Returns the recorded calls as a JSON document in the Chrome trace event
+   * format (load it in chrome://tracing or https://ui.perfetto.dev).
+   */
+  std::string toChromeTrace() const;
+
+  void writeJson(const std::string& filename) const;
+  void writeChromeTrace(const std::string& filename) const;
+
+ protected:
+  struct TraceEvent {
+    int node;
+    int tid;
+    double start; // in microseconds since the creation of the profiler
+    double duration;
+    streaming::AlgorithmStatus status;
+  };
+
+  std::vector<streaming::Algorithm*> _algos;
+  std::map<streaming::Algorithm*, int> _index;
+  std::vector<NodeStats> _stats;
+
+  // totals of the connectors when the profiler was created
+  std::vector<int> _consumedAtStart;
+  std::vector<int> _producedAtStart;
+
+  int _maxTraceEvents;
+  std::vector<TraceEvent> _trace;
+  std::map<std::thread::id, int> _threadIds;
+  mutable ForcedMutex _traceMutex;
+
+  double _startTime;
+};
+
+} // namespace scheduler
+} // namespace essentia
+
+#endif // ESSENTIA_SCHEDULER_NETWORKPROFILER_H
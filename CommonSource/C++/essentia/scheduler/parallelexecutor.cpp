@@ -0,0 +1,326 @@
+/*
+ * Copyright (C) 2006-2016  Music Technology Group - Universitat Pompeu Fabra
+ *
+ * This file is part of Essentia
+ *
+ * Essentia is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ */
+
+#include <algorithm>
+#include "parallelexecutor.h"
+#include "graphutils.h"
+#include "networkprofiler.h"
+#include "../streaming/algorithms/poolstorage.h"
+using namespace std;
+using namespace essentia;
+using namespace essentia::streaming;
+
+namespace essentia {
+namespace scheduler {
+
+const int ParallelExecutor::GeneratorTask;
+
+ParallelExecutor::ParallelExecutor(NetworkNode* root, int numThreads, NetworkProfiler* profiler) :
+  _profiler(profiler), _remaining(0), _endOfStream(false), _generatorRunning(false),
+  _shutdown(false) {
+
+  if (!root) throw EssentiaException("ParallelExecutor: cannot run an empty network");
+
+  // the generator always gets index 0, the other nodes can come in any order
+  NodeVector nodes = depthFirstSearch(root);
+  nodes.erase(std::remove(nodes.begin(), nodes.end(), root), nodes.end());
+  nodes.insert(nodes.begin(), root);
+
+  map<NetworkNode*, int> nodeIndex;
+  for (int i=0; i<(int)nodes.size(); i++) nodeIndex[nodes[i]] = i;
+
+  _nodes.resize(nodes.size());
+  for (int i=0; i<(int)nodes.size(); i++) {
+    _nodes[i].algo = nodes[i]->algorithm();
+    _nodes[i].nParents = 0;
+    _nodes[i].exclusive = 0;
+  }
+
+  for (int i=0; i<(int)nodes.size(); i++) {
+    const NodeVector& children = nodes[i]->children();
+    for (int j=0; j<(int)children.size(); j++) {
+      int c = nodeIndex[children[j]];
+      _nodes[i].children.push_back(c);
+      _nodes[c].nParents++;
+    }
+
+    // a Pool which is not concurrent is not thread-safe, so serialize all the
+    // storages writing to the same one
+    PoolStorageBase* storage = dynamic_cast<PoolStorageBase*>(_nodes[i].algo);
+    if (storage && !storage->pool()->isConcurrent()) {
+      ForcedMutex*& m = _poolMutexes[storage->pool()];
+      if (!m) m = new ForcedMutex();
+      _nodes[i].exclusive = m;
+    }
+  }
+
+  // the storages writing to the same descriptor are run one after the other,
+  // always in the same order, so that its values are always in the same order
+  // too. They are sinks, so that this cannot create a cycle.
+  map<pair<Pool*, string>, int> lastWriter;
+  for (int i=0; i<(int)_nodes.size(); i++) {
+    PoolStorageBase* storage = dynamic_cast<PoolStorageBase*>(_nodes[i].algo);
+    if (!storage) continue;
+
+    pair<Pool*, string> descriptor(storage->pool(), storage->descriptorName());
+    map<pair<Pool*, string>, int>::iterator previous = lastWriter.find(descriptor);
+    if (previous != lastWriter.end()) {
+      _nodes[previous->second].children.push_back(i);
+      _nodes[i].nParents++;
+    }
+    lastWriter[descriptor] = i;
+  }
+
+  _active.resize(_nodes.size());
+  _rescheduled.resize(_nodes.size());
+  _tainted.resize(_nodes.size());
+  _pending.resize(_nodes.size());
+
+  E_DEBUG(EScheduler, "ParallelExecutor: running " << _nodes.size() << " nodes on " << numThreads << " threads");
+
+  for (int i=1; i<numThreads; i++) {
+    _workers.push_back(std::thread(&ParallelExecutor::workerLoop, this));
+  }
+}
+
+ParallelExecutor::~ParallelExecutor() {
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _shutdown = true;
+  }
+  _readyCondition.notify_all();
+  for (int i=0; i<(int)_workers.size(); i++) _workers[i].join();
+
+  for (map<Pool*, ForcedMutex*>::iterator it = _poolMutexes.begin(); it != _poolMutexes.end(); ++it) {
+    delete it->second;
+  }
+}
+
+
+void ParallelExecutor::runNodes(bool endOfStream, bool generatorAhead) {
+  _endOfStream = endOfStream;
+
+  // the generator is not part of the passes, as its children do not need to
+  // wait for it: they consume what it has already produced
+  if (generatorAhead) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _generatorRunning = true;
+    _ready.push_front(GeneratorTask);
+    _readyCondition.notify_one();
+  }
+
+  // first pass: everything but the generator, which has already been run
+  std::fill(_active.begin(), _active.end(), 1);
+  _active[0] = 0;
+
+  while (true) {
+    runPass();
+    if (_error) break;
+
+    // nodes which had their output buffers full need to be run again, and so do
+    // all the nodes which depend on them, as they might get more tokens
+    std::fill(_active.begin(), _active.end(), 0);
+    vector<int> toVisit;
+    for (int i=0; i<(int)_nodes.size(); i++) {
+      if (_rescheduled[i]) toVisit.push_back(i);
+    }
+    if (toVisit.empty()) break;
+
+    while (!toVisit.empty()) {
+      int idx = toVisit.back();
+      toVisit.pop_back();
+      if (_active[idx]) continue;
+      _active[idx] = 1;
+      const vector<int>& children = _nodes[idx].children;
+      for (int j=0; j<(int)children.size(); j++) toVisit.push_back(children[j]);
+    }
+  }
+
+  // wait for the generator, or run it ourselves if no worker has picked it up yet
+  {
+    std::unique_lock<std::mutex> lock(_mutex);
+    deque<int>::iterator task = std::find(_ready.begin(), _ready.end(), (int)GeneratorTask);
+    if (task != _ready.end()) {
+      _ready.erase(task);
+      runTask(GeneratorTask, lock);
+    }
+    while (_generatorRunning) _doneCondition.wait(lock);
+  }
+
+  if (_error) {
+    std::exception_ptr error = _error;
+    _error = std::exception_ptr();
+    std::rethrow_exception(error);
+  }
+}
+
+
+void ParallelExecutor::runPass() {
+  std::unique_lock<std::mutex> lock(_mutex);
+
+  std::fill(_rescheduled.begin(), _rescheduled.end(), 0);
+  std::fill(_tainted.begin(), _tainted.end(), 0);
+  std::fill(_pending.begin(), _pending.end(), 0);
+  _remaining = 0;
+
+  for (int i=0; i<(int)_nodes.size(); i++) {
+    if (!_active[i]) continue;
+    _remaining++;
+    const vector<int>& children = _nodes[i].children;
+    for (int j=0; j<(int)children.size(); j++) {
+      if (_active[children[j]]) _pending[children[j]]++;
+    }
+  }
+
+  for (int i=0; i<(int)_nodes.size(); i++) {
+    if (_active[i] && _pending[i] == 0) _ready.push_back(i);
+  }
+  _readyCondition.notify_all();
+
+  // the calling thread also takes part in the work
+  while (_remaining > 0) {
+    if (_ready.empty()) {
+      _doneCondition.wait(lock);
+      continue;
+    }
+    int idx = _ready.front();
+    _ready.pop_front();
+    runTask(idx, lock);
+  }
+}
+
+
+void ParallelExecutor::workerLoop() {
+  std::unique_lock<std::mutex> lock(_mutex);
+
+  while (true) {
+    while (!_shutdown && _ready.empty()) _readyCondition.wait(lock);
+    if (_shutdown) return;
+
+    int idx = _ready.front();
+    _ready.pop_front();
+    runTask(idx, lock);
+  }
+}
+
+
+// _mutex should be locked before entering this function, it is released while
+// the task is running
+void ParallelExecutor::runTask(int idx, std::unique_lock<std::mutex>& lock) {
+  lock.unlock();
+  if (idx == GeneratorTask) executeGenerator();
+  else execute(idx);
+  lock.lock();
+
+  if (idx == GeneratorTask) {
+    _generatorRunning = false;
+    _doneCondition.notify_all();
+  }
+  else complete(idx);
+}
+
+
+void ParallelExecutor::execute(int idx) {
+  Node& node = _nodes[idx];
+
+  // do not run anything anymore once one of the nodes failed, just let the
+  // pass wind down so that the exception can be rethrown
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_error) return;
+  }
+
+  try {
+    if (node.exclusive) node.exclusive->lock();
+
+    // only propagate the end of stream marker if none of our ancestors is
+    // going to be rescheduled, as they would produce more tokens for us
+    node.algo->shouldStop(_endOfStream && !_tainted[idx]);
+
+    AlgorithmStatus status;
+    do {
+      status = _profiler ? _profiler->process(node.algo) : node.algo->process();
+
+#if DEBUGGING_ENABLED
+      if (status == OK || status == FINISHED) node.algo->nProcess++;
+#endif
+
+    } while (status == OK);
+
+    if (node.exclusive) node.exclusive->unlock();
+
+    if (status == NO_OUTPUT) {
+      _rescheduled[idx] = 1;
+      if (_onRescheduling) _onRescheduling(node.algo);
+      E_DEBUG(EScheduler, "Rescheduling algorithm " << node.algo->name() <<
+              " to run later, output buffers temporarily full");
+    }
+  }
+  catch (...) {
+    if (node.exclusive) node.exclusive->unlock();
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (!_error) _error = std::current_exception();
+  }
+}
+
+
+// runs the generator once, as Network::runStep() would
+void ParallelExecutor::executeGenerator() {
+  streaming::Algorithm* gen = _nodes[0].algo;
+
+  try {
+    if (_profiler) _profiler->process(gen);
+    else gen->process();
+
+#if DEBUGGING_ENABLED
+    gen->nProcess++;
+#endif
+  }
+  catch (...) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (!_error) _error = std::current_exception();
+  }
+}
+
+
+// _mutex should be locked before entering this function
+void ParallelExecutor::complete(int idx) {
+  bool taint = _rescheduled[idx] || _tainted[idx];
+  const vector<int>& children = _nodes[idx].children;
+  int newReady = 0;
+
+  for (int j=0; j<(int)children.size(); j++) {
+    int c = children[j];
+    if (!_active[c]) continue;
+    if (taint) _tainted[c] = 1;
+    if (--_pending[c] == 0) {
+      _ready.push_back(c);
+      newReady++;
+    }
+  }
+
+  _remaining--;
+
+  // we are going to pick one of them ourselves, only wake up workers for the others
+  for (int i=1; i<newReady; i++) _readyCondition.notify_one();
+  _doneCondition.notify_one();
+}
+
+} // namespace scheduler
+} // namespace essentia
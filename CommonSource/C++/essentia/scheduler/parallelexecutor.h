@@ -0,0 +1,143 @@
+/*
+ * Copyright (C) 2006-2016  Music Technology Group - Universitat Pompeu Fabra
+ *
+ * This file is part of Essentia
+ *
+ * Essentia is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ */
+
+#ifndef ESSENTIA_SCHEDULER_PARALLELEXECUTOR_H
+#define ESSENTIA_SCHEDULER_PARALLELEXECUTOR_H
+
+#include <vector>
+#include <deque>
+#include <map>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include "network.h"
+#include "../threading.h"
+
+namespace essentia {
+
+class Pool;
+
+namespace scheduler {
+
+/**
+ * The ParallelExecutor runs the nodes of an execution network on a pool of
+ * worker threads. It is used by Network::run(numThreads) in place of the serial
+ * loop over the topologically sorted network, once the generator has run.
+ *
+ * A node becomes ready when all of its parents in the execution network have
+ * finished consuming their inputs for the current generator step. This means
+ * that a buffer is never written while one of its readers is running, and
+ * readers of the same buffer only ever touch their own read window, so the
+ * PhantomBuffers do not need to be locked. The only exception is the generator
+ * when it is run ahead of the nodes (see runNodes()), which is why it needs
+ * ConcurrentPhantomBuffers then.
+ *
+ * Nodes returning NO_OUTPUT are rescheduled, together with all their
+ * descendants, in a new pass once the current one is complete. The end of
+ * stream is only propagated to a node if none of its ancestors has been
+ * rescheduled in the current pass, which mirrors the runStack logic of
+ * Network::runStep().
+ *
+ * PoolStorage algorithms writing into the same Pool are never run at the same
+ * time, unless the Pool is concurrent (see Pool::setConcurrent()). Those
+ * writing into the same descriptor are always run one after the other, in the
+ * same order, so that the pool is the same from one run to the other.
+ */
+class ParallelExecutor {
+ public:
+  /**
+   * @param root the root of the execution network, ie: the generator
+   * @param numThreads total number of threads used to run the network,
+   *        including the calling thread
+   * @param profiler if non-null, all the calls to process() go through it
+   */
+  ParallelExecutor(NetworkNode* root, int numThreads, NetworkProfiler* profiler = 0);
+  ~ParallelExecutor();
+
+  int numThreads() const { return (int)_workers.size() + 1; }
+
+  /**
+   * Runs all the nodes of the network (except the generator) as many times as
+   * needed for them to consume everything on their inputs. Returns when all
+   * of them are done; rethrows the first exception thrown by any of them.
+   *
+   * If @c generatorAhead is true, the generator is also run once, on one of
+   * the worker threads, while the nodes consume the tokens it produced before.
+   * This is only allowed if all its outputs are ConcurrentPhantomBuffers (see
+   * Source::setConcurrentBuffer()), as it writes to them while their readers
+   * are running.
+   */
+  void runNodes(bool endOfStream, bool generatorAhead = false);
+
+  /**
+   * Sets a function to be called each time a node returns NO_OUTPUT. It is
+   * called from the thread which ran the node, before any of its children can
+   * run, so it can be called concurrently for different nodes.
+   */
+  void setReschedulingCallback(const std::function<void(streaming::Algorithm*)>& callback) {
+    _onRescheduling = callback;
+  }
+
+ protected:
+  struct Node {
+    streaming::Algorithm* algo;
+    std::vector<int> children;
+    int nParents;
+    ForcedMutex* exclusive; // locked while running, if non-null
+  };
+
+  std::vector<Node> _nodes; // _nodes[0] is the generator
+  std::map<Pool*, ForcedMutex*> _poolMutexes;
+  NetworkProfiler* _profiler;
+  std::function<void(streaming::Algorithm*)> _onRescheduling;
+
+  // state of the current pass, guarded by _mutex
+  std::vector<char> _active;
+  std::vector<char> _rescheduled;
+  std::vector<char> _tainted; // an ancestor got rescheduled in this pass
+  std::vector<int> _pending;  // number of active parents not done yet
+  std::deque<int> _ready;
+  int _remaining;
+  bool _endOfStream;
+  std::exception_ptr _error;
+  bool _generatorRunning;
+
+  std::mutex _mutex;
+  std::condition_variable _readyCondition;
+  std::condition_variable _doneCondition;
+  bool _shutdown;
+  std::vector<std::thread> _workers;
+
+  // index of the task running the generator ahead of the nodes in _ready
+  static const int GeneratorTask = -1;
+
+  void workerLoop();
+  void runPass();
+  void runTask(int idx, std::unique_lock<std::mutex>& lock);
+  void execute(int idx);
+  void executeGenerator();
+  void complete(int idx);
+};
+
+} // namespace scheduler
+} // namespace essentia
+
+#endif // ESSENTIA_SCHEDULER_PARALLELEXECUTOR_H
@@ -0,0 +1,411 @@
+/*
+ * Copyright (C) 2006-2016  Music Technology Group - Universitat Pompeu Fabra
+ *
+ * This file is part of Essentia
+ *
+ * Essentia is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ */
+
+#include "onlinepoolaggregator.h"
+#include "../../essentiamath.h"
+#include "../../utils/tnt/tnt.h"
+#include "../../utils/tnt/jama_lu.h"
+using namespace std;
+
+namespace essentia {
+namespace streaming {
+
+// names of the statistics, in the order of OnlineStatistics::Statistic
+static const char* statisticNames[] =
+  {"min", "max", "median", "mean", "var", "stdev", "skew", "kurt",
+   "dmean", "dvar", "dmean2", "dvar2",
+   "cov", "icov",
+   "last"};
+
+#define STAT(s) (1u << OnlineStatistics::s)
+
+static const unsigned int derivativeStats = STAT(DMean) | STAT(DVar) | STAT(DMean2) | STAT(DVar2);
+static const unsigned int secondDerivativeStats = STAT(DMean2) | STAT(DVar2);
+static const unsigned int covarianceStats = STAT(Cov) | STAT(ICov);
+
+#undef STAT
+
+// increments of the desired positions of the P-square markers of the median
+static const double medianIncrements[5] = { 0.0, 0.25, 0.5, 0.75, 1.0 };
+
+
+OnlineStatistics::OnlineStatistics(const vector<string>& stats) : _mask(0), _order(0) {
+  for (int i=0; i<(int)stats.size(); i++) {
+    if (stats[i] == "last" && stats.size() != 1) {
+      throw EssentiaException("OnlinePoolAggregator: the 'last' aggregation statistic "
+                              "is exclusive, it cannot be used with other "
+                              "statistics for the same descriptor");
+    }
+    if (stats[i] == "copy" || stats[i] == "value") {
+      throw EssentiaException("OnlinePoolAggregator: the '", stats[i], "' aggregation statistic "
+                              "needs all the frames, it cannot be computed online");
+    }
+
+    int stat = 0;
+    while (stat < NumberOfStatistics && stats[i] != statisticNames[stat]) stat++;
+    if (stat == NumberOfStatistics) {
+      throw EssentiaException("OnlinePoolAggregator: unsupported aggregation statistic: '" + stats[i] + "'");
+    }
+
+    _names.push_back(stats[i]);
+    _stats.push_back(Statistic(stat));
+    _mask |= 1u << stat;
+  }
+
+  if (has(Mean) || (_mask & covarianceStats)) _order = 1;
+  if (has(Var) || has(Stdev)) _order = 2;
+  if (has(Skew)) _order = 3;
+  if (has(Kurt)) _order = 4;
+
+  clear();
+}
+
+void OnlineStatistics::clear() {
+  _size = 0;
+  _count = 0;
+  _invalid = false;
+}
+
+void OnlineStatistics::initialize(int size) {
+  _size = size;
+
+  if (has(Min) || has(Max)) {
+    _min.assign(size, 0.0);
+    _max.assign(size, 0.0);
+  }
+
+  if (has(Mean)) _sum.assign(size, 0.0);
+  if (_order > 0) _mean.assign(size, 0.0);
+  if (_order > 1) _m2.assign(size, 0.0);
+  if (_order > 2) _m3.assign(size, 0.0);
+  if (_order > 3) _m4.assign(size, 0.0);
+
+  if (_mask & covarianceStats) {
+    _comoment.assign(size*(size+1)/2, 0.0);
+    _deviation.assign(size, 0.0);
+  }
+
+  if (_mask & derivativeStats) {
+    _previous.assign(size, 0.0);
+    _previousDerivative.assign(size, 0.0);
+    _dSum.assign(size, 0.0);
+    _d2Sum.assign(size, 0.0);
+    _dMean.assign(size, 0.0);
+    _dM2.assign(size, 0.0);
+    _d2Mean.assign(size, 0.0);
+    _d2M2.assign(size, 0.0);
+  }
+
+  if (has(Median)) {
+    _heights.assign(5*size, 0.0);
+    _positions.assign(5*size, 0);
+    _firstFrames.clear();
+    _firstFrames.reserve(MedianExactFrames*size);
+  }
+}
+
+bool OnlineStatistics::add(const Real* frame, int size) {
+  if (_invalid) return true;
+
+  if (_count == 0) initialize(size);
+  else if (size != _size) {
+    _invalid = true;
+    return false;
+  }
+
+  _count++;
+  double n = _count;
+
+  if (has(Min) || has(Max)) {
+    if (_count == 1) {
+      for (int j=0; j<size; j++) _min[j] = _max[j] = frame[j];
+    }
+    else {
+      for (int j=0; j<size; j++) {
+        _min[j] = min(_min[j], frame[j]);
+        _max[j] = max(_max[j], frame[j]);
+      }
+    }
+  }
+
+  if (has(Last)) _last.assign(frame, frame + size);
+
+  if (has(Mean)) {
+    for (int j=0; j<size; j++) _sum[j] += frame[j];
+  }
+
+  // mean and central moments, updated with the deviation from the previous
+  // mean (Welford, and Pebay for the orders 3 and 4)
+  if (_order > 0) {
+    bool covariance = (_mask & covarianceStats) != 0;
+
+    for (int j=0; j<size; j++) {
+      double deviation = frame[j] - _mean[j];
+      double deviationN = deviation / n;
+      double term = deviation * deviationN * (n - 1);
+      if (covariance) _deviation[j] = deviation;
+
+      _mean[j] += deviationN;
+      if (_order > 3) {
+        _m4[j] += term * deviationN * deviationN * (n*n - 3*n + 3)
+                + 6 * deviationN * deviationN * _m2[j] - 4 * deviationN * _m3[j];
+      }
+      if (_order > 2) _m3[j] += term * deviationN * (n - 2) - 3 * deviationN * _m2[j];
+      if (_order > 1) _m2[j] += term;
+    }
+
+    if (covariance) {
+      double* comoment = &_comoment[0];
+      for (int i=0; i<size; i++) {
+        for (int j=0; j<=i; j++) {
+          *comoment++ += _deviation[i] * (frame[j] - _mean[j]);
+        }
+      }
+    }
+  }
+
+  // mean and variance of the absolute value of the derivatives
+  if (_mask & derivativeStats) {
+    if (_count > 1) {
+      bool second = (_mask & secondDerivativeStats) != 0;
+      for (int j=0; j<size; j++) {
+        Real derivative = frame[j] - _previous[j];
+
+        _dSum[j] += abs(derivative);
+        double value = abs(derivative);
+        double deviation = value - _dMean[j];
+        _dMean[j] += deviation / (_count - 1);
+        _dM2[j] += deviation * (value - _dMean[j]);
+
+        if (second && _count > 2) {
+          _d2Sum[j] += abs(derivative - _previousDerivative[j]);
+          value = abs(derivative - _previousDerivative[j]);
+          deviation = value - _d2Mean[j];
+          _d2Mean[j] += deviation / (_count - 2);
+          _d2M2[j] += deviation * (value - _d2Mean[j]);
+        }
+        _previousDerivative[j] = derivative;
+      }
+    }
+    for (int j=0; j<size; j++) _previous[j] = frame[j];
+  }
+
+  if (has(Median)) addMedian(frame);
+
+  return true;
+}
+
+void OnlineStatistics::addMedian(const Real* frame) {
+  if (_count <= MedianExactFrames) {
+    _firstFrames.insert(_firstFrames.end(), frame, frame + _size);
+    if (_count < MedianExactFrames) return;
+
+    // the initial markers are the minimum, the quartiles and the maximum of
+    // the first frames of each dimension
+    vector<Real> values(MedianExactFrames);
+    for (int i=0; i<5; i++) {
+      _desired[i] = 1 + (MedianExactFrames - 1) * medianIncrements[i];
+    }
+    for (int j=0; j<_size; j++) {
+      for (int k=0; k<MedianExactFrames; k++) values[k] = _firstFrames[k*_size + j];
+      sort(values.begin(), values.end());
+
+      double* heights = &_heights[5*j];
+      int* positions = &_positions[5*j];
+      for (int i=0; i<5; i++) {
+        positions[i] = int(_desired[i]);
+        heights[i] = values[positions[i] - 1];
+      }
+    }
+    return;
+  }
+
+  for (int i=0; i<5; i++) _desired[i] += medianIncrements[i];
+
+  for (int j=0; j<_size; j++) {
+    double* q = &_heights[5*j];
+    int* n = &_positions[5*j];
+    double x = frame[j];
+
+    // find the cell k such that q[k] <= x < q[k+1], extending the extreme
+    // markers if needed, and shift the positions of the markers above it
+    int k;
+    if (x < q[0]) {
+      q[0] = x;
+      k = 0;
+    }
+    else if (x >= q[4]) {
+      q[4] = x;
+      k = 3;
+    }
+    else {
+      k = 0;
+      while (x >= q[k+1]) k++;
+    }
+    for (int i=k+1; i<5; i++) n[i]++;
+
+    // move the middle markers towards their desired positions, with a
+    // piecewise-parabolic interpolation of their heights, or a linear one if
+    // the parabola is not monotonic
+    for (int i=1; i<4; i++) {
+      double d = _desired[i] - n[i];
+      if ((d >= 1 && n[i+1] - n[i] > 1) || (d <= -1 && n[i-1] - n[i] < -1)) {
+        int s = d > 0 ? 1 : -1;
+        double parabolic = q[i] + double(s) / (n[i+1] - n[i-1]) *
+          ((n[i] - n[i-1] + s) * (q[i+1] - q[i]) / (n[i+1] - n[i]) +
+           (n[i+1] - n[i] - s) * (q[i] - q[i-1]) / (n[i] - n[i-1]));
+
+        if (q[i-1] < parabolic && parabolic < q[i+1]) q[i] = parabolic;
+        else q[i] += s * (q[i+s] - q[i]) / (n[i+s] - n[i]);
+        n[i] += s;
+      }
+    }
+  }
+}
+
+Real OnlineStatistics::median(int dimension) const {
+  if (_count > MedianExactFrames) return _heights[5*dimension + 2];
+
+  // exact median of the first frames
+  vector<Real> values(_count);
+  for (int i=0; i<_count; i++) values[i] = _firstFrames[i*_size + dimension];
+  return medianInPlace(values);
+}
+
+void OnlineStatistics::write(Pool& pool, const string& key, bool vectors) const {
+  if (_count == 0 || _invalid) return;
+
+  double n = _count;
+  int dsize = _count - 1;
+  int d2size = _count - 2;
+
+  for (int s=0; s<(int)_stats.size(); s++) {
+    string subkey = key + "." + _names[s];
+
+    if (_stats[s] == Last) {
+      if (vectors) pool.set(key, _last);
+      else pool.set(key, _last[0]);
+      continue;
+    }
+
+    if (_stats[s] == Cov || _stats[s] == ICov) {
+      // only defined for vectors
+      if (!vectors) continue;
+
+      if (_count < 2) {
+        throw EssentiaException("OnlinePoolAggregator: cannot compute the covariance of \"", key, "\" with a single frame");
+      }
+
+      // unbiased estimator, as in SingleGaussian
+      TNT::Array2D<double> cov(_size, _size);
+      const double* comoment = &_comoment[0];
+      for (int i=0; i<_size; i++) {
+        for (int j=0; j<=i; j++) {
+          cov[i][j] = cov[j][i] = *comoment++ / (n - 1);
+        }
+      }
+
+      if (_stats[s] == ICov) {
+        JAMA::LU<double> solver(cov);
+        if (!solver.isNonsingular()) {
+          throw EssentiaException("OnlinePoolAggregator: cannot compute the inverse covariance of \"", key, "\" because it is singular");
+        }
+        TNT::Array2D<double> identity(_size, _size, 0.0);
+        for (int i=0; i<_size; i++) identity[i][i] = 1.0;
+        cov = solver.solve(identity);
+      }
+
+      vector<Real> row(_size);
+      for (int i=0; i<_size; i++) {
+        for (int j=0; j<_size; j++) row[j] = cov[i][j];
+        pool.add(subkey, row);
+      }
+      continue;
+    }
+
+    for (int j=0; j<_size; j++) {
+      Real value = 0;
+      switch (_stats[s]) {
+        case Min: value = _min[j]; break;
+        case Max: value = _max[j]; break;
+        case Median: value = median(j); break;
+        case Mean: value = _sum[j] / _count; break;
+        case Var: value = _m2[j] / n; break;
+        case Stdev: value = sqrt(_m2[j] / n); break;
+
+        case Skew:
+        case Kurt: {
+          Real var = _m2[j] / n;
+          if (_stats[s] == Skew) value = skewnessFromMoments(var, Real(_m3[j] / n));
+          else                   value = (_m4[j] / n) / (var*var) - 3;
+          // as the PoolAggregator, only Reals get 0 for constant values
+          if (!vectors && (std::isnan(value) || std::isinf(value))) value = 0;
+          break;
+        }
+
+        // the derivatives of a single frame are 0
+        case DMean: value = dsize > 0 ? _dSum[j] / dsize : 0; break;
+        case DVar: value = dsize > 0 ? _dM2[j] / dsize : 0; break;
+        case DMean2: value = d2size > 0 ? _d2Sum[j] / d2size : 0; break;
+        case DVar2: value = d2size > 0 ? _d2M2[j] / d2size : 0; break;
+
+        default: break;
+      }
+
+      if (vectors) pool.add(subkey, value);
+      else pool.set(subkey, value);
+    }
+  }
+}
+
+
+#define CREATE_ONLINE_POOL_AGGREGATOR(type)\
+  if (sameType(sourceType, typeid(type))) {\
+     aggregator = new OnlinePoolAggregator<type>(&pool, descriptorName, stats);\
+  }
+
+void connectAggregated(SourceBase& source, Pool& pool, const string& descriptorName,
+                       const vector<string>& stats) {
+
+  const type_info& sourceType = source.typeInfo();
+
+  Algorithm* aggregator = 0;
+
+  CREATE_ONLINE_POOL_AGGREGATOR(Real);
+  CREATE_ONLINE_POOL_AGGREGATOR(int);
+  CREATE_ONLINE_POOL_AGGREGATOR(vector<Real>);
+
+  if (!aggregator) throw EssentiaException("OnlinePoolAggregator doesn't work for type: ", nameOfType(sourceType));
+
+  try {
+    connect(source, aggregator->input("data"));
+  }
+  catch (EssentiaException& e) {
+    delete aggregator;
+    std::ostringstream msg;
+    msg << "While connecting " << source.fullName()
+        << " to the statistics of Pool[" << descriptorName << "]:\n"
+        << e.what();
+    throw EssentiaException(msg);
+  }
+}
+
+
+} // namespace streaming
+} // namespace essentia
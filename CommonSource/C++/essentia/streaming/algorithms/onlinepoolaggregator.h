@@ -0,0 +1,210 @@
+/*
+ * Copyright (C) 2006-2016  Music Technology Group - Universitat Pompeu Fabra
+ *
+ * This file is part of Essentia
+ *
+ * Essentia is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ */
+
+#ifndef ESSENTIA_ONLINEPOOLAGGREGATOR_H
+#define ESSENTIA_ONLINEPOOLAGGREGATOR_H
+
+#include "poolstorage.h"
+
+namespace essentia {
+namespace streaming {
+
+/**
+ * Statistics of a stream of frames of the same size, updated as the frames
+ * arrive, in a memory which does not depend on their number.
+ *
+ * The statistics are those of the PoolAggregator, except 'copy' and 'value'
+ * which need all the frames:
+ * - 'min', 'max', 'mean', 'dmean', 'dmean2' and 'last' are computed as the
+ *   PoolAggregator does, and are identical to its ones;
+ * - the central moments ('var', 'stdev', 'skew', 'kurt', 'dvar', 'dvar2') and
+ *   the covariance ('cov', 'icov') are computed in a single pass in double
+ *   precision (Welford's and Pebay's updates), whereas the PoolAggregator
+ *   computes them in float around the final mean. They agree within 1e-4,
+ *   relatively for the variances, and absolutely for 'skew' and 'kurt', and
+ *   within 1e-3 relatively for 'cov' and 'icov';
+ * - the median is exact up to MedianExactFrames (100) frames. After that, it
+ *   is estimated with the P-square algorithm (Jain and Chlamtac, 1985), which
+ *   tracks 5 markers per dimension. Its rank error depends on the
+ *   distribution of the values and is not bounded: it is a few percent on
+ *   smooth distributions, and reaches 15% on skewed ones (x^3 of uniform
+ *   values), so the median is an estimate which should not be compared
+ *   exactly with the PoolAggregator's one.
+ */
+class OnlineStatistics {
+ public:
+  enum Statistic {
+    Min, Max, Median, Mean, Var, Stdev, Skew, Kurt,
+    DMean, DVar, DMean2, DVar2,
+    Cov, ICov,
+    Last,
+    NumberOfStatistics
+  };
+
+  /**
+   * @param stats the names of the statistics, as given to the PoolAggregator
+   */
+  explicit OnlineStatistics(const std::vector<std::string>& stats);
+
+  void clear();
+
+  /**
+   * Adds a frame of @c size values. Returns false if its size is not the one
+   * of the previous frames, in which case the statistics are not computed.
+   */
+  bool add(const Real* frame, int size);
+
+  int count() const { return _count; }
+
+  /**
+   * Adds the statistics to @c pool, with the names and layout used by the
+   * PoolAggregator for a descriptor named @c key made of Reals, or of vectors
+   * of Reals if @c vectors is true. Nothing is added if no frame (or frames of
+   * different sizes) has been given.
+   */
+  void write(Pool& pool, const std::string& key, bool vectors) const;
+
+ protected:
+  std::vector<std::string> _names;
+  std::vector<Statistic> _stats;
+  unsigned int _mask;
+  int _order; // highest central moment needed
+
+  int _size;
+  int _count;
+  bool _invalid;
+
+  std::vector<Real> _min, _max, _last;
+  // sum of the values, in float as the PoolAggregator computes the mean
+  std::vector<Real> _sum;
+  // mean, and sums of the powers of the deviations from it
+  std::vector<double> _mean, _m2, _m3, _m4;
+  // co-moments (the lower triangle of a _size x _size matrix)
+  std::vector<double> _comoment;
+  std::vector<double> _deviation;
+
+  // sum, mean and sum of the squared deviations of the absolute value of the
+  // first and second derivatives
+  std::vector<Real> _previous, _previousDerivative;
+  std::vector<Real> _dSum, _d2Sum;
+  std::vector<double> _dMean, _dM2, _d2Mean, _d2M2;
+
+  // P-square markers of the median: 5 heights and positions per dimension,
+  // and the desired positions, which are the same for all of them. The first
+  // MedianExactFrames frames are kept, for their exact median and to
+  // initialize the markers.
+  static const int MedianExactFrames = 100;
+  std::vector<double> _heights;
+  std::vector<int> _positions;
+  double _desired[5];
+  std::vector<Real> _firstFrames;
+
+  bool has(Statistic stat) const { return (_mask & (1u << stat)) != 0; }
+  void initialize(int size);
+  void addMedian(const Real* frame);
+  Real median(int dimension) const;
+};
+
+
+/**
+ * Sink which computes statistics of a descriptor as its tokens arrive, and adds
+ * them to a Pool at the end of the stream, instead of storing all the tokens
+ * as the PoolStorage does. The statistics are added as if the PoolAggregator
+ * had computed them for a descriptor named @c descriptorName.
+ */
+template <typename TokenType>
+class OnlinePoolAggregator : public PoolStorageBase {
+ protected:
+  Sink<TokenType> _descriptor;
+  OnlineStatistics _statistics;
+
+ public:
+  OnlinePoolAggregator(Pool* pool, const std::string& descriptorName,
+                       const std::vector<std::string>& stats) :
+    PoolStorageBase(pool, descriptorName), _statistics(stats) {
+
+    setName("OnlinePoolAggregator");
+    declareInput(_descriptor, 1, "data", "the input data");
+  }
+
+  ~OnlinePoolAggregator() {}
+
+  void declareParameters() {}
+
+  AlgorithmStatus process() {
+    EXEC_DEBUG("process(), for desc: " << _descriptorName);
+
+    int ntokens = std::min(_descriptor.available(),
+                           _descriptor.buffer().bufferInfo().maxContiguousElements);
+    ntokens = std::max(ntokens, 1);
+
+    if (_descriptor.acquire(ntokens)) {
+      const std::vector<TokenType>& tokens = _descriptor.tokens();
+      for (int i=0; i<ntokens; i++) addToStatistics(tokens[i]);
+      _descriptor.release(ntokens);
+      return OK;
+    }
+
+    if (!shouldStop()) return NO_INPUT;
+
+    // end of the stream: all the tokens have been aggregated
+    EXEC_DEBUG("adding the statistics to the pool");
+    _statistics.write(*_pool, _descriptorName, sameType(typeid(TokenType), typeid(std::vector<Real>)));
+
+    return FINISHED;
+  }
+
+  void reset() {
+    Algorithm::reset();
+    _statistics.clear();
+  }
+
+  void addToStatistics(const Real& value) {
+    if (!_statistics.add(&value, 1)) warnFrameSize();
+  }
+
+  void addToStatistics(int value) {
+    addToStatistics(Real(value));
+  }
+
+  void addToStatistics(const std::vector<Real>& value) {
+    if (!_statistics.add(value.empty() ? 0 : &value[0], (int)value.size())) warnFrameSize();
+  }
+
+  void warnFrameSize() {
+    E_WARNING("OnlinePoolAggregator: not aggregating \"" << _descriptorName << "\" because it has frames of different sizes");
+  }
+
+};
+
+
+/**
+ * Connect a source (eg: the output of an algorithm) to a Pool through an
+ * OnlinePoolAggregator: instead of all the tokens, only the given statistics
+ * are stored, under the name '<descriptorName>.<stat>', once the stream is
+ * over. The source must output Reals, ints or vectors of Reals.
+ */
+void connectAggregated(SourceBase& source, Pool& pool,
+                       const std::string& descriptorName,
+                       const std::vector<std::string>& stats);
+
+} // namespace streaming
+} // namespace essentia
+
+#endif // ESSENTIA_ONLINEPOOLAGGREGATOR_H
@@ -52,10 +52,14 @@ template <typename TokenType, typename StorageType = TokenType>
 class PoolStorage : public PoolStorageBase {
  protected:
   Sink<TokenType> _descriptor;
+  // the descriptor name interned by the pool, with which the tokens are added
+  // without looking it up
+  DescriptorHandle _handle;
 
  public:
   PoolStorage(Pool* pool, const std::string& descriptorName, bool setSingle = false) :
-    PoolStorageBase(pool, descriptorName, setSingle) {
+    PoolStorageBase(pool, descriptorName, setSingle),
+    _handle(pool->registerDescriptor(descriptorName)) {
 
     setName("PoolStorage");
     declareInput(_descriptor, 1, "data", "the input data");
@@ -81,7 +85,7 @@ class PoolStorage : public PoolStorageBase {
 
     EXEC_DEBUG("appending tokens to pool");
     if (ntokens > 1) {
-      _pool->append(_descriptorName, _descriptor.tokens());
+      _pool->append(_handle, _descriptor.tokens());
     }
     else {
       addToPool((StorageType)_descriptor.firstToken());
@@ -97,25 +101,25 @@ class PoolStorage : public PoolStorageBase {
   void addToPool(const std::vector<T>& value) {
     if (_setSingle) {
       for (int i=0; i<(int)value.size();++i)
-      _pool->add(_descriptorName, value[i]);
+      _pool->add(_handle, value[i]);
     }
-    else _pool->add(_descriptorName, value);
+    else _pool->add(_handle, value);
   }
 
   void addToPool(const std::vector<Real>& value) {
     if (_setSingle) _pool->set(_descriptorName, value);
-    else            _pool->add(_descriptorName, value);
+    else            _pool->add(_handle, value);
   }
 
   template <typename T>
   void addToPool(const T& value) {
     if (_setSingle) _pool->set(_descriptorName, value);
-    else            _pool->add(_descriptorName, value);
+    else            _pool->add(_handle, value);
    }
 
   template <typename T>
   void addToPool(const TNT::Array2D<T>& value) {
-    _pool->add(_descriptorName, value);
+    _pool->add(_handle, value);
     /*
       if (_setSingle) {
       throw EssentiaException("PoolStorage::addToPool, setting Array2D as single value"
@@ -131,7 +135,7 @@ class PoolStorage : public PoolStorageBase {
                               " is not supported by Pool.");
     }
     else {
-      _pool->add(_descriptorName, value);
+      _pool->add(_handle, value);
     }
   }
 
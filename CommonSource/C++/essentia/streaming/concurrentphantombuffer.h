@@ -0,0 +1,178 @@
+/*
+ * Copyright (C) 2006-2016  Music Technology Group - Universitat Pompeu Fabra
+ *
+ * This file is part of Essentia
+ *
+ * Essentia is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ */
+
+#ifndef ESSENTIA_CONCURRENTPHANTOMBUFFER_H
+#define ESSENTIA_CONCURRENTPHANTOMBUFFER_H
+
+#include <vector>
+#include <atomic>
+#include "multiratebuffer.h"
+#include "phantombuffer.h"
+#include "../roguevector.h"
+#include "../essentiautil.h"
+
+
+namespace essentia {
+namespace streaming {
+
+/**
+ * The ConcurrentPhantomBuffer class is a lock-free version of the PhantomBuffer,
+ * which allows the writer (Source) and each of the readers (Sinks) to live on
+ * different threads. It has the same memory layout and the same phantom zone
+ * semantics as the PhantomBuffer.
+ *
+ * Each window is only ever modified by the thread that owns it; the only shared
+ * state is the total number of tokens written and, for each reader, the total
+ * number of tokens read. These are published with release semantics once the
+ * tokens have been written (including their replica in the phantom zone) or
+ * consumed, so that the other side never sees a window it is not allowed to
+ * touch yet. Reader states are kept on separate cache lines so that readers do
+ * not invalidate each other's caches.
+ *
+ * Only the methods used for streaming (acquire/release/available/views) are
+ * thread-safe. Adding or removing readers, resizing and resetting the buffer
+ * should only be done while no one is using it.
+ */
+template <typename T>
+class ConcurrentPhantomBuffer : public MultiRateBuffer<T> {
+
+ public:
+
+  ConcurrentPhantomBuffer(SourceBase* parent, BufferUsage::BufferUsageType type) :
+    _parent(parent), _bufferSize(0), _phantomSize(0), _written(0) {
+    setBufferType(type);
+  }
+
+  ConcurrentPhantomBuffer(SourceBase* parent, const BufferInfo& info) :
+    _parent(parent), _bufferSize(0), _phantomSize(0), _written(0) {
+    setBufferInfo(info);
+  }
+
+  ~ConcurrentPhantomBuffer() {
+    for (int i=0; i<(int)_readers.size(); i++) delete _readers[i];
+  }
+
+  void setBufferType(BufferUsage::BufferUsageType type) {
+    setBufferInfo(defaultBufferInfo(type));
+  }
+
+  BufferInfo bufferInfo() const {
+    BufferInfo info;
+    info.size = _bufferSize;
+    info.maxContiguousElements = _phantomSize;
+    return info;
+  }
+
+  void setBufferInfo(const BufferInfo& info) {
+    resize(info.size, info.maxContiguousElements);
+  }
+
+  const std::vector<T>& readView(ReaderID id) const { return _readers[id]->view; }
+  std::vector<T>& writeView() { return _writeView; }
+
+  bool acquireForRead(ReaderID id, int requested);
+  bool acquireForWrite(int requested);
+
+  void releaseForWrite(int released);
+  void releaseForRead(ReaderID id, int released);
+
+  ReaderID addReader(bool startFromZero = false);
+  void removeReader(ReaderID id);
+
+  int numberReaders() const { return (int)_readers.size(); }
+
+  /**
+   * Resizes the buffer, keeping the tokens which have not been read yet (see
+   * PhantomBuffer::resize()). Not thread-safe.
+   */
+  void resize(int size, int phantomSize);
+
+  int totalTokensWritten() const {
+    return (int)_written.load(std::memory_order_acquire);
+  }
+
+  int totalTokensRead(ReaderID id) const {
+    return (int)_readers[id]->total.load(std::memory_order_acquire);
+  }
+
+  /**
+   * WARNING: only call this from the writer thread, or when the buffer is not
+   * being written to.
+   */
+  const T& lastTokenProduced() const {
+    if (_written.load(std::memory_order_acquire) == 0) {
+      throw EssentiaException("Tried to call ::lastTokenProduced() on ", _parent->fullName(),
+                              " which hasn't produced any token yet");
+    }
+
+    int idx = _writeWindow.begin;
+    if (idx == 0) return _buffer[_bufferSize-1];
+    return _buffer[idx-1];
+  }
+
+  void reset();
+
+  int availableForRead(ReaderID id) const;
+  int availableForWrite(bool contiguous=true) const;
+
+ protected:
+  // the counters shared between threads are surrounded by this much padding,
+  // so that they sit on a cache line of their own. The buffer and its readers
+  // are allocated with new, which does not honour alignas() for more than the
+  // default alignment before C++17
+  static const int CacheLineSize = 64;
+
+  // the state of a reader, only modified by the thread owning this reader
+  struct Reader {
+    char paddingBefore[CacheLineSize];
+    // total number of tokens read, published for the writer
+    std::atomic<long long> total;
+    char paddingAfter[CacheLineSize - sizeof(std::atomic<long long>)];
+    Window window;
+    RogueVector<T> view;
+
+    Reader() : total(0) {}
+  };
+
+  SourceBase* _parent;
+
+  int _bufferSize, _phantomSize; // bufferSize does not include phantomSize
+  std::vector<T> _buffer;
+
+  // writer state, only modified by the writer thread
+  Window _writeWindow;
+  RogueVector<T> _writeView;
+
+  // total number of tokens written, published for the readers
+  char _paddingBefore[CacheLineSize];
+  std::atomic<long long> _written;
+  char _paddingAfter[CacheLineSize - sizeof(std::atomic<long long>)];
+
+  std::vector<Reader*> _readers;
+
+  void updateReadView(ReaderID id);
+  void updateWriteView();
+};
+
+} // namespace streaming
+} // namespace essentia
+
+#include "concurrentphantombuffer_impl.h"
+
+#endif // ESSENTIA_CONCURRENTPHANTOMBUFFER_H
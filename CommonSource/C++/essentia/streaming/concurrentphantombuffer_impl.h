@@ -0,0 +1,270 @@
+/*
+ * Copyright (C) 2006-2016  Music Technology Group - Universitat Pompeu Fabra
+ *
+ * This file is part of Essentia
+ *
+ * Essentia is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ */
+
+#ifndef ESSENTIA_CONCURRENTPHANTOMBUFFER_IMPL_H
+#define ESSENTIA_CONCURRENTPHANTOMBUFFER_IMPL_H
+
+#include "streamingalgorithm.h"
+
+namespace essentia {
+namespace streaming {
+
+template <typename T>
+ReaderID ConcurrentPhantomBuffer<T>::addReader(bool startFromZero) {
+  // add read window & view, just at where our write window is
+  Reader* r = new Reader();
+  if (!startFromZero) {
+    r->window.end = r->window.begin = _writeWindow.begin;
+    r->total.store(_written.load(std::memory_order_relaxed), std::memory_order_relaxed);
+  }
+  _readers.push_back(r);
+
+  ReaderID id = (int)_readers.size() - 1; // index of last one
+  updateReadView(id);
+
+  return id;
+}
+
+template <typename T>
+void ConcurrentPhantomBuffer<T>::removeReader(ReaderID id) {
+  delete _readers[id];
+  _readers.erase(_readers.begin() + id);
+}
+
+
+/**
+ * This method tries to acquire the requested number of tokens. It returns true
+ * on success, or false if there were not enough tokens available.
+ * It should only be called from the thread owning the given reader.
+ */
+template <typename T>
+bool ConcurrentPhantomBuffer<T>::acquireForRead(ReaderID id, int requested) {
+
+  // see PhantomBuffer::acquireForRead for why we can afford phantomSize + 1 here
+  if (requested > (_phantomSize + 1)) {
+    std::ostringstream msg;
+    msg << "acquireForRead: Requested number of tokens (" << requested << ") > phantom size (" << _phantomSize << ")";
+    msg << " in " << _parent->fullName() << " → " << _parent->sinks()[id]->fullName();
+    throw EssentiaException(msg);
+  }
+
+  if (availableForRead(id) < requested) return false;
+
+  Reader& r = *_readers[id];
+  r.window.end = r.window.begin + requested;
+  updateReadView(id);
+
+  return true;
+}
+
+/**
+ * This method tries to acquire the requested number of tokens. It returns true
+ * on success, or false if there was not enough free space available.
+ * It should only be called from the writer thread.
+ */
+template <typename T>
+bool ConcurrentPhantomBuffer<T>::acquireForWrite(int requested) {
+
+  if (requested > (_phantomSize + 1)) {
+    std::ostringstream msg;
+    msg << "acquireForWrite: Requested number of tokens (" << requested << ") > phantom size (" << _phantomSize << ")";
+    msg << " in " << _parent->fullName();
+    throw EssentiaException(msg);
+  }
+
+  if (availableForWrite() < requested) return false;
+
+  _writeWindow.end = _writeWindow.begin + requested;
+  updateWriteView();
+
+  return true;
+}
+
+template <typename T>
+void ConcurrentPhantomBuffer<T>::releaseForWrite(int released) {
+
+  // error checking:
+  if (released > _writeWindow.end - _writeWindow.begin) {
+    std::ostringstream msg;
+    msg << _parent->fullName() << ": releasing too many tokens (write access): "
+        << released << " instead of " << _writeWindow.end - _writeWindow.begin << " max allowed";
+    throw EssentiaException(msg);
+  }
+
+  // replicate from the beginning to the phantom zone if necessary
+  if (_writeWindow.begin < _phantomSize) {
+    T* first  = &_buffer[_writeWindow.begin];
+    T* last   = &_buffer[std::min(_writeWindow.begin + released, _phantomSize)];
+    T* result = &_buffer[_writeWindow.begin + _bufferSize];
+    fastcopy(result, first, (int)(last-first));
+  }
+  // replicate from the phantom zone to the beginning if necessary
+  else if (_writeWindow.end > _bufferSize) {
+    int beginIdx = std::max(_writeWindow.begin, (int)_bufferSize);
+    T* first  = &_buffer[beginIdx];
+    T* last   = &_buffer[_writeWindow.end];
+    T* result = &_buffer[beginIdx - _bufferSize];
+    fastcopy(result, first, (int)(last-first));
+  }
+
+  _writeWindow.begin += released;
+  if (_writeWindow.begin >= _bufferSize) {
+    _writeWindow.begin -= _bufferSize;
+    _writeWindow.end -= _bufferSize;
+  }
+  updateWriteView();
+
+  // publish the new tokens (and their replicas) to the readers
+  _written.store(_written.load(std::memory_order_relaxed) + released, std::memory_order_release);
+}
+
+template <typename T>
+void ConcurrentPhantomBuffer<T>::releaseForRead(ReaderID id, int released) {
+  Reader& r = *_readers[id];
+  Window& w = r.window;
+
+  // error checking:
+  if (released > w.end - w.begin) {
+    std::ostringstream msg;
+    msg << _parent->fullName() << ": releasing too many tokens (read access): "
+        << released << " instead of " << w.end - w.begin << " max allowed";
+    throw EssentiaException(msg);
+  }
+
+  w.begin += released;
+  if (w.begin >= _bufferSize) {
+    w.begin -= _bufferSize;
+    w.end -= _bufferSize;
+  }
+  updateReadView(id);
+
+  // give the space back to the writer, once we're done reading from it
+  r.total.store(r.total.load(std::memory_order_relaxed) + released, std::memory_order_release);
+}
+
+
+template <typename T>
+inline void ConcurrentPhantomBuffer<T>::updateReadView(ReaderID id) {
+  Reader& r = *_readers[id];
+  r.view.setData(&_buffer[0] + r.window.begin);
+  r.view.setSize(r.window.end - r.window.begin);
+}
+
+template <typename T>
+inline void ConcurrentPhantomBuffer<T>::updateWriteView() {
+  _writeView.setData(&_buffer[0] + _writeWindow.begin);
+  _writeView.setSize(_writeWindow.end - _writeWindow.begin);
+}
+
+
+/**
+ * Maximum number of contiguous tokens that can be acquired by the given reader
+ * at this moment, ie: the minimum between the number of tokens published by the
+ * writer that we haven't read yet and the number of contiguous tokens from the
+ * place where we are inside the buffer.
+ */
+template <typename T>
+int ConcurrentPhantomBuffer<T>::availableForRead(ReaderID id) const {
+  const Reader& r = *_readers[id];
+  long long theoretical = _written.load(std::memory_order_acquire) - r.total.load(std::memory_order_relaxed);
+  int contiguous = _bufferSize + _phantomSize - r.window.begin;
+
+  return (int)std::min(theoretical, (long long)contiguous);
+}
+
+/**
+ * Maximum number of contiguous tokens that can be acquired by the writer at
+ * this moment, ie: the minimum between the free space left behind the slowest
+ * reader and the number of contiguous tokens from the place where we are
+ * inside the buffer.
+ */
+template <typename T>
+int ConcurrentPhantomBuffer<T>::availableForWrite(bool contiguous) const {
+  long long written = _written.load(std::memory_order_relaxed);
+  long long minTotal = written;
+
+  if (!_readers.empty()) {
+    minTotal = _readers[0]->total.load(std::memory_order_acquire);
+    for (int i=1; i<(int)_readers.size(); i++) {
+      minTotal = std::min(minTotal, _readers[i]->total.load(std::memory_order_acquire));
+    }
+  }
+
+  int theoretical = (int)(minTotal - written) + _bufferSize;
+  if (!contiguous) {
+    return theoretical;
+  }
+
+  int ncontiguous = _bufferSize + _phantomSize - _writeWindow.begin;
+  return std::min(theoretical, ncontiguous);
+}
+
+template <typename T>
+void ConcurrentPhantomBuffer<T>::resize(int size, int phantomSize) {
+  if (size == _bufferSize && phantomSize == _phantomSize) return;
+
+  long long written = _written.load(std::memory_order_relaxed);
+  long long first = written;
+  for (int i=0; i<(int)_readers.size(); i++) {
+    first = std::min(first, _readers[i]->total.load(std::memory_order_relaxed));
+  }
+
+  if (written - first > size) {
+    std::ostringstream msg;
+    msg << "Cannot resize buffer of " << _parent->fullName() << " to " << size
+        << " tokens, as it still contains " << written - first << " unread tokens";
+    throw EssentiaException(msg);
+  }
+
+  std::vector<T> buffer(size + phantomSize);
+  for (long long t=first; t<written; t++) {
+    int pos = (int)(t % size);
+    std::swap(buffer[pos], _buffer[t % _bufferSize]);
+    if (pos < phantomSize) buffer[pos + size] = buffer[pos];
+  }
+  _buffer.swap(buffer);
+  _bufferSize = size;
+  _phantomSize = phantomSize;
+
+  _writeWindow.begin = _writeWindow.end = (int)(written % size);
+  updateWriteView();
+
+  for (int i=0; i<(int)_readers.size(); i++) {
+    Window& w = _readers[i]->window;
+    w.begin = w.end = (int)(_readers[i]->total.load(std::memory_order_relaxed) % size);
+    updateReadView(i);
+  }
+  std::atomic_thread_fence(std::memory_order_release);
+}
+
+template <typename T>
+void ConcurrentPhantomBuffer<T>::reset() {
+  _writeWindow = Window();
+  _written.store(0, std::memory_order_relaxed);
+  for (int i=0; i<(int)_readers.size(); i++) {
+    _readers[i]->window = Window();
+    _readers[i]->total.store(0, std::memory_order_relaxed);
+  }
+  std::atomic_thread_fence(std::memory_order_release);
+}
+
+} // namespace streaming
+} // namespace essentia
+
+#endif // ESSENTIA_CONCURRENTPHANTOMBUFFER_IMPL_H
@@ -73,6 +73,40 @@ class MultiRateBuffer {
 
 };
 
+/**
+ * Returns the default size and phantom size of a buffer used to convey tokens
+ * in the given way.
+ */
+inline BufferInfo defaultBufferInfo(BufferUsage::BufferUsageType type) {
+  BufferInfo buf;
+  switch (type) {
+  case BufferUsage::forSingleFrames:
+    buf.size = 16;
+    buf.maxContiguousElements = 0;
+    break;
+
+  case BufferUsage::forMultipleFrames:
+    buf.size = 262144;
+    buf.maxContiguousElements = 32768;
+    break;
+
+  case BufferUsage::forAudioStream:
+    buf.size = 65536;
+    buf.maxContiguousElements = 4096;
+    break;
+
+  case BufferUsage::forLargeAudioStream:
+    buf.size = 1048576;
+    buf.maxContiguousElements = 262144;
+    break;
+
+  default:
+    throw EssentiaException("Unknown buffer type");
+  }
+
+  return buf;
+}
+
 // it's the MultiRateBuffer that does all the allocation
 // the source and sink do not allocate memory, they just take
 // ownership of the memory zone in the buffer
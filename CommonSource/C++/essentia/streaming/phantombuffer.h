@@ -61,39 +61,14 @@ class PhantomBuffer : public MultiRateBuffer<T> {
 
  public:
 
-  PhantomBuffer(SourceBase* parent, BufferUsage::BufferUsageType type) {
+  PhantomBuffer(SourceBase* parent, BufferUsage::BufferUsageType type) :
+    _bufferSize(0), _phantomSize(0) {
     _parent = parent;
     setBufferType(type);
   }
 
   void setBufferType(BufferUsage::BufferUsageType type) {
-    BufferInfo buf;
-    switch (type) {
-    case BufferUsage::forSingleFrames:
-      buf.size = 16;
-      buf.maxContiguousElements = 0;
-      break;
-
-    case BufferUsage::forMultipleFrames:
-      buf.size = 262144;
-      buf.maxContiguousElements = 32768;
-      break;
-
-    case BufferUsage::forAudioStream:
-      buf.size = 65536;
-      buf.maxContiguousElements = 4096;
-      break;
-
-    case BufferUsage::forLargeAudioStream:
-      buf.size = 1048576;
-      buf.maxContiguousElements = 262144;
-      break;
-
-    default:
-      throw EssentiaException("Unknown buffer type");
-    }
-
-    setBufferInfo(buf);
+    setBufferInfo(defaultBufferInfo(type));
   }
 
   BufferInfo bufferInfo() const {
@@ -104,9 +79,7 @@ class PhantomBuffer : public MultiRateBuffer<T> {
   }
 
   void setBufferInfo(const BufferInfo& info) {
-    _bufferSize = info.size;
-    _phantomSize = info.maxContiguousElements;
-    _buffer.resize(_bufferSize + _phantomSize);
+    resize(info.size, info.maxContiguousElements);
   }
 
   PhantomBuffer(SourceBase* parent, int size, int phantomSize) :
@@ -154,16 +127,12 @@ class PhantomBuffer : public MultiRateBuffer<T> {
   int numberReaders() const;
 
   /**
-   * WARNING: do only before starting to use buffer, for initial configuration
-   * @todo find a way to be able to call this function at any time to allow
-   *       dynamic resizing, even by locking everything. It doesn't matter if
-   *       it takes too much time, as it should be called only very rarely
+   * Resizes the buffer, keeping the tokens which have not been read yet by all
+   * the readers, so that it can be called while the buffer is being used.
+   * WARNING: the windows acquired by the writer and the readers are lost, so
+   *          this should only be called between calls to process().
    */
-  void resize(int size, int phantomSize) {
-    _buffer.resize(size+phantomSize);
-    _bufferSize = size;
-    _phantomSize = phantomSize;
-  }
+  void resize(int size, int phantomSize);
 
   int totalTokensWritten() const {
     MutexLocker lock(mutex); NOWARN_UNUSED(lock);
@@ -294,6 +294,52 @@ void PhantomBuffer<T>::relocateReadWindow(ReaderID id) {
   }
 }
 
+template <typename T>
+void PhantomBuffer<T>::resize(int size, int phantomSize) {
+  MutexLocker lock(mutex); NOWARN_UNUSED(lock);
+
+  if (size == _bufferSize && phantomSize == _phantomSize) return;
+
+  // the tokens still needed by someone are the ones between the slowest reader
+  // and the writer
+  int written = _writeWindow.total(_bufferSize);
+  std::vector<int> read(_readWindow.size());
+  int first = written;
+  for (int i=0; i<(int)_readWindow.size(); i++) {
+    read[i] = _readWindow[i].total(_bufferSize);
+    first = std::min(first, read[i]);
+  }
+
+  if (written - first > size) {
+    std::ostringstream msg;
+    msg << "Cannot resize buffer of " << _parent->fullName() << " to " << size
+        << " tokens, as it still contains " << written - first << " unread tokens";
+    throw EssentiaException(msg);
+  }
+
+  // move them to the place they would have been if the buffer had always had
+  // the new size, replicating those at the beginning into the phantom zone
+  std::vector<T> buffer(size + phantomSize);
+  for (int t=first; t<written; t++) {
+    int pos = t % size;
+    std::swap(buffer[pos], _buffer[t % _bufferSize]);
+    if (pos < phantomSize) buffer[pos + size] = buffer[pos];
+  }
+  _buffer.swap(buffer);
+  _bufferSize = size;
+  _phantomSize = phantomSize;
+
+  _writeWindow.turn = written / size;
+  _writeWindow.begin = _writeWindow.end = written % size;
+  updateWriteView();
+
+  for (int i=0; i<(int)_readWindow.size(); i++) {
+    _readWindow[i].turn = read[i] / size;
+    _readWindow[i].begin = _readWindow[i].end = read[i] % size;
+    updateReadView(i);
+  }
+}
+
 template <typename T>
 void PhantomBuffer<T>::reset() {
   // we don't need to clear the buffer, because when new data is written to the
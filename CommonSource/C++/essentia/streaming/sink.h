@@ -64,6 +64,12 @@ class Sink : public SinkBase {
   virtual const void* getTokens() const { return &tokens(); }
   virtual const void* getFirstToken() const { return &firstToken(); }
 
+  virtual int totalConsumed() const {
+    if (_source)      return buffer().totalTokensRead(_id);
+    else if (_sproxy) return _sproxy->totalConsumed();
+    else return 0;
+  }
+
   inline void acquire() { StreamConnector::acquire(); }
 
   virtual bool acquire(int n) {
@@ -85,6 +85,9 @@ class SinkBase : public Connector {
   // should return a TokenType*
   virtual const void* getFirstToken() const = 0;
 
+  // total number of tokens consumed by this sink so far
+  virtual int totalConsumed() const = 0;
+
  protected:
   // methods for standard connections
 
@@ -232,6 +232,11 @@ class SinkProxy : public SinkProxyBase {
     return buffer().availableForRead(_id);
   }
 
+  virtual int totalConsumed() const {
+    if (!_source) return 0;
+    return buffer().totalTokensRead(_id);
+  }
+
   virtual void reset() {}
 
 };
@@ -62,6 +62,13 @@ class Source : public SourceBase {
     _buffer->setBufferInfo(info);
   }
 
+  virtual int tokenSize() const {
+    return (int)sizeof(TokenType);
+  }
+
+  virtual void setConcurrentBuffer(bool concurrent);
+  virtual bool isConcurrentBuffer() const;
+
   int totalProduced() const { return _buffer->totalTokensWritten(); }
 
   ReaderID addReader() {
@@ -136,6 +143,7 @@ const T& lastTokenProduced(const SourceBase& source) {
 // NB: Implementation needs to go into the header as it is a template class we are defining
 
 #include "phantombuffer.h"
+#include "concurrentphantombuffer.h"
 
 
 namespace essentia {
@@ -153,6 +161,34 @@ Source<TokenType>::Source(const std::string& name) :
   SourceBase(name),
   _buffer(new PhantomBuffer<TokenType>(this, BufferUsage::forSingleFrames)) {}
 
+template <typename TokenType>
+bool Source<TokenType>::isConcurrentBuffer() const {
+  return dynamic_cast<const ConcurrentPhantomBuffer<TokenType>*>(_buffer) != 0;
+}
+
+template <typename TokenType>
+void Source<TokenType>::setConcurrentBuffer(bool concurrent) {
+  if (concurrent == isConcurrentBuffer()) return;
+
+  if (_buffer->totalTokensWritten() > 0) {
+    throw EssentiaException("Cannot change the type of buffer of ", fullName(),
+                            " after it has started producing tokens");
+  }
+
+  MultiRateBuffer<TokenType>* buffer;
+  if (concurrent) buffer = new ConcurrentPhantomBuffer<TokenType>(this, _buffer->bufferInfo());
+  else {
+    buffer = new PhantomBuffer<TokenType>(this, BufferUsage::forSingleFrames);
+    buffer->setBufferInfo(_buffer->bufferInfo());
+  }
+
+  // the connected sinks keep their ReaderID, as those are just indices
+  for (int i=0; i<_buffer->numberReaders(); i++) buffer->addReader();
+
+  delete _buffer;
+  _buffer = buffer;
+}
+
 } // namespace streaming
 } // namespace essentia
 
@@ -113,6 +113,15 @@ class SourceBase : public Connector {
   virtual BufferInfo bufferInfo() const = 0;
   virtual void setBufferInfo(const BufferInfo& info) = 0;
 
+  // size in bytes of a single token, used to compute the memory taken by the buffer
+  virtual int tokenSize() const = 0;
+
+  // switch between the default buffer and a ConcurrentPhantomBuffer, which can
+  // be written and read from different threads. Only possible before any token
+  // has been produced.
+  virtual void setConcurrentBuffer(bool concurrent) = 0;
+  virtual bool isConcurrentBuffer() const = 0;
+
  protected:
   // made those protected so that only our friend streaming::{dis}connect() functions can access these
   // @todo this function should probably be protected by a mutex (?)
@@ -80,6 +80,18 @@ class SourceProxyBase : public SourceBase {
     _proxiedSource->setBufferInfo(info);
   }
 
+  virtual int tokenSize() const {
+    return _proxiedSource->tokenSize();
+  }
+
+  virtual void setConcurrentBuffer(bool concurrent) {
+    _proxiedSource->setConcurrentBuffer(concurrent);
+  }
+
+  virtual bool isConcurrentBuffer() const {
+    return _proxiedSource->isConcurrentBuffer();
+  }
+
 
   //---- StreamConnector interface hijacking for proxies ----------------------------------------//
 
@@ -29,6 +29,7 @@ namespace essentia {
 namespace scheduler {
 
   class Network;
+  class ParallelExecutor;
 
 } // namespace scheduler
 } // namespace essentia
@@ -251,6 +252,7 @@ class ESSENTIA_API Algorithm : public Configurable {
 
 #if DEBUGGING_ENABLED
   friend class essentia::scheduler::Network;
+  friend class essentia::scheduler::ParallelExecutor;
 
   /** number of times the process() method has been called */
   int nProcess;
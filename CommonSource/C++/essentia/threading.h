@@ -101,6 +101,36 @@ class ForcedMutexLocker {
 };
 
 
+// the ConditionalMutex is a real Mutex which only locks once it has been
+// enabled, for the objects which only need to be thread-safe on demand
+// (ex: the Pool, see Pool::setConcurrent()). It must not be enabled or
+// disabled while another thread uses it.
+// A copy gets a mutex of its own, enabled if the original one is.
+
+class ConditionalMutex {
+ protected:
+  ForcedMutex _mutex;
+  bool _enabled;
+ public:
+  ConditionalMutex() : _enabled(false) {}
+  ConditionalMutex(const ConditionalMutex& other) : _enabled(other._enabled) {}
+  ConditionalMutex& operator=(const ConditionalMutex& other) { _enabled = other._enabled; return *this; }
+
+  void setEnabled(bool enabled) { _enabled = enabled; }
+  bool enabled() const { return _enabled; }
+  void lock()    { if (_enabled) _mutex.lock(); }
+  void unlock()  { if (_enabled) _mutex.unlock(); }
+};
+
+class ConditionalMutexLocker {
+ protected:
+  ConditionalMutex& _mutex;
+ public:
+  ConditionalMutexLocker(ConditionalMutex& mutex) : _mutex(mutex) { _mutex.lock(); }
+  ~ConditionalMutexLocker() { _mutex.unlock(); }
+};
+
+
 } // namespace essentia
 
 #endif // ESSENTIA_THREADING_H
@@ -369,6 +369,55 @@ class Tuple2 {
  */
 typedef Tuple2<Real> StereoSample;
 
+/**
+ * Frames of the same size stored one after the other in a single buffer, as
+ * the rows of a matrix. This is how the Pool stores the frames of a
+ * descriptor made of vectors of Reals, so that they can be read without
+ * following a pointer per frame: the values of frame @c i start at
+ * <tt>frames[i]</tt>, and those of frame <tt>i+1</tt> width() values later.
+ */
+class FrameMatrix {
+ public:
+  FrameMatrix() : _rows(0), _width(0) {}
+  FrameMatrix(int rows, int width) : _data(rows*width, Real(0)), _rows(rows), _width(width) {}
+
+  /** @returns the number of frames */
+  int size() const { return _rows; }
+  bool empty() const { return _rows == 0; }
+
+  /** @returns the size of the frames, which is also the stride between them */
+  int width() const { return _width; }
+
+  const Real* operator[](int i) const { return _data.data() + i*_width; }
+  Real* operator[](int i) { return _data.data() + i*_width; }
+
+  /** @returns a copy of the frame @c i */
+  std::vector<Real> frame(int i) const {
+    return std::vector<Real>((*this)[i], (*this)[i] + _width);
+  }
+
+  /**
+   * Adds a frame after the others. The first frame sets the width of the
+   * matrix, and the next ones must have the same size.
+   */
+  void push_back(const std::vector<Real>& frame) {
+    if (_rows == 0) _width = (int)frame.size();
+    assert((int)frame.size() == _width);
+    _data.insert(_data.end(), frame.begin(), frame.end());
+    _rows++;
+  }
+
+  void clear() {
+    _data.clear();
+    _rows = _width = 0;
+  }
+
+ protected:
+  std::vector<Real> _data;
+  int _rows;
+  int _width;
+};
+
 
 
 namespace streaming {
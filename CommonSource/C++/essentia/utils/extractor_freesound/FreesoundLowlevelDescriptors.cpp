@@ -35,21 +35,15 @@ void FreesoundLowlevelDescriptors::createNetwork(SourceBase& source, Pool& pool)
   string silentFrames = options.value<string>("lowlevel.silentFrames");
   string windowType = options.value<string>("lowlevel.windowType");
 
-  Algorithm* fc = factory.create("FrameCutter",
-                                 "frameSize", frameSize,
-                                 "hopSize", hopSize,
-                                 "silentFrames", silentFrames);
-  
-  Algorithm* w = factory.create("Windowing",
-                                "type", windowType,
-                                "zeroPadding", zeroPadding);
-  
-  Algorithm* spec = factory.create("Spectrum");
+  Algorithm* spec = factory.create("FramedSpectrum",
+                                   "frameSize", frameSize,
+                                   "hopSize", hopSize,
+                                   "silentFrames", silentFrames,
+                                   "windowType", windowType,
+                                   "zeroPadding", zeroPadding);
 
 
-  source >> fc->input("signal");
-  fc->output("frame") >> w->input("frame");
-  w->output("frame") >> spec->input("frame");
+  source >> spec->input("signal");
 
   // Silence Rate
   Real thresholds_dB[] = { -20, -30, -60 };
@@ -59,14 +53,14 @@ void FreesoundLowlevelDescriptors::createNetwork(SourceBase& source, Pool& pool)
     thresholds[i] = db2lin(thresholds_dB[i]/2.0);
   }
   Algorithm* sr = factory.create("SilenceRate","thresholds", thresholds);
-  fc->output("frame") >> sr->input("frame");
+  spec->output("frame") >> sr->input("frame");
   sr->output("threshold_0") >> PC(pool, nameSpace + "silence_rate_20dB");
   sr->output("threshold_1") >> PC(pool, nameSpace + "silence_rate_30dB");
   sr->output("threshold_2") >> PC(pool, nameSpace + "silence_rate_60dB");
 
   // Zero crossing rate
   Algorithm* zcr = factory.create("ZeroCrossingRate");
-  fc->output("frame") >> zcr->input("signal");
+  spec->output("frame") >> zcr->input("signal");
   zcr->output("zeroCrossingRate") >> PC(pool, nameSpace + "zerocrossingrate");
 
   // MFCC
@@ -288,12 +282,12 @@ void FreesoundLowlevelDescriptors::createNetwork(SourceBase& source, Pool& pool)
 
   // Note: loudness is computed on shorter frames compared to MusicExtractor
   Algorithm* ln = factory.create("Loudness");
-  fc->output("frame") >> ln->input("signal");
+  spec->output("frame") >> ln->input("signal");
   ln->output("loudness") >> PC(pool, nameSpace + "loudness");
 
   // StartStopSilence
   Algorithm* ss = factory.create("StartStopSilence","threshold",-60);
-  fc->output("frame") >> ss->input("frame");
+  spec->output("frame") >> ss->input("frame");
   ss->output("startFrame") >> PC(pool, nameSpace + "startFrame");
   ss->output("stopFrame") >> PC(pool, nameSpace + "stopFrame");
 
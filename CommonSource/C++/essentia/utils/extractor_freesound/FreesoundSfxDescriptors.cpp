@@ -144,24 +144,16 @@ void  FreesoundSfxDescriptors::createHarmonicityNetwork(SourceBase& source, Pool
   string silentFrames = options.value<string>("lowlevel.silentFrames");
   string windowType = options.value<string>("lowlevel.windowType");
 
-  // FrameCutter
-  Algorithm* fc = factory.create("FrameCutter",
-                                 "frameSize", frameSize,
-                                 "hopSize", hopSize,
-                                 "silentFrames", silentFrames);
-
-  source >> fc->input("signal");
-
-  // Windowing
-  Algorithm* w = factory.create("Windowing",
-                                "type", windowType,
-                                "zeroPadding", zeroPadding);
-
-  fc->output("frame") >> w->input("frame");
-
-  // Spectrum
-  Algorithm* spec = factory.create("Spectrum");
-  w->output("frame") >> spec->input("frame");
+  // FrameCutter, Windowing and Spectrum
+  Algorithm* spec = factory.create("FramedSpectrum",
+                                   "frameSize", frameSize,
+                                   "hopSize", hopSize,
+                                   "silentFrames", silentFrames,
+                                   "windowType", windowType,
+                                   "zeroPadding", zeroPadding);
+
+  source >> spec->input("signal");
+  spec->output("frame") >> NOWHERE;
 
   Algorithm* harmPeaks = factory.create("HarmonicPeaks");
   Algorithm* peaks = factory.create("SpectralPeaks",
@@ -34,14 +34,12 @@ void FreesoundTonalDescriptors ::createNetwork(SourceBase& source, Pool& pool) {
 
   AlgorithmFactory& factory = AlgorithmFactory::instance();
 
-  Algorithm* fc = factory.create("FrameCutter",
-                                 "frameSize", frameSize,
-                                 "hopSize", hopSize,
-                                 "silentFrames", silentFrames);
-  Algorithm* w = factory.create("Windowing",
-                                "type", windowType,
-                                "zeroPadding", zeroPadding);
-  Algorithm* spec = factory.create("Spectrum");
+  Algorithm* spec = factory.create("FramedSpectrum",
+                                   "frameSize", frameSize,
+                                   "hopSize", hopSize,
+                                   "silentFrames", silentFrames,
+                                   "windowType", windowType,
+                                   "zeroPadding", zeroPadding);
 
   // Compute tuning frequency
   Algorithm* peaks = factory.create("SpectralPeaks",
@@ -52,9 +50,8 @@ void FreesoundTonalDescriptors ::createNetwork(SourceBase& source, Pool& pool) {
                                     "orderBy", "magnitude");
   Algorithm* tuning = factory.create("TuningFrequency");
 
-  source >> fc->input("signal");
-  fc->output("frame") >> w->input("frame");
-  w->output("frame") >> spec->input("frame");
+  source >> spec->input("signal");
+  spec->output("frame") >> NOWHERE;
   spec->output("spectrum") >> peaks->input("spectrum");
   peaks->output("magnitudes") >> tuning->input("magnitudes");
   peaks->output("frequencies") >> tuning->input("frequencies");
@@ -30,6 +30,7 @@
 #include "../../streaming/streamingalgorithm.h"
 #include "../../algorithmfactory.h"
 #include "../../streaming/algorithms/poolstorage.h"
+#include "../../streaming/algorithms/onlinepoolaggregator.h"
 #include "../../streaming/algorithms/vectorinput.h"
 
 using namespace std;
@@ -41,6 +42,19 @@ class MusicDescriptorSet {
  public:
  	static const string nameSpace;  
 
+  /**
+   * Returns the statistics computed for a descriptor, given by the options of
+   * its namespace, or an empty vector if the default ones are used.
+   */
+  static vector<string> descriptorStats(const Pool& options, const string& name) {
+    if (name.find("lowlevel.mfcc") != string::npos) return options.value<vector<string> >("lowlevel.mfccStats");
+    if (name.find("lowlevel.gfcc") != string::npos) return options.value<vector<string> >("lowlevel.gfccStats");
+    if (name.find("lowlevel.") != string::npos) return options.value<vector<string> >("lowlevel.stats");
+    if (name.find("rhythm.") != string::npos) return options.value<vector<string> >("rhythm.stats");
+    if (name.find("tonal.") != string::npos) return options.value<vector<string> >("tonal.stats");
+    return vector<string>();
+  }
+
  protected:
   Pool options;
 
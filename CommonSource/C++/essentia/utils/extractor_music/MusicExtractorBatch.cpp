@@ -0,0 +1,189 @@
+/*
+ * Copyright (C) 2006-2016  Music Technology Group - Universitat Pompeu Fabra
+ *
+ * This file is part of Essentia
+ *
+ * Essentia is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ */
+
+#include <thread>
+#include <algorithm>
+#include <sstream>
+#include "MusicExtractorBatch.h"
+#include "../../algorithmfactory.h"
+#include "../../pool.h"
+
+using namespace std;
+using namespace essentia;
+using namespace essentia::standard;
+
+
+MusicExtractorBatch::MusicExtractorBatch(const ParameterMap& parameters, int numThreads,
+                                         const string& extractor) :
+  _parameters(parameters), _audioFilenames(0), _outputFilenames(0), _framesFilenames(0),
+  _signals(0), _results(0), _computeItem(0), _size(0), _next(0) {
+
+  if (numThreads == 0) numThreads = (int)std::thread::hardware_concurrency();
+  if (numThreads < 1) numThreads = 1;
+
+  for (int i=0; i<numThreads; i++) {
+    Algorithm* algo = AlgorithmFactory::create(extractor);
+    algo->configure(_parameters);
+    _extractors.push_back(algo);
+    _outputs.push_back(0);
+  }
+}
+
+MusicExtractorBatch::~MusicExtractorBatch() {
+  for (int i=0; i<(int)_extractors.size(); i++) {
+    delete _extractors[i];
+    delete _outputs[i];
+  }
+}
+
+
+int MusicExtractorBatch::compute(const vector<string>& audioFilenames,
+                                 const vector<string>& outputFilenames,
+                                 const vector<string>& framesFilenames,
+                                 const string& format) {
+  if (outputFilenames.size() != audioFilenames.size() ||
+      (!framesFilenames.empty() && framesFilenames.size() != audioFilenames.size())) {
+    ostringstream msg;
+    msg << "MusicExtractorBatch: got " << audioFilenames.size() << " audio files but "
+        << outputFilenames.size() << " output files and " << framesFilenames.size() << " frames output files";
+    throw EssentiaException(msg);
+  }
+
+  _audioFilenames = &audioFilenames;
+  _outputFilenames = &outputFilenames;
+  _framesFilenames = &framesFilenames;
+  _format = format;
+
+  int failed = run((int)audioFilenames.size(), &MusicExtractorBatch::computeFile);
+
+  _audioFilenames = _outputFilenames = _framesFilenames = 0;
+
+  return failed;
+}
+
+
+int MusicExtractorBatch::compute(const vector<vector<Real> >& signals, vector<Pool>& results) {
+  results.assign(signals.size(), Pool());
+
+  _signals = &signals;
+  _results = &results;
+
+  int failed = run((int)signals.size(), &MusicExtractorBatch::computeSignal);
+
+  _signals = 0;
+  _results = 0;
+
+  return failed;
+}
+
+
+int MusicExtractorBatch::run(int size, void (MusicExtractorBatch::*computeItem)(int, int)) {
+  _computeItem = computeItem;
+  _size = size;
+  _next = 0;
+  _errors.clear();
+
+  // no need for more threads than there are items
+  int nworkers = std::min((int)_extractors.size(), size);
+
+  vector<std::thread> workers;
+  for (int i=1; i<nworkers; i++) {
+    workers.push_back(std::thread(&MusicExtractorBatch::workerLoop, this, i));
+  }
+
+  // the calling thread also takes part in the work
+  workerLoop(0);
+
+  for (int i=0; i<(int)workers.size(); i++) workers[i].join();
+
+  _computeItem = 0;
+
+  return (int)_errors.size();
+}
+
+
+void MusicExtractorBatch::workerLoop(int worker) {
+  while (true) {
+    int idx;
+    {
+      ForcedMutexLocker lock(_mutex);
+      if (_next >= _size) return;
+      idx = _next++;
+    }
+
+    (this->*_computeItem)(worker, idx);
+  }
+}
+
+
+void MusicExtractorBatch::computeFile(int worker, int idx) {
+  const string& audioFilename = (*_audioFilenames)[idx];
+  Algorithm* extractor = _extractors[worker];
+
+  E_INFO("MusicExtractorBatch: analyzing " << audioFilename);
+
+  try {
+    Pool stats, frames;
+
+    extractor->input("filename").set(audioFilename);
+    extractor->output("results").set(stats);
+    extractor->output("resultsFrames").set(frames);
+    extractor->compute();
+
+    if (!_outputs[worker]) _outputs[worker] = AlgorithmFactory::create("YamlOutput");
+    Algorithm* output = _outputs[worker];
+
+    output->configure("filename", (*_outputFilenames)[idx], "format", _format);
+    output->input("pool").set(stats);
+    output->compute();
+
+    if (!_framesFilenames->empty()) {
+      output->configure("filename", (*_framesFilenames)[idx], "format", _format);
+      output->input("pool").set(frames);
+      output->compute();
+    }
+  }
+  catch (const exception& e) {
+    recordError(audioFilename, e);
+  }
+}
+
+
+void MusicExtractorBatch::computeSignal(int worker, int idx) {
+  Algorithm* extractor = _extractors[worker];
+
+  try {
+    extractor->input("audio").set((*_signals)[idx]);
+    extractor->output("pool").set((*_results)[idx]);
+    extractor->compute();
+  }
+  catch (const exception& e) {
+    ostringstream item;
+    item << "signal " << idx;
+    recordError(item.str(), e);
+  }
+}
+
+
+void MusicExtractorBatch::recordError(const string& item, const exception& e) {
+  E_WARNING("MusicExtractorBatch: error processing " << item << ": " << e.what());
+
+  ForcedMutexLocker lock(_mutex);
+  _errors.push_back(make_pair(item, string(e.what())));
+}
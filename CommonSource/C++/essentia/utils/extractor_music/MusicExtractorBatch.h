@@ -0,0 +1,125 @@
+/*
+ * Copyright (C) 2006-2016  Music Technology Group - Universitat Pompeu Fabra
+ *
+ * This file is part of Essentia
+ *
+ * Essentia is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Affero General Public License as published by the Free
+ * Software Foundation (FSF), either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the Affero GNU General Public License
+ * version 3 along with this program.  If not, see http://www.gnu.org/licenses/
+ */
+
+#ifndef MUSIC_EXTRACTOR_BATCH_H
+#define MUSIC_EXTRACTOR_BATCH_H
+
+#include <vector>
+#include <string>
+#include <utility>
+#include "../../algorithm.h"
+#include "../../pool.h"
+#include "../../threading.h"
+
+
+/**
+ * Runs the MusicExtractor on a list of files, using a given number of threads.
+ *
+ * Each worker thread owns its own MusicExtractor, which is created and
+ * configured once and then reused for all the files that worker analyzes, so
+ * that its streaming networks (loaders, descriptor sub-networks, filter banks,
+ * FFT plans, aggregator) are only built once per worker instead of once per
+ * file. The extractors are kept between calls to compute().
+ *
+ * The statistics of each file are written to its output file as soon as it has
+ * been analyzed. A file that fails does not stop the batch, its error is
+ * recorded and can be retrieved with errors().
+ *
+ * Another extractor can be used instead of the MusicExtractor, in which case
+ * it can also be run on signals which have already been loaded, see
+ * compute(signals, results).
+ */
+class MusicExtractorBatch {
+
+ public:
+  /**
+   * @param parameters the parameters of the MusicExtractor (eg: "profile")
+   * @param numThreads the number of files analyzed concurrently, 0 uses as
+   *        many threads as there are cores
+   * @param extractor the name of the standard algorithm run on each file or
+   *        signal
+   */
+  MusicExtractorBatch(const essentia::ParameterMap& parameters = essentia::ParameterMap(),
+                      int numThreads = 1,
+                      const std::string& extractor = "MusicExtractor");
+  ~MusicExtractorBatch();
+
+  /**
+   * Analyzes all the given audio files, writing the statistics of
+   * audioFilenames[i] to outputFilenames[i] and, if given, its frame values to
+   * framesFilenames[i]. Returns the number of files which failed.
+   *
+   * The extractor must have a "filename" input and "results" and
+   * "resultsFrames" outputs, as the MusicExtractor.
+   *
+   * @param format the format of the output files, "json" or "yaml"
+   */
+  int compute(const std::vector<std::string>& audioFilenames,
+              const std::vector<std::string>& outputFilenames,
+              const std::vector<std::string>& framesFilenames = std::vector<std::string>(),
+              const std::string& format = "json");
+
+  /**
+   * Analyzes all the given signals, storing the descriptors of signals[i] in
+   * results[i]. Returns the number of signals which failed, whose errors are
+   * recorded under "signal <i>".
+   *
+   * The extractor must have an "audio" input and a "pool" output, as the
+   * Extractor.
+   */
+  int compute(const std::vector<std::vector<essentia::Real> >& signals,
+              std::vector<essentia::Pool>& results);
+
+  /**
+   * The files (or signals) which failed during the last call to compute(),
+   * with the corresponding error message.
+   */
+  const std::vector<std::pair<std::string, std::string> >& errors() const { return _errors; }
+
+  int numThreads() const { return (int)_extractors.size(); }
+
+ protected:
+  essentia::ParameterMap _parameters;
+
+  // one extractor and one output per worker, worker 0 being the calling
+  // thread. The outputs are only created once a file is analyzed.
+  std::vector<essentia::standard::Algorithm*> _extractors;
+  std::vector<essentia::standard::Algorithm*> _outputs;
+
+  // state of the current batch
+  const std::vector<std::string>* _audioFilenames;
+  const std::vector<std::string>* _outputFilenames;
+  const std::vector<std::string>* _framesFilenames;
+  std::string _format;
+  const std::vector<std::vector<essentia::Real> >* _signals;
+  std::vector<essentia::Pool>* _results;
+  void (MusicExtractorBatch::*_computeItem)(int worker, int idx);
+  int _size;
+  int _next;
+  std::vector<std::pair<std::string, std::string> > _errors;
+  essentia::ForcedMutex _mutex; // guards _next and _errors
+
+  int run(int size, void (MusicExtractorBatch::*computeItem)(int, int));
+  void workerLoop(int worker);
+  void computeFile(int worker, int idx);
+  void computeSignal(int worker, int idx);
+  void recordError(const std::string& item, const std::exception& e);
+};
+
+#endif
@@ -25,6 +25,22 @@ using namespace essentia::streaming;
 
 const string MusicLowlevelDescriptors::nameSpace="lowlevel.";  
 
+/**
+ * Connects a frame descriptor to the pool, like PC(pool, name). If the
+ * "lowlevel.outputFrames" option is false, its frames are not stored: its
+ * statistics are computed as they arrive by an OnlinePoolAggregator, and added
+ * to the stats pool at the end of the stream, so that the memory used does not
+ * grow with the length of the audio.
+ */
+void MusicLowlevelDescriptors::connectFrames(SourceBase& source, Pool& pool, const string& name) {
+  if (statsPool && !options.value<Real>("lowlevel.outputFrames")) {
+    connectAggregated(source, *statsPool, name, descriptorStats(options, name));
+  }
+  else {
+    source >> PC(pool, name);
+  }
+}
+
 void MusicLowlevelDescriptors::createNetworkNeqLoud(SourceBase& source, Pool& pool){
 
   AlgorithmFactory& factory = AlgorithmFactory::instance();
@@ -36,18 +52,14 @@ void MusicLowlevelDescriptors::createNetworkNeqLoud(SourceBase& source, Pool& po
   string silentFrames = options.value<string>("lowlevel.silentFrames");
   string windowType = options.value<string>("lowlevel.windowType");
 
-  Algorithm* fc = factory.create("FrameCutter",
-                                 "frameSize", frameSize,
-                                 "hopSize", hopSize,
-                                 "silentFrames", silentFrames);
-  Algorithm* w = factory.create("Windowing",
-                                "type", windowType,
-                                "zeroPadding", zeroPadding);
-  Algorithm* spec = factory.create("Spectrum");
+  Algorithm* spec = factory.create("FramedSpectrum",
+                                   "frameSize", frameSize,
+                                   "hopSize", hopSize,
+                                   "silentFrames", silentFrames,
+                                   "windowType", windowType,
+                                   "zeroPadding", zeroPadding);
 
-  source              >> fc->input("signal");
-  fc->output("frame") >> w->input("frame");
-  w->output("frame")  >> spec->input("frame");
+  source >> spec->input("signal");
 
   // Silence Rate
   Real thresholds_dB[] = { -20, -30, -60 };
@@ -56,87 +68,87 @@ void MusicLowlevelDescriptors::createNetworkNeqLoud(SourceBase& source, Pool& po
     thresholds[i] = db2lin(thresholds_dB[i]/2.0);
   }
   Algorithm* sr = factory.create("SilenceRate", "thresholds", thresholds);
-  fc->output("frame")       >> sr->input("frame");
-  sr->output("threshold_0") >> PC(pool, nameSpace + "silence_rate_20dB");
-  sr->output("threshold_1") >> PC(pool, nameSpace + "silence_rate_30dB");
-  sr->output("threshold_2") >> PC(pool, nameSpace + "silence_rate_60dB");
+  spec->output("frame")     >> sr->input("frame");
+  connectFrames(sr->output("threshold_0"), pool, nameSpace + "silence_rate_20dB");
+  connectFrames(sr->output("threshold_1"), pool, nameSpace + "silence_rate_30dB");
+  connectFrames(sr->output("threshold_2"), pool, nameSpace + "silence_rate_60dB");
   
   // Zero crossing rate
   Algorithm* zcr = factory.create("ZeroCrossingRate");
-  fc->output("frame")             >> zcr->input("signal");
-  zcr->output("zeroCrossingRate") >> PC(pool, nameSpace + "zerocrossingrate");
+  spec->output("frame")           >> zcr->input("signal");
+  connectFrames(zcr->output("zeroCrossingRate"), pool, nameSpace + "zerocrossingrate");
 
   // MelBands and MFCC
   Algorithm* mfcc = factory.create("MFCC", "numberBands", 40);
   spec->output("spectrum")  >> mfcc->input("spectrum");
-  mfcc->output("bands")     >> PC(pool, nameSpace + "melbands");
-  mfcc->output("mfcc")      >> PC(pool, nameSpace + "mfcc");
+  connectFrames(mfcc->output("bands"), pool, nameSpace + "melbands");
+  connectFrames(mfcc->output("mfcc"), pool, nameSpace + "mfcc");
   
   // Spectral MelBands Central Moments Statistics, Flatness and Crest
   Algorithm* mels_cm = factory.create("CentralMoments", "range", 40-1);
   Algorithm* mels_ds = factory.create("DistributionShape");
   mfcc->output("bands")             >> mels_cm->input("array");
   mels_cm->output("centralMoments") >> mels_ds->input("centralMoments");
-  mels_ds->output("kurtosis")       >> PC(pool, nameSpace + "melbands_kurtosis");
-  mels_ds->output("spread")         >> PC(pool, nameSpace + "melbands_spread");
-  mels_ds->output("skewness")       >> PC(pool, nameSpace + "melbands_skewness");
+  connectFrames(mels_ds->output("kurtosis"), pool, nameSpace + "melbands_kurtosis");
+  connectFrames(mels_ds->output("spread"), pool, nameSpace + "melbands_spread");
+  connectFrames(mels_ds->output("skewness"), pool, nameSpace + "melbands_skewness");
 
   Algorithm* mels_fl = factory.create("FlatnessDB");
   Algorithm* mels_cr = factory.create("Crest");
   mfcc->output("bands")      >> mels_fl->input("array");
   mfcc->output("bands")      >> mels_cr->input("array");
-  mels_fl->output("flatnessDB")  >> PC(pool, nameSpace + "melbands_flatness_db");
-  mels_cr->output("crest")       >> PC(pool, nameSpace + "melbands_crest");
+  connectFrames(mels_fl->output("flatnessDB"), pool, nameSpace + "melbands_flatness_db");
+  connectFrames(mels_cr->output("crest"), pool, nameSpace + "melbands_crest");
   
   // MelBands 128 
   Algorithm* melbands128 = factory.create("MelBands", "numberBands", 128);
   spec->output("spectrum")     >> melbands128->input("spectrum");
-  melbands128->output("bands") >> PC(pool, nameSpace + "melbands128");
+  connectFrames(melbands128->output("bands"), pool, nameSpace + "melbands128");
 
   // ERBBands and GFCC
   uint nERBBands = 40;
   Algorithm* gfcc = factory.create("GFCC", "numberBands", nERBBands);
   spec->output("spectrum")  >> gfcc->input("spectrum");
-  gfcc->output("bands")     >> PC(pool, nameSpace + "erbbands");
-  gfcc->output("gfcc")      >> PC(pool, nameSpace + "gfcc");
+  connectFrames(gfcc->output("bands"), pool, nameSpace + "erbbands");
+  connectFrames(gfcc->output("gfcc"), pool, nameSpace + "gfcc");
 
   // Spectral ERBBands Central Moments Statistics, Flatness and Crest
   Algorithm* erbs_cm = factory.create("CentralMoments", "range", nERBBands-1);
   Algorithm* erbs_ds = factory.create("DistributionShape");
   gfcc->output("bands")             >> erbs_cm->input("array");
   erbs_cm->output("centralMoments") >> erbs_ds->input("centralMoments");
-  erbs_ds->output("kurtosis")       >> PC(pool, nameSpace + "erbbands_kurtosis");
-  erbs_ds->output("spread")         >> PC(pool, nameSpace + "erbbands_spread");
-  erbs_ds->output("skewness")       >> PC(pool, nameSpace + "erbbands_skewness");
+  connectFrames(erbs_ds->output("kurtosis"), pool, nameSpace + "erbbands_kurtosis");
+  connectFrames(erbs_ds->output("spread"), pool, nameSpace + "erbbands_spread");
+  connectFrames(erbs_ds->output("skewness"), pool, nameSpace + "erbbands_skewness");
 
   Algorithm* erbs_fl = factory.create("FlatnessDB");
   Algorithm* erbs_cr = factory.create("Crest");
   gfcc->output("bands")      >> erbs_fl->input("array");
   gfcc->output("bands")      >> erbs_cr->input("array");
-  erbs_fl->output("flatnessDB")  >> PC(pool, nameSpace + "erbbands_flatness_db");
-  erbs_cr->output("crest")       >> PC(pool, nameSpace + "erbbands_crest");
+  connectFrames(erbs_fl->output("flatnessDB"), pool, nameSpace + "erbbands_flatness_db");
+  connectFrames(erbs_cr->output("crest"), pool, nameSpace + "erbbands_crest");
 
   // BarkBands
   int nBarkBands = 27;
   Algorithm* barkBands = factory.create("BarkBands", "numberBands", nBarkBands);
   spec->output("spectrum")    >> barkBands->input("spectrum");
-  barkBands->output("bands")  >> PC(pool, nameSpace + "barkbands");
+  connectFrames(barkBands->output("bands"), pool, nameSpace + "barkbands");
 
   // Spectral BarkBands Central Moments Statistics, Flatness and Crest
   Algorithm* barks_cm = factory.create("CentralMoments", "range", nBarkBands-1);
   Algorithm* barks_ds = factory.create("DistributionShape");
   barkBands->output("bands")          >> barks_cm->input("array");
   barks_cm->output("centralMoments")  >> barks_ds->input("centralMoments");
-  barks_ds->output("kurtosis")        >> PC(pool, nameSpace + "barkbands_kurtosis");
-  barks_ds->output("spread")          >> PC(pool, nameSpace + "barkbands_spread");
-  barks_ds->output("skewness")        >> PC(pool, nameSpace + "barkbands_skewness");
+  connectFrames(barks_ds->output("kurtosis"), pool, nameSpace + "barkbands_kurtosis");
+  connectFrames(barks_ds->output("spread"), pool, nameSpace + "barkbands_spread");
+  connectFrames(barks_ds->output("skewness"), pool, nameSpace + "barkbands_skewness");
 
   Algorithm* barks_fl = factory.create("FlatnessDB");
   Algorithm* barks_cr = factory.create("Crest");
   barkBands->output("bands")      >> barks_fl->input("array");
   barkBands->output("bands")      >> barks_cr->input("array");
-  barks_fl->output("flatnessDB")  >> PC(pool, nameSpace + "barkbands_flatness_db");
-  barks_cr->output("crest")       >> PC(pool, nameSpace + "barkbands_crest");
+  connectFrames(barks_fl->output("flatnessDB"), pool, nameSpace + "barkbands_flatness_db");
+  connectFrames(barks_cr->output("crest"), pool, nameSpace + "barkbands_crest");
 
   // Spectral Decrease
   Algorithm* square = factory.create("UnaryOperator", "type", "square");
@@ -144,22 +156,22 @@ void MusicLowlevelDescriptors::createNetworkNeqLoud(SourceBase& source, Pool& po
                                        "range", sampleRate * 0.5);
   spec->output("spectrum")      >> square->input("array");
   square->output("array")       >> decrease->input("array");
-  decrease->output("decrease")  >> PC(pool, nameSpace + "spectral_decrease");
+  connectFrames(decrease->output("decrease"), pool, nameSpace + "spectral_decrease");
 
   // Spectral Roll Off
   Algorithm* ro = factory.create("RollOff");
   spec->output("spectrum")  >> ro->input("spectrum");
-  ro->output("rollOff")     >> PC(pool, nameSpace + "spectral_rolloff");
+  connectFrames(ro->output("rollOff"), pool, nameSpace + "spectral_rolloff");
 
   // Spectral Energy
   Algorithm* energy = factory.create("Energy");
   spec->output("spectrum") >> energy->input("array");
-  energy->output("energy") >> PC(pool, nameSpace + "spectral_energy");
+  connectFrames(energy->output("energy"), pool, nameSpace + "spectral_energy");
 
   // Spectral RMS
   Algorithm* rms = factory.create("RMS");
   spec->output("spectrum")  >> rms->input("array");
-  rms->output("rms")        >> PC(pool, nameSpace + "spectral_rms");
+  connectFrames(rms->output("rms"), pool, nameSpace + "spectral_rms");
 
   // Spectral Energy Band Ratio
   Algorithm* ebr_low      = factory.create("EnergyBand",
@@ -178,35 +190,35 @@ void MusicLowlevelDescriptors::createNetworkNeqLoud(SourceBase& source, Pool& po
   spec->output("spectrum")  >> ebr_mid_low->input("spectrum");
   spec->output("spectrum")  >> ebr_mid_hi->input("spectrum");
   spec->output("spectrum")  >> ebr_hi->input("spectrum");
-  ebr_low->output("energyBand")     >> PC(pool, nameSpace + "spectral_energyband_low");
-  ebr_mid_low->output("energyBand") >> PC(pool, nameSpace + "spectral_energyband_middle_low");
-  ebr_mid_hi->output("energyBand")  >> PC(pool, nameSpace + "spectral_energyband_middle_high");
-  ebr_hi->output("energyBand")      >> PC(pool, nameSpace + "spectral_energyband_high");
+  connectFrames(ebr_low->output("energyBand"), pool, nameSpace + "spectral_energyband_low");
+  connectFrames(ebr_mid_low->output("energyBand"), pool, nameSpace + "spectral_energyband_middle_low");
+  connectFrames(ebr_mid_hi->output("energyBand"), pool, nameSpace + "spectral_energyband_middle_high");
+  connectFrames(ebr_hi->output("energyBand"), pool, nameSpace + "spectral_energyband_high");
 
   // Spectral HFC
   Algorithm* hfc = factory.create("HFC");
   spec->output("spectrum")  >> hfc->input("spectrum");
-  hfc->output("hfc")        >> PC(pool, nameSpace + "hfc");
+  connectFrames(hfc->output("hfc"), pool, nameSpace + "hfc");
 
   // Spectral Flux
   Algorithm* flux = factory.create("Flux");
   spec->output("spectrum")  >> flux->input("spectrum");
-  flux->output("flux")      >> PC(pool, nameSpace + "spectral_flux");
+  connectFrames(flux->output("flux"), pool, nameSpace + "spectral_flux");
 
   // Spectral Strong Peak
   Algorithm* sp = factory.create("StrongPeak");
   spec->output("spectrum") >> sp->input("spectrum");
-  sp->output("strongPeak") >> PC(pool, nameSpace + "spectral_strongpeak");
+  connectFrames(sp->output("strongPeak"), pool, nameSpace + "spectral_strongpeak");
 
   // Spectral Complexity
   Algorithm* tc = factory.create("SpectralComplexity", "magnitudeThreshold", 0.005);
   spec->output("spectrum")          >> tc->input("spectrum");
-  tc->output("spectralComplexity")  >> PC(pool, nameSpace + "spectral_complexity");
+  connectFrames(tc->output("spectralComplexity"), pool, nameSpace + "spectral_complexity");
 
   // Pitch Salience
   Algorithm* ps = factory.create("PitchSalience");
   spec->output("spectrum")    >> ps->input("spectrum");
-  ps->output("pitchSalience") >> PC(pool, nameSpace + "pitch_salience");
+  connectFrames(ps->output("pitchSalience"), pool, nameSpace + "pitch_salience");
 
 
   // NB: Removed pitch detection based on PitchYinFFT because it is usefull for monophonic signals only
@@ -262,35 +274,32 @@ void MusicLowlevelDescriptors::createNetworkEqLoud(SourceBase& source, Pool& poo
 
   Algorithm* eqloud = factory.create("EqualLoudness",
                                      "sampleRate", sampleRate);
-  Algorithm* fc   = factory.create("FrameCutter",
+  Algorithm* spec = factory.create("FramedSpectrum",
                                    "frameSize", frameSize,
                                    "hopSize", hopSize,
-                                   "silentFrames", silentFrames);
-  Algorithm* w    = factory.create("Windowing",
-                                   "type", windowType,
+                                   "silentFrames", silentFrames,
+                                   "windowType", windowType,
                                    "zeroPadding", zeroPadding);
-  Algorithm* spec = factory.create("Spectrum");
 
   source                    >> eqloud->input("signal");
-  eqloud->output("signal")  >> fc->input("signal");
-  fc->output("frame")       >> w->input("frame");
-  w->output("frame")        >> spec->input("frame");
+  eqloud->output("signal")  >> spec->input("signal");
+  spec->output("frame")     >> NOWHERE;
 
   // Spectral Centroid
   Algorithm* square = factory.create("UnaryOperator", "type", "square");
   Algorithm* centroid = factory.create("Centroid", "range", sampleRate * 0.5);
   spec->output("spectrum")      >> square->input("array");
   square->output("array")       >> centroid->input("array");
-  centroid->output("centroid")  >> PC(pool, nameSpace + "spectral_centroid");
+  connectFrames(centroid->output("centroid"), pool, nameSpace + "spectral_centroid");
 
   // Spectral Central Moments Statistics
   Algorithm* cm = factory.create("CentralMoments", "range", sampleRate * 0.5);
   Algorithm* ds = factory.create("DistributionShape");
   spec->output("spectrum")      >> cm->input("array");
   cm->output("centralMoments")  >> ds->input("centralMoments");
-  ds->output("kurtosis")        >> PC(pool, nameSpace + "spectral_kurtosis");
-  ds->output("spread")          >> PC(pool, nameSpace + "spectral_spread");
-  ds->output("skewness")        >> PC(pool, nameSpace + "spectral_skewness");
+  connectFrames(ds->output("kurtosis"), pool, nameSpace + "spectral_kurtosis");
+  connectFrames(ds->output("spread"), pool, nameSpace + "spectral_spread");
+  connectFrames(ds->output("skewness"), pool, nameSpace + "spectral_skewness");
 
   // Spectral Dissonance
   Algorithm* peaks = factory.create("SpectralPeaks", "orderBy", "frequency");
@@ -298,12 +307,12 @@ void MusicLowlevelDescriptors::createNetworkEqLoud(SourceBase& source, Pool& poo
   spec->output("spectrum")      >> peaks->input("spectrum");
   peaks->output("frequencies")  >> diss->input("frequencies");
   peaks->output("magnitudes")   >> diss->input("magnitudes");
-  diss->output("dissonance")    >> PC(pool, nameSpace + "dissonance");
+  connectFrames(diss->output("dissonance"), pool, nameSpace + "dissonance");
 
   // Spectral Entropy
   Algorithm* ent = factory.create("Entropy");
   spec->output("spectrum")  >> ent->input("array");
-  ent->output("entropy")    >> PC(pool, nameSpace + "spectral_entropy");
+  connectFrames(ent->output("entropy"), pool, nameSpace + "spectral_entropy");
 
   // Spectral Contrast
   Algorithm* sc = factory.create("SpectralContrast",
@@ -316,8 +325,8 @@ void MusicLowlevelDescriptors::createNetworkEqLoud(SourceBase& source, Pool& poo
                                  "staticDistribution", 0.15);
 
   spec->output("spectrum")        >> sc->input("spectrum");
-  sc->output("spectralContrast")  >> PC(pool, nameSpace + "spectral_contrast_coeffs");
-  sc->output("spectralValley")    >> PC(pool, nameSpace + "spectral_contrast_valleys");
+  connectFrames(sc->output("spectralContrast"), pool, nameSpace + "spectral_contrast_coeffs");
+  connectFrames(sc->output("spectralValley"), pool, nameSpace + "spectral_contrast_valleys");
 }
 
 
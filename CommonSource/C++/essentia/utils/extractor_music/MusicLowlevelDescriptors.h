@@ -30,15 +30,26 @@ class MusicLowlevelDescriptors : public MusicDescriptorSet {
  public:
  	static const string nameSpace;  
 
-  MusicLowlevelDescriptors(Pool& options) {
+  MusicLowlevelDescriptors(Pool& options) : statsPool(0) {
     this->options = options;
   }
-  ~MusicLowlevelDescriptors();
+  ~MusicLowlevelDescriptors() {}
+
+  /**
+   * Sets the pool receiving the statistics of the frame descriptors when
+   * their frames are not stored (see connectFrames()).
+   */
+  void setStatsPool(Pool* pool) { statsPool = pool; }
 
  	void createNetworkNeqLoud(SourceBase& source, Pool& pool);
   void createNetworkEqLoud(SourceBase& source, Pool& pool);
   void createNetworkLoudness(SourceBase& source, Pool& pool);
 	void computeAverageLoudness(Pool& pool);
+
+ protected:
+  Pool* statsPool;
+
+  void connectFrames(SourceBase& source, Pool& pool, const string& name);
 };
 
 #endif
\ No newline at end of file
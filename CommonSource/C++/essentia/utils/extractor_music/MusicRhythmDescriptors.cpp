@@ -87,4 +87,11 @@ void MusicRhythmDescriptors::createNetworkBeatsLoudness(SourceBase& source, Pool
   source                                      >> beatsLoudness->input("signal");
   beatsLoudness->output("loudness")           >> PC(pool, nameSpace + "beats_loudness");
   beatsLoudness->output("loudnessBandRatio")  >> PC(pool, nameSpace + "beats_loudness_band_ratio");
+
+  _beatsLoudness = beatsLoudness;
+}
+
+void MusicRhythmDescriptors::updateNetworkBeatsLoudness(Pool& pool) {
+  vector<Real> ticks = pool.value<vector<Real> >(nameSpace + "beats_position");
+  _beatsLoudness->configure("beats", ticks);
 }
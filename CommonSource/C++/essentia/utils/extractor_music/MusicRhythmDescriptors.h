@@ -32,13 +32,20 @@ class MusicRhythmDescriptors : public MusicDescriptorSet {
 
  	static const string nameSpace;  
 
-  MusicRhythmDescriptors(Pool& options) {
+  MusicRhythmDescriptors(Pool& options) : _beatsLoudness(0) {
     this->options = options;
   }
-  ~MusicRhythmDescriptors();
+  ~MusicRhythmDescriptors() {}
 
  	void createNetwork(SourceBase& source, Pool& pool);
 	void createNetworkBeatsLoudness(SourceBase& source, Pool& pool);
+
+  // reconfigures the network created by createNetworkBeatsLoudness() with the
+  // beat positions of a new file, so that it can be run again
+  void updateNetworkBeatsLoudness(Pool& pool);
+
+ protected:
+  Algorithm* _beatsLoudness;
 };
 
  #endif
\ No newline at end of file
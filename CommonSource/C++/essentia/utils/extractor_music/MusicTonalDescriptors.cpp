@@ -34,14 +34,12 @@ void MusicTonalDescriptors::createNetworkTuningFrequency(SourceBase& source, Poo
 
   AlgorithmFactory& factory = AlgorithmFactory::instance();
 
-  Algorithm* fc     = factory.create("FrameCutter",
+  Algorithm* spec   = factory.create("FramedSpectrum",
                                      "frameSize", frameSize,
                                      "hopSize", hopSize,
-                                     "silentFrames", silentFrames);
-  Algorithm* w      = factory.create("Windowing",
-                                     "type", windowType,
+                                     "silentFrames", silentFrames,
+                                     "windowType", windowType,
                                      "zeroPadding", zeroPadding);
-  Algorithm* spec   = factory.create("Spectrum");
   // TODO: which parameters to select for min/maxFrequency? [20, 3500] for consistency?
   Algorithm* peaks  = factory.create("SpectralPeaks",
                                      "maxPeaks", 10000,
@@ -51,9 +49,8 @@ void MusicTonalDescriptors::createNetworkTuningFrequency(SourceBase& source, Poo
                                      "orderBy", "frequency");
   Algorithm* tuning = factory.create("TuningFrequency");
 
-  source                            >> fc->input("signal");
-  fc->output("frame")               >> w->input("frame");
-  w->output("frame")                >> spec->input("frame");
+  source                            >> spec->input("signal");
+  spec->output("frame")             >> NOWHERE;
   spec->output("spectrum")          >> peaks->input("spectrum");
   peaks->output("magnitudes")       >> tuning->input("magnitudes");
   peaks->output("frequencies")      >> tuning->input("frequencies");
@@ -79,14 +76,12 @@ void MusicTonalDescriptors::createNetwork(SourceBase& source, Pool& pool) {
 
   AlgorithmFactory& factory = AlgorithmFactory::instance();
 
-  Algorithm* fc = factory.create("FrameCutter",
-                                 "frameSize", frameSize,
-                                 "hopSize", hopSize,
-                                 "silentFrames", silentFrames);
-  Algorithm* w = factory.create("Windowing",
-                                "type", windowType,
-                                "zeroPadding", zeroPadding);
-  Algorithm* spec = factory.create("Spectrum");
+  Algorithm* spec = factory.create("FramedSpectrum",
+                                   "frameSize", frameSize,
+                                   "hopSize", hopSize,
+                                   "silentFrames", silentFrames,
+                                   "windowType", windowType,
+                                   "zeroPadding", zeroPadding);
   Algorithm* peaks = factory.create("SpectralPeaks",
                                     "maxPeaks", 60,
                                     "magnitudeThreshold", 0.00001,
@@ -153,9 +148,8 @@ void MusicTonalDescriptors::createNetwork(SourceBase& source, Pool& pool) {
   Algorithm* schord = factory.create("ChordsDetection");
   Algorithm* schords_desc = factory.create("ChordsDescriptors");
 
-  source                       >> fc->input("signal");
-  fc->output("frame")          >> w->input("frame");
-  w->output("frame")           >> spec->input("frame");
+  source                       >> spec->input("signal");
+  spec->output("frame")        >> NOWHERE;
   spec->output("spectrum")     >> peaks->input("spectrum");
 
   peaks->output("frequencies") >> hpcp_key->input("frequencies");
@@ -224,12 +218,24 @@ void MusicTonalDescriptors::createNetwork(SourceBase& source, Pool& pool) {
   peaks->output("frequencies")  >> hpcp_tuning->input("frequencies");
   peaks->output("magnitudes")   >> hpcp_tuning->input("magnitudes");
   hpcp_tuning->output("hpcp")   >> PC(pool, nameSpace + "hpcp_highres");
+
+  _hpcps.clear();
+  _hpcps.push_back(hpcp_key);
+  _hpcps.push_back(hpcp_chord);
+  _hpcps.push_back(hpcp_tuning);
+}
+
+void MusicTonalDescriptors::updateNetwork(Pool& pool) {
+  Real tuningFreq = pool.value<vector<Real> >(nameSpace + "tuning_frequency").back();
+  for (int i=0; i<(int)_hpcps.size(); i++) {
+    _hpcps[i]->configure("referenceFrequency", tuningFreq);
+  }
 }
 
 
 void MusicTonalDescriptors::computeTuningSystemFeatures(Pool& pool){
 
-  vector<Real> hpcp_highres = meanFrames(pool.value<vector<vector<Real> > >(nameSpace + "hpcp_highres"));
+  vector<Real> hpcp_highres = meanFrames(pool.frames(nameSpace + "hpcp_highres"));
   pool.remove(nameSpace + "hpcp_highres");
   normalize(hpcp_highres);
 
@@ -269,7 +275,7 @@ void MusicTonalDescriptors::computeTuningSystemFeatures(Pool& pool){
   pool.set(nameSpace + "tuning_nontempered_energy_ratio", ntEnergy);
 
   // 3- THPCP
-  vector<Real> hpcp = meanFrames(pool.value<vector<vector<Real> > >(nameSpace + "hpcp"));
+  vector<Real> hpcp = meanFrames(pool.frames(nameSpace + "hpcp"));
   normalize(hpcp);
   int idxMax = argmax(hpcp);
   vector<Real> hpcp_bak = hpcp;
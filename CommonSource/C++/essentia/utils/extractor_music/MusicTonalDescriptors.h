@@ -31,11 +31,19 @@ class MusicTonalDescriptors : public MusicDescriptorSet {
   MusicTonalDescriptors(Pool& options) {
     this->options = options;
   }
-  ~MusicTonalDescriptors();
+  ~MusicTonalDescriptors() {}
 
   void createNetworkTuningFrequency(SourceBase& source, Pool& pool);
  	void createNetwork(SourceBase& source, Pool& pool);
   void computeTuningSystemFeatures(Pool& pool);
+
+  // reconfigures the network created by createNetwork() with the tuning
+  // frequency of a new file, so that it can be run again
+  void updateNetwork(Pool& pool);
+
+ protected:
+  // HPCPs using the tuning frequency as reference frequency
+  vector<Algorithm*> _hpcps;
 };
 
 #endif
\ No newline at end of file
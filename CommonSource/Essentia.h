@@ -37,6 +37,8 @@ FOUNDATION_EXPORT const unsigned char Essentia_MacVersionString[];
 #import <Essentia/NSValue+BridgingExtensions.h>
 #import <Essentia/AlgorithmFactoryWrapper.h>
 #import <Essentia/NetworkWrapper.h>
+#import <Essentia/AudioCacheWrapper.h>
+#import <Essentia/MusicExtractorBatchWrapper.h>
 #import <Essentia/VectorInputWrapper.h>
 #import <Essentia/VectorOutputWrapper.h>
 #import <Essentia/LoggerWrapper.h>
@@ -82,4 +82,30 @@
   createStreamingAlgorithmWithName:(nonnull NSString *)name
                    parameterValues:(nullable NSDictionary<NSString *, ParameterWrapper *> *)parameters;
 
+/**
+ Selects the implementation of the FFT, IFFT, FFTC and IFFTC algorithms created from then on.
+
+ @param backend "accelerate" for Apple's Accelerate framework, which is the default, or "builtin"
+                for the FFT of Essentia.
+ @return Whether `backend` is a known backend.
+ */
++ (BOOL)setFFTBackend:(nonnull NSString *)backend;
+
+/**
+ The number of FFT plans shared by the FFT algorithms which currently exist, or kept among the
+ `recentFFTPlanCount` most recently used ones. Any other plan is freed as soon as no algorithm uses
+ it anymore.
+ */
+@property (class, nonatomic, readonly) NSInteger cachedFFTPlanCount;
+
+/**
+ The number of recently used FFT plans kept once no algorithm uses them anymore.
+ */
+@property (class, nonatomic, readonly) NSInteger recentFFTPlanCount;
+
+/**
+ Frees the recently used FFT plans which no algorithm uses anymore.
+ */
++ (void)clearFFTPlanCache;
+
 @end
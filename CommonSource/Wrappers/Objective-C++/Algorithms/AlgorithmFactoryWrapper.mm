@@ -13,6 +13,7 @@
 #import "NSArray+BridgingExtensions.hpp"
 #import "NSString+BridgingExtensions.hpp"
 #import "ParameterWrapper+BridgingExtensions.hpp"
+#import "fftplancache.h"
 
 using namespace essentia;
 using namespace std;
@@ -151,4 +152,41 @@ using namespace std;
 
 }
 
+/**
+ Selects the implementation of the FFT, IFFT, FFTC and IFFTC algorithms created from then on.
+
+ @param backend "accelerate" for Apple's Accelerate framework, which is the default, or "builtin"
+                for the FFT of Essentia.
+ @return Whether `backend` is a known backend.
+ */
++ (BOOL)setFFTBackend:(nonnull NSString *)backend {
+
+  try {
+    essentia::setFFTBackend(backend.cppString);
+    return YES;
+  } catch (exception) {
+    return NO;
+  }
+
+}
+
+/**
+ Accessor for the number of FFT plans in the cache.
+
+ @return The value retrieved via `FFTPlanCache::size`.
+ */
++ (NSInteger)cachedFFTPlanCount { return FFTPlanCache::size(); }
+
+/**
+ Accessor for the number of recently used FFT plans kept by the cache.
+
+ @return The value of `FFTPlanCache::RecentPlans`.
+ */
++ (NSInteger)recentFFTPlanCount { return FFTPlanCache::RecentPlans; }
+
+/**
+ Frees the recently used FFT plans which no algorithm uses anymore.
+ */
++ (void)clearFFTPlanCache { FFTPlanCache::clear(); }
+
 @end
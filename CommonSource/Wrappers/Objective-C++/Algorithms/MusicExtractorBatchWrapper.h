@@ -0,0 +1,79 @@
+//
+//  MusicExtractorBatchWrapper.h
+//  Essentia
+//
+//  Copyright © 2017 Moondeer Studios. All rights reserved.
+//
+#import <Foundation/Foundation.h>
+#import "WrappedTypes.h"
+
+@class ParameterWrapper;
+@class PoolWrapper;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ A wrapper for the C++ `MusicExtractorBatch`, which runs the `MusicExtractor` on a list of files
+ using several threads, each of them reusing its own extractor for all the files it analyzes.
+ */
+@interface MusicExtractorBatchWrapper : NSObject
+
+/**
+ Initializes the wrapper with the parameters of the extractors and a number of threads.
+
+ @param parameters The dictionary of parameter values of the `MusicExtractor` keyed by their names.
+ @param numThreads The number of files analyzed concurrently. `0` uses as many threads as there
+                   are cores.
+ @return The newly initialized batch wrapper.
+ */
+- (instancetype)initWithParameters:(nullable NSDictionary<NSString *, ParameterWrapper *> *)parameters
+                        numThreads:(NSInteger)numThreads;
+
+/**
+ Initializes the wrapper with the name, the parameters of the extractors and a number of threads.
+
+ @param extractor The name of the standard algorithm run on each file or signal.
+ @param parameters The dictionary of parameter values of the extractor keyed by their names.
+ @param numThreads The number of files analyzed concurrently. `0` uses as many threads as there
+                   are cores.
+ @return The newly initialized batch wrapper.
+ */
+- (instancetype)initWithExtractor:(NSString *)extractor
+                       parameters:(nullable NSDictionary<NSString *, ParameterWrapper *> *)parameters
+                       numThreads:(NSInteger)numThreads;
+
+/**
+ Analyzes all the given audio files, writing the statistics of `audioFiles[i]` to `outputFiles[i]`.
+
+ @param audioFiles The paths of the audio files to analyze.
+ @param outputFiles The paths of the files receiving the statistics.
+ @param format The format of the output files, "json" or "yaml".
+ @return The number of files which failed.
+ */
+- (NSInteger)computeWithAudioFiles:(NSArray<NSString *> *)audioFiles
+                       outputFiles:(NSArray<NSString *> *)outputFiles
+                            format:(NSString *)format;
+
+/**
+ Analyzes all the given signals with an extractor which has an "audio" input and a "pool" output,
+ such as the `Extractor`.
+
+ @param signals The signals to analyze.
+ @return The pools of descriptors of the signals, empty for the signals which failed.
+ */
+- (NSArray<PoolWrapper *> *)computeWithSignals:(OBJCRealVecVec)signals;
+
+/**
+ The paths of the files (or "signal <i>" for the signals) which failed during the last
+ computation, with their error messages.
+ */
+@property (nonatomic, readonly) NSDictionary<NSString *, NSString *> *errors;
+
+/**
+ The number of threads used to analyze the files.
+ */
+@property (nonatomic, readonly) NSInteger numThreads;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,86 @@
+//
+//  MusicExtractorBatchWrapper.mm
+//  Essentia
+//
+//  Copyright © 2017 Moondeer Studios. All rights reserved.
+//
+#import "MusicExtractorBatchWrapper.h"
+#import "ParameterWrapper+BridgingExtensions.hpp"
+#import "NSString+BridgingExtensions.hpp"
+#import "NSArray+BridgingExtensions.hpp"
+#import "PoolWrapper+BridgingExtensions.hpp"
+#import "MusicExtractorBatch.h"
+#import <memory>
+
+using namespace essentia;
+using namespace std;
+
+@implementation MusicExtractorBatchWrapper {
+  unique_ptr<MusicExtractorBatch> _batch;
+}
+
+- (instancetype)initWithParameters:(NSDictionary<NSString *, ParameterWrapper *> *)parameters
+                        numThreads:(NSInteger)numThreads
+{
+  return [self initWithExtractor:@"MusicExtractor" parameters:parameters numThreads:numThreads];
+}
+
+- (instancetype)initWithExtractor:(NSString *)extractor
+                       parameters:(NSDictionary<NSString *, ParameterWrapper *> *)parameters
+                       numThreads:(NSInteger)numThreads
+{
+  if (!(self = [super init])) { return nil; }
+
+  ParameterMap map;
+
+  for (NSString *key in parameters.allKeys) {
+    map.add(key.cppString, parameters[key].parameter);
+  }
+
+  _batch = make_unique<MusicExtractorBatch>(map, (int)numThreads, extractor.cppString);
+
+  return self;
+}
+
+- (NSInteger)computeWithAudioFiles:(NSArray<NSString *> *)audioFiles
+                       outputFiles:(NSArray<NSString *> *)outputFiles
+                            format:(NSString *)format
+{
+  vector<string> audioFilenames, outputFilenames;
+
+  for (NSString *file in audioFiles) { audioFilenames.push_back(file.cppString); }
+  for (NSString *file in outputFiles) { outputFilenames.push_back(file.cppString); }
+
+  return _batch->compute(audioFilenames, outputFilenames, vector<string>(), format.cppString);
+}
+
+- (NSArray<PoolWrapper *> *)computeWithSignals:(OBJCRealVecVec)signals {
+
+  vector<Pool> pools;
+  _batch->compute(signals.realVecVecValue, pools);
+
+  NSMutableArray<PoolWrapper *> *result = [NSMutableArray new];
+
+  for (Pool &pool : pools) {
+    [result addObject:[PoolWrapper poolWrapperWithPool:&pool]];
+  }
+
+  return [NSArray arrayWithArray:result];
+
+}
+
+- (NSDictionary<NSString *, NSString *> *)errors {
+
+  NSMutableDictionary *result = [NSMutableDictionary new];
+
+  for (auto error : _batch->errors()) {
+    result[[NSString stringWithCPPString:error.first]] = [NSString stringWithCPPString:error.second];
+  }
+
+  return [NSDictionary dictionaryWithDictionary:result];
+
+}
+
+- (NSInteger)numThreads { return _batch->numThreads(); }
+
+@end
@@ -0,0 +1,71 @@
+//
+//  AudioCacheWrapper.h
+//  Essentia
+//
+//  Copyright © 2017 Moondeer Studios. All rights reserved.
+//
+#import <Foundation/Foundation.h>
+#import "WrappedTypes.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ A wrapper for a reference on a signal of the C++ `AudioCache`, the cache of decoded mono signals
+ which the `CachedMonoLoader` algorithm reads from. The signal stays in the cache at least as long
+ as the wrapper holds its reference.
+ */
+@interface AudioCacheWrapper : NSObject
+
+/**
+ Initializes the wrapper with a reference on the signal of a file, which is decoded with a
+ `MonoLoader` if it is not in the cache yet.
+
+ @param filename The path of the audio file.
+ @param sampleRate The sample rate of the signal.
+ @param downmix The mixing type for stereo files, "left", "right" or "mix".
+ @return The newly initialized wrapper.
+ */
+- (instancetype)initWithFilename:(NSString *)filename
+                      sampleRate:(float)sampleRate
+                         downmix:(NSString *)downmix;
+
+/**
+ Initializes the wrapper with a reference on a signal which has already been decoded. If the
+ signal of the file is already in the cache, the cached signal is kept instead.
+
+ @param signal The decoded signal.
+ @param filename The path of the audio file.
+ @param sampleRate The sample rate of the signal.
+ @param downmix The mixing type for stereo files, "left", "right" or "mix".
+ @return The newly initialized wrapper.
+ */
+- (instancetype)initWithSignal:(OBJCRealVec)signal
+                      filename:(NSString *)filename
+                    sampleRate:(float)sampleRate
+                       downmix:(NSString *)downmix;
+
+/**
+ Releases the reference before the wrapper is deallocated.
+ */
+- (void)releaseSignal;
+
+/**
+ The signal the wrapper holds a reference on, `nil` once it has been released.
+ */
+@property (nullable, nonatomic, readonly) OBJCRealVec signal;
+
+/**
+ Whether the signal of a file is in the cache.
+ */
++ (BOOL)containsFilename:(NSString *)filename
+              sampleRate:(float)sampleRate
+                 downmix:(NSString *)downmix;
+
+/**
+ The number of signals in the cache.
+ */
+@property (class, nonatomic, readonly) NSInteger count;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,68 @@
+//
+//  AudioCacheWrapper.mm
+//  Essentia
+//
+//  Copyright © 2017 Moondeer Studios. All rights reserved.
+//
+#import "AudioCacheWrapper.h"
+#import "NSArray+BridgingExtensions.hpp"
+#import "NSString+BridgingExtensions.hpp"
+#import "audiocache.h"
+#import <memory>
+
+using namespace essentia;
+using namespace std;
+
+@implementation AudioCacheWrapper {
+  unique_ptr<AudioCacheReference> _reference;
+}
+
+- (instancetype)initWithFilename:(NSString *)filename
+                      sampleRate:(float)sampleRate
+                         downmix:(NSString *)downmix
+{
+  if (!(self = [super init])) { return nil; }
+
+  _reference = make_unique<AudioCacheReference>();
+  _reference->acquire(filename.cppString, sampleRate, downmix.cppString);
+
+  return self;
+}
+
+- (instancetype)initWithSignal:(OBJCRealVec)signal
+                      filename:(NSString *)filename
+                    sampleRate:(float)sampleRate
+                       downmix:(NSString *)downmix
+{
+  if (!(self = [super init])) { return nil; }
+
+  RealVec audio = signal.realVecValue;
+
+  _reference = make_unique<AudioCacheReference>();
+  _reference->insert(filename.cppString, sampleRate, downmix.cppString, 0, audio);
+
+  return self;
+}
+
+- (void)releaseSignal { _reference->release(); }
+
+- (OBJCRealVec)signal {
+
+  if (!_reference->audio()) { return nil; }
+
+  RealVec audio = *_reference->audio();
+
+  return [NSArray arrayWithRealVec:audio];
+
+}
+
++ (BOOL)containsFilename:(NSString *)filename
+              sampleRate:(float)sampleRate
+                 downmix:(NSString *)downmix
+{
+  return AudioCache::instance().contains(filename.cppString, sampleRate, downmix.cppString);
+}
+
++ (NSInteger)count { return AudioCache::instance().size(); }
+
+@end
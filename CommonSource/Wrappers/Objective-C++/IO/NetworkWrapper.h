@@ -56,6 +56,15 @@ NS_ASSUME_NONNULL_BEGIN
  */
 - (void)run;
 
+/**
+ Executes all the algorithms in the network like `run`, running the algorithms which do not depend
+ on each other concurrently.
+
+ @param numThreads The number of threads to use, including the calling thread. `0` uses as many
+                   threads as there are cores.
+ */
+- (void)runWithThreads:(NSInteger)numThreads;
+
 /**
  Does the preparation needed to process the tokens of the network.
  */
@@ -73,6 +82,58 @@ NS_ASSUME_NONNULL_BEGIN
  */
 - (void)update;
 
+/**
+ Switches all the buffers of the network to lock-free buffers which can be written and read from
+ different threads, or back to the default buffers. Must be invoked before running the network.
+ When run on several threads, the generator of such a network produces the tokens of the next step
+ while the other algorithms consume those of the current one.
+
+ @param concurrent Whether to use the lock-free buffers.
+ */
+- (void)setConcurrentBuffers:(BOOL)concurrent;
+
+/**
+ Whether the next run of the network records per-algorithm statistics (calls, time spent, tokens
+ consumed and produced, buffer occupancy) and a trace of every call to `process`.
+ */
+@property (nonatomic, readwrite) BOOL profiling;
+
+/**
+ The statistics recorded during the last profiled run as a JSON document, `nil` if the network
+ has not been profiled.
+ */
+@property (nullable, nonatomic, readonly) NSString *profileJSON;
+
+/**
+ The calls recorded during the last profiled run in the Chrome trace event format, which can be
+ loaded in chrome://tracing. `nil` if the network has not been profiled.
+ */
+@property (nullable, nonatomic, readonly) NSString *chromeTrace;
+
+/**
+ Sets whether the buffers are resized during the first `warmupSteps` steps of the next runs, so
+ that no algorithm has to be rescheduled because its output buffers are full.
+ */
+- (void)setAdaptiveBufferSizes:(BOOL)adaptive warmupSteps:(NSInteger)warmupSteps;
+
+/**
+ The memory taken by the buffers of the network, in bytes.
+ */
+@property (nonatomic, readonly) long long bufferMemory;
+
+/**
+ Whether algorithms with the same type and parameters whose inputs are connected to the same
+ sources are merged into one when the network is run. Algorithms using random numbers (eg:
+ NoiseAdder) are never merged. Disabled by default.
+ */
+@property (nonatomic, readwrite) BOOL mergeDuplicates;
+
+/**
+ The number of algorithms which have been disconnected from the network because they were
+ duplicates of another one.
+ */
+@property (nonatomic, readonly) NSInteger mergedAlgorithmCount;
+
 /**
  Invokes `reset` for each algorithm contained in the network.
  */
@@ -8,6 +8,7 @@
 #import "NetworkWrapper+BridgingExtensions.hpp"
 #import "AlgorithmWrapper+BridgingExtensions.hpp"
 #import "NSString+BridgingExtensions.hpp"
+#import "networkprofiler.h"
 #import <memory>
 
 using namespace essentia;
@@ -91,6 +92,15 @@ using namespace std;
  */
 - (void)run { _network->run(); }
 
+/**
+ Executes all the algorithms in the network like `run`, running the algorithms which do not depend
+ on each other concurrently.
+
+ @param numThreads The number of threads to use, including the calling thread. `0` uses as many
+                   threads as there are cores.
+ */
+- (void)runWithThreads:(NSInteger)numThreads { _network->run((int)numThreads); }
+
 /**
  Does the preparation needed to process the tokens of the network.
  */
@@ -108,6 +118,40 @@ using namespace std;
  */
 - (void)update { _network->update(); }
 
+/**
+ Switches all the buffers of the network to lock-free buffers which can be written and read from
+ different threads, or back to the default buffers. Must be invoked before running the network.
+
+ @param concurrent Whether to use the lock-free buffers.
+ */
+- (void)setConcurrentBuffers:(BOOL)concurrent { _network->setConcurrentBuffers(concurrent); }
+
+- (BOOL)profiling { return (BOOL)_network->isProfiling(); }
+
+- (void)setProfiling:(BOOL)profiling { _network->setProfiling(profiling); }
+
+- (NSString *)profileJSON {
+  NetworkProfiler *profiler = _network->profiler();
+  return profiler ? [NSString stringWithCPPString:profiler->toJson()] : nil;
+}
+
+- (NSString *)chromeTrace {
+  NetworkProfiler *profiler = _network->profiler();
+  return profiler ? [NSString stringWithCPPString:profiler->toChromeTrace()] : nil;
+}
+
+- (void)setAdaptiveBufferSizes:(BOOL)adaptive warmupSteps:(NSInteger)warmupSteps {
+  _network->setAdaptiveBufferSizes(adaptive, (int)warmupSteps);
+}
+
+- (long long)bufferMemory { return _network->bufferMemory(); }
+
+- (BOOL)mergeDuplicates { return (BOOL)_network->isMergeDuplicates(); }
+
+- (void)setMergeDuplicates:(BOOL)mergeDuplicates { _network->setMergeDuplicates(mergeDuplicates); }
+
+- (NSInteger)mergedAlgorithmCount { return (NSInteger)_network->mergedAlgorithms().size(); }
+
 /**
  Invokes `reset` for each algorithm contained in the network.
  */
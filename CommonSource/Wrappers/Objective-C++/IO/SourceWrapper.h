@@ -56,6 +56,19 @@ NS_ASSUME_NONNULL_BEGIN
              usingDescriptor:(NSString *)descriptorName
                    setSingle:(BOOL)setSingle;
 
+/**
+ Connects the source to the specified pool through an `OnlinePoolAggregator`, which only stores
+ the statistics of the data, computed as it flows, instead of the data itself.
+
+ @param poolWrapper The wrapper for the pool to which the source will be connected.
+ @param descriptorName The descriptor whose statistics will be stored in `poolWrapper`, under the
+                       names '<descriptorName>.<statistic>'.
+ @param statistics The names of the statistics, as given to the `PoolAggregator`.
+ */
+- (void)connectToPoolWrapper:(PoolWrapper *)poolWrapper
+             usingDescriptor:(NSString *)descriptorName
+       aggregatingStatistics:(NSArray<NSString *> *)statistics;
+
 /**
  Disconnects the source from the specified sink.
 
@@ -9,6 +9,7 @@
 #import "NSString+BridgingExtensions.hpp"
 #import "IODataType+BridgingExtensions.hpp"
 #import "poolstorage.h"
+#import "onlinepoolaggregator.h"
 #import "PoolWrapper+BridgingExtensions.hpp"
 #import "vectoroutput.h"
 #import "SinkWrapper+BridgingExtensions.hpp"
@@ -164,6 +165,26 @@ using namespace std;
   }
 }
 
+/**
+ Connects the source to the specified pool through an `OnlinePoolAggregator`, which only stores
+ the statistics of the data, computed as it flows, instead of the data itself.
+
+ @param poolWrapper The wrapper for the pool to which the source will be connected.
+ @param descriptorName The descriptor whose statistics will be stored in `poolWrapper`, under the
+                       names '<descriptorName>.<statistic>'.
+ @param statistics The names of the statistics, as given to the `PoolAggregator`.
+ */
+- (void)connectToPoolWrapper:(PoolWrapper *)poolWrapper
+             usingDescriptor:(NSString *)descriptorName
+       aggregatingStatistics:(NSArray<NSString *> *)statistics
+{
+  vector<string> stats;
+
+  for (NSString *statistic in statistics) { stats.push_back(statistic.cppString); }
+
+  streaming::connectAggregated(*(_sourceBase), *(poolWrapper->_pool), descriptorName.cppString, stats);
+}
+
 /**
  Disconnects the source from the specified sink.
 
@@ -9,6 +9,13 @@
 #import "pool.h"
 #import <memory>
 
+@interface DescriptorHandleWrapper () {
+  @package
+  essentia::DescriptorHandle _handle;
+}
+
+@end
+
 @interface PoolWrapper () {
   @package
   std::shared_ptr<essentia::Pool> _pool;
@@ -10,6 +10,12 @@
 
 NS_ASSUME_NONNULL_BEGIN
 
+/**
+ Wrapper class that serves to bridge the C++ class `DescriptorHandle`.
+ */
+@interface DescriptorHandleWrapper: NSObject
+@end
+
 /**
  Wrapper class that serves to bridge the C++ class `Pool`.
  */
@@ -22,6 +28,14 @@ NS_ASSUME_NONNULL_BEGIN
  */
 - (instancetype)init;
 
+/**
+ Initializing with a copy of the pool wrapped by another wrapper.
+
+ @param poolWrapper The wrapper for the pool to copy.
+ @return The newly initialized wrapper for the copy of the pool.
+ */
+- (instancetype)initWithPoolWrapper:(PoolWrapper *)poolWrapper;
+
 /**
  Adds a value to the wrapped pool for the specified name.
 
@@ -140,6 +154,42 @@ NS_ASSUME_NONNULL_BEGIN
 - (void)addStereoSampleValue:(OBJCStereoSample)stereoSampleValue
                     forName:(OBJCString)name;
 
+/**
+ Interns a descriptor name, which does not add it to the wrapped pool.
+
+ @param name The descriptor name to intern.
+ @return A handle with which values can be added for `name` without looking it up. It remains
+         valid as long as the pool exists, and can be used with the copies of the pool too.
+ */
+- (DescriptorHandleWrapper *)registerDescriptorName:(OBJCString)name;
+
+/**
+ Adds a value to the wrapped pool for the descriptor name of the specified handle, as
+ `addRealValue:forName:` does.
+
+ @param realValue The value to add to the collection of data for `handle`.
+ @param handle The handle returned by `registerDescriptorName:`.
+ */
+- (void)addRealValue:(OBJCReal)realValue forHandle:(DescriptorHandleWrapper *)handle;
+
+/**
+ Adds a value to the wrapped pool for the descriptor name of the specified handle, as
+ `addRealVecValue:forName:` does.
+
+ @param realVecValue The value to add to the collection of data for `handle`.
+ @param handle The handle returned by `registerDescriptorName:`.
+ */
+- (void)addRealVecValue:(OBJCRealVec)realVecValue forHandle:(DescriptorHandleWrapper *)handle;
+
+/**
+ Adds a value to the wrapped pool for the descriptor name of the specified handle, as
+ `addStringValue:forName:` does.
+
+ @param stringValue The value to add to the collection of data for `handle`.
+ @param handle The handle returned by `registerDescriptorName:`.
+ */
+- (void)addStringValue:(OBJCString)stringValue forHandle:(DescriptorHandleWrapper *)handle;
+
 /**
  Sets the value of a descriptor name.
 
@@ -229,6 +279,13 @@ NS_ASSUME_NONNULL_BEGIN
  */
 - (void)mergeWithPool:(PoolWrapper *)pool type:(OBJCString)type;
 
+/**
+ Replaces the values and the registered descriptors of the pool with copies of those of `pool`.
+
+ @param pool The pool to copy.
+ */
+- (void)replaceWithPool:(PoolWrapper *)pool;
+
 /**
  Merges the specified values into the pool for `name`.
 
@@ -402,6 +459,15 @@ NS_ASSUME_NONNULL_BEGIN
  */
 - (OBJCRealVecVec)realVecVecValueForName:(OBJCString)name;
 
+/**
+ Accessor for the frames of a real vector descriptor, read from their contiguous storage. An
+ exception is thrown if there are no such frames for `name`, or if they have different sizes.
+
+ @param name The descriptor for which to retrieve the frames.
+ @return The frames of `name`.
+ */
+- (OBJCRealVecVec)realVecFramesForName:(OBJCString)name;
+
 /**
  Accessor for the data associated with a descriptor. An exception is thrown if there is not any
  data associated with `name` of the appropriate return type.
@@ -527,6 +593,12 @@ NS_ASSUME_NONNULL_BEGIN
  */
 - (BOOL)containsStereoSampleVecForName:(nonnull OBJCString)name;
 
+/**
+ Whether the pool locks its sub-pools, so that several threads can write to it at the same time.
+ It is `NO` by default, and must only be set while no other thread uses the pool.
+ */
+@property (nonatomic, getter=isConcurrent) BOOL concurrent;
+
 /**
  The list of descriptor names in the pool.
  */
@@ -16,6 +16,9 @@
 using namespace essentia;
 using namespace std;
 
+@implementation DescriptorHandleWrapper
+@end
+
 @implementation PoolWrapper
 
 /**
@@ -45,6 +48,16 @@ using namespace std;
   return self;
 }
 
+/**
+ Initializing with a copy of the pool wrapped by another wrapper.
+
+ @param poolWrapper The wrapper for the pool to copy.
+ @return The newly initialized wrapper for the copy of the pool.
+ */
+- (nonnull instancetype)initWithPoolWrapper:(nonnull PoolWrapper *)poolWrapper {
+  return [self initWithPool:poolWrapper->_pool.get()];
+}
+
 /**
  Creates a new wrapper for an existing C++ `Pool`.
 
@@ -191,6 +204,58 @@ using namespace std;
   _pool->add(name.cppString, stereoSample);
 }
 
+/**
+ Interns a descriptor name, which does not add it to the wrapped pool.
+
+ @param name The descriptor name to intern.
+ @return A handle with which values can be added for `name` without looking it up. It remains
+         valid as long as the pool exists, and can be used with the copies of the pool too.
+ */
+- (nonnull DescriptorHandleWrapper *)registerDescriptorName:(nonnull OBJCString)name {
+  DescriptorHandleWrapper *handle = [DescriptorHandleWrapper new];
+  handle->_handle = _pool->registerDescriptor(name.cppString);
+  return handle;
+}
+
+/**
+ Adds a value to the wrapped pool for the descriptor name of the specified handle, as
+ `addRealValue:forName:` does.
+
+ @param realValue The value to add to the collection of data for `handle`.
+ @param handle The handle returned by `registerDescriptorName:`.
+ */
+- (void)addRealValue:(nonnull OBJCReal)realValue
+           forHandle:(nonnull DescriptorHandleWrapper *)handle
+{
+  _pool->add(handle->_handle, realValue.floatValue);
+}
+
+/**
+ Adds a value to the wrapped pool for the descriptor name of the specified handle, as
+ `addRealVecValue:forName:` does.
+
+ @param realVecValue The value to add to the collection of data for `handle`.
+ @param handle The handle returned by `registerDescriptorName:`.
+ */
+- (void)addRealVecValue:(nonnull OBJCRealVec)realVecValue
+              forHandle:(nonnull DescriptorHandleWrapper *)handle
+{
+  _pool->add(handle->_handle, realVecValue.realVecValue);
+}
+
+/**
+ Adds a value to the wrapped pool for the descriptor name of the specified handle, as
+ `addStringValue:forName:` does.
+
+ @param stringValue The value to add to the collection of data for `handle`.
+ @param handle The handle returned by `registerDescriptorName:`.
+ */
+- (void)addStringValue:(nonnull OBJCString)stringValue
+             forHandle:(nonnull DescriptorHandleWrapper *)handle
+{
+  _pool->add(handle->_handle, stringValue.cppString);
+}
+
 /**
  Sets the value of a descriptor name.
 
@@ -292,6 +357,16 @@ using namespace std;
   _pool->merge(*(pool->_pool), type.cppString);
 }
 
+/**
+ Replaces the values and the registered descriptors of the pool with copies of those of `pool`.
+
+ @param pool The pool to copy.
+ */
+- (void)replaceWithPool:(nonnull PoolWrapper *)pool
+{
+  *_pool = *(pool->_pool);
+}
+
 /**
  Merges the specified values into the pool for `name`.
 
@@ -506,6 +581,23 @@ using namespace std;
   return [NSArray arrayWithRealVecVec: value];
 }
 
+/**
+ Accessor for the frames of a real vector descriptor, read from their contiguous storage. An
+ exception is thrown if there are no such frames for `name`, or if they have different sizes.
+
+ @param name The descriptor for which to retrieve the frames.
+ @return The frames of `name`.
+ */
+- (nonnull OBJCRealVecVec)realVecFramesForName:(nonnull OBJCString)name {
+  const FrameMatrix& frames = _pool->frames(name.cppString);
+  NSMutableArray *result = [NSMutableArray arrayWithCapacity:frames.size()];
+  for (int i = 0; i < frames.size(); i++) {
+    RealVec frame = frames.frame(i);
+    [result addObject:[NSArray arrayWithRealVec:frame]];
+  }
+  return result;
+}
+
 /**
  Accessor for the data associated with a descriptor. An exception is thrown if there is not any
  data associated with `name` of the appropriate return type.
@@ -672,6 +764,22 @@ using namespace std;
   return (BOOL)_pool->contains<vector<StereoSample>>(name.cppString);
 }
 
+/**
+ Whether the pool locks its sub-pools, so that several threads can write to it at the same time.
+ */
+- (BOOL)isConcurrent {
+  return (BOOL)_pool->isConcurrent();
+}
+
+/**
+ Makes the pool lock its sub-pools or stop locking them.
+
+ @param concurrent Whether the pool locks its sub-pools.
+ */
+- (void)setConcurrent:(BOOL)concurrent {
+  _pool->setConcurrent(concurrent);
+}
+
 /**
  The list of descriptor names in the pool.
  */
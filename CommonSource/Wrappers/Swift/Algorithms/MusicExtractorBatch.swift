@@ -0,0 +1,72 @@
+//
+//  MusicExtractorBatch.swift
+//  Essentia
+//
+//  Copyright © 2017 Moondeer Studios. All rights reserved.
+//
+import Foundation
+
+/// The Swift-facing interface for `MusicExtractorBatchWrapper`, which runs the `MusicExtractor` on
+/// a list of files using several threads, each of them reusing its own extractor for all the files
+/// it analyzes. Another extractor can be run the same way on signals, see `compute(signals:)`.
+public class MusicExtractorBatch {
+
+  /// The bridge between the C++ `MusicExtractorBatch` and the Swift `MusicExtractorBatch`.
+  internal let wrapper: MusicExtractorBatchWrapper
+
+  /// Initializing with the parameters of the extractors and a number of threads.
+  ///
+  /// - Parameters:
+  ///   - parameters: The parameter values of the `MusicExtractor` keyed by their names.
+  ///   - threads: The number of files analyzed concurrently. `0` uses as many threads as there are
+  ///              cores.
+  public init(_ parameters: [String:Parameter] = [:], threads: Int = 1) {
+    wrapper = MusicExtractorBatchWrapper(parameters: parameters.mapValues(\.wrapper),
+                                         numThreads: threads)
+  }
+
+  /// Initializing with the name and the parameters of the extractors and a number of threads.
+  ///
+  /// - Parameters:
+  ///   - extractor: The name of the standard algorithm run on each file or signal.
+  ///   - parameters: The parameter values of the extractor keyed by their names.
+  ///   - threads: The number of files analyzed concurrently. `0` uses as many threads as there are
+  ///              cores.
+  public init(extractor: String, _ parameters: [String:Parameter] = [:], threads: Int = 1) {
+    wrapper = MusicExtractorBatchWrapper(extractor: extractor,
+                                         parameters: parameters.mapValues(\.wrapper),
+                                         numThreads: threads)
+  }
+
+  /// The number of threads used to analyze the files.
+  public var threads: Int { return wrapper.numThreads }
+
+  /// Analyzes all the given audio files, writing the statistics of `audioFiles[i]` to
+  /// `outputFiles[i]`.
+  ///
+  /// - Parameters:
+  ///   - audioFiles: The audio files to analyze.
+  ///   - outputFiles: The files receiving the statistics.
+  ///   - format: The format of the output files, "json" or "yaml".
+  /// - Returns: The number of files which failed.
+  @discardableResult
+  public func compute(audioFiles: [URL], outputFiles: [URL], format: String = "json") -> Int {
+    return wrapper.compute(withAudioFiles: audioFiles.map(\.path),
+                           outputFiles: outputFiles.map(\.path),
+                           format: format)
+  }
+
+  /// Analyzes all the given signals with an extractor which has an "audio" input and a "pool"
+  /// output, such as the `Extractor`.
+  ///
+  /// - Parameter signals: The signals to analyze.
+  /// - Returns: The descriptors of each signal, empty for the signals which failed.
+  public func compute(signals: [[Float]]) -> [Pool] {
+    return wrapper.compute(withSignals: signals as [[NSNumber]]).map(Pool.init(wrapper:))
+  }
+
+  /// The paths of the files (or "signal <i>" for the signals) which failed during the last
+  /// computation, with their error messages.
+  public var errors: [String:String] { return wrapper.errors }
+
+}
@@ -57,10 +57,10 @@ public enum Standard: AlgorithmMode {
 
     /// Standard
     case AutoCorrelation, BPF, BinaryOperator, BinaryOperatorStream, Clipper, ConstantQ,
-         CrossCorrelation, CubicSpline, DCT, Derivative, FFT, FFTC, FrameCutter, FrameToReal, IDCT,
-         IFFT, IFFTC, MonoMixer, Multiplexer, NoiseAdder, OverlapAdd, PeakDetection, Scale, Slicer,
-         Spline, StereoDemuxer, StereoMuxer, StereoTrimmer, Trimmer, UnaryOperator,
-         UnaryOperatorStream, WarpedAutoCorrelation, Windowing, ZeroCrossingRate
+         CrossCorrelation, CubicSpline, DCT, Derivative, FFT, FFTBatch, FFTC, FrameCutter,
+         FrameToReal, IDCT, IFFT, IFFTC, MonoMixer, Multiplexer, NoiseAdder, OverlapAdd,
+         PeakDetection, Scale, Slicer, Spline, StereoDemuxer, StereoMuxer, StereoTrimmer, Trimmer,
+         UnaryOperator, UnaryOperatorStream, WarpedAutoCorrelation, Windowing, ZeroCrossingRate
 
     /// Transformations
     case PCA
@@ -117,11 +117,11 @@ public enum Standard: AlgorithmMode {
        .LevelExtractor, .Loudness, .LoudnessEBUR128, .LoudnessVickers, .ReplayGain, .AllPass,
        .BandPass, .BandReject, .DCRemoval, .EqualLoudness, .HighPass, .IIR, .LowPass, .MaxFilter,
        .MovingAverage, .AutoCorrelation, .BPF, .BinaryOperator, .BinaryOperatorStream, .Clipper,
-       .ConstantQ, .CrossCorrelation, .CubicSpline, .DCT, .Derivative, .FFT, .FFTC, .FrameCutter,
-       .FrameToReal, .IDCT, .IFFT, .IFFTC, .MonoMixer, .Multiplexer, .NoiseAdder, .OverlapAdd,
-       .PeakDetection, .Scale, .Slicer, .Spline, .StereoDemuxer, .StereoMuxer, .StereoTrimmer,
-       .Trimmer, .UnaryOperator, .UnaryOperatorStream, .WarpedAutoCorrelation, .Windowing,
-       .ZeroCrossingRate, .PCA, .BFCC, .BarkBands, .ERBBands, .EnergyBand, .EnergyBandRatio,
+       .ConstantQ, .CrossCorrelation, .CubicSpline, .DCT, .Derivative, .FFT, .FFTBatch, .FFTC,
+       .FrameCutter, .FrameToReal, .IDCT, .IFFT, .IFFTC, .MonoMixer, .Multiplexer, .NoiseAdder,
+       .OverlapAdd, .PeakDetection, .Scale, .Slicer, .Spline, .StereoDemuxer, .StereoMuxer,
+       .StereoTrimmer, .Trimmer, .UnaryOperator, .UnaryOperatorStream, .WarpedAutoCorrelation,
+       .Windowing, .ZeroCrossingRate, .PCA, .BFCC, .BarkBands, .ERBBands, .EnergyBand, .EnergyBandRatio,
        .FlatnessDB, .Flux, .FrequencyBands, .GFCC, .HFC, .LPC, .MFCC, .MaxMagFreq, .MelBands,
        .Panning, .PowerSpectrum, .RollOff, .SpectralCentroidTime, .SpectralComplexity,
        .SpectralContrast, .SpectralPeaks, .SpectralWhitening, .Spectrum, .SpectrumToCent,
@@ -242,6 +242,7 @@ public enum Standard: AlgorithmMode {
         case .DCT: return Standard.DCT.self as! Spec.Type
         case .Derivative: return Standard.Derivative.self as! Spec.Type
         case .FFT: return Standard.FFT.self as! Spec.Type
+        case .FFTBatch: return Standard.FFTBatch.self as! Spec.Type
         case .FFTC: return Standard.FFTC.self as! Spec.Type
         case .FrameCutter: return Standard.FrameCutter.self as! Spec.Type
         case .FrameToReal: return Standard.FrameToReal.self as! Spec.Type
@@ -648,6 +649,9 @@ public enum Standard: AlgorithmMode {
   /// A typealias for `Standard.FFT` so that it can be used without knowing the category.
   public typealias FFT = Standard.FFT
 
+  /// A typealias for `Standard.FFTBatch` so that it can be used without knowing the category.
+  public typealias FFTBatch = Standard.FFTBatch
+
   /// A typealias for `Standard.FFTC` so that it can be used without knowing the category.
   public typealias FFTC = Standard.FFTC
 
@@ -1061,6 +1065,7 @@ public typealias CubicSplineAlgorithm                     = StandardAlgorithm<St
 public typealias DCTAlgorithm                             = StandardAlgorithm<Standard.DCT>
 public typealias DerivativeAlgorithm                      = StandardAlgorithm<Standard.Derivative>
 public typealias FFTAlgorithm                             = StandardAlgorithm<Standard.FFT>
+public typealias FFTBatchAlgorithm                           = StandardAlgorithm<Standard.FFTBatch>
 public typealias FFTCAlgorithm                            = StandardAlgorithm<Standard.FFTC>
 public typealias FrameCutterAlgorithm                     = StandardAlgorithm<Standard.FrameCutter>
 public typealias FrameToRealAlgorithm                     = StandardAlgorithm<Standard.FrameToReal>
@@ -7024,6 +7024,7 @@ extension Standard {
         case binsPerOctave
         case maxFrequency
         case minFrequency
+        case minimalFFTLength
         case sampleRate
         case threshold
 
@@ -7032,6 +7033,7 @@ extension Standard {
              .binsPerOctave,
              .maxFrequency,
              .minFrequency,
+             .minimalFFTLength,
              .sampleRate,
              .threshold
           ]
@@ -7388,6 +7390,71 @@ extension Standard {
 
     }
 
+    /// The specification for the standard `FFTBatch` algorithm.
+    public struct FFTBatch: StandardSpecification {
+
+      public static func downCast(wrapper: StandardAlgorithmWrapper) -> StandardAlgorithm<FFTBatch> {
+        guard wrapper.name == name else {
+          fatalError("Invalid cast from \(wrapper.name) to \(name).")
+        }
+        return StandardAlgorithm<FFTBatch>(wrapper: wrapper)
+      }
+
+      /// The algorithm's name. This is equal to `info.algorithmName`.
+      public static var name: String { return "FFTBatch" }
+
+      /// The algorithm's operating mode.
+      public static var mode: AlgorithmMode.Type { return Essentia.Standard.self }
+
+      /// The algorithm's category.
+      public static var category: AlgorithmCategory.Type { return Standard.self }
+
+      /// The algorithm's description. This is equal to `info.algorithmDescription`.
+      public static var description: String {
+        return AlgorithmFactoryWrapper.standardInfo(forName: name)?.algorithmDescription ?? ""
+      }
+
+      /// An enumeration of the valid input names for the algorithm.
+      public enum Input: String, KeyEnumeration {
+
+        case frames
+
+        public static var allKeys: Set<Input> {
+          return [
+             .frames
+          ]
+        }
+
+      }
+
+      /// An enumeration of the valid output names for the algorithm.
+      public enum Output: String, KeyEnumeration {
+
+        case ffts
+
+        public static var allKeys: Set<Output> {
+          return [
+             .ffts
+          ]
+        }
+
+      }
+
+      /// An enumeration of the valid parameter names for the algorithm.
+      public enum Parameter: String, KeyEnumeration {
+
+        case size
+
+        public static var allKeys: Set<Parameter> {
+          return [
+             .size
+          ]
+        }
+
+      }
+
+    }
+
     /// The specification for the standard `FFTC` algorithm.
     public struct FFTC: StandardSpecification {
 
@@ -12953,11 +13020,13 @@ extension Standard {
 
         case defaultStats
         case exceptions
+        case threads
 
         public static var allKeys: Set<Parameter> {
           return [
              .defaultStats,
-             .exceptions
+             .exceptions,
+             .threads
           ]
         }
 
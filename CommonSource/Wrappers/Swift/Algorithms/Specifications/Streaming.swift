@@ -65,15 +65,15 @@ public enum Streaming: AlgorithmMode {
 
     /// Standard
     case AutoCorrelation, BPF, BinaryOperator, BinaryOperatorStream, Clipper, ConstantQ,
-         CrossCorrelation, CubicSpline, DCT, Derivative, FFT, FFTC, FrameCutter, FrameToReal, IDCT,
-         IFFT, IFFTC, MonoMixer, Multiplexer, NoiseAdder, OverlapAdd, PeakDetection, Scale, Slicer,
-         Spline, StereoDemuxer, StereoMuxer, StereoTrimmer, Trimmer, UnaryOperator,
-         UnaryOperatorStream, WarpedAutoCorrelation, Windowing, ZeroCrossingRate
+         CrossCorrelation, CubicSpline, DCT, Derivative, FFT, FFTBatch, FFTC, FrameCutter,
+         FrameToReal, IDCT, IFFT, IFFTC, MonoMixer, Multiplexer, NoiseAdder, OverlapAdd,
+         PeakDetection, Scale, Slicer, Spline, StereoDemuxer, StereoMuxer, StereoTrimmer, Trimmer,
+         UnaryOperator, UnaryOperatorStream, WarpedAutoCorrelation, Windowing, ZeroCrossingRate
 
     /// Spectral
-    case BFCC, BarkBands, ERBBands, EnergyBand, EnergyBandRatio, FlatnessDB, Flux, FrequencyBands,
-         GFCC, HFC, LPC, MFCC, MaxMagFreq, MelBands, Panning, PowerSpectrum, RollOff,
-         SpectralCentroidTime, SpectralComplexity, SpectralContrast, SpectralPeaks,
+    case BFCC, BarkBands, ERBBands, EnergyBand, EnergyBandRatio, FlatnessDB, Flux, FramedSpectrum,
+         FrequencyBands, GFCC, HFC, LPC, MFCC, MaxMagFreq, MelBands, Panning, PowerSpectrum,
+         RollOff, SpectralCentroidTime, SpectralComplexity, SpectralContrast, SpectralPeaks,
          SpectralWhitening, Spectrum, SpectrumToCent, StrongPeak, TriangularBands,
          TriangularBarkBands
 
@@ -121,13 +121,13 @@ public enum Streaming: AlgorithmMode {
        .Larm, .Leq, .LevelExtractor, .Loudness, .LoudnessEBUR128, .LoudnessVickers, .ReplayGain,
        .AllPass, .BandPass, .BandReject, .DCRemoval, .EqualLoudness, .HighPass, .IIR, .LowPass,
        .MaxFilter, .MovingAverage, .AutoCorrelation, .BPF, .BinaryOperator, .BinaryOperatorStream,
-       .Clipper, .ConstantQ, .CrossCorrelation, .CubicSpline, .DCT, .Derivative, .FFT, .FFTC,
-       .FrameCutter, .FrameToReal, .IDCT, .IFFT, .IFFTC, .MonoMixer, .Multiplexer, .NoiseAdder,
+       .Clipper, .ConstantQ, .CrossCorrelation, .CubicSpline, .DCT, .Derivative, .FFT, .FFTBatch,
+       .FFTC, .FrameCutter, .FrameToReal, .IDCT, .IFFT, .IFFTC, .MonoMixer, .Multiplexer, .NoiseAdder,
        .OverlapAdd, .PeakDetection, .Scale, .Slicer, .Spline, .StereoDemuxer, .StereoMuxer,
        .StereoTrimmer, .Trimmer, .UnaryOperator, .UnaryOperatorStream, .WarpedAutoCorrelation,
        .Windowing, .ZeroCrossingRate, .BFCC, .BarkBands, .ERBBands, .EnergyBand, .EnergyBandRatio,
-       .FlatnessDB, .Flux, .FrequencyBands, .GFCC, .HFC, .LPC, .MFCC, .MaxMagFreq, .MelBands,
-       .Panning, .PowerSpectrum, .RollOff, .SpectralCentroidTime, .SpectralComplexity,
+       .FlatnessDB, .Flux, .FramedSpectrum, .FrequencyBands, .GFCC, .HFC, .LPC, .MFCC, .MaxMagFreq,
+       .MelBands, .Panning, .PowerSpectrum, .RollOff, .SpectralCentroidTime, .SpectralComplexity,
        .SpectralContrast, .SpectralPeaks, .SpectralWhitening, .Spectrum, .SpectrumToCent,
        .StrongPeak, .TriangularBands, .TriangularBarkBands, .LowLevelSpectralEqloudExtractor,
        .LowLevelSpectralExtractor, .AfterMaxToBeforeMaxEnergyRatio, .DerivativeSFX, .Envelope,
@@ -243,6 +243,7 @@ public enum Streaming: AlgorithmMode {
         case .DCT: return Standard.DCT.self as! Spec.Type
         case .Derivative: return Standard.Derivative.self as! Spec.Type
         case .FFT: return Standard.FFT.self as! Spec.Type
+        case .FFTBatch: return Standard.FFTBatch.self as! Spec.Type
         case .FFTC: return Standard.FFTC.self as! Spec.Type
         case .FrameCutter: return Standard.FrameCutter.self as! Spec.Type
         case .FrameToReal: return Standard.FrameToReal.self as! Spec.Type
@@ -273,6 +274,7 @@ public enum Streaming: AlgorithmMode {
         case .EnergyBandRatio: return Spectral.EnergyBandRatio.self as! Spec.Type
         case .FlatnessDB: return Spectral.FlatnessDB.self as! Spec.Type
         case .Flux: return Spectral.Flux.self as! Spec.Type
+        case .FramedSpectrum: return Spectral.FramedSpectrum.self as! Spec.Type
         case .FrequencyBands: return Spectral.FrequencyBands.self as! Spec.Type
         case .GFCC: return Spectral.GFCC.self as! Spec.Type
         case .HFC: return Spectral.HFC.self as! Spec.Type
@@ -638,6 +640,9 @@ public enum Streaming: AlgorithmMode {
   /// A typealias for `Standard.FFT` so that it can be used without knowing the category.
   public typealias FFT = Standard.FFT
 
+  /// A typealias for `Standard.FFTBatch` so that it can be used without knowing the category.
+  public typealias FFTBatch = Standard.FFTBatch
+
   /// A typealias for `Standard.FFTC` so that it can be used without knowing the category.
   public typealias FFTC = Standard.FFTC
 
@@ -728,6 +733,9 @@ public enum Streaming: AlgorithmMode {
   /// A typealias for `Spectral.Flux` so that it can be used without knowing the category.
   public typealias Flux = Spectral.Flux
 
+  /// A typealias for `Spectral.FramedSpectrum` so that it can be used without knowing the category.
+  public typealias FramedSpectrum = Spectral.FramedSpectrum
+
   /// A typealias for `Spectral.FrequencyBands` so that it can be used without knowing the category.
   public typealias FrequencyBands = Spectral.FrequencyBands
 
@@ -1034,6 +1042,7 @@ public typealias CubicSplineSAlgorithm                     = StreamingAlgorithm<
 public typealias DCTSAlgorithm                             = StreamingAlgorithm<Streaming.DCT>
 public typealias DerivativeSAlgorithm                      = StreamingAlgorithm<Streaming.Derivative>
 public typealias FFTSAlgorithm                             = StreamingAlgorithm<Streaming.FFT>
+public typealias FFTBatchSAlgorithm                           = StreamingAlgorithm<Streaming.FFTBatch>
 public typealias FFTCSAlgorithm                            = StreamingAlgorithm<Streaming.FFTC>
 public typealias FrameCutterSAlgorithm                     = StreamingAlgorithm<Streaming.FrameCutter>
 public typealias FrameToRealSAlgorithm                     = StreamingAlgorithm<Streaming.FrameToReal>
@@ -1064,6 +1073,7 @@ public typealias EnergyBandSAlgorithm                      = StreamingAlgorithm<
 public typealias EnergyBandRatioSAlgorithm                 = StreamingAlgorithm<Streaming.EnergyBandRatio>
 public typealias FlatnessDBSAlgorithm                      = StreamingAlgorithm<Streaming.FlatnessDB>
 public typealias FluxSAlgorithm                            = StreamingAlgorithm<Streaming.Flux>
+public typealias FramedSpectrumSAlgorithm                  = StreamingAlgorithm<Streaming.FramedSpectrum>
 public typealias FrequencyBandsSAlgorithm                  = StreamingAlgorithm<Streaming.FrequencyBands>
 public typealias GFCCSAlgorithm                            = StreamingAlgorithm<Streaming.GFCC>
 public typealias HFCSAlgorithm                             = StreamingAlgorithm<Streaming.HFC>
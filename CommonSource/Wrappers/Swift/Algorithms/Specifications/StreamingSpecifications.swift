@@ -6848,6 +6848,7 @@ extension Streaming {
         case binsPerOctave
         case maxFrequency
         case minFrequency
+        case minimalFFTLength
         case sampleRate
         case threshold
 
@@ -6856,6 +6857,7 @@ extension Streaming {
              .binsPerOctave,
              .maxFrequency,
              .minFrequency,
+             .minimalFFTLength,
              .sampleRate,
              .threshold
           ]
@@ -7212,6 +7214,73 @@ extension Streaming {
 
     }
 
+    /// The specification for the streaming `FFTBatch` algorithm.
+    public struct FFTBatch: StreamingSpecification {
+
+      public static func downCast(wrapper: StreamingAlgorithmWrapper) -> StreamingAlgorithm<FFTBatch> {
+        guard wrapper.name == name else {
+          fatalError("Invalid cast from \(wrapper.name) to \(name).")
+        }
+        return StreamingAlgorithm<FFTBatch>(wrapper: wrapper)
+      }
+
+      /// The algorithm's name. This is equal to `info.algorithmName`.
+      public static var name: String { return "FFTBatch" }
+
+      /// The algorithm's operating mode.
+      public static var mode: AlgorithmMode.Type { return Essentia.Streaming.self }
+
+      /// The algorithm's category.
+      public static var category: AlgorithmCategory.Type { return Standard.self }
+
+      /// The algorithm's description. This is equal to `info.algorithmDescription`.
+      public static var description: String {
+        return AlgorithmFactoryWrapper.streamingInfo(forName: name)?.algorithmDescription ?? ""
+      }
+
+      /// An enumeration of the valid input names for the algorithm.
+      public enum Input: String, KeyEnumeration {
+
+        case frame
+
+        public static var allKeys: Set<Input> {
+          return [
+             .frame
+          ]
+        }
+
+      }
+
+      /// An enumeration of the valid output names for the algorithm.
+      public enum Output: String, KeyEnumeration {
+
+        case fft
+
+        public static var allKeys: Set<Output> {
+          return [
+             .fft
+          ]
+        }
+
+      }
+
+      /// An enumeration of the valid parameter names for the algorithm.
+      public enum Parameter: String, KeyEnumeration {
+
+        case batchSize
+        case size
+
+        public static var allKeys: Set<Parameter> {
+          return [
+             .batchSize,
+             .size
+          ]
+        }
+
+      }
+
+    }
+
     /// The specification for the streaming `FFTC` algorithm.
     public struct FFTC: StreamingSpecification {
 
@@ -9300,6 +9369,91 @@ extension Streaming {
 
     }
 
+    /// The specification for the streaming `FramedSpectrum` algorithm.
+    public struct FramedSpectrum: StreamingSpecification {
+
+      public static func downCast(wrapper: StreamingAlgorithmWrapper) -> StreamingAlgorithm<FramedSpectrum> {
+        guard wrapper.name == name else {
+          fatalError("Invalid cast from \(wrapper.name) to \(name).")
+        }
+        return StreamingAlgorithm<FramedSpectrum>(wrapper: wrapper)
+      }
+
+      /// The algorithm's name. This is equal to `info.algorithmName`.
+      public static var name: String { return "FramedSpectrum" }
+
+      /// The algorithm's operating mode.
+      public static var mode: AlgorithmMode.Type { return Essentia.Streaming.self }
+
+      /// The algorithm's category.
+      public static var category: AlgorithmCategory.Type { return Spectral.self }
+
+      /// The algorithm's description. This is equal to `info.algorithmDescription`.
+      public static var description: String {
+        return AlgorithmFactoryWrapper.streamingInfo(forName: name)?.algorithmDescription ?? ""
+      }
+
+      /// An enumeration of the valid input names for the algorithm.
+      public enum Input: String, KeyEnumeration {
+
+        case signal
+
+        public static var allKeys: Set<Input> {
+          return [
+             .signal
+          ]
+        }
+
+      }
+
+      /// An enumeration of the valid output names for the algorithm.
+      public enum Output: String, KeyEnumeration {
+
+        case frame
+        case spectrum
+
+        public static var allKeys: Set<Output> {
+          return [
+             .frame,
+             .spectrum
+          ]
+        }
+
+      }
+
+      /// An enumeration of the valid parameter names for the algorithm.
+      public enum Parameter: String, KeyEnumeration {
+
+        case frameSize
+        case hopSize
+        case lastFrameToEndOfFile
+        case normalized
+        case silentFrames
+        case startFromZero
+        case validFrameThresholdRatio
+        case windowType
+        case zeroPadding
+        case zeroPhase
+
+        public static var allKeys: Set<Parameter> {
+          return [
+             .frameSize,
+             .hopSize,
+             .lastFrameToEndOfFile,
+             .normalized,
+             .silentFrames,
+             .startFromZero,
+             .validFrameThresholdRatio,
+             .windowType,
+             .zeroPadding,
+             .zeroPhase
+          ]
+        }
+
+      }
+
+    }
+
     /// The specification for the streaming `FrequencyBands` algorithm.
     public struct FrequencyBands: StreamingSpecification {
 
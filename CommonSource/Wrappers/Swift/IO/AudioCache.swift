@@ -0,0 +1,55 @@
+//
+//  AudioCache.swift
+//  Essentia
+//
+//  Copyright © 2017 Moondeer Studios. All rights reserved.
+//
+import Foundation
+
+/// The Swift-facing interface for a reference on a signal of the cache of decoded mono signals,
+/// which the `CachedMonoLoader` algorithm reads from. The signal stays in the cache at least as long
+/// as the reference is held.
+public class AudioCacheReference {
+
+  /// The bridge between the C++ `AudioCacheReference` and the Swift `AudioCacheReference`.
+  internal let wrapper: AudioCacheWrapper
+
+  /// Initializing with the signal of a file, which is decoded with a `MonoLoader` if it is not in
+  /// the cache yet.
+  ///
+  /// - Parameters:
+  ///   - url: The audio file.
+  ///   - sampleRate: The sample rate of the signal.
+  ///   - downmix: The mixing type for stereo files, "left", "right" or "mix".
+  public init(url: URL, sampleRate: Float = 44100, downmix: String = "mix") {
+    wrapper = AudioCacheWrapper(filename: url.path, sampleRate: sampleRate, downmix: downmix)
+  }
+
+  /// Initializing with a signal which has already been decoded. If the signal of the file is
+  /// already in the cache, the cached signal is kept instead.
+  ///
+  /// - Parameters:
+  ///   - signal: The decoded signal.
+  ///   - url: The audio file.
+  ///   - sampleRate: The sample rate of the signal.
+  ///   - downmix: The mixing type for stereo files, "left", "right" or "mix".
+  public init(signal: [Float], url: URL, sampleRate: Float = 44100, downmix: String = "mix") {
+    wrapper = AudioCacheWrapper(signal: signal as [NSNumber], filename: url.path,
+                                sampleRate: sampleRate, downmix: downmix)
+  }
+
+  /// The signal the reference is held on, `nil` once it has been released.
+  public var signal: [Float]? { return wrapper.signal?.map(\.floatValue) }
+
+  /// Releases the reference before it is deinitialized.
+  public func release() { wrapper.releaseSignal() }
+
+  /// Whether the signal of a file is in the cache.
+  public static func contains(url: URL, sampleRate: Float = 44100, downmix: String = "mix") -> Bool {
+    return AudioCacheWrapper.containsFilename(url.path, sampleRate: sampleRate, downmix: downmix)
+  }
+
+  /// The number of signals in the cache.
+  public static var count: Int { return AudioCacheWrapper.count }
+
+}
@@ -24,6 +24,13 @@ public class Network {
   /// processed by all the algorithms. Internally it just calls runPrepare and then runStep repeatedly.
   public func run() { wrapper.run() }
 
+  /// Executes all the algorithms in the network like `run()`, running the algorithms which do not
+  /// depend on each other concurrently.
+  ///
+  /// - Parameter threads: The number of threads to use, including the calling thread. `0` uses as
+  ///                      many threads as there are cores.
+  public func run(threads: Int) { wrapper.run(withThreads: threads) }
+
   /// Does the preparation needed to process the tokens of the network.
   public func runPrepare() { wrapper.runPrepare() }
 
@@ -35,6 +42,54 @@ public class Network {
   /// Rebuilds the visible and execution network.
   public func update() { wrapper.update() }
 
+  /// Switches all the buffers of the network to lock-free buffers which can be written and read
+  /// from different threads, or back to the default buffers. Must be invoked before running the
+  /// network. When run on several threads, the generator of such a network produces the tokens of
+  /// the next step while the other algorithms consume those of the current one.
+  ///
+  /// - Parameter concurrent: Whether to use the lock-free buffers.
+  public func setConcurrentBuffers(_ concurrent: Bool) { wrapper.setConcurrentBuffers(concurrent) }
+
+  /// Whether the next run of the network records per-algorithm statistics (calls, time spent,
+  /// tokens consumed and produced, buffer occupancy) and a trace of every call to `process`.
+  public var profiling: Bool {
+    get { return wrapper.profiling }
+    set { wrapper.profiling = newValue }
+  }
+
+  /// The statistics recorded during the last profiled run as a JSON document, `nil` if the
+  /// network has not been profiled.
+  public var profileJSON: String? { return wrapper.profileJSON }
+
+  /// The calls recorded during the last profiled run in the Chrome trace event format, which can
+  /// be loaded in chrome://tracing. `nil` if the network has not been profiled.
+  public var chromeTrace: String? { return wrapper.chromeTrace }
+
+  /// Sets whether the buffers are resized during the first steps of the next runs, so that no
+  /// algorithm has to be rescheduled because its output buffers are full.
+  ///
+  /// - Parameters:
+  ///   - adaptive: Whether to resize the buffers depending on their usage.
+  ///   - warmupSteps: The number of steps observed before resizing the buffers.
+  public func setAdaptiveBufferSizes(_ adaptive: Bool, warmupSteps: Int = 32) {
+    wrapper.setAdaptiveBufferSizes(adaptive, warmupSteps: warmupSteps)
+  }
+
+  /// The memory taken by the buffers of the network, in bytes.
+  public var bufferMemory: Int64 { return wrapper.bufferMemory }
+
+  /// Whether algorithms with the same type and parameters whose inputs are connected to the same
+  /// sources are merged into one when the network is run, so that they are only computed once.
+  /// Algorithms using random numbers (eg: NoiseAdder) are never merged. Disabled by default.
+  public var mergeDuplicates: Bool {
+    get { return wrapper.mergeDuplicates }
+    set { wrapper.mergeDuplicates = newValue }
+  }
+
+  /// The number of algorithms which have been disconnected from the network because they were
+  /// duplicates of another one.
+  public var mergedAlgorithmCount: Int { return wrapper.mergedAlgorithmCount }
+
   /// Invokes `reset` for each algorithm contained in the network.
   public func reset() { wrapper.reset() }
 
@@ -73,6 +73,18 @@ public class Source: CustomStringConvertible {
     wrapper.connect(to: pool.wrapper, usingDescriptor: descriptorName, setSingle: setSingle)
   }
 
+  /// Connects the source to the specified pool through an online aggregator, which only stores the
+  /// statistics of the data, computed as it flows, under the names '<descriptorName>.<statistic>'.
+  ///
+  /// - Parameters:
+  ///   - pool: The pool to which the source will be connected.
+  ///   - descriptorName: The descriptor whose statistics will be stored in the pool.
+  ///   - statistics: The names of the statistics, as given to the `PoolAggregator`.
+  public func connectTo(pool: Pool, descriptorName: String, statistics: [String]) {
+    wrapper.connect(to: pool.wrapper, usingDescriptor: descriptorName,
+                    aggregatingStatistics: statistics)
+  }
+
   /// Disconnects the source from the specified pool for the specified descriptor name.
   ///
   /// - Parameters:
@@ -55,6 +55,32 @@ public final class Pool: WrappingType {
     wrapper = PoolWrapper()
   }
 
+  /// Initializing with a copy of another pool, which includes its registered descriptors.
+  ///
+  /// - Parameter pool: The pool to copy.
+  public init(copying pool: Pool) {
+    wrapper = PoolWrapper(poolWrapper: pool.wrapper)
+  }
+
+  /// Handle of a descriptor name interned by a pool with `registerDescriptor(name:)`, with which
+  /// values can be added to the descriptor without looking up its name. It is meant to be used
+  /// with that pool or with its copies; another pool looks its name up instead.
+  public struct DescriptorHandle {
+
+    /// The bridge between the C++ `DescriptorHandle` and the Swift `DescriptorHandle`.
+    internal let wrapper: DescriptorHandleWrapper
+
+  }
+
+  /// Interns a descriptor name, which does not add it to the pool.
+  ///
+  /// - Parameter name: The descriptor name to intern.
+  /// - Returns: A handle with which values can be added for `name` with `add(_:for:)`. It remains
+  ///            valid as long as the pool exists, even if the descriptor is removed.
+  public func registerDescriptor(name: String) -> DescriptorHandle {
+    return DescriptorHandle(wrapper: wrapper.registerDescriptorName(name))
+  }
+
   /// Adds a value for a descriptor name to one of the non-single pools. The valid cases for
   /// `value` are `.real`, `.realVec`, `.realVecVec`, `.string`, `.stringVec`, and
   /// `.stereoSample`. Any other case used for `value` does nothing.
@@ -94,6 +120,28 @@ public final class Pool: WrappingType {
 
   }
 
+  /// Adds a value for the descriptor name of a handle, as `add(_:for:)` does for the name itself.
+  /// The valid cases for `value` are `.real`, `.realVec` and `.string`. Any other case used for
+  /// `value` does nothing.
+  ///
+  /// - Parameters:
+  ///   - value: The value to add to the collection of data for `handle`.
+  ///   - handle: The handle returned by `registerDescriptor(name:)`.
+  public func add(_ value: StoredValue, for handle: DescriptorHandle) {
+
+    switch value {
+      case .real(let value):
+        wrapper.addRealValue(value as NSNumber, forHandle: handle.wrapper)
+      case .realVec(let value):
+        wrapper.addRealVecValue(value as [NSNumber], forHandle: handle.wrapper)
+      case .string(let value):
+        wrapper.addStringValue(value, forHandle: handle.wrapper)
+      default:
+        break
+    }
+
+  }
+
   /// Sets the value of a descriptor name in one of the single pools. The valid cases for `value`
   /// are `.real`, `.realVec`, `.string`, `.stringVec`. Any other case used for `value`
   /// does nothing.
@@ -160,6 +208,14 @@ public final class Pool: WrappingType {
     wrapper.merge(withPool: otherPool.wrapper, type: type.rawValue)
   }
 
+  /// Replaces the values and the registered descriptors of the pool with copies of those of
+  /// another pool, whose handles can then be used with this pool as well.
+  ///
+  /// - Parameter otherPool: The pool to copy.
+  public func replace(with otherPool: Pool) {
+    wrapper.replace(withPool: otherPool.wrapper)
+  }
+
   /// Merges the specified values into the pool for `name`. The valid cases for `value`
   /// are `.realVec`, `.realVecVec`, `.stringVec`, `.stringVecVec`,
   /// `.realMatrixVec`, and `.stereoSampleVec`. Any other case used for `value`
@@ -330,6 +386,15 @@ public final class Pool: WrappingType {
     return result
   }
 
+  /// Accessor for the frames of a real vector descriptor, read from their contiguous storage. The
+  /// frames must all have the same size.
+  ///
+  /// - Parameter name: The descriptor name for the frames.
+  /// - Returns: The frames of `name`.
+  public func frames(name: String) -> [[Float]] {
+    return wrapper.realVecFrames(forName: name).map({$0.map({$0.floatValue})})
+  }
+
   /// Accessor of convenience for getting an unwrapped string value.
   ///
   /// - Parameter name: The descriptor name for the value.
@@ -463,6 +528,15 @@ public final class Pool: WrappingType {
     return wrapper.containsStereoSampleVec(forName: name)
   }
 
+  /// Whether the pool locks its sub-pools, so that several threads can write to it at the same
+  /// time. It is `false` by default, and must only be set while no other thread uses the pool.
+  /// Only the values added to a descriptor by the same thread are kept in the order in which they
+  /// were added.
+  public var isConcurrent: Bool {
+    get { return wrapper.isConcurrent }
+    set { wrapper.isConcurrent = newValue }
+  }
+
   /// The list of descriptor names in the pool.
   public var descriptorNames: [String] {
     return wrapper.descriptorNames
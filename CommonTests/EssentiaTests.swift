@@ -531,6 +531,24 @@ class EssentiaTests: XCTestCase {
                                                         [[21.1, 21.2, 21.3], [22.1, 22.2, 22.3]],
                                                         [[31.1, 31.2, 31.3], [32.1, 32.2, 32.3]]])
 
+    /*
+     Test adding vectors of reals of different sizes for the same descriptor.
+     */
+
+    let pool3 = Pool()
+
+    let raggedRealVecs: [[Float]] = [[1.1, 1.2], [2.1, 2.2], [3.1], [4.1, 4.2, 4.3]]
+
+    for realVec in raggedRealVecs {
+      pool3.add(.realVec(realVec), for: "realVector")
+    }
+
+    XCTAssertEqual(pool3[realVecVec: "realVector"], raggedRealVecs)
+
+    pool3.add(.realVec([5.1, 5.2]), for: "realVector")
+
+    XCTAssertEqual(pool3[realVecVec: "realVector"], raggedRealVecs + [[5.1, 5.2]])
+
     /*
      Test the collection interface for the pool.
      */
@@ -545,6 +563,303 @@ class EssentiaTests: XCTestCase {
 
   }
 
+  /// Tests that the frames of a real vector descriptor read with `frames(name:)`, `realVecVec` and
+  /// `realVecPool` stay the same whatever the order in which they are read and written.
+  func testPoolFrames() {
+
+    let pool = Pool()
+
+    var expected: [[Float]] = [[1, 2, 3], [4, 5, 6]]
+
+    for frame in expected { pool.add(.realVec(frame), for: "foo.bar") }
+
+    XCTAssertEqual(pool.frames(name: "foo.bar"), expected)
+    XCTAssertEqual(pool[realVecVec: "foo.bar"], expected)
+    XCTAssertEqual(pool.frames(name: "foo.bar"), expected)
+
+    /*
+     Test writing between the reads.
+     */
+
+    for frame: [Float] in [[7, 8, 9], [10, 11, 12], [13, 14, 15]] {
+      pool.add(.realVec(frame), for: "foo.bar")
+      expected.append(frame)
+      XCTAssertEqual(pool[realVecVec: "foo.bar"], expected)
+      XCTAssertEqual(pool.realVecPool["foo.bar"], expected)
+      XCTAssertEqual(pool.frames(name: "foo.bar"), expected)
+    }
+
+    pool.merge(.realVecVec([[16, 17, 18]]), for: "foo.bar", type: .append)
+    expected.append([16, 17, 18])
+
+    XCTAssertEqual(pool.frames(name: "foo.bar"), expected)
+    XCTAssertEqual(pool[realVecVec: "foo.bar"], expected)
+
+    pool.merge(.realVecVec([[0, 0, 0]]), for: "foo.baz")
+
+    XCTAssertEqual(pool.frames(name: "foo.baz"), [[0, 0, 0]])
+
+    /*
+     Test a frame of another size, after which the frames are only read as vectors.
+     */
+
+    pool.add(.realVec([1]), for: "foo.bar")
+    expected.append([1])
+
+    XCTAssertEqual(pool[realVecVec: "foo.bar"], expected)
+    XCTAssertEqual(pool.realVecPool, ["foo.bar": expected, "foo.baz": [[0, 0, 0]]])
+
+    pool.add(.realVec([2, 2]), for: "foo.bar")
+    expected.append([2, 2])
+
+    XCTAssertEqual(pool.realVecPool["foo.bar"], expected)
+    XCTAssertEqual(pool[realVecVec: "foo.bar"], expected)
+
+    /*
+     Test that removing the descriptor drops its frames.
+     */
+
+    pool.remove(name: "foo.bar")
+    pool.add(.realVec([3, 4]), for: "foo.bar")
+
+    XCTAssertEqual(pool.frames(name: "foo.bar"), [[3, 4]])
+    XCTAssertEqual(pool.realVecPool, ["foo.bar": [[3, 4]], "foo.baz": [[0, 0, 0]]])
+
+  }
+
+  /// Tests adding values through the handles of registered descriptors, after the values they
+  /// point to have been removed or merged, and with copies of the pool and other pools.
+  func testPoolDescriptorHandles() {
+
+    let pool = Pool()
+
+    let real = pool.registerDescriptor(name: "foo.real")
+    let vector = pool.registerDescriptor(name: "foo.vector")
+
+    XCTAssertEqual(pool.descriptorNames, [])
+
+    pool.add(.real(1), for: real)
+    pool.add(.real(2), for: real)
+    pool.add(.realVec([1, 2]), for: vector)
+    pool.add(.realVec([3, 4]), for: vector)
+
+    XCTAssertEqual(pool[realVec: "foo.real"], [1, 2])
+    XCTAssertEqual(pool[realVecVec: "foo.vector"], [[1, 2], [3, 4]])
+
+    /*
+     Test the handles once their values have been removed.
+     */
+
+    pool.remove(name: "foo.real")
+    pool.remove(name: "foo.vector")
+    pool.add(.real(3), for: real)
+    pool.add(.realVec([5, 6]), for: vector)
+
+    XCTAssertEqual(pool[realVec: "foo.real"], [3])
+    XCTAssertEqual(pool[realVecVec: "foo.vector"], [[5, 6]])
+
+    /*
+     Test the handles once their values have been merged.
+     */
+
+    pool.merge(.realVec([10, 11]), for: "foo.real", type: .replace)
+    pool.add(.real(4), for: real)
+
+    XCTAssertEqual(pool[realVec: "foo.real"], [10, 11, 4])
+
+    pool.merge(.realVecVec([[7, 8]]), for: "foo.vector", type: .append)
+    pool.add(.realVec([9, 10]), for: vector)
+
+    XCTAssertEqual(pool[realVecVec: "foo.vector"], [[5, 6], [7, 8], [9, 10]])
+    XCTAssertEqual(pool.frames(name: "foo.vector"), [[5, 6], [7, 8], [9, 10]])
+
+    pool.merge(.realVecVec([[0], [0], [0]]), for: "foo.vector", type: .interleave)
+    pool.add(.realVec([11, 12]), for: vector)
+
+    XCTAssertEqual(pool[realVecVec: "foo.vector"],
+                   [[5, 6], [0], [7, 8], [0], [9, 10], [0], [11, 12]])
+
+    let other = Pool()
+    other.add(.real(5), for: "foo.real")
+    pool.merge(with: other, type: .append)
+    pool.add(.real(6), for: real)
+
+    XCTAssertEqual(pool[realVec: "foo.real"], [10, 11, 4, 5, 6])
+
+    pool.clear()
+    pool.add(.real(7), for: real)
+
+    XCTAssertEqual(pool[realVec: "foo.real"], [7])
+
+    /*
+     Test the handles with a copy of the pool, whose values are its own.
+     */
+
+    let copy = Pool(copying: pool)
+
+    copy.add(.real(8), for: real)
+    pool.add(.real(9), for: real)
+    copy.add(.realVec([1, 1]), for: vector)
+
+    XCTAssertEqual(copy[realVec: "foo.real"], [7, 8])
+    XCTAssertEqual(pool[realVec: "foo.real"], [7, 9])
+    XCTAssertEqual(copy[realVecVec: "foo.vector"], [[1, 1]])
+    XCTAssertFalse(pool.containsRealVecVec(forName: "foo.vector"))
+
+    // Once the copy and the pool register names of their own, the same ids stand for different
+    // names in each of them.
+    let copyOnly = copy.registerDescriptor(name: "copy.only")
+    let poolOnly = pool.registerDescriptor(name: "pool.only")
+
+    copy.add(.real(1), for: poolOnly)
+    pool.add(.real(2), for: copyOnly)
+
+    XCTAssertEqual(copy[realVec: "pool.only"], [1])
+    XCTAssertFalse(copy.contains(name: "copy.only"))
+    XCTAssertEqual(pool[realVec: "copy.only"], [2])
+    XCTAssertFalse(pool.contains(name: "pool.only"))
+
+    /*
+     Test the handles with another pool, which looks their names up.
+     */
+
+    let different = Pool()
+    let bar = different.registerDescriptor(name: "bar.x")
+
+    different.add(.real(1), for: real)
+    different.add(.real(2), for: real)
+    different.add(.realVec([3]), for: vector)
+    different.add(.real(4), for: bar)
+    pool.add(.real(5), for: bar)
+
+    XCTAssertEqual(different[realVec: "foo.real"], [1, 2])
+    XCTAssertEqual(different[realVecVec: "foo.vector"], [[3]])
+    XCTAssertEqual(different[realVec: "bar.x"], [4])
+    XCTAssertEqual(pool[realVec: "bar.x"], [5])
+    XCTAssertEqual(pool[realVec: "foo.real"], [7, 9])
+
+    /*
+     Test the handles once a copy of the pool, which has since diverged, replaces it.
+     */
+
+    let replaced = Pool()
+    let handle = replaced.registerDescriptor(name: "m.m")
+
+    replaced.add(.real(1), for: handle)
+    replaced.add(.real(2), for: handle)
+
+    let saved = Pool(copying: replaced)
+
+    replaced.add(.real(1), for: "z.z")
+    saved.add(.real(1), for: "a.a")
+    replaced.replace(with: saved)
+    replaced.add(.real(3), for: handle)
+
+    XCTAssertEqual(replaced[realVec: "m.m"], [1, 2, 3])
+    XCTAssertEqual(replaced[realVec: "a.a"], [1])
+    XCTAssertFalse(replaced.contains(name: "z.z"))
+    XCTAssertEqual(saved[realVec: "m.m"], [1, 2])
+
+  }
+
+  /// Tests adding values to a concurrent pool from several threads at the same time, by name and
+  /// through handles, and merging pools of their own into it.
+  func testConcurrentPool() {
+
+    let threadCount = 8
+    let valueCount = 2000
+
+    let pool = Pool()
+
+    XCTAssertFalse(pool.isConcurrent)
+
+    pool.isConcurrent = true
+
+    XCTAssertTrue(pool.isConcurrent)
+
+    let sharedHandle = pool.registerDescriptor(name: "shared.handle")
+
+    DispatchQueue.concurrentPerform(iterations: threadCount) { thread in
+
+      let ownHandle = pool.registerDescriptor(name: "ownHandle.t\(thread)")
+      let framesHandle = pool.registerDescriptor(name: "shared.frames")
+      let shard = Pool()
+
+      for index in 0..<valueCount {
+
+        let value = Float(thread * 100_000 + index)
+
+        pool.add(.real(Float(index)), for: "own.t\(thread)")
+        pool.add(.real(Float(index)), for: ownHandle)
+        pool.add(.real(value), for: "shared.real")
+        pool.add(.real(value), for: sharedHandle)
+        pool.add(.realVec([value, value, value]), for: framesHandle)
+
+        if index < 100 {
+          pool.add(.real(Float(thread)), for: "shared.k\(index)")
+          pool.set(.real(Float(index)), for: "single.t\(thread).k\(index)")
+        }
+
+        shard.add(.real(Float(thread)), for: "shard.values")
+
+      }
+
+      pool.merge(with: shard, type: .append)
+
+    }
+
+    // Checks that the values added by each thread are all there, in the order of that thread.
+    func inThreadOrder(_ values: [Float]) -> Bool {
+
+      var last = Array(repeating: -1, count: threadCount)
+
+      for value in values {
+        let thread = Int(value) / 100_000, index = Int(value) % 100_000
+        guard index == last[thread] + 1 else { return false }
+        last[thread] = index
+      }
+
+      return last.allSatisfy { $0 == valueCount - 1 }
+
+    }
+
+    for thread in 0..<threadCount {
+      XCTAssertEqual(pool[realVec: "own.t\(thread)"], (0..<valueCount).map(Float.init))
+      XCTAssertEqual(pool[realVec: "ownHandle.t\(thread)"], (0..<valueCount).map(Float.init))
+    }
+
+    XCTAssertTrue(inThreadOrder(pool[realVec: "shared.real"]))
+    XCTAssertTrue(inThreadOrder(pool[realVec: "shared.handle"]))
+
+    let frames = pool.frames(name: "shared.frames")
+
+    XCTAssertTrue(frames.allSatisfy { $0.count == 3 })
+    XCTAssertTrue(inThreadOrder(frames.map { $0[0] }))
+
+    for index in 0..<100 {
+      XCTAssertEqual(pool[realVec: "shared.k\(index)"].sorted(), (0..<threadCount).map(Float.init))
+    }
+
+    XCTAssertEqual(pool.realSinglePool.count, threadCount * 100)
+    XCTAssertEqual(pool[realVec: "shard.values"].count, threadCount * valueCount)
+
+    // A copy of a concurrent pool is concurrent too, with values of its own.
+    let copy = Pool(copying: pool)
+
+    XCTAssertTrue(copy.isConcurrent)
+
+    copy.add(.real(-1), for: sharedHandle)
+
+    XCTAssertEqual(copy[realVec: "shared.handle"].count, threadCount * valueCount + 1)
+    XCTAssertEqual(pool[realVec: "shared.handle"].count, threadCount * valueCount)
+
+    copy.isConcurrent = false
+
+    XCTAssertFalse(copy.isConcurrent)
+    XCTAssertTrue(pool.isConcurrent)
+
+  }
+
   /// Tests that creating a `Network` instance of streaming algorithms behaves as expected.
   func testNetwork() {
 
@@ -587,6 +902,350 @@ class EssentiaTests: XCTestCase {
 
   }
 
+  /// Tests that running a `Network` on several threads gives the same results as running it on a
+  /// single thread.
+  func testParallelNetwork() {
+
+    let url = bundleURL(name: "C4-E♭4-G4_Boesendorfer_Grand_Piano-Trimmed", ext: "aif")
+    let chordSignal = monoBufferData(url: url)
+
+    func runNetwork(threads: Int) -> ([[Float]], [[Float]]) {
+
+      let signalInput = VectorInput<Float>(chordSignal)
+
+      let frameCutter1 = FrameCutterSAlgorithm([.frameSize: 1024, .hopSize: 256])
+      let windowing1 = WindowingSAlgorithm([.type: "hann"])
+      let spectrum1 = SpectrumSAlgorithm()
+      let output1 = VectorOutput<[Float]>()
+
+      let frameCutter2 = FrameCutterSAlgorithm([.frameSize: 2048, .hopSize: 512])
+      let windowing2 = WindowingSAlgorithm([.type: "blackmanharris62"])
+      let spectrum2 = SpectrumSAlgorithm()
+      let output2 = VectorOutput<[Float]>()
+
+      signalInput[output: .data] >> frameCutter1[input: .signal]
+      frameCutter1[output: .frame] >> windowing1[input: .frame]
+      windowing1[output: .frame] >> spectrum1[input: .frame]
+      spectrum1[output: .spectrum] >> output1[input: .data]
+
+      signalInput[output: .data] >> frameCutter2[input: .signal]
+      frameCutter2[output: .frame] >> windowing2[input: .frame]
+      windowing2[output: .frame] >> spectrum2[input: .frame]
+      spectrum2[output: .spectrum] >> output2[input: .data]
+
+      let network = Network(generator: signalInput)
+      network.run(threads: threads)
+
+      return (output1.vector, output2.vector)
+
+    }
+
+    let (serial1, serial2) = runNetwork(threads: 1)
+    let (parallel1, parallel2) = runNetwork(threads: 4)
+
+    XCTAssertFalse(serial1.isEmpty)
+    XCTAssertFalse(serial2.isEmpty)
+    XCTAssertEqual(parallel1, serial1)
+    XCTAssertEqual(parallel2, serial2)
+
+  }
+
+  /// Tests that a parallel `Network` in which two branches write to the same descriptor of a pool
+  /// gives the same pool as running it on a single thread, whether the pool is concurrent or not.
+  func testParallelNetworkSharedDescriptor() {
+
+    let url = bundleURL(name: "C4-E♭4-G4_Boesendorfer_Grand_Piano-Trimmed", ext: "aif")
+    let chordSignal = monoBufferData(url: url)
+
+    func runNetwork(threads: Int, concurrent: Bool) -> Pool {
+
+      let signalInput = VectorInput<Float>(chordSignal)
+
+      let frameCutter1 = FrameCutterSAlgorithm([.frameSize: 1024, .hopSize: 256])
+      let windowing1 = WindowingSAlgorithm([.type: "hann"])
+      let spectrum1 = SpectrumSAlgorithm()
+
+      let frameCutter2 = FrameCutterSAlgorithm([.frameSize: 2048, .hopSize: 512])
+      let windowing2 = WindowingSAlgorithm([.type: "blackmanharris62"])
+      let spectrum2 = SpectrumSAlgorithm()
+
+      let pool = Pool()
+      pool.isConcurrent = concurrent
+
+      signalInput[output: .data] >> frameCutter1[input: .signal]
+      frameCutter1[output: .frame] >> windowing1[input: .frame]
+      windowing1[output: .frame] >> spectrum1[input: .frame]
+      spectrum1[output: .spectrum] >> pool[input: "spectrum.shared"]
+      spectrum1[output: .spectrum] >> pool[input: "spectrum.first"]
+
+      signalInput[output: .data] >> frameCutter2[input: .signal]
+      frameCutter2[output: .frame] >> windowing2[input: .frame]
+      windowing2[output: .frame] >> spectrum2[input: .frame]
+      spectrum2[output: .spectrum] >> pool[input: "spectrum.shared"]
+      spectrum2[output: .spectrum] >> pool[input: "spectrum.second"]
+
+      let network = Network(generator: signalInput)
+      network.run(threads: threads)
+
+      return pool
+
+    }
+
+    let serial = runNetwork(threads: 1, concurrent: false)
+
+    XCTAssertEqual(serial[realVecVec: "spectrum.shared"].count,
+                   serial[realVecVec: "spectrum.first"].count
+                     + serial[realVecVec: "spectrum.second"].count)
+
+    for (threads, concurrent) in [(4, false), (4, true), (8, true)] {
+
+      let parallel = runNetwork(threads: threads, concurrent: concurrent)
+
+      XCTAssertEqual(parallel.descriptorNames.sorted(), serial.descriptorNames.sorted())
+
+      for name in serial.descriptorNames {
+        XCTAssertEqual(parallel[realVecVec: name], serial[realVecVec: name],
+                       "\(name) with \(threads) threads")
+      }
+
+    }
+
+  }
+
+  /// Tests that a parallel `Network` with concurrent buffers, in which the generator produces the
+  /// tokens of the next step while its readers consume those of the current one, gives the same
+  /// results as running it on a single thread.
+  func testConcurrentBufferNetwork() {
+
+    let signal = (0..<200_000).map { Float($0 % 1000) / 1000 }
+
+    func runNetwork(concurrent: Bool, threads: Int) -> ([[Float]], [Float]) {
+
+      let signalInput = VectorInput<Float>(signal)
+
+      let frameCutter = FrameCutterSAlgorithm([.frameSize: 1024, .hopSize: 256])
+      let frameOutput = VectorOutput<[Float]>()
+
+      let scale = ScaleSAlgorithm([.factor: 2])
+      let signalOutput = VectorOutput<Float>()
+
+      signalInput[output: .data] >> frameCutter[input: .signal]
+      frameCutter[output: .frame] >> frameOutput[input: .data]
+
+      signalInput[output: .data] >> scale[input: .signal]
+      scale[output: .signal] >> signalOutput[input: .data]
+
+      let network = Network(generator: signalInput)
+      network.setConcurrentBuffers(concurrent)
+      network.run(threads: threads)
+
+      return (frameOutput.vector, signalOutput.vector)
+
+    }
+
+    let (serialFrames, serialSignal) = runNetwork(concurrent: false, threads: 1)
+
+    XCTAssertFalse(serialFrames.isEmpty)
+    XCTAssertEqual(serialSignal.count, signal.count)
+
+    // the writer and the readers of the buffers race differently on every run
+    for _ in 0..<10 {
+      let (frames, scaled) = runNetwork(concurrent: true, threads: 4)
+      XCTAssertEqual(frames, serialFrames)
+      XCTAssertEqual(scaled, serialSignal)
+    }
+
+  }
+
+  func testNetworkProfiling() {
+
+    let url = bundleURL(name: "C4-E♭4-G4_Boesendorfer_Grand_Piano-Trimmed", ext: "aif")
+    let chordSignal = monoBufferData(url: url)
+
+    let signalInput = VectorInput<Float>(chordSignal)
+    let frameCutter = FrameCutterSAlgorithm([.frameSize: 1024, .hopSize: 256])
+    let spectrum = SpectrumSAlgorithm()
+    let output = VectorOutput<[Float]>()
+
+    signalInput[output: .data] >> frameCutter[input: .signal]
+    frameCutter[output: .frame] >> spectrum[input: .frame]
+    spectrum[output: .spectrum] >> output[input: .data]
+
+    let network = Network(generator: signalInput)
+    XCTAssertNil(network.profileJSON)
+
+    network.profiling = true
+    network.run()
+
+    guard let json = network.profileJSON,
+          let trace = network.chromeTrace,
+          let profile = try? JSONSerialization.jsonObject(with: Data(json.utf8)) as? [String: Any],
+          let nodes = profile["nodes"] as? [[String: Any]],
+          let traceObject = try? JSONSerialization.jsonObject(with: Data(trace.utf8)) as? [String: Any],
+          let events = traceObject["traceEvents"] as? [[String: Any]] else {
+      XCTFail("Failed to retrieve the profile of the network.")
+      return
+    }
+
+    XCTAssertEqual(nodes.map({$0["name"] as? String ?? ""}),
+                   ["VectorInput", "FrameCutter", "Spectrum", "VectorOutput"])
+    XCTAssertEqual(nodes[2]["tokensConsumed"] as? Int, output.vector.count)
+    XCTAssertEqual(nodes[2]["tokensProduced"] as? Int, output.vector.count)
+    XCTAssertFalse(events.isEmpty)
+
+  }
+
+  func testAdaptiveBufferSizes() {
+
+    let url = bundleURL(name: "C4-E♭4-G4_Boesendorfer_Grand_Piano-Trimmed", ext: "aif")
+    let chordSignal = monoBufferData(url: url)
+
+    func spectra(adaptive: Bool, threads: Int = 1) -> ([[Float]], Network) {
+      let signalInput = VectorInput<Float>(chordSignal)
+      let frameCutter = FrameCutterSAlgorithm([.frameSize: 1024, .hopSize: 256])
+      let spectrum = SpectrumSAlgorithm()
+      let output = VectorOutput<[Float]>()
+
+      signalInput[output: .data] >> frameCutter[input: .signal]
+      frameCutter[output: .frame] >> spectrum[input: .frame]
+      spectrum[output: .spectrum] >> output[input: .data]
+
+      let network = Network(generator: signalInput)
+      network.setAdaptiveBufferSizes(adaptive, warmupSteps: 4)
+      network.run(threads: threads)
+
+      return (output.vector, network)
+    }
+
+    let (expected, _) = spectra(adaptive: false)
+    let (actual, network) = spectra(adaptive: true)
+
+    XCTAssertEqual(actual, expected)
+    XCTAssertGreaterThan(network.bufferMemory, 0)
+
+    // the warm-up observes the same steps when the nodes run on several threads
+    let (parallel, parallelNetwork) = spectra(adaptive: true, threads: 4)
+
+    XCTAssertEqual(parallel, expected)
+    XCTAssertEqual(parallelNetwork.bufferMemory, network.bufferMemory)
+
+  }
+
+  func testMergeDuplicates() {
+
+    let url = bundleURL(name: "C4-E♭4-G4_Boesendorfer_Grand_Piano-Trimmed", ext: "aif")
+    let chordSignal = monoBufferData(url: url)
+
+    func spectra(merge: Bool) -> ([[Float]], [[Float]], Network) {
+
+      let signalInput = VectorInput<Float>(chordSignal)
+
+      let frameCutter1 = FrameCutterSAlgorithm([.frameSize: 1024, .hopSize: 512])
+      let windowing1 = WindowingSAlgorithm([.type: "hann"])
+      let spectrum1 = SpectrumSAlgorithm()
+      let output1 = VectorOutput<[Float]>()
+
+      let frameCutter2 = FrameCutterSAlgorithm([.frameSize: 1024, .hopSize: 512])
+      let windowing2 = WindowingSAlgorithm([.type: "hann"])
+      let spectrum2 = SpectrumSAlgorithm()
+      let output2 = VectorOutput<[Float]>()
+
+      signalInput[output: .data] >> frameCutter1[input: .signal]
+      frameCutter1[output: .frame] >> windowing1[input: .frame]
+      windowing1[output: .frame] >> spectrum1[input: .frame]
+      spectrum1[output: .spectrum] >> output1[input: .data]
+
+      signalInput[output: .data] >> frameCutter2[input: .signal]
+      frameCutter2[output: .frame] >> windowing2[input: .frame]
+      windowing2[output: .frame] >> spectrum2[input: .frame]
+      spectrum2[output: .spectrum] >> output2[input: .data]
+
+      let network = Network(generator: signalInput)
+      network.mergeDuplicates = merge
+      network.run()
+
+      return (output1.vector, output2.vector, network)
+    }
+
+    let (expected, _, unmerged) = spectra(merge: false)
+    let (actual1, actual2, merged) = spectra(merge: true)
+
+    XCTAssertFalse(Network(generator: VectorInput<Float>([0])).mergeDuplicates)
+    XCTAssertEqual(unmerged.mergedAlgorithmCount, 0)
+    XCTAssertEqual(merged.mergedAlgorithmCount, 3)
+    XCTAssertEqual(actual1, expected)
+    XCTAssertEqual(actual2, expected)
+
+    // resetting the network undoes the merges, running it again merges the algorithms again
+    merged.reset()
+    XCTAssertEqual(merged.mergedAlgorithmCount, 0)
+    merged.run()
+    XCTAssertEqual(merged.mergedAlgorithmCount, 3)
+
+    // algorithms using random numbers are never merged
+    let signalInput = VectorInput<Float>([Float](repeating: 0, count: 4096))
+    let noisyCutter1 = FrameCutterSAlgorithm([.frameSize: 1024, .hopSize: 512, .silentFrames: "noise"])
+    let noisyCutter2 = FrameCutterSAlgorithm([.frameSize: 1024, .hopSize: 512, .silentFrames: "noise"])
+    let noisyOutput1 = VectorOutput<[Float]>()
+    let noisyOutput2 = VectorOutput<[Float]>()
+
+    signalInput[output: .data] >> noisyCutter1[input: .signal]
+    signalInput[output: .data] >> noisyCutter2[input: .signal]
+    noisyCutter1[output: .frame] >> noisyOutput1[input: .data]
+    noisyCutter2[output: .frame] >> noisyOutput2[input: .data]
+
+    let noisy = Network(generator: signalInput)
+    noisy.mergeDuplicates = true
+    noisy.run()
+
+    XCTAssertEqual(noisy.mergedAlgorithmCount, 0)
+    XCTAssertEqual(noisyOutput1.vector.count, noisyOutput2.vector.count)
+
+  }
+
+  /// Builds a network that pushes a long signal through a chain of cheap algorithms, so that the
+  /// cost of running it is dominated by the buffers.
+  private func bufferBoundNetwork(concurrent: Bool) -> (Network, VectorOutput<Float>) {
+
+    let signalInput = VectorInput<Float>([0.5] * 1_000_000)
+    let scale1 = ScaleSAlgorithm([.factor: 2])
+    let scale2 = ScaleSAlgorithm([.factor: 0.5])
+    let output = VectorOutput<Float>()
+
+    signalInput[output: .data] >> scale1[input: .signal]
+    scale1[output: .signal] >> scale2[input: .signal]
+    scale2[output: .signal] >> output[input: .data]
+
+    let network = Network(generator: signalInput)
+    network.setConcurrentBuffers(concurrent)
+
+    return (network, output)
+
+  }
+
+  /// Measures the performance of a network using the default buffers.
+  func testBufferPerformance() {
+
+    measure {
+      let (network, output) = bufferBoundNetwork(concurrent: false)
+      network.run()
+      XCTAssertEqual(output.vector.count, 1_000_000)
+    }
+
+  }
+
+  /// Measures the performance of a network using the lock-free buffers, to be compared with
+  /// `testBufferPerformance`.
+  func testConcurrentBufferPerformance() {
+
+    measure {
+      let (network, output) = bufferBoundNetwork(concurrent: true)
+      network.run()
+      XCTAssertEqual(output.vector.count, 1_000_000)
+    }
+
+  }
+
 }
 
 
@@ -104,4 +104,205 @@ class ExtractorsAlgorithmTests: XCTestCase {
 
   }
 
+  /// Tests that `MusicExtractorBatch` running the `Extractor` on several signals concurrently, with
+  /// extractors reused from one signal to the next, gives the same descriptors as analyzing each
+  /// signal with a fresh extractor.
+  func testExtractorBatch() {
+
+    // A low tone keeps the frames from being silent, as the frame cutters add random noise to the
+    // silent ones.
+    let input = loadVector(name: "extractor_input")
+    let tone = input.indices.map { 1e-3 * sin(Float($0) * 0.05) }
+    let signal = zip(input, tone).map(+)
+
+    // The same signal appears twice, so that workers analyze it at the same time.
+    let signals = [signal, signal.reversed(), signal.map { $0 * 0.5 }, signal]
+
+    let expected = signals.map { signal -> Pool in
+      let single = MusicExtractorBatch(extractor: "Extractor")
+      let pools = single.compute(signals: [signal])
+      XCTAssertEqual(single.errors, [:])
+      return pools[0]
+    }
+
+    let batch = MusicExtractorBatch(extractor: "Extractor", threads: 3)
+    XCTAssertEqual(batch.threads, 3)
+
+    // The second run starts with warm extractors.
+    for run in 0..<2 {
+
+      let actual = batch.compute(signals: signals)
+
+      XCTAssertEqual(batch.errors, [:])
+      XCTAssertEqual(actual.count, signals.count)
+
+      for (index, (actualPool, expectedPool)) in zip(actual, expected).enumerated() {
+
+        XCTAssertFalse(expectedPool.descriptorNames.isEmpty)
+        XCTAssertEqual(actualPool.descriptorNames.sorted(), expectedPool.descriptorNames.sorted())
+
+        for descriptor in expectedPool.descriptorNames {
+          XCTAssertEqual(actualPool[descriptor: descriptor], expectedPool[descriptor: descriptor],
+                         "run \(run), signal \(index), descriptor '\(descriptor)'")
+        }
+
+      }
+
+    }
+
+  }
+
+  /// Tests that `MusicExtractorBatch`, which analyzes several files concurrently with extractors
+  /// reused from one file to the next, gives the same statistics as analyzing each file with a
+  /// fresh extractor.
+  func testMusicExtractorBatch() throws {
+
+    try XCTSkipUnless(AlgorithmFactoryWrapper.standardRegisteredNames.contains("MusicExtractor"),
+                      "The MusicExtractor is not available in this build.")
+
+    // The same file appears twice, so that workers analyze it at the same time and share the
+    // process-wide state (decoded audio, FFT plans) of the extractors.
+    let audioFiles = [
+      bundleURL(name: "dubstep", ext: "wav"),
+      bundleURL(name: "vignesh", ext: "wav"),
+      bundleURL(name: "dubstep", ext: "wav"),
+      bundleURL(name: "cat_purrrr", ext: "wav")
+    ]
+
+    let directory = FileManager.default.temporaryDirectory
+                      .appendingPathComponent("MusicExtractorBatch-\(UUID().uuidString)")
+    try FileManager.default.createDirectory(at: directory, withIntermediateDirectories: true)
+    defer { try? FileManager.default.removeItem(at: directory) }
+
+    func outputFiles(_ prefix: String) -> [URL] {
+      return audioFiles.indices.map { directory.appendingPathComponent("\(prefix)\($0).json") }
+    }
+
+    let expectedFiles = outputFiles("single")
+
+    for (audioFile, outputFile) in zip(audioFiles, expectedFiles) {
+      let single = MusicExtractorBatch()
+      XCTAssertEqual(single.compute(audioFiles: [audioFile], outputFiles: [outputFile]), 0,
+                     "\(single.errors)")
+    }
+
+    let batch = MusicExtractorBatch(threads: 3)
+    XCTAssertEqual(batch.threads, 3)
+
+    // The second run starts with warm extractors.
+    for run in 0..<2 {
+
+      let actualFiles = outputFiles("batch\(run)-")
+
+      XCTAssertEqual(batch.compute(audioFiles: audioFiles, outputFiles: actualFiles), 0,
+                     "\(batch.errors)")
+
+      for (actualFile, expectedFile) in zip(actualFiles, expectedFiles) {
+        XCTAssertEqual(try Data(contentsOf: actualFile), try Data(contentsOf: expectedFile),
+                       "\(actualFile.lastPathComponent) differs from \(expectedFile.lastPathComponent)")
+      }
+
+    }
+
+  }
+
+  /// Tests that the statistics of low-level frame descriptors computed as the frames arrive, as the
+  /// `MusicExtractor` does when `lowlevelOutputFrames` is false, match those the `PoolAggregator`
+  /// computes over the stored frames, within the tolerances documented in onlinepoolaggregator.h.
+  func testOnlineStatisticsOfFrameDescriptors() {
+
+    let signal = monoBufferData(url: bundleURL(name: "dubstep", ext: "wav"))
+
+    let stats = ["mean", "var", "stdev", "median", "min", "max", "dmean", "dmean2", "dvar", "dvar2"]
+    let mfccStats = ["mean", "cov", "icov"]
+
+    let signalInput = VectorInput<Float>(signal)
+    let frameCutter = FrameCutterSAlgorithm([.frameSize: 2048, .hopSize: 1024])
+    let windowing = WindowingSAlgorithm([.type: "blackmanharris62"])
+    let spectrum = SpectrumSAlgorithm()
+    let mfcc = MFCCSAlgorithm()
+    let centroid = CentroidSAlgorithm([.range: 22050])
+    let energy = EnergySAlgorithm()
+
+    signalInput[output: .data] >> frameCutter[input: .signal]
+    frameCutter[output: .frame] >> windowing[input: .frame]
+    windowing[output: .frame] >> spectrum[input: .frame]
+    spectrum[output: .spectrum] >> mfcc[input: .spectrum]
+    spectrum[output: .spectrum] >> centroid[input: .array]
+    spectrum[output: .spectrum] >> energy[input: .array]
+
+    let framesPool = Pool(), onlinePool = Pool()
+
+    mfcc[output: .mfcc] >> framesPool[input: "lowlevel.mfcc"]
+    mfcc[output: .bands] >> framesPool[input: "lowlevel.melbands"]
+    centroid[output: .centroid] >> framesPool[input: "lowlevel.spectral_centroid"]
+    energy[output: .energy] >> framesPool[input: "lowlevel.spectral_energy"]
+
+    mfcc[output: .mfcc].connectTo(pool: onlinePool, descriptorName: "lowlevel.mfcc",
+                                  statistics: mfccStats)
+    mfcc[output: .bands].connectTo(pool: onlinePool, descriptorName: "lowlevel.melbands",
+                                   statistics: stats)
+    centroid[output: .centroid].connectTo(pool: onlinePool,
+                                          descriptorName: "lowlevel.spectral_centroid",
+                                          statistics: stats)
+    energy[output: .energy].connectTo(pool: onlinePool, descriptorName: "lowlevel.spectral_energy",
+                                      statistics: stats)
+
+    Network(generator: signalInput).run()
+
+    // The median is only estimated past 100 frames, which this signal exceeds.
+    XCTAssertGreaterThan(framesPool[realVecVec: "lowlevel.melbands"].count, 100)
+
+    let aggregator = PoolAggregatorAlgorithm([.defaultStats: stats])
+    aggregator[stringVecMapParameter: .exceptions] = ["lowlevel.mfcc": mfccStats]
+    aggregator[poolInput: .input] = framesPool
+    aggregator.compute()
+    let expected = aggregator[poolOutput: .output]
+
+    XCTAssertEqual(onlinePool.descriptorNames.sorted(), expected.descriptorNames.sorted())
+
+    for name in expected.descriptorNames {
+
+      let stat = String(name.split(separator: ".").last ?? "")
+      let descriptor = name.split(separator: ".").dropLast().joined(separator: ".")
+
+      /// Flattens a statistic, which is a real, a vector or a matrix.
+      func values(_ value: StoredValue) -> [Float] {
+        switch value {
+          case .real(let real): return [real]
+          case .realVec(let vector): return vector
+          case .realVecVec(let matrix): return matrix.flatMap { $0 }
+          case .realMatrixVec(let matrices): return matrices.flatMap { $0.flatMap { $0 } }
+          default: return []
+        }
+      }
+
+      let actualValues = values(onlinePool[descriptor: name])
+      let expectedValues = values(expected[descriptor: name])
+      XCTAssertEqual(actualValues.count, expectedValues.count, name)
+      XCTAssertFalse(expectedValues.isEmpty, name)
+
+      // The median is estimated, so that it is only checked against the range of the values; its
+      // accuracy is checked by `testOnlinePoolAggregator`.
+      let minimums = values(expected[descriptor: descriptor + ".min"])
+      let maximums = values(expected[descriptor: descriptor + ".max"])
+      let largest = expectedValues.map(abs).max() ?? 0
+
+      for (i, (a, e)) in zip(actualValues, expectedValues).enumerated() {
+        switch stat {
+          case "min", "max", "mean", "dmean", "dmean2":
+            XCTAssertEqual(a, e, name)
+          case "median":
+            XCTAssertEqual(a, e, accuracy: (maximums[i] - minimums[i]) * 0.25, name)
+          case "cov", "icov":
+            XCTAssertEqual(a, e, accuracy: largest * 1e-3, name)
+          default:
+            XCTAssertEqual(a, e, accuracy: abs(e) * 1e-4, name)
+        }
+      }
+
+    }
+
+  }
+
 }
@@ -264,4 +264,268 @@ class IOAlgorithmTests: XCTestCase {
 
   }
 
+  /// Runs a streaming loader created by name and returns the signal it outputs.
+  ///
+  /// - Parameters:
+  ///   - name: The name of the loader, `MonoLoader` or `CachedMonoLoader`.
+  ///   - url: The file to load.
+  ///   - sampleRate: The sample rate of the signal.
+  ///   - downmix: The mixing type for stereo files.
+  /// - Returns: The signal output by the loader.
+  private func loadSignal(_ name: String,
+                          url: URL,
+                          sampleRate: Float = 44100,
+                          downmix: String = "mix") -> [Float]
+  {
+    let parameters: [String:Parameter] = [
+      "filename": Parameter(value: .string(url.path)),
+      "sampleRate": Parameter(value: .real(sampleRate)),
+      "downmix": Parameter(value: .string(downmix))
+    ]
+
+    guard let wrapper = AlgorithmFactoryWrapper.createStreamingAlgorithm(
+                          withName: name, parameterValues: parameters.mapValues(\.wrapper))
+      else
+    {
+      XCTFail("Failed to create a `\(name)`.")
+      return []
+    }
+
+    let loader = AnyStreamingAlgorithm(wrapper: wrapper)
+    let output = VectorOutput<Float>()
+
+    loader[output: "audio"]! >> output[input: .data]
+
+    NetworkWrapper(generator: wrapper).run()
+
+    return output.vector
+  }
+
+  /// Tests that signals are found in the audio cache as long as they are referenced, and that the
+  /// `CachedMonoLoader` reads them from there.
+  func testAudioCache() {
+
+    // The file does not exist, so the signal can only be read from the cache.
+    let url = FileManager.default.temporaryDirectory.appendingPathComponent("\(UUID().uuidString).wav")
+    let signal: [Float] = (0..<10_000).map { sin(Float($0) * 0.01) }
+
+    let count = AudioCacheReference.count
+    XCTAssertFalse(AudioCacheReference.contains(url: url))
+
+    let reference = AudioCacheReference(signal: signal, url: url)
+    XCTAssertTrue(AudioCacheReference.contains(url: url))
+    XCTAssertFalse(AudioCacheReference.contains(url: url, sampleRate: 22050))
+    XCTAssertFalse(AudioCacheReference.contains(url: url, downmix: "left"))
+    XCTAssertEqual(AudioCacheReference.count, count + 1)
+    XCTAssertEqual(reference.signal, signal)
+
+    // A second signal for the same file is not inserted, the cached one is kept.
+    let other = AudioCacheReference(signal: [0, 0, 0], url: url)
+    XCTAssertEqual(other.signal, signal)
+    XCTAssertEqual(AudioCacheReference.count, count + 1)
+
+    XCTAssertEqual(loadSignal("CachedMonoLoader", url: url), signal)
+    XCTAssertTrue(AudioCacheReference.contains(url: url))
+
+    // The signal is freed once its last reference is released.
+    reference.release()
+    XCTAssertNil(reference.signal)
+    XCTAssertTrue(AudioCacheReference.contains(url: url))
+    other.release()
+    XCTAssertFalse(AudioCacheReference.contains(url: url))
+    XCTAssertEqual(AudioCacheReference.count, count)
+
+  }
+
+  /// Tests that the `CachedMonoLoader` outputs exactly the same signal as the `MonoLoader`, whether
+  /// it decodes the file itself or reads it from the cache.
+  func testCachedMonoLoader() throws {
+
+    try XCTSkipUnless(AlgorithmFactoryWrapper.streamingRegisteredNames.contains("MonoLoader"),
+                      "The MonoLoader is not available in this build.")
+
+    let files = [
+      (bundleURL(name: "impulses_1second_22050_st", ext: "wav"), "mix"),
+      (bundleURL(name: "impulses_1second_441002", ext: "wav"), "left"),
+      (bundleURL(name: "dubstep", ext: "wav"), "mix")
+    ]
+
+    for (url, downmix) in files {
+      for sampleRate: Float in [44100, 22050] {
+
+        let expected = loadSignal("MonoLoader", url: url, sampleRate: sampleRate, downmix: downmix)
+        XCTAssertFalse(expected.isEmpty)
+
+        // A miss: the loader decodes the file and releases it once it has been output.
+        XCTAssertFalse(AudioCacheReference.contains(url: url, sampleRate: sampleRate, downmix: downmix))
+        XCTAssertEqual(loadSignal("CachedMonoLoader", url: url, sampleRate: sampleRate, downmix: downmix),
+                       expected, "\(url.lastPathComponent) at \(sampleRate)Hz")
+        XCTAssertFalse(AudioCacheReference.contains(url: url, sampleRate: sampleRate, downmix: downmix))
+
+        // A hit: the signal is decoded by the reference and read from the cache by the loader.
+        let reference = AudioCacheReference(url: url, sampleRate: sampleRate, downmix: downmix)
+        XCTAssertEqual(reference.signal, expected)
+        XCTAssertEqual(loadSignal("CachedMonoLoader", url: url, sampleRate: sampleRate, downmix: downmix),
+                       expected, "\(url.lastPathComponent) at \(sampleRate)Hz")
+        reference.release()
+
+      }
+    }
+
+  }
+
+  /// Tests that the PCM files read directly by the `AudioLoader` give exactly the same signal and
+  /// metadata as when they are decoded with ffmpeg.
+  func testAudioLoaderPCMFastPath() throws {
+
+    try XCTSkipUnless(AlgorithmFactoryWrapper.streamingRegisteredNames.contains("AudioLoader"),
+                      "The AudioLoader is not available in this build.")
+
+    /// Helper for loading a file with a streaming `AudioLoader`.
+    ///
+    /// - Parameters:
+    ///   - url: The file to load.
+    ///   - readPCMDirectly: Whether PCM files are read without ffmpeg.
+    /// - Returns: The signal and a pool with the other outputs of the loader.
+    func load(url: URL, readPCMDirectly: Bool) -> ([StereoSample], Pool) {
+
+      let parameters: [String:Parameter] = [
+        "filename": Parameter(value: .string(url.path)),
+        "computeMD5": Parameter(value: .boolean(true)),
+        "readPCMDirectly": Parameter(value: .boolean(readPCMDirectly))
+      ]
+
+      guard let wrapper = AlgorithmFactoryWrapper.createStreamingAlgorithm(
+                            withName: "AudioLoader", parameterValues: parameters.mapValues(\.wrapper))
+        else
+      {
+        XCTFail("Failed to create an `AudioLoader`.")
+        return ([], Pool())
+      }
+
+      let loader = AnyStreamingAlgorithm(wrapper: wrapper)
+      let audio = VectorOutput<StereoSample>()
+      let pool = Pool()
+
+      loader[output: "audio"]! >> audio[input: .data]
+
+      for output in ["sampleRate", "numberChannels", "md5", "bit_rate", "codec"] {
+        loader[output: output]! >> pool[singleInput: output]
+      }
+
+      NetworkWrapper(generator: wrapper).run()
+
+      return (audio.vector, pool)
+
+    }
+
+    let urls = [
+      bundleURL(name: "cat_purrrr", ext: "wav"),
+      bundleURL(name: "cat_purrrr22050", ext: "wav"),
+      bundleURL(name: "cat_purrrr24bit", ext: "wav"),
+      bundleURL(name: "cat_purrrr32bit", ext: "wav"),
+      bundleURL(name: "distorted", ext: "wav"),
+      bundleURL(name: "dubstep", ext: "wav"),
+      bundleURL(name: "vignesh", ext: "wav"),
+      bundleURL(name: "C4-E♭4-G4_Boesendorfer_Grand_Piano-Trimmed", ext: "aif")
+    ]
+
+    for url in urls {
+
+      let (expectedAudio, expected) = load(url: url, readPCMDirectly: false)
+      let (actualAudio, actual) = load(url: url, readPCMDirectly: true)
+
+      let file = url.lastPathComponent
+
+      XCTAssertFalse(expectedAudio.isEmpty, file)
+      XCTAssertEqual(actualAudio, expectedAudio, file)
+      XCTAssertEqual(actual[string: "md5"], expected[string: "md5"], file)
+      XCTAssertEqual(actual[string: "codec"], expected[string: "codec"], file)
+      XCTAssertEqual(actual[real: "bit_rate"], expected[real: "bit_rate"], file)
+      XCTAssertEqual(actual[real: "sampleRate"], expected[real: "sampleRate"], file)
+      XCTAssertEqual(actual[real: "numberChannels"], expected[real: "numberChannels"], file)
+
+    }
+
+  }
+
+  /// Tests that decoding a long file in parallel segments gives exactly the same signal as decoding
+  /// it sequentially.
+  func testAudioLoaderThreads() throws {
+
+    try XCTSkipUnless(AlgorithmFactoryWrapper.streamingRegisteredNames.contains("AudioLoader"),
+                      "The AudioLoader is not available in this build.")
+
+    // Files are only split into segments of at least a minute, none of the bundled ones is long
+    // enough so write one. It is decoded with ffmpeg, as PCM files read directly are never split.
+    let url = FileManager.default.temporaryDirectory.appendingPathComponent("\(UUID().uuidString).wav")
+    defer { try? FileManager.default.removeItem(at: url) }
+
+    let sampleRate: UInt32 = 44100, channels: UInt16 = 2, frames = 150 * Int(sampleRate)
+    var wav = Data()
+
+    func append<T: FixedWidthInteger>(_ value: T) {
+      withUnsafeBytes(of: value.littleEndian) { wav.append(contentsOf: $0) }
+    }
+
+    wav.append(contentsOf: Array("RIFF".utf8)); append(UInt32(36 + frames * 4))
+    wav.append(contentsOf: Array("WAVEfmt ".utf8)); append(UInt32(16))
+    append(UInt16(1)); append(channels); append(sampleRate); append(sampleRate * 4)
+    append(UInt16(4)); append(UInt16(16))
+    wav.append(contentsOf: Array("data".utf8)); append(UInt32(frames * 4))
+
+    var seed: UInt32 = 1
+    for _ in 0..<(frames * Int(channels)) {
+      seed = seed &* 1_664_525 &+ 1_013_904_223
+      append(Int16(truncatingIfNeeded: seed >> 16))
+    }
+
+    try wav.write(to: url)
+
+    func load(threads: Int32) -> ([StereoSample], String) {
+
+      let parameters: [String:Parameter] = [
+        "filename": Parameter(value: .string(url.path)),
+        "computeMD5": Parameter(value: .boolean(true)),
+        "readPCMDirectly": Parameter(value: .boolean(false)),
+        "threads": Parameter(value: .integer(threads))
+      ]
+
+      guard let wrapper = AlgorithmFactoryWrapper.createStreamingAlgorithm(
+                            withName: "AudioLoader", parameterValues: parameters.mapValues(\.wrapper))
+        else
+      {
+        XCTFail("Failed to create an `AudioLoader`.")
+        return ([], "")
+      }
+
+      let loader = AnyStreamingAlgorithm(wrapper: wrapper)
+      let audio = VectorOutput<StereoSample>()
+      let pool = Pool()
+
+      loader[output: "audio"]! >> audio[input: .data]
+      loader[output: "md5"]! >> pool[singleInput: "md5"]
+
+      for output in ["sampleRate", "numberChannels", "bit_rate", "codec"] {
+        loader[output: output]!>>|
+      }
+
+      NetworkWrapper(generator: wrapper).run()
+
+      return (audio.vector, pool[string: "md5"])
+
+    }
+
+    let (expected, expectedMD5) = load(threads: 1)
+    XCTAssertEqual(expected.count, frames)
+
+    for threads: Int32 in [2, 3] {
+      let (actual, actualMD5) = load(threads: threads)
+      XCTAssertEqual(actual.count, expected.count, "\(threads) threads")
+      XCTAssertTrue(actual == expected, "\(threads) threads")
+      XCTAssertEqual(actualMD5, expectedMD5, "\(threads) threads")
+    }
+
+  }
+
 }
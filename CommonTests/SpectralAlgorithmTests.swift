@@ -63,6 +63,48 @@ class SpectralAlgorithmTests: XCTestCase {
 
   }
 
+  /// Tests that the fused frame cutting, windowing and spectrum algorithm gives the same frames and
+  /// spectra as the chain of algorithms it replaces.
+  func testFramedSpectrum() {
+
+    let audioSignal = monoBufferData(url: bundleURL(name: "sin440_sweep_0db", ext: "wav"))
+
+    let vectorInput1 = VectorInput<Float>(audioSignal)
+    let frameCutter = FrameCutterSAlgorithm([.frameSize: 2048, .hopSize: 512, .silentFrames: "keep"])
+    let windowing = WindowingSAlgorithm([.type: "blackmanharris62", .zeroPadding: 2048])
+    let spectrum = SpectrumSAlgorithm()
+    let framesOutput1 = VectorOutput<[Float]>()
+    let spectrumOutput1 = VectorOutput<[Float]>()
+
+    vectorInput1[output: .data] >> frameCutter[input: .signal]
+    frameCutter[output: .frame] >> windowing[input: .frame]
+    frameCutter[output: .frame] >> framesOutput1[input: .data]
+    windowing[output: .frame] >> spectrum[input: .frame]
+    spectrum[output: .spectrum] >> spectrumOutput1[input: .data]
+
+    Network(generator: vectorInput1).run()
+
+    let vectorInput2 = VectorInput<Float>(audioSignal)
+    let framedSpectrum = FramedSpectrumSAlgorithm([.frameSize: 2048, .hopSize: 512,
+                                                   .silentFrames: "keep",
+                                                   .windowType: "blackmanharris62",
+                                                   .zeroPadding: 2048])
+    let framesOutput2 = VectorOutput<[Float]>()
+    let spectrumOutput2 = VectorOutput<[Float]>()
+
+    vectorInput2[output: .data] >> framedSpectrum[input: .signal]
+    framedSpectrum[output: .frame] >> framesOutput2[input: .data]
+    framedSpectrum[output: .spectrum] >> spectrumOutput2[input: .data]
+
+    Network(generator: vectorInput2).run()
+
+    XCTAssertFalse(spectrumOutput1.vector.isEmpty)
+    XCTAssertEqual(spectrumOutput2.vector.first?.count, 2049)
+    XCTAssertEqual(framesOutput2.vector, framesOutput1.vector)
+    XCTAssertEqual(spectrumOutput2.vector, spectrumOutput1.vector)
+
+  }
+
   /// Tests the functionality of the `HPCP` algorithm. Values taken from 'test_hpcp.py'.
   func testHPCP() {
 
@@ -640,6 +682,149 @@ class SpectralAlgorithmTests: XCTestCase {
 
   }
 
+  /// Tests the MelBands algorithm for regression. The expected values were computed by the dense
+  /// implementation that preceded the banded `FilterBank`.
+  func testMelBands() {
+
+    let spectrum = (0..<1025).map { Float(($0 * 37) % 101) / 100 }
+
+    /*
+     Test for regression with the default parameters.
+     */
+
+    let expected1: [Float] = [
+      0.342903435, 0.300141096, 0.355743468, 0.355009973, 0.365425885, 0.318090022, 0.349059492,
+      0.333085805, 0.329342246, 0.320392966, 0.341608763, 0.341398209, 0.335869372, 0.32555303,
+      0.343250304, 0.333241671, 0.333317488, 0.335613728, 0.336039603, 0.334064066, 0.334857762,
+      0.335327029, 0.335249722, 0.334683031
+    ]
+
+    let melBands1 = MelBandsAlgorithm()
+    melBands1[realVecInput: .spectrum] = spectrum
+    melBands1.compute()
+
+    XCTAssertEqual(melBands1[realVecOutput: .bands], expected1, deviation: 1e-3)
+
+    /*
+     Test for regression with log magnitude bands normalized to a unit maximum.
+     */
+
+    let expected2: [Float] = [
+      1.20831704, 1.45194793, 1.42704272, 1.4628669, 1.74817371, 1.64828706, 1.91270173, 1.96644759,
+      1.98044384, 1.99177766, 2.19432878, 2.34727144, 2.36325884, 2.40326643, 2.58008933,
+      2.66429782, 2.6949091, 2.89234805, 3.06272078, 3.06390762, 3.24359965, 3.28847241, 3.39432621,
+      3.53697562, 3.67084146, 3.7674942, 3.85629106, 3.98704123, 4.1216898, 4.20548439, 4.33718252,
+      4.4643321, 4.55435467, 4.70047712, 4.79537487, 4.93038893, 5.04054689, 5.15886688, 5.28180742,
+      5.40277433
+    ]
+
+    let melBands2 = MelBandsAlgorithm([
+      .numberBands: 40,
+      .type: "magnitude",
+      .normalize: "unit_max",
+      .log: true
+      ])
+    melBands2[realVecInput: .spectrum] = spectrum
+    melBands2.compute()
+
+    XCTAssertEqual(melBands2[realVecOutput: .bands], expected2, deviation: 1e-3)
+
+  }
+
+  /// Tests the ERBBands algorithm for regression. The expected values were computed by the dense
+  /// implementation that preceded the banded `FilterBank`.
+  func testERBBands() {
+
+    let spectrum = (0..<1025).map { Float(($0 * 37) % 101) / 100 }
+
+    /*
+     Test for regression with the default parameters.
+     */
+
+    let expected1: [Float] = [
+      52.9345741, 264.742523, 891.488708, 3199.35962, 3540.39258, 4606.65332, 9163.27051, 18836.959,
+      23713.334, 29989.8828, 55002.6758, 54116.9531, 76260.4766, 75490.7422, 117262.977, 143151.078,
+      157839.219, 165210.391, 212509.344, 255960.469, 271727.75, 345604.25, 402064.406, 428252.5,
+      458825.969, 511040.5, 538844.812, 593822.688, 598717.5, 585881.188, 599874.188, 539845.75,
+      480434.375, 391712.531, 292766.344, 187929.047, 102702.734, 41456.7852, 10434.2354, 1114.52197
+    ]
+
+    let erbBands1 = ERBBandsAlgorithm()
+    erbBands1[realVecInput: .spectrum] = spectrum
+    erbBands1.compute()
+
+    XCTAssertEqual(erbBands1[realVecOutput: .bands], expected1, deviation: 1e-3)
+
+    /*
+     Test for regression with magnitude bands.
+     */
+
+    let expected2: [Float] = [
+      82.7939224, 2010.26917, 8065.24268, 36917.1875, 75829.3516, 104997.148, 208632.469,
+      304174.938, 416400.719, 591521.188, 763132.375, 892043.688, 888013.188, 660370.562,
+      281260.188, 33506.918
+    ]
+
+    let erbBands2 = ERBBandsAlgorithm([.numberBands: 16, .type: "magnitude"])
+    erbBands2[realVecInput: .spectrum] = spectrum
+    erbBands2.compute()
+
+    XCTAssertEqual(erbBands2[realVecOutput: .bands], expected2, deviation: 1e-3)
+
+  }
+
+  /// Tests the TriangularBarkBands algorithm for regression. The expected values were computed by
+  /// the dense implementation that preceded the banded `FilterBank`.
+  func testTriangularBarkBands() {
+
+    let spectrum = (0..<1025).map { Float(($0 * 37) % 101) / 100 }
+
+    /*
+     Test for regression with the default parameters.
+     */
+
+    let expected1: [Float] = [
+      0.206302956, 0.321977198, 0.324986458, 0.370320708, 0.329341233, 0.375210881, 0.320969909,
+      0.322081804, 0.349768877, 0.331856489, 0.333290458, 0.320595711, 0.344859749, 0.336511105,
+      0.325401276, 0.336803049, 0.33344242, 0.33690697, 0.3353315, 0.334888935, 0.336329311,
+      0.335870951, 0.334351301, 0.331314951
+    ]
+
+    let barkBands1 = TriangularBarkBandsAlgorithm()
+    barkBands1[realVecInput: .spectrum] = spectrum
+    barkBands1.compute()
+
+    XCTAssertEqual(barkBands1[realVecOutput: .bands], expected1, deviation: 1e-3)
+
+    /*
+     Test for regression with magnitude bands.
+     */
+
+    let expected2: [Float] = [
+      0.345731646, 0.486909747, 0.488028586, 0.53231895, 0.497690171, 0.537849605, 0.486569285,
+      0.486847132, 0.515464902, 0.496355832, 0.498757929, 0.485612988, 0.509736121, 0.501585841,
+      0.490472615, 0.501829565, 0.498411447, 0.501879573, 0.500300109, 0.499877006, 0.501300156,
+      0.500875592, 0.499352008, 0.49601984
+    ]
+
+    let barkBands2 = TriangularBarkBandsAlgorithm([.type: "magnitude"])
+    barkBands2[realVecInput: .spectrum] = spectrum
+    barkBands2.compute()
+
+    XCTAssertEqual(barkBands2[realVecOutput: .bands], expected2, deviation: 1e-3)
+
+    /*
+     Test that the log bands are log2(1 + x) of the bands, applied once per band.
+     */
+
+    let barkBands3 = TriangularBarkBandsAlgorithm([.log: true])
+    barkBands3[realVecInput: .spectrum] = spectrum
+    barkBands3.compute()
+
+    XCTAssertEqual(barkBands3[realVecOutput: .bands], expected1.map { log2(1 + $0) }, deviation: 1e-3)
+
+  }
+
   /// Tests the functionality of the MaxMagFreq algorithm. Values taken from
   /// `test_maxmagfreq.py`.
   func testMaxMagFreq() {
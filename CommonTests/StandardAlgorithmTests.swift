@@ -359,6 +359,85 @@ class StandardAlgorithmTests: XCTestCase {
 
   }
 
+  /// Tests that the batched FFT gives the same spectra as the `FFT` algorithm run on each frame.
+  func testFFTBatch() {
+
+    let url = bundleURL(name: "C4-E♭4-G4_Boesendorfer_Grand_Piano-Trimmed", ext: "aif")
+    let signal = monoBufferData(url: url)
+    let frames = (0 ..< 37).map { Array(signal[($0 * 512) ..< ($0 * 512 + 1024)]) }
+
+    let fft = FFTAlgorithm([.size: 1024])
+    var expected: [DSPComplex] = []
+
+    for frame in frames {
+      fft[realVecInput: .frame] = frame
+      fft.compute()
+      expected.append(contentsOf: fft[complexRealVecOutput: .fft])
+    }
+
+    let fftBatch1 = FFTBatchAlgorithm([.size: 1024])
+    fftBatch1[realVecInput: .frames] = Array(frames.joined())
+    fftBatch1.compute()
+
+    XCTAssertEqual(fftBatch1[complexRealVecOutput: .ffts], expected, accuracy: 1e-3)
+
+    /*
+     Test the streaming mode, with a number of frames which is not a multiple of the batch size.
+     */
+
+    let vectorInput = VectorInput<[Float]>(frames)
+    let fftBatch2 = FFTBatchSAlgorithm([.size: 1024, .batchSize: 16])
+    let vectorOutput = VectorOutput<[DSPComplex]>()
+
+    vectorInput[output: .data] >> fftBatch2[input: .frame]
+    fftBatch2[output: .fft] >> vectorOutput[input: .data]
+
+    Network(generator: vectorInput).run()
+
+    XCTAssertEqual(vectorOutput.vector.count, frames.count)
+    XCTAssertEqual(Array(vectorOutput.vector.joined()), expected, accuracy: 1e-3)
+
+  }
+
+  /// Tests the FFT and IFFT algorithms with sizes which are not a power of 2, against a direct computation of the DFT.
+  func testFFTMixedRadix() {
+
+    let url = bundleURL(name: "C4-E♭4-G4_Boesendorfer_Grand_Piano-Trimmed", ext: "aif")
+    let signal = monoBufferData(url: url)
+
+    // 1000 = 2^3 * 5^3 is computed with mixed-radix passes, 1018 = 2 * 509 with Bluestein's algorithm
+    for size in [1000, 1018] {
+
+      let frame = Array(signal[4096 ..< (4096 + size)])
+
+      var expected: [DSPComplex] = []
+      for k in 0 ... size / 2 {
+        var re = 0.0, im = 0.0
+        for (n, x) in frame.enumerated() {
+          let phase = -2.0 * Double.pi * Double((k * n) % size) / Double(size)
+          re += Double(x) * cos(phase)
+          im += Double(x) * sin(phase)
+        }
+        expected.append(DSPComplex(real: Float(re), imag: Float(im)))
+      }
+
+      let fft = FFTAlgorithm([.size: size])
+      fft[realVecInput: .frame] = frame
+      fft.compute()
+
+      let spectrum = fft[complexRealVecOutput: .fft]
+      XCTAssertEqual(spectrum, expected, accuracy: 1e-2)
+
+      let ifft = IFFTAlgorithm([.size: size])
+      ifft[complexRealVecInput: .fft] = spectrum
+      ifft.compute()
+
+      XCTAssertEqual(ifft[realVecOutput: .frame].map { $0 / Float(size) }, frame, accuracy: 1e-4)
+
+    }
+
+  }
+
   /// Tests the functionality ofthe IFFT algorithm. Values taken from `test_ifft.py`.
   func testIFFT() {
 
@@ -405,6 +484,151 @@ class StandardAlgorithmTests: XCTestCase {
 
   }
 
+  /// Tests that the built-in FFT, IFFT and FFTC algorithms, selected with `setFFTBackend`, give
+  /// the regression values of `testFFT()` and `testIFFT()` and the same results as the default
+  /// algorithms based on the Accelerate framework.
+  func testFFTBackends() {
+
+    defer { XCTAssertTrue(AlgorithmFactoryWrapper.setFFTBackend("accelerate")) }
+
+    XCTAssertFalse(AlgorithmFactoryWrapper.setFFTBackend("unknown"))
+
+    let url = bundleURL(name: "C4-E♭4-G4_Boesendorfer_Grand_Piano-Trimmed", ext: "aif")
+    let signal = monoBufferData(url: url)
+    let frames = (0 ..< 16).map { Array(signal[($0 * 1024) ..< ($0 * 1024 + 1024)]) }
+
+    /// Computes the FFT, IFFT and FFTC of the frames and of the regression inputs with the
+    /// algorithms of a backend.
+    func compute(backend: String) -> (fft: [[DSPComplex]], ifft: [[Float]], fftc: [[DSPComplex]]) {
+
+      XCTAssertTrue(AlgorithmFactoryWrapper.setFFTBackend(backend))
+
+      let fft = FFTAlgorithm([.size: 1024])
+      let ifft = IFFTAlgorithm([.size: 1024])
+      let fftc = FFTCAlgorithm([.size: 1024])
+
+      var result: (fft: [[DSPComplex]], ifft: [[Float]], fftc: [[DSPComplex]]) = ([], [], [])
+
+      for frame in frames {
+
+        fft[realVecInput: .frame] = frame
+        fft.compute()
+        let spectrum = fft[complexRealVecOutput: .fft]
+        result.fft.append(spectrum)
+
+        ifft[complexRealVecInput: .fft] = spectrum
+        ifft.compute()
+        result.ifft.append(ifft[realVecOutput: .frame])
+
+        fftc[complexRealVecInput: .frame] = frame.map { DSPComplex(real: $0, imag: 0) }
+        fftc.compute()
+        result.fftc.append(fftc[complexRealVecOutput: .fft])
+
+      }
+
+      let regressionFFT = FFTAlgorithm()
+      regressionFFT[realVecInput: .frame] = loadVector(name: "fft_input")
+      regressionFFT.compute()
+
+      XCTAssertEqual(regressionFFT[complexRealVecOutput: .fft],
+                     loadComplexVector(name: "fft_output"),
+                     accuracy: 1e-3, backend)
+
+      let regressionIFFT = IFFTAlgorithm()
+      regressionIFFT[complexRealVecInput: .fft] = loadComplexVector(name: "ifft_input")
+      regressionIFFT.compute()
+
+      XCTAssertEqual(regressionIFFT[realVecOutput: .frame],
+                     loadVector(name: "ifft_output"),
+                     accuracy: 1e-2, backend)
+
+      return result
+
+    }
+
+    let builtin = compute(backend: "builtin")
+    let accelerate = compute(backend: "accelerate")
+
+    for (actual, expected) in zip(builtin.fft, accelerate.fft) {
+      XCTAssertEqual(actual, expected, accuracy: 1e-3)
+    }
+
+    // The IFFT is not normalized, its values are about 1024 times larger.
+    for (actual, expected) in zip(builtin.ifft, accelerate.ifft) {
+      XCTAssertEqual(actual, expected, accuracy: 1e-2)
+    }
+
+    for (actual, expected) in zip(builtin.fftc, accelerate.fftc) {
+      XCTAssertEqual(actual, expected, accuracy: 1e-3)
+    }
+
+    // The FFTC of a real frame starts with the FFT of the frame.
+    for (fftc, fft) in zip(builtin.fftc, builtin.fft) {
+      XCTAssertEqual(Array(fftc.prefix(fft.count)), fft, accuracy: 1e-3)
+    }
+
+  }
+
+  /// Tests that the FFT algorithms of the same size share their plan, that a plan is kept for a
+  /// while once no algorithm uses it anymore, and that the cache only keeps a few such plans.
+  func testFFTPlanCache() {
+
+    defer { XCTAssertTrue(AlgorithmFactoryWrapper.setFFTBackend("accelerate")) }
+
+    for backend in ["builtin", "accelerate"] {
+
+      XCTAssertTrue(AlgorithmFactoryWrapper.setFFTBackend(backend))
+
+      AlgorithmFactoryWrapper.clearFFTPlanCache()
+
+      let count = AlgorithmFactoryWrapper.cachedFFTPlanCount
+
+      // An unusual size, so that no other algorithm uses the same plan.
+      let size: Int32 = backend == "builtin" ? 1000 : 1 << 15
+      let frame = [Float](repeating: 0.5, count: Int(size))
+
+      // The wrappers might be autoreleased, the pool makes sure they are freed at its end.
+      autoreleasepool {
+
+        let fft1 = FFTAlgorithm([.size: Parameter(value: .integer(size))])
+        fft1[realVecInput: .frame] = frame
+        fft1.compute()
+
+        XCTAssertEqual(AlgorithmFactoryWrapper.cachedFFTPlanCount, count + 1, backend)
+
+        let fft2 = FFTAlgorithm([.size: Parameter(value: .integer(size))])
+        fft2[realVecInput: .frame] = frame
+        fft2.compute()
+
+        XCTAssertEqual(AlgorithmFactoryWrapper.cachedFFTPlanCount, count + 1, backend)
+        XCTAssertEqual(fft1[complexRealVecOutput: .fft], fft2[complexRealVecOutput: .fft])
+
+      }
+
+      // The plan is kept for the next algorithm of that size.
+      XCTAssertEqual(AlgorithmFactoryWrapper.cachedFFTPlanCount, count + 1, backend)
+
+      // Going through many sizes only keeps the most recent plans.
+      for index in 0..<(2 * AlgorithmFactoryWrapper.recentFFTPlanCount) {
+        autoreleasepool {
+          let otherSize = Int32(backend == "builtin" ? 1002 + 2 * index : 1 << (index % 8 + 6))
+          let fft = FFTAlgorithm([.size: Parameter(value: .integer(otherSize))])
+          fft[realVecInput: .frame] = [Float](repeating: 0.5, count: Int(otherSize))
+          fft.compute()
+        }
+      }
+
+      XCTAssertLessThanOrEqual(AlgorithmFactoryWrapper.cachedFFTPlanCount,
+                               count + AlgorithmFactoryWrapper.recentFFTPlanCount, backend)
+
+      AlgorithmFactoryWrapper.clearFFTPlanCache()
+
+      XCTAssertEqual(AlgorithmFactoryWrapper.cachedFFTPlanCount, count, backend)
+
+    }
+
+  }
+
   /// Tests the DCT algorithm. Values taken from 'test_dct.py'.
   func testDCT() {
 
@@ -440,6 +664,34 @@ class StandardAlgorithmTests: XCTestCase {
 
     XCTAssertEqual(output.vector, expected, accuracy: 1e-5)
 
+    /*
+     Test with enough coefficients to be computed with the FFT, against the definition of the DCT and with
+     the IDCT.
+     */
+
+    let size = 64
+    let signal = (0 ..< size).map { Float(sin(Double($0) * 0.3) + cos(Double($0 * $0) * 0.1)) }
+
+    let expectedDCT: [Float] = (0 ..< size).map { k in
+      let scale = k == 0 ? 1 / sqrt(Double(size)) : sqrt(2 / Double(size))
+      let sum = signal.enumerated().reduce(0.0) { result, element in
+        result + Double(element.element) * cos(Double.pi * Double(k) * (Double(element.offset) + 0.5) / Double(size))
+      }
+      return Float(scale * sum)
+    }
+
+    let dct2 = DCTAlgorithm([.inputSize: size, .outputSize: size, .dctType: 2])
+    dct2[realVecInput: .array] = signal
+    dct2.compute()
+
+    XCTAssertEqual(dct2[realVecOutput: .dct], expectedDCT, accuracy: 1e-4)
+
+    let idct = IDCTAlgorithm([.inputSize: size, .outputSize: size, .dctType: 2])
+    idct[realVecInput: .dct] = dct2[realVecOutput: .dct]
+    idct.compute()
+
+    XCTAssertEqual(idct[realVecOutput: .idct], signal, accuracy: 1e-4)
+
   }
 
   /// Tests the functionality of the `Envelope` algorithm. Values taken from `test_envelope.py`.
@@ -1871,7 +2123,26 @@ class StandardAlgorithmTests: XCTestCase {
                                descriptor: "ConstantQ",
                                results: [.differenceMeanOrDeviation: false]))
     }
-    
+
+    /*
+     Test with several frames at once, which are transformed by batches.
+     */
+
+    let input = loadComplexVector(name: "constantq_input")
+    let frames = (1 ... 9).map { scale in input.map { DSPComplex(real: $0.real * Float(scale), imag: $0.imag * Float(scale)) } }
+
+    var expectedFrames: [DSPComplex] = []
+    for frame in frames {
+      constantQ[complexRealVecInput: .frame] = frame
+      constantQ.compute()
+      expectedFrames.append(contentsOf: constantQ[complexRealVecOutput: .constantq])
+    }
+
+    constantQ[complexRealVecInput: .frame] = Array(frames.joined())
+    constantQ.compute()
+
+    XCTAssertEqual(constantQ[complexRealVecOutput: .constantq], expectedFrames, accuracy: 1e-4)
+
   }
 
   /// Tests the functionality of the PeakDetection algorithm. Values taken from
@@ -2135,6 +2406,26 @@ class StandardAlgorithmTests: XCTestCase {
     XCTAssert(peakDetection18[realVecOutput: .positions].isEmpty)
     XCTAssert(peakDetection18[realVecOutput: .amplitudes].isEmpty)
 
+    /*
+     Test keeping fewer peaks than found, above the threshold, with both orderings.
+     */
+
+    let peakDetection19 = PeakDetectionAlgorithm([
+      .range: 10, .maxPosition: 10, .maxPeaks: 2, .threshold: 1.5, .orderBy: "amplitude", .interpolate: false
+      ])
+
+    peakDetection19[realVecInput: .array] = [0, 2, 0, 5, 0, 1, 0, 4, 0, 3, 0]
+    peakDetection19.compute()
+
+    XCTAssertEqual(peakDetection19[realVecOutput: .positions], [3, 7])
+    XCTAssertEqual(peakDetection19[realVecOutput: .amplitudes], [5, 4])
+
+    peakDetection19[stringParameter: .orderBy] = "position"
+    peakDetection19.compute()
+
+    XCTAssertEqual(peakDetection19[realVecOutput: .positions], [1, 3])
+    XCTAssertEqual(peakDetection19[realVecOutput: .amplitudes], [2, 5])
+
   }
 
   /// Tests the functionality of the AutoCorrelation algorithm. Values taken from
@@ -261,6 +261,136 @@ class StatisticsAlgorithmTests: XCTestCase {
     XCTAssertEqual(result13[realVecVec: "foo.bar.dmean2"], [[0, 0], [0, 0]])
     XCTAssertEqual(result13[realVecVec: "foo.bar.dvar2"], [[0, 0], [0, 0]])
 
+    /*
+     Test real matrix calculations for matrices with more columns than rows.
+     */
+
+    let pool16: Pool = ["foo": [[[0, 1, 2], [3, 4, 5]], [[2, 2, 2], [6, 6, 6]], [[1, 4, 1], [0, 8, 2]]]]
+    let aggregator16 = PoolAggregatorAlgorithm([
+      .defaultStats: ["mean", "min", "max", "var", "dmean", "dvar", "dmean2", "dvar2"]
+      ])
+    aggregator16[poolInput: .input] = pool16
+    aggregator16.compute()
+    let result16 = aggregator16[poolOutput: .output]
+
+    XCTAssertEqual(result16[realVecVec: "foo.min"], [[0, 1, 1], [0, 4, 2]])
+    XCTAssertEqual(result16[realVecVec: "foo.max"], [[2, 4, 2], [6, 8, 6]])
+    XCTAssertEqual(result16[realVecVec: "foo.mean"], [[1, 2.3333333, 1.6666667], [3, 6, 4.3333333]],
+                   accuracy: 1e-6)
+    XCTAssertEqual(result16[realVecVec: "foo.var"],
+                   [[0.6666667, 1.5555556, 0.2222222], [6, 2.6666667, 2.8888889]],
+                   accuracy: 1e-5)
+    XCTAssertEqual(result16[realVecVec: "foo.dmean"], [[1.5, 1.5, 0.5], [4.5, 2, 2.5]])
+    XCTAssertEqual(result16[realVecVec: "foo.dvar"], [[0.25, 0.25, 0.25], [2.25, 0, 2.25]])
+    XCTAssertEqual(result16[realVecVec: "foo.dmean2"], [[3, 1, 1], [9, 0, 5]])
+    XCTAssertEqual(result16[realVecVec: "foo.dvar2"], [[0, 0, 0], [0, 0, 0]])
+
+    /*
+     Test that aggregating the descriptors in parallel gives the same results.
+     */
+
+    let pool14: Pool = ["foo": [1, 1, 2, 3, 5, 8, 13, 21, 34],
+                        "bar": [3, 6, 3, 2, 39],
+                        "baz": [[1.1, 2.2, 3.3], [4.4, 5.5, 6.6], [7.7, 8.8, 9.9], [10, 10, 10]],
+                        "qux": [[32.3, 43.21], [44.0, 5.12], [45.12, 415.0]]]
+    let stats14 = ["mean", "min", "max", "median", "var", "stdev", "skew", "kurt",
+                   "dmean", "dvar", "dmean2", "dvar2"]
+
+    let aggregator14 = PoolAggregatorAlgorithm([.defaultStats: stats14])
+    aggregator14[poolInput: .input] = pool14
+    aggregator14.compute()
+    let result14 = aggregator14[poolOutput: .output]
+
+    let aggregator15 = PoolAggregatorAlgorithm([.defaultStats: stats14, .threads: 4])
+    aggregator15[poolInput: .input] = pool14
+    aggregator15.compute()
+    let result15 = aggregator15[poolOutput: .output]
+
+    XCTAssertEqual(result15.descriptorNames.sorted(), result14.descriptorNames.sorted())
+    for stat in stats14 {
+      XCTAssertEqual(result15[real: "foo." + stat], result14[real: "foo." + stat])
+      XCTAssertEqual(result15[real: "bar." + stat], result14[real: "bar." + stat])
+      XCTAssertEqual(result15[realVec: "baz." + stat], result14[realVec: "baz." + stat])
+      XCTAssertEqual(result15[realVec: "qux." + stat], result14[realVec: "qux." + stat])
+    }
+
+  }
+
+  /// Tests that the statistics computed as the frames flow by an online aggregator match those of
+  /// the PoolAggregator computed over all the frames, within the tolerances documented in
+  /// onlinepoolaggregator.h.
+  func testOnlinePoolAggregator() {
+
+    var seed: UInt32 = 0
+
+    /// Returns the next pseudo-random value in [-1, 1).
+    func nextValue() -> Float {
+      seed = seed &* 1103515245 &+ 12345
+      return Float(seed >> 9) / Float(1 << 22) - 1
+    }
+
+    let stats = ["min", "max", "median", "mean", "var", "stdev", "skew", "kurt",
+                 "dmean", "dvar", "dmean2", "dvar2"]
+
+    /// Checks the online value of `stat` against the one of the PoolAggregator, for `column`.
+    func check(_ stat: String, _ actual: Float, _ expected: Float, _ column: [Float]) {
+      let message = "\(stat) over \(column.count) frames"
+      guard !(actual.isNaN && expected.isNaN) else { return }
+      switch stat {
+        case "min", "max", "mean", "dmean", "dmean2":
+          XCTAssertEqual(actual, expected, message)
+        case "skew", "kurt":
+          XCTAssertEqual(actual, expected, accuracy: 1e-4, message)
+        case "median" where column.count <= 100:
+          XCTAssertEqual(actual, expected, message)
+        case "median":
+          // The P-square estimate has no bound on its rank error; these ones were measured on the
+          // values of this test, and only catch an estimate gone wrong.
+          let below = Float(column.filter({ $0 < actual }).count) / Float(column.count)
+          XCTAssertEqual(below, 0.5, accuracy: column.count >= 1500 ? 0.12 : 0.2, message)
+        default:
+          XCTAssertEqual(actual, expected, accuracy: abs(expected) * 1e-4, message)
+      }
+    }
+
+    for count in [1, 2, 3, 6, 40, 100, 101, 300, 2000] {
+
+      seed = UInt32(count)
+      let reals: [Float] = (0..<count).map { _ in let value = nextValue(); return value * value }
+      let frames: [[Float]] = (0..<count).map { _ in
+        let (a, b, c) = (nextValue(), nextValue(), nextValue())
+        return [a, b * b * b, c + 4]
+      }
+
+      let framesPool = Pool(), onlinePool = Pool()
+
+      let realInput = VectorInput<Float>(reals)
+      realInput[output: .data] >> framesPool[input: "real"]
+      realInput[output: .data].connectTo(pool: onlinePool, descriptorName: "real", statistics: stats)
+      Network(generator: realInput).run()
+
+      let framesInput = VectorInput<[Float]>(frames)
+      framesInput[output: .data] >> framesPool[input: "vector"]
+      framesInput[output: .data].connectTo(pool: onlinePool, descriptorName: "vector",
+                                           statistics: stats)
+      Network(generator: framesInput).run()
+
+      let aggregator = PoolAggregatorAlgorithm([.defaultStats: stats])
+      aggregator[poolInput: .input] = framesPool
+      aggregator.compute()
+      let result = aggregator[poolOutput: .output]
+
+      XCTAssertEqual(onlinePool.descriptorNames.sorted(), result.descriptorNames.sorted())
+
+      for stat in stats {
+        check(stat, onlinePool[real: "real." + stat], result[real: "real." + stat], reals)
+        let actual = onlinePool[realVec: "vector." + stat]
+        let expected = result[realVec: "vector." + stat]
+        for j in 0..<3 { check(stat, actual[j], expected[j], frames.map { $0[j] }) }
+      }
+
+    }
+
   }
 
   /// Tests the functionality of the PowerMean algorithm. Values taken from `test_powermean.py`.